@@ -65,7 +65,10 @@ module cheep_bus #(
     input  reg_pkg::reg_rsp_t dlc_resp_i,
 
     output reg_pkg::reg_req_t cic_req_o,
-    input  reg_pkg::reg_rsp_t cic_resp_i
+    input  reg_pkg::reg_rsp_t cic_resp_i,
+
+    output reg_pkg::reg_req_t irq_ctrl_req_o,
+    input  reg_pkg::reg_rsp_t irq_ctrl_resp_i
 );
   import cheep_pkg::*;
   import obi_pkg::*;
@@ -160,6 +163,9 @@ module cheep_bus #(
   assign cic_req_o                          = ext_periph_req[CheepCICIdx];
   assign ext_periph_rsp[CheepCICIdx]        = cic_resp_i;
 
+  assign irq_ctrl_req_o                     = ext_periph_req[CheepIRQCtrlIdx];
+  assign ext_periph_rsp[CheepIRQCtrlIdx]    = irq_ctrl_resp_i;
+
   // External peripherals bus
   periph_bus #(
       .NSLAVE(ExtPeriphNSlave)
@@ -10,13 +10,19 @@
 //              Dynamically routes a 1-bit DSM input to either a CIC or SES filter.
 //              The active path is selected at runtime via register interface.
 //
+// Parameters:
+//   - SES_FIFO_DEPTH          : Depth of the output FIFO of the SES filter.
+//
 // Ports:
 //   - clk_i, rst_ni           : System clock and active-low reset.
 //   - cic_req_i, cic_rsp_o    : Register bus interface for CIC path.
 //   - ses_filter_req_i, ses_filter_rsp_o : Register bus interface for SES path.
 //   - dsm_in_i                : 1-bit delta-sigma modulated input.
 //   - dsm_clk_o               : Clock forwarded to DSM source (from active filter).
-//   - refresh_notif_o         : Pulse when new filtered PCM data is ready.
+//   - refresh_notif_o         : High when new filtered PCM data is ready (with the SES filter,
+//                               from the FIFO watermark until the FIFO is empty).
+//   - ses_data_valid_o        : Data valid of the SES filter, while it is activated.
+//   - cic_data_valid_o        : Data valid of the CIC, while it is activated.
 //
 // Notes:
 //   - Only one filter is active at a time.
@@ -26,6 +32,7 @@
 //   - Produces a valid signal (refresh_notif_o) when either filter outputs valid data.
 
 module dsm_decimation #(
+    parameter integer SES_FIFO_DEPTH = 16
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -42,7 +49,11 @@ module dsm_decimation #(
     input  logic dsm_in_i,
     output logic dsm_clk_o,
 
-    output logic refresh_notif_o
+    output logic refresh_notif_o,
+
+    // Interrupt sources
+    output logic ses_data_valid_o,
+    output logic cic_data_valid_o
 );
 
   //Filters
@@ -91,6 +102,7 @@ module dsm_decimation #(
 
   ses_filter #(
       .MAXIMUM_WIDTH(24),
+      .FIFO_DEPTH(SES_FIFO_DEPTH),
       .reg_req_t(reg_pkg::reg_req_t),
       .reg_rsp_t(reg_pkg::reg_rsp_t)
   ) u_ses_filter (
@@ -108,4 +120,7 @@ module dsm_decimation #(
   assign MUX_control = (SES_activated) ? '1 : ~CIC_activated;
   assign refresh_notif_o = (SES_activated) ? SES_dataValid : (CIC_activated) ? CIC_dataValid : '0;
 
+  assign ses_data_valid_o = SES_activated & SES_dataValid;
+  assign cic_data_valid_o = CIC_activated & CIC_dataValid;
+
 endmodule  // dsm_decimation
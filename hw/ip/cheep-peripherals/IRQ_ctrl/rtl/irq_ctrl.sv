@@ -0,0 +1,102 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: irq_ctrl.sv
+// Description: HEEPidermis peripheral interrupt controller. The rising edge
+//              of each peripheral event sets its pending bit (INTR_STATE,
+//              write 1 to clear), and each enabled pending bit drives one
+//              line of the external interrupt vector (PLIC source EXT_INTR_i).
+
+module irq_ctrl (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // Bus interface
+    input  reg_pkg::reg_req_t req_i,
+    output reg_pkg::reg_rsp_t rsp_o,
+
+    // Peripheral events
+    input logic ses_data_valid_i,
+    input logic cic_data_valid_i,
+    input logic vco_overflow_i,
+    input logic idac_refresh_i,
+    input logic dlc_done_i,
+
+    // Interrupt lines (one per event)
+    output logic [cheep_pkg::IrqCtrlNumSources-1:0] intr_o
+);
+
+  // Hardware --> Registers
+  irq_ctrl_reg_pkg::irq_ctrl_hw2reg_t hw2reg;
+
+  // Registers --> hardware
+  irq_ctrl_reg_pkg::irq_ctrl_reg2hw_t reg2hw;
+
+  // Interrupt controller registers
+  irq_ctrl_reg_top #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t)
+  ) u_irq_ctrl_reg_top (
+      .clk_i    (clk_i),
+      .rst_ni   (rst_ni),
+      .reg_req_i(req_i),
+      .reg_rsp_o(rsp_o),
+      .reg2hw   (reg2hw),
+      .hw2reg   (hw2reg),
+      .devmode_i(1'b0)
+  );
+
+  // Event edge detection. The previous values reset to 1, so that events
+  // that are high out of reset (e.g., dlc_done) do not fire.
+  logic [cheep_pkg::IrqCtrlNumSources-1:0] event_q;
+  logic [cheep_pkg::IrqCtrlNumSources-1:0] event_d;
+  logic [cheep_pkg::IrqCtrlNumSources-1:0] event_rise;
+  logic [cheep_pkg::IrqCtrlNumSources-1:0] intr_state;
+  logic [cheep_pkg::IrqCtrlNumSources-1:0] intr_enable;
+
+  assign event_d = {dlc_done_i, idac_refresh_i, vco_overflow_i, cic_data_valid_i, ses_data_valid_i};
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      event_q <= '1;
+    end else begin
+      event_q <= event_d;
+    end
+  end
+
+  assign event_rise = event_d & ~event_q;
+
+  // Set the pending bits on the rising edges (a write 1 to clear in the same
+  // cycle takes precedence)
+  assign hw2reg.intr_state.ses_data_valid.d = 1'b1;
+  assign hw2reg.intr_state.ses_data_valid.de = event_rise[0];
+  assign hw2reg.intr_state.cic_data_valid.d = 1'b1;
+  assign hw2reg.intr_state.cic_data_valid.de = event_rise[1];
+  assign hw2reg.intr_state.vco_overflow.d = 1'b1;
+  assign hw2reg.intr_state.vco_overflow.de = event_rise[2];
+  assign hw2reg.intr_state.idac_refresh.d = 1'b1;
+  assign hw2reg.intr_state.idac_refresh.de = event_rise[3];
+  assign hw2reg.intr_state.dlc_done.d = 1'b1;
+  assign hw2reg.intr_state.dlc_done.de = event_rise[4];
+
+  assign intr_state = {
+    reg2hw.intr_state.dlc_done.q,
+    reg2hw.intr_state.idac_refresh.q,
+    reg2hw.intr_state.vco_overflow.q,
+    reg2hw.intr_state.cic_data_valid.q,
+    reg2hw.intr_state.ses_data_valid.q
+  };
+  assign intr_enable = {
+    reg2hw.intr_enable.dlc_done.q,
+    reg2hw.intr_enable.idac_refresh.q,
+    reg2hw.intr_enable.vco_overflow.q,
+    reg2hw.intr_enable.cic_data_valid.q,
+    reg2hw.intr_enable.ses_data_valid.q
+  };
+
+  // The PLIC sources are level-sensitive: the line stays high until the
+  // firmware clears the pending bit
+  assign intr_o = intr_state & intr_enable;
+
+endmodule  // irq_ctrl
@@ -0,0 +1,82 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Package auto-generated by `reggen` containing data structure
+
+package irq_ctrl_reg_pkg;
+
+  // Address widths within the block
+  parameter int BlockAw = 3;
+
+  ////////////////////////////
+  // Typedefs for registers //
+  ////////////////////////////
+
+  typedef struct packed {
+    struct packed {logic q;} ses_data_valid;
+    struct packed {logic q;} cic_data_valid;
+    struct packed {logic q;} vco_overflow;
+    struct packed {logic q;} idac_refresh;
+    struct packed {logic q;} dlc_done;
+  } irq_ctrl_reg2hw_intr_state_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} ses_data_valid;
+    struct packed {logic q;} cic_data_valid;
+    struct packed {logic q;} vco_overflow;
+    struct packed {logic q;} idac_refresh;
+    struct packed {logic q;} dlc_done;
+  } irq_ctrl_reg2hw_intr_enable_reg_t;
+
+  typedef struct packed {
+    struct packed {
+      logic d;
+      logic de;
+    } ses_data_valid;
+    struct packed {
+      logic d;
+      logic de;
+    } cic_data_valid;
+    struct packed {
+      logic d;
+      logic de;
+    } vco_overflow;
+    struct packed {
+      logic d;
+      logic de;
+    } idac_refresh;
+    struct packed {
+      logic d;
+      logic de;
+    } dlc_done;
+  } irq_ctrl_hw2reg_intr_state_reg_t;
+
+  // Register -> HW type
+  typedef struct packed {
+    irq_ctrl_reg2hw_intr_state_reg_t  intr_state;   // [9:5]
+    irq_ctrl_reg2hw_intr_enable_reg_t intr_enable;  // [4:0]
+  } irq_ctrl_reg2hw_t;
+
+  // HW -> register type
+  typedef struct packed {
+    irq_ctrl_hw2reg_intr_state_reg_t intr_state;  // [9:0]
+  } irq_ctrl_hw2reg_t;
+
+  // Register offsets
+  parameter logic [BlockAw-1:0] IRQ_CTRL_INTR_STATE_OFFSET = 3'h0;
+  parameter logic [BlockAw-1:0] IRQ_CTRL_INTR_ENABLE_OFFSET = 3'h4;
+
+  // Register index
+  typedef enum int {
+    IRQ_CTRL_INTR_STATE,
+    IRQ_CTRL_INTR_ENABLE
+  } irq_ctrl_id_e;
+
+  // Register width information to check illegal writes
+  parameter logic [3:0] IRQ_CTRL_PERMIT[2] = '{
+      4'b0001,  // index[0] IRQ_CTRL_INTR_STATE
+      4'b0001  // index[1] IRQ_CTRL_INTR_ENABLE
+  };
+
+endpackage
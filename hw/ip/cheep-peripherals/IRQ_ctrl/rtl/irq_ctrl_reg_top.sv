@@ -0,0 +1,504 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Top module auto-generated by `reggen`
+
+
+`include "common_cells/assertions.svh"
+
+module irq_ctrl_reg_top #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int AW = 3
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+    // To HW
+    output irq_ctrl_reg_pkg::irq_ctrl_reg2hw_t reg2hw,  // Write
+    input irq_ctrl_reg_pkg::irq_ctrl_hw2reg_t hw2reg,  // Read
+
+
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+
+  import irq_ctrl_reg_pkg::*;
+
+  localparam int DW = 32;
+  localparam int DBW = DW / 8;  // Byte Width
+
+  // register signals
+  logic           reg_we;
+  logic           reg_re;
+  logic [ AW-1:0] reg_addr;
+  logic [ DW-1:0] reg_wdata;
+  logic [DBW-1:0] reg_be;
+  logic [ DW-1:0] reg_rdata;
+  logic           reg_error;
+
+  logic addrmiss, wr_err;
+
+  logic [DW-1:0] reg_rdata_next;
+
+  // Below register interface can be changed
+  reg_req_t reg_intf_req;
+  reg_rsp_t reg_intf_rsp;
+
+
+  assign reg_intf_req = reg_req_i;
+  assign reg_rsp_o = reg_intf_rsp;
+
+
+  assign reg_we = reg_intf_req.valid & reg_intf_req.write;
+  assign reg_re = reg_intf_req.valid & ~reg_intf_req.write;
+  assign reg_addr = reg_intf_req.addr;
+  assign reg_wdata = reg_intf_req.wdata;
+  assign reg_be = reg_intf_req.wstrb;
+  assign reg_intf_rsp.rdata = reg_rdata;
+  assign reg_intf_rsp.error = reg_error;
+  assign reg_intf_rsp.ready = 1'b1;
+
+  assign reg_rdata = reg_rdata_next;
+  assign reg_error = (devmode_i & addrmiss) | wr_err;
+
+
+  // Define SW related signals
+  // Format: <reg>_<field>_{wd|we|qs}
+  //        or <reg>_{wd|we|qs} if field == 1 or 0
+  logic intr_state_ses_data_valid_qs;
+  logic intr_state_ses_data_valid_wd;
+  logic intr_state_ses_data_valid_we;
+  logic intr_state_cic_data_valid_qs;
+  logic intr_state_cic_data_valid_wd;
+  logic intr_state_cic_data_valid_we;
+  logic intr_state_vco_overflow_qs;
+  logic intr_state_vco_overflow_wd;
+  logic intr_state_vco_overflow_we;
+  logic intr_state_idac_refresh_qs;
+  logic intr_state_idac_refresh_wd;
+  logic intr_state_idac_refresh_we;
+  logic intr_state_dlc_done_qs;
+  logic intr_state_dlc_done_wd;
+  logic intr_state_dlc_done_we;
+  logic intr_enable_ses_data_valid_qs;
+  logic intr_enable_ses_data_valid_wd;
+  logic intr_enable_ses_data_valid_we;
+  logic intr_enable_cic_data_valid_qs;
+  logic intr_enable_cic_data_valid_wd;
+  logic intr_enable_cic_data_valid_we;
+  logic intr_enable_vco_overflow_qs;
+  logic intr_enable_vco_overflow_wd;
+  logic intr_enable_vco_overflow_we;
+  logic intr_enable_idac_refresh_qs;
+  logic intr_enable_idac_refresh_wd;
+  logic intr_enable_idac_refresh_we;
+  logic intr_enable_dlc_done_qs;
+  logic intr_enable_dlc_done_wd;
+  logic intr_enable_dlc_done_we;
+
+  // Register instances
+  // R[intr_state]: V(False)
+
+  //   F[ses_data_valid]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("W1C"),
+      .RESVAL  (1'h0)
+  ) u_intr_state_ses_data_valid (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_state_ses_data_valid_we),
+      .wd(intr_state_ses_data_valid_wd),
+
+      // from internal hardware
+      .de(hw2reg.intr_state.ses_data_valid.de),
+      .d (hw2reg.intr_state.ses_data_valid.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_state.ses_data_valid.q),
+
+      // to register interface (read)
+      .qs(intr_state_ses_data_valid_qs)
+  );
+
+
+  //   F[cic_data_valid]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("W1C"),
+      .RESVAL  (1'h0)
+  ) u_intr_state_cic_data_valid (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_state_cic_data_valid_we),
+      .wd(intr_state_cic_data_valid_wd),
+
+      // from internal hardware
+      .de(hw2reg.intr_state.cic_data_valid.de),
+      .d (hw2reg.intr_state.cic_data_valid.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_state.cic_data_valid.q),
+
+      // to register interface (read)
+      .qs(intr_state_cic_data_valid_qs)
+  );
+
+
+  //   F[vco_overflow]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("W1C"),
+      .RESVAL  (1'h0)
+  ) u_intr_state_vco_overflow (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_state_vco_overflow_we),
+      .wd(intr_state_vco_overflow_wd),
+
+      // from internal hardware
+      .de(hw2reg.intr_state.vco_overflow.de),
+      .d (hw2reg.intr_state.vco_overflow.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_state.vco_overflow.q),
+
+      // to register interface (read)
+      .qs(intr_state_vco_overflow_qs)
+  );
+
+
+  //   F[idac_refresh]: 3:3
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("W1C"),
+      .RESVAL  (1'h0)
+  ) u_intr_state_idac_refresh (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_state_idac_refresh_we),
+      .wd(intr_state_idac_refresh_wd),
+
+      // from internal hardware
+      .de(hw2reg.intr_state.idac_refresh.de),
+      .d (hw2reg.intr_state.idac_refresh.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_state.idac_refresh.q),
+
+      // to register interface (read)
+      .qs(intr_state_idac_refresh_qs)
+  );
+
+
+  //   F[dlc_done]: 4:4
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("W1C"),
+      .RESVAL  (1'h0)
+  ) u_intr_state_dlc_done (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_state_dlc_done_we),
+      .wd(intr_state_dlc_done_wd),
+
+      // from internal hardware
+      .de(hw2reg.intr_state.dlc_done.de),
+      .d (hw2reg.intr_state.dlc_done.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_state.dlc_done.q),
+
+      // to register interface (read)
+      .qs(intr_state_dlc_done_qs)
+  );
+
+
+  // R[intr_enable]: V(False)
+
+  //   F[ses_data_valid]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_intr_enable_ses_data_valid (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_enable_ses_data_valid_we),
+      .wd(intr_enable_ses_data_valid_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_enable.ses_data_valid.q),
+
+      // to register interface (read)
+      .qs(intr_enable_ses_data_valid_qs)
+  );
+
+
+  //   F[cic_data_valid]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_intr_enable_cic_data_valid (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_enable_cic_data_valid_we),
+      .wd(intr_enable_cic_data_valid_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_enable.cic_data_valid.q),
+
+      // to register interface (read)
+      .qs(intr_enable_cic_data_valid_qs)
+  );
+
+
+  //   F[vco_overflow]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_intr_enable_vco_overflow (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_enable_vco_overflow_we),
+      .wd(intr_enable_vco_overflow_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_enable.vco_overflow.q),
+
+      // to register interface (read)
+      .qs(intr_enable_vco_overflow_qs)
+  );
+
+
+  //   F[idac_refresh]: 3:3
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_intr_enable_idac_refresh (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_enable_idac_refresh_we),
+      .wd(intr_enable_idac_refresh_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_enable.idac_refresh.q),
+
+      // to register interface (read)
+      .qs(intr_enable_idac_refresh_qs)
+  );
+
+
+  //   F[dlc_done]: 4:4
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_intr_enable_dlc_done (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(intr_enable_dlc_done_we),
+      .wd(intr_enable_dlc_done_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.intr_enable.dlc_done.q),
+
+      // to register interface (read)
+      .qs(intr_enable_dlc_done_qs)
+  );
+
+
+
+
+  logic [1:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == IRQ_CTRL_INTR_STATE_OFFSET);
+    addr_hit[1] = (reg_addr == IRQ_CTRL_INTR_ENABLE_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[0] & (|(IRQ_CTRL_PERMIT[0] & ~reg_be))) |
+               (addr_hit[1] & (|(IRQ_CTRL_PERMIT[1] & ~reg_be)))));
+  end
+
+  assign intr_state_ses_data_valid_we = addr_hit[0] & reg_we & !reg_error;
+  assign intr_state_ses_data_valid_wd = reg_wdata[0];
+
+  assign intr_state_cic_data_valid_we = addr_hit[0] & reg_we & !reg_error;
+  assign intr_state_cic_data_valid_wd = reg_wdata[1];
+
+  assign intr_state_vco_overflow_we = addr_hit[0] & reg_we & !reg_error;
+  assign intr_state_vco_overflow_wd = reg_wdata[2];
+
+  assign intr_state_idac_refresh_we = addr_hit[0] & reg_we & !reg_error;
+  assign intr_state_idac_refresh_wd = reg_wdata[3];
+
+  assign intr_state_dlc_done_we = addr_hit[0] & reg_we & !reg_error;
+  assign intr_state_dlc_done_wd = reg_wdata[4];
+
+  assign intr_enable_ses_data_valid_we = addr_hit[1] & reg_we & !reg_error;
+  assign intr_enable_ses_data_valid_wd = reg_wdata[0];
+
+  assign intr_enable_cic_data_valid_we = addr_hit[1] & reg_we & !reg_error;
+  assign intr_enable_cic_data_valid_wd = reg_wdata[1];
+
+  assign intr_enable_vco_overflow_we = addr_hit[1] & reg_we & !reg_error;
+  assign intr_enable_vco_overflow_wd = reg_wdata[2];
+
+  assign intr_enable_idac_refresh_we = addr_hit[1] & reg_we & !reg_error;
+  assign intr_enable_idac_refresh_wd = reg_wdata[3];
+
+  assign intr_enable_dlc_done_we = addr_hit[1] & reg_we & !reg_error;
+  assign intr_enable_dlc_done_wd = reg_wdata[4];
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[0] = intr_state_ses_data_valid_qs;
+        reg_rdata_next[1] = intr_state_cic_data_valid_qs;
+        reg_rdata_next[2] = intr_state_vco_overflow_qs;
+        reg_rdata_next[3] = intr_state_idac_refresh_qs;
+        reg_rdata_next[4] = intr_state_dlc_done_qs;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[0] = intr_enable_ses_data_valid_qs;
+        reg_rdata_next[1] = intr_enable_cic_data_valid_qs;
+        reg_rdata_next[2] = intr_enable_vco_overflow_qs;
+        reg_rdata_next[3] = intr_enable_idac_refresh_qs;
+        reg_rdata_next[4] = intr_enable_dlc_done_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module irq_ctrl_reg_top_intf #(
+    parameter  int AW = 3,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    // To HW
+    output irq_ctrl_reg_pkg::irq_ctrl_reg2hw_t reg2hw,  // Write
+    input irq_ctrl_reg_pkg::irq_ctrl_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+
+
+  irq_ctrl_reg_top #(
+      .reg_req_t(reg_bus_req_t),
+      .reg_rsp_t(reg_bus_rsp_t),
+      .AW(AW)
+  ) i_regs (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(s_reg_req),
+      .reg_rsp_o(s_reg_rsp),
+      .reg2hw,  // Write
+      .hw2reg,  // Read
+      .devmode_i
+  );
+
+endmodule
+
+
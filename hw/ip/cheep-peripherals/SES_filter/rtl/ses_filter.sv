@@ -12,7 +12,7 @@
 //
 // Compile-Time Parameters:
 //   - MAXIMUM_WIDTH  : Bit-width of internal datapath (default: 32).
-//   - FIFO_DEPTH     : Depth of the CDC FIFO buffer.
+//   - FIFO_DEPTH     : Depth of the output FIFO (1 to 255, default: 16).
 //
 // Runtime Configuration (via registers):
 //   - ses_window_size          : Common window size (Ww) for all stages.
@@ -20,6 +20,7 @@
 //   - ses_sysclk_division      : Division factor for generating clk_fs_o.
 //   - ses_activated_stages     : Thermometric bitmask to enable SES stages (contiguous '1's, right-aligned).
 //   - ses_gain_stage           : Per-stage input gain (WgX).
+//   - ses_fifo_watermark       : Output FIFO level that raises SES_dataValid.
 //
 // Ports:
 //   - clk_sys_i, rst_ni        : System clock and active-low reset.
@@ -27,11 +28,15 @@
 //   - clk_fs_o                 : Sampling clock derived from clk_sys_i.
 //   - req_i, rsp_o             : Register bus interface.
 //   - SES_activated            : Indicates whether SES filtering is active.
-//   - SES_dataValid            : High when filtered PCM output is ready.
+//   - SES_dataValid            : High from the time the output FIFO reaches the watermark
+//                                until it is empty (DMA trigger).
 //
 // Control and status:
 //   - ses_control              : Enables/disables the SES filter.
-//   - ses_status               : Status register indicating filter state (PCM data Valid, activated).
+//   - ses_status               : Status register indicating filter state (overflow, watermark,
+//                                PCM data valid, activated).
+//   - ses_fifo_level           : Number of filtered outputs in the output FIFO.
+//   - ses_fifo_overflow        : Saturating count of the outputs dropped on a full FIFO.
 //
 // Output:
 //   - rx_data (via FIFO window)
@@ -40,7 +45,9 @@
 //   - Internally instantiates multiple `ses_stage` modules.
 //   - clk_fs_o is derived by dividing clk_sys_i by ses_sysclk_division.
 //   - Applies SES filtering, then decimates the result.
-//   - Output is buffered across clock domains using a CDC FIFO.
+//   - Output crosses to clk_sys_i through a shallow CDC FIFO that is always drained into
+//     the FIFO_DEPTH-deep output FIFO, so that the level can be reported in one domain.
+//   - With the watermark, the DMA reads the FIFO in bursts instead of on every output.
 //   - Results are accessed via the register-mapped window interface.
 //   - If the DEBUG section is uncommented, it will print filtered output values directly to the console.
 
@@ -49,7 +56,7 @@ module ses_filter #(
     parameter type reg_rsp_t = logic,
 
     parameter integer MAXIMUM_WIDTH = 32,  // Maximum width of the internal signals. If bigger than 32, risk of truncation
-    parameter integer FIFO_DEPTH = 4
+    parameter integer FIFO_DEPTH = 16
 ) (
     input logic clk_sys_i,
     input logic rst_ni,
@@ -100,7 +107,10 @@ module ses_filter #(
   localparam integer InputGainWidth = $bits(reg2hw.ses_gain_stage.gain_stg_0.q);
   localparam integer SesStageNumber = $bits(reg2hw.ses_activated_stages.q);
   localparam integer Log2SesStageNumber = $clog2(SesStageNumber);
-  localparam integer Log2FifoDepth = $clog2(FIFO_DEPTH);
+  localparam integer CdcLog2FifoDepth = 2;
+  localparam integer FifoLevelWidth = $bits(hw2reg.ses_fifo_level.d);
+  localparam integer OverflowWidth = $bits(hw2reg.ses_fifo_overflow.d);
+  localparam integer FifoUsageWidth = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
 
 
   //--------------Link between the register and the hardware-----------------
@@ -150,7 +160,22 @@ module ses_filter #(
 
   logic [     MAXIMUM_WIDTH-1:0] cdc_fifo_dst_data_o;
   logic                          cdc_fifo_dst_valid;
-  logic                          cdc_fifo_dst_ready;
+
+  //-----------------Output FIFO--------------------------------------------
+  logic [     MAXIMUM_WIDTH-1:0] fifo_data_o;
+  logic                          fifo_push;
+  logic                          fifo_pop;
+  logic                          fifo_full;
+  logic                          fifo_empty;
+  logic [    FifoUsageWidth-1:0] fifo_usage;
+  logic [    FifoLevelWidth-1:0] fifo_level;
+  logic                          fifo_drop;
+  logic                          rx_ready;
+
+  //-----------------Watermark----------------------------------------------
+  logic [    FifoLevelWidth-1:0] watermark;
+  logic                          burst_q;
+  logic                          trigger;
 
   always_ff @(posedge clk_sys_i or negedge rst_ni) begin
     //reset
@@ -237,7 +262,7 @@ module ses_filter #(
       status_valid <= 1'b0;
 
     end else begin
-      status <= {cdc_fifo_dst_valid, control};
+      status <= {|reg2hw.ses_fifo_overflow.q, trigger, ~fifo_empty, control};
       status_valid <= ~status_valid;
     end
   end
@@ -250,7 +275,7 @@ module ses_filter #(
 
   cdc_fifo_gray #(
       .T(logic [MAXIMUM_WIDTH-1:0]),
-      .LOG_DEPTH(Log2FifoDepth)
+      .LOG_DEPTH(CdcLog2FifoDepth)
   ) pdm2pcm_fifo_i (
       .src_clk_i  (clock_fs),
       .src_rst_ni (rst_ni),
@@ -262,9 +287,63 @@ module ses_filter #(
       .dst_clk_i  (clk_sys_i),
       .dst_data_o (cdc_fifo_dst_data_o),
       .dst_valid_o(cdc_fifo_dst_valid),
-      .dst_ready_i(cdc_fifo_dst_ready)
+      .dst_ready_i(1'b1)
+  );
+
+  //-----------------Output FIFO--------------------------------------------
+  // The outputs arriving on a full FIFO are dropped and counted
+  assign fifo_push = cdc_fifo_dst_valid & ~fifo_full;
+  assign fifo_drop = cdc_fifo_dst_valid & fifo_full;
+  assign fifo_pop  = rx_ready & ~fifo_empty;
+
+  fifo_v3 #(
+      .FALL_THROUGH(1'b0),
+      .DATA_WIDTH  (MAXIMUM_WIDTH),
+      .DEPTH       (FIFO_DEPTH)
+  ) u_output_fifo (
+      .clk_i     (clk_sys_i),
+      .rst_ni    (rst_ni),
+      .flush_i   (1'b0),
+      .testmode_i(1'b0),
+      .full_o    (fifo_full),
+      .empty_o   (fifo_empty),
+      .usage_o   (fifo_usage),
+      .data_i    (cdc_fifo_dst_data_o),
+      .push_i    (fifo_push),
+      .data_o    (fifo_data_o),
+      .pop_i     (fifo_pop)
   );
 
+  assign fifo_level = fifo_full ? FifoLevelWidth'(FIFO_DEPTH) : FifoLevelWidth'(fifo_usage);
+
+  assign hw2reg.ses_fifo_level.d = fifo_level;
+  assign hw2reg.ses_fifo_level.de = 1'b1;
+
+  assign hw2reg.ses_fifo_overflow.d = reg2hw.ses_fifo_overflow.q + OverflowWidth'(1);
+  assign hw2reg.ses_fifo_overflow.de = fifo_drop & ~&reg2hw.ses_fifo_overflow.q;
+
+  //-----------------Watermark----------------------------------------------
+  // The trigger is raised when the level reaches the watermark (clamped to
+  // 1..FIFO_DEPTH) and held until the FIFO is empty, so that the DMA drains
+  // the FIFO in one burst
+  always_comb begin
+    watermark = reg2hw.ses_fifo_watermark.q;
+    if (watermark == '0) watermark = FifoLevelWidth'(1);
+    else if (watermark > FifoLevelWidth'(FIFO_DEPTH)) watermark = FifoLevelWidth'(FIFO_DEPTH);
+  end
+
+  always_ff @(posedge clk_sys_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      burst_q <= 1'b0;
+    end else if (fifo_empty) begin
+      burst_q <= 1'b0;
+    end else if (fifo_level >= watermark) begin
+      burst_q <= 1'b1;
+    end
+  end
+
+  assign trigger = ~fifo_empty & (burst_q | (fifo_level >= watermark));
+
   ses_filter_window #(
       .reg_req_t(reg_req_t),
       .reg_rsp_t(reg_rsp_t),
@@ -272,18 +351,18 @@ module ses_filter #(
   ) u_window (
       .rx_win_i  (fifo_win_h2d),
       .rx_win_o  (fifo_win_d2h),
-      .rx_data_i (cdc_fifo_dst_data_o),
-      .rx_ready_o(cdc_fifo_dst_ready)
+      .rx_data_i (fifo_data_o),
+      .rx_ready_o(rx_ready)
   );
 
   //-----------------sync with DSM stage------------------------------------
   assign SES_activated = control;
-  assign SES_dataValid = cdc_fifo_dst_valid;
+  assign SES_dataValid = trigger;
 
   //---------------DEBUG ONLY, do not push uncommented----------------------
   /*
   always @(posedge data_valid) begin
-    $display("[Time %0t ps] filtered output = %x", $time, cdc_fifo_dst_data_o);
+    $display("[Time %0t ps] filtered output = %x", $time, fifo_data_o);
   end
   */
 
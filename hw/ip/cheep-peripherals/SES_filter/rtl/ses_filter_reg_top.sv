@@ -10,7 +10,7 @@
 module ses_filter_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 5
+    parameter int AW = 6
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -86,7 +86,7 @@ module ses_filter_reg_top #(
     reg_steer = 1;  // Default set to register
 
     // TODO: Can below codes be unique case () inside ?
-    if (reg_req_i.addr[AW-1:0] >= 28) begin
+    if (reg_req_i.addr[AW-1:0] >= 40 && reg_req_i.addr[AW-1:0] < 44) begin
       reg_steer = 0;
     end
   end
@@ -111,7 +111,7 @@ module ses_filter_reg_top #(
   logic ses_control_qs;
   logic ses_control_wd;
   logic ses_control_we;
-  logic [1:0] ses_status_qs;
+  logic [3:0] ses_status_qs;
   logic [4:0] ses_window_size_qs;
   logic [4:0] ses_window_size_wd;
   logic ses_window_size_we;
@@ -142,6 +142,13 @@ module ses_filter_reg_top #(
   logic [4:0] ses_gain_stage_gain_stg_5_qs;
   logic [4:0] ses_gain_stage_gain_stg_5_wd;
   logic ses_gain_stage_gain_stg_5_we;
+  logic [7:0] ses_fifo_level_qs;
+  logic [7:0] ses_fifo_watermark_qs;
+  logic [7:0] ses_fifo_watermark_wd;
+  logic ses_fifo_watermark_we;
+  logic [15:0] ses_fifo_overflow_qs;
+  logic [15:0] ses_fifo_overflow_wd;
+  logic ses_fifo_overflow_we;
 
   // Register instances
   // R[ses_control]: V(False)
@@ -174,9 +181,9 @@ module ses_filter_reg_top #(
   // R[ses_status]: V(False)
 
   prim_subreg #(
-      .DW      (2),
+      .DW      (4),
       .SWACCESS("RO"),
-      .RESVAL  (2'h0)
+      .RESVAL  (4'h0)
   ) u_ses_status (
       .clk_i (clk_i),
       .rst_ni(rst_ni),
@@ -463,9 +470,89 @@ module ses_filter_reg_top #(
   );
 
 
+  // R[ses_fifo_level]: V(False)
 
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_ses_fifo_level (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.ses_fifo_level.de),
+      .d (hw2reg.ses_fifo_level.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(ses_fifo_level_qs)
+  );
+
+
+  // R[ses_fifo_watermark]: V(False)
+
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_ses_fifo_watermark (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ses_fifo_watermark_we),
+      .wd(ses_fifo_watermark_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ses_fifo_watermark.q),
 
-  logic [6:0] addr_hit;
+      // to register interface (read)
+      .qs(ses_fifo_watermark_qs)
+  );
+
+
+  // R[ses_fifo_overflow]: V(False)
+
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_ses_fifo_overflow (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ses_fifo_overflow_we),
+      .wd(ses_fifo_overflow_wd),
+
+      // from internal hardware
+      .de(hw2reg.ses_fifo_overflow.de),
+      .d (hw2reg.ses_fifo_overflow.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ses_fifo_overflow.q),
+
+      // to register interface (read)
+      .qs(ses_fifo_overflow_qs)
+  );
+
+
+
+
+  logic [9:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == SES_FILTER_SES_CONTROL_OFFSET);
@@ -475,6 +562,9 @@ module ses_filter_reg_top #(
     addr_hit[4] = (reg_addr == SES_FILTER_SES_SYSCLK_DIVISION_OFFSET);
     addr_hit[5] = (reg_addr == SES_FILTER_SES_ACTIVATED_STAGES_OFFSET);
     addr_hit[6] = (reg_addr == SES_FILTER_SES_GAIN_STAGE_OFFSET);
+    addr_hit[7] = (reg_addr == SES_FILTER_SES_FIFO_LEVEL_OFFSET);
+    addr_hit[8] = (reg_addr == SES_FILTER_SES_FIFO_WATERMARK_OFFSET);
+    addr_hit[9] = (reg_addr == SES_FILTER_SES_FIFO_OVERFLOW_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -488,7 +578,10 @@ module ses_filter_reg_top #(
                (addr_hit[3] & (|(SES_FILTER_PERMIT[3] & ~reg_be))) |
                (addr_hit[4] & (|(SES_FILTER_PERMIT[4] & ~reg_be))) |
                (addr_hit[5] & (|(SES_FILTER_PERMIT[5] & ~reg_be))) |
-               (addr_hit[6] & (|(SES_FILTER_PERMIT[6] & ~reg_be)))));
+               (addr_hit[6] & (|(SES_FILTER_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(SES_FILTER_PERMIT[7] & ~reg_be))) |
+               (addr_hit[8] & (|(SES_FILTER_PERMIT[8] & ~reg_be))) |
+               (addr_hit[9] & (|(SES_FILTER_PERMIT[9] & ~reg_be)))));
   end
 
   assign ses_control_we = addr_hit[0] & reg_we & !reg_error;
@@ -524,6 +617,12 @@ module ses_filter_reg_top #(
   assign ses_gain_stage_gain_stg_5_we = addr_hit[6] & reg_we & !reg_error;
   assign ses_gain_stage_gain_stg_5_wd = reg_wdata[29:25];
 
+  assign ses_fifo_watermark_we = addr_hit[8] & reg_we & !reg_error;
+  assign ses_fifo_watermark_wd = reg_wdata[7:0];
+
+  assign ses_fifo_overflow_we = addr_hit[9] & reg_we & !reg_error;
+  assign ses_fifo_overflow_wd = reg_wdata[15:0];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -533,7 +632,7 @@ module ses_filter_reg_top #(
       end
 
       addr_hit[1]: begin
-        reg_rdata_next[1:0] = ses_status_qs;
+        reg_rdata_next[3:0] = ses_status_qs;
       end
 
       addr_hit[2]: begin
@@ -561,6 +660,18 @@ module ses_filter_reg_top #(
         reg_rdata_next[29:25] = ses_gain_stage_gain_stg_5_qs;
       end
 
+      addr_hit[7]: begin
+        reg_rdata_next[7:0] = ses_fifo_level_qs;
+      end
+
+      addr_hit[8]: begin
+        reg_rdata_next[7:0] = ses_fifo_watermark_qs;
+      end
+
+      addr_hit[9]: begin
+        reg_rdata_next[15:0] = ses_fifo_overflow_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -582,7 +693,7 @@ module ses_filter_reg_top #(
 endmodule
 
 module ses_filter_reg_top_intf #(
-    parameter  int AW = 5,
+    parameter  int AW = 6,
     localparam int DW = 32
 ) (
     input logic clk_i,
@@ -5,9 +5,27 @@
 // File: vco_decoder.sv
 // Author: David Mallasen
 // Description: HEEPidermis VCO decoder
+//
+// Each conversion updates the VCO_DECODER_CNT register. In double-tap mode
+// (DOUBLE_TAP_GAP = G != 0), each trigger refreshes the VCOs twice, G cycles
+// apart, and only the second refresh is a conversion: its count is the number
+// of oscillations during the gap, which avoids the coarse counter overflow at
+// slow sampling rates. With PACKING.ENABLE set, the count of each VCO is
+// output in its own 16-bit field of the sample instead of their difference,
+// so that one DMA beat moves both channels. With oversampling
+// (OVERSAMPLING.COUNT = M > 1), the counts of M consecutive conversions are
+// summed (accumulate-and-dump, i.e., a first-order CIC decimator) and shifted
+// right by OVERSAMPLING.SHIFT, and only the resulting output samples update the
+// register and notify the DMA. With FIFO_CONTROL.ENABLE set, each output sample
+// is also pushed into a FIFO_DEPTH-deep sample FIFO together with its
+// timestamp (system clock cycles since the FIFO was enabled), read through the
+// FIFO_DATA window, and refresh_notif_o becomes a watermark trigger: it is raised
+// when the FIFO holds FIFO_WATERMARK entries and held until it is empty, so that
+// the DMA moves several samples per trigger.
 
 module vco_decoder #(
-    parameter int unsigned DELAY_CC = vco_pkg::VcoTrigger2drDelayCc
+    parameter int unsigned DELAY_CC = vco_pkg::VcoTrigger2drDelayCc,
+    parameter int unsigned FIFO_DEPTH = 16  // Depth of the sample FIFO (1 to 255)
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -35,18 +53,24 @@ module vco_decoder #(
   // Registers --> hardware
   vco_decoder_reg_pkg::vco_decoder_reg2hw_t reg2hw;
 
+  // Sample FIFO window interface
+  reg_pkg::reg_req_t fifo_win_h2d;
+  reg_pkg::reg_rsp_t fifo_win_d2h;
+
   // VCO decoder registers
   vco_decoder_reg_top #(
       .reg_req_t(reg_pkg::reg_req_t),
       .reg_rsp_t(reg_pkg::reg_rsp_t)
   ) u_vco_decoder_reg_top (
-      .clk_i    (clk_i),
-      .rst_ni   (rst_ni),
-      .reg_req_i(req_i),
-      .reg_rsp_o(rsp_o),
-      .reg2hw   (reg2hw),
-      .hw2reg   (hw2reg),
-      .devmode_i(1'b0)
+      .clk_i        (clk_i),
+      .rst_ni       (rst_ni),
+      .reg_req_i    (req_i),
+      .reg_rsp_o    (rsp_o),
+      .reg_req_win_o(fifo_win_h2d),
+      .reg_rsp_win_i(fifo_win_d2h),
+      .reg2hw       (reg2hw),
+      .hw2reg       (hw2reg),
+      .devmode_i    (1'b0)
   );
 
   // Generate a refresh signal every reg2hw.refresh_cycles cycles, as
@@ -64,26 +88,73 @@ module vco_decoder #(
       .trigger_o(refresh_train)
   );
 
-  assign refresh_o = refresh_train[0] | reg2hw.manual_refresh_train0;
+  // Double tap: a second refresh train starts DOUBLE_TAP_GAP cycles after
+  // each trigger, and the conversion is taken on the second train only. The
+  // gap is at least 2 cycles, as the trains must not merge on train[1], which
+  // clocks vco_computation. The triggers during the gap are skipped, with
+  // their whole train, so that a gap longer than the refresh period only
+  // lowers the conversion rate.
+  logic [DELAY_CC-1:0] tap_train;
+  logic [        31:0] gap_cycles;
+  logic [        31:0] gap_count_q;
+  logic                gap_active_q;
+  logic                double_tap;
+  logic                first_tap;
+  logic                second_tap;
+  logic                skip;
+  logic [DELAY_CC-2:0] skip_q;
+  logic [DELAY_CC-1:0] first_train;
+  logic [DELAY_CC-1:0] train;
+
+  assign double_tap = reg2hw.double_tap_gap.q != '0;
+  assign gap_cycles = (reg2hw.double_tap_gap.q < 32'd2) ? 32'd2 : reg2hw.double_tap_gap.q;
+  assign first_tap = double_tap & refresh_train[0] & ~gap_active_q;
+  assign skip = double_tap & refresh_train[0] & gap_active_q;
+  assign second_tap = gap_active_q & (gap_count_q == gap_cycles - 32'd1);
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      gap_count_q  <= '0;
+      gap_active_q <= 1'b0;
+      tap_train    <= '0;
+      skip_q       <= '0;
+    end else begin
+      tap_train <= {tap_train[DELAY_CC-2:0], second_tap};
+      skip_q    <= {skip_q[DELAY_CC-3:0], skip};
+      if (first_tap) begin
+        gap_count_q  <= 32'd1;
+        gap_active_q <= 1'b1;
+      end else if (!double_tap || second_tap) begin
+        gap_count_q  <= '0;
+        gap_active_q <= 1'b0;
+      end else if (gap_active_q) begin
+        gap_count_q <= gap_count_q + 32'd1;
+      end
+    end
+  end
+
+  assign first_train = refresh_train & ~{skip_q, skip};
+  assign train = first_train | tap_train;
+
+  assign refresh_o = train[0] | reg2hw.manual_refresh_train0;
 
   // Set the values of the registers (d) and enable them (de) at the appropriate time.
   // First the VCO sets the coarse and fine values and then the vco_computation
   assign hw2reg.adc_p_fine_out.d = p_fine_i;
-  assign hw2reg.adc_p_fine_out.de = refresh_train[1] | reg2hw.manual_refresh_train1;
+  assign hw2reg.adc_p_fine_out.de = train[1] | reg2hw.manual_refresh_train1;
   assign hw2reg.adc_n_fine_out.d = n_fine_i;
-  assign hw2reg.adc_n_fine_out.de = refresh_train[1] | reg2hw.manual_refresh_train1;
+  assign hw2reg.adc_n_fine_out.de = train[1] | reg2hw.manual_refresh_train1;
   assign hw2reg.adc_p_coarse_out.d = p_coarse_i;
-  assign hw2reg.adc_p_coarse_out.de = refresh_train[1] | reg2hw.manual_refresh_train1;
+  assign hw2reg.adc_p_coarse_out.de = train[1] | reg2hw.manual_refresh_train1;
   assign hw2reg.adc_n_coarse_out.d = n_coarse_i;
-  assign hw2reg.adc_n_coarse_out.de = refresh_train[1] | reg2hw.manual_refresh_train1;
+  assign hw2reg.adc_n_coarse_out.de = train[1] | reg2hw.manual_refresh_train1;
 
   logic [31:0] p_decoder_cnt;
   logic [31:0] n_decoder_cnt;
-  logic [31:0] decoder_cnt;
 
   vco_computation u_vco_p_computation (
       .rstn_i(rst_ni),
-      .clk_i(refresh_train[1] | reg2hw.manual_refresh_train1),  // 1 cycle delayed refresh signal
+      .clk_i(train[1] | reg2hw.manual_refresh_train1),  // 1 cycle delayed refresh signal
       .phasesS2(p_fine_i),
       .coarsecAS(p_coarse_i),
       .digdata_o(p_decoder_cnt)
@@ -91,32 +162,227 @@ module vco_decoder #(
 
   vco_computation u_vco_n_computation (
       .rstn_i(rst_ni),
-      .clk_i(refresh_train[1] | reg2hw.manual_refresh_train1),  // 1 cycle delayed refresh signal
+      .clk_i(train[1] | reg2hw.manual_refresh_train1),  // 1 cycle delayed refresh signal
       .phasesS2(n_fine_i),
       .coarsecAS(n_coarse_i),
       .digdata_o(n_decoder_cnt)
   );
 
+  assign p_enable_o = reg2hw.enable.p_enable;
+  assign n_enable_o = reg2hw.enable.n_enable;
+
+  // Oversampling
+  // Each conversion (rising edge of refresh_train[2], of tap_train[2] in
+  // double-tap mode, or of the manual train) adds the decoder count of each
+  // VCO to its accumulator; the M-th one dumps the sums as an output sample.
+  // Without oversampling, the output sample follows the decoder counts.
+  localparam integer OversamplingWidth = $bits(reg2hw.oversampling.count.q);
+
+  logic                         conversion;
+  logic                         conversion_q;
+  logic                         conversion_rise;
+  logic                         oversampling;
+  logic [OversamplingWidth-1:0] acc_count_q;
+  logic [                 31:0] p_acc_q;
+  logic [                 31:0] n_acc_q;
+  logic [                 31:0] p_acc_sum;
+  logic [                 31:0] n_acc_sum;
+  logic [                 31:0] acc_sum;
+  logic                         acc_dump;
+  logic [                 31:0] sample;
+  logic                         sample_strobe;
+  logic                         sample_valid;
+
+  assign conversion = (double_tap ? tap_train[2] : refresh_train[2]) | reg2hw.manual_refresh_train2;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      conversion_q <= 1'b0;
+    end else begin
+      conversion_q <= conversion;
+    end
+  end
+
+  assign conversion_rise = conversion & ~conversion_q;
+  assign oversampling = reg2hw.oversampling.count.q > OversamplingWidth'(1);
+  assign p_acc_sum = (oversampling ? p_acc_q : '0) + p_decoder_cnt;
+  assign n_acc_sum = (oversampling ? n_acc_q : '0) + n_decoder_cnt;
+  assign acc_dump = ~oversampling | (acc_count_q >= reg2hw.oversampling.count.q - OversamplingWidth'(1));
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      p_acc_q     <= '0;
+      n_acc_q     <= '0;
+      acc_count_q <= '0;
+    end else if (!oversampling || (conversion_rise && acc_dump)) begin
+      p_acc_q     <= '0;
+      n_acc_q     <= '0;
+      acc_count_q <= '0;
+    end else if (conversion_rise) begin
+      p_acc_q     <= p_acc_sum;
+      n_acc_q     <= n_acc_sum;
+      acc_count_q <= acc_count_q + OversamplingWidth'(1);
+    end
+  end
+
   // If both VCOs are enabled, the decoder count is the difference between the two VCOs.
   // Otherwise, it is the count of the enabled VCO, if any.
   always_comb begin
     if (p_enable_o && n_enable_o) begin
-      decoder_cnt = p_decoder_cnt - n_decoder_cnt;
+      acc_sum = p_acc_sum - n_acc_sum;
     end else if (p_enable_o) begin
-      decoder_cnt = p_decoder_cnt;
+      acc_sum = p_acc_sum;
     end else if (n_enable_o) begin
-      decoder_cnt = n_decoder_cnt;
+      acc_sum = n_acc_sum;
     end else begin
-      decoder_cnt = '0;
+      acc_sum = '0;
+    end
+  end
+
+  // Dual-channel output
+  // With PACKING.ENABLE set, the output sample packs the shifted sum of each
+  // VCO in a 16-bit field (P in 15:0, N in 31:16) instead of their difference,
+  // so that the DMA moves both channels in one beat. The counts are clamped to
+  // the field range, which loses its MSB to the channel tag with PACKING.TAG.
+  logic [31:0] diff_sample;
+  logic [31:0] p_sample;
+  logic [31:0] n_sample;
+  logic [15:0] field_max;
+  logic [15:0] p_field;
+  logic [15:0] n_field;
+
+  assign diff_sample = $signed(acc_sum) >>> reg2hw.oversampling.shift.q;
+  assign p_sample = $signed(p_acc_sum) >>> reg2hw.oversampling.shift.q;
+  assign n_sample = $signed(n_acc_sum) >>> reg2hw.oversampling.shift.q;
+  assign field_max = reg2hw.packing.tag.q ? 16'h7fff : 16'hffff;
+
+  // The field of a disabled VCO is 0
+  always_comb begin
+    if (!p_enable_o || $signed(p_sample) < 0) p_field = '0;
+    else if (p_sample > {16'h0, field_max}) p_field = field_max;
+    else p_field = p_sample[15:0];
+    if (!n_enable_o || $signed(n_sample) < 0) n_field = '0;
+    else if (n_sample > {16'h0, field_max}) n_field = field_max;
+    else n_field = n_sample[15:0];
+    if (reg2hw.packing.tag.q) begin
+      p_field[15] = 1'b0;
+      n_field[15] = 1'b1;
     end
   end
 
+  assign sample = reg2hw.packing.enable.q ? {n_field, p_field} : diff_sample;
+
+  // Output sample: a pulse per dump with oversampling, otherwise the
+  // conversion train itself
+  assign sample_strobe = conversion_rise & acc_dump;
+  assign sample_valid = oversampling ? sample_strobe : conversion;
+
   // sets the decoder count (output of the decoders, computed from the coarse and fine counts)
-  assign hw2reg.vco_decoder_cnt.d = decoder_cnt;
-  assign hw2reg.vco_decoder_cnt.de = refresh_train[2] | reg2hw.manual_refresh_train2;
-  assign refresh_notif_o = refresh_train[2] | reg2hw.manual_refresh_train2;
-  assign p_enable_o = reg2hw.enable.p_enable;
-  assign n_enable_o = reg2hw.enable.n_enable;
+  assign hw2reg.vco_decoder_cnt.d = sample;
+  assign hw2reg.vco_decoder_cnt.de = sample_valid;
+
+  // Sample FIFO
+  // Each output sample is pushed with its timestamp. The samples arriving on
+  // a full FIFO are dropped and counted.
+  localparam integer FifoLevelWidth = $bits(hw2reg.fifo_level.d);
+  localparam integer OverflowWidth = $bits(hw2reg.fifo_overflow.d);
+  localparam integer FifoUsageWidth = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
+
+  logic                      fifo_enable;
+  logic [              31:0] timestamp;
+  logic [              63:0] fifo_data_o;
+  logic                      fifo_push;
+  logic                      fifo_pop;
+  logic                      fifo_full;
+  logic                      fifo_empty;
+  logic [FifoUsageWidth-1:0] fifo_usage;
+  logic [FifoLevelWidth-1:0] fifo_level;
+  logic                      fifo_drop;
+  logic [FifoLevelWidth-1:0] watermark;
+  logic                      burst_q;
+  logic                      trigger;
+
+  assign fifo_enable = reg2hw.fifo_control.enable.q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      timestamp <= '0;
+    end else begin
+      timestamp <= fifo_enable ? timestamp + 32'd1 : '0;
+    end
+  end
+
+  assign hw2reg.timestamp.d = timestamp;
+  assign hw2reg.timestamp.de = 1'b1;
+
+  assign fifo_push = fifo_enable & sample_strobe & ~fifo_full;
+  assign fifo_drop = fifo_enable & sample_strobe & fifo_full;
+
+  fifo_v3 #(
+      .FALL_THROUGH(1'b0),
+      .DATA_WIDTH  (64),
+      .DEPTH       (FIFO_DEPTH)
+  ) u_sample_fifo (
+      .clk_i     (clk_i),
+      .rst_ni    (rst_ni),
+      .flush_i   (~fifo_enable),
+      .testmode_i(1'b0),
+      .full_o    (fifo_full),
+      .empty_o   (fifo_empty),
+      .usage_o   (fifo_usage),
+      .data_i    ({timestamp, sample}),
+      .push_i    (fifo_push),
+      .data_o    (fifo_data_o),
+      .pop_i     (fifo_pop)
+  );
+
+  assign fifo_level = fifo_full ? FifoLevelWidth'(FIFO_DEPTH) : FifoLevelWidth'(fifo_usage);
+
+  assign hw2reg.fifo_level.d = fifo_level;
+  assign hw2reg.fifo_level.de = 1'b1;
+
+  assign hw2reg.fifo_overflow.d = reg2hw.fifo_overflow.q + OverflowWidth'(1);
+  assign hw2reg.fifo_overflow.de = fifo_drop & ~&reg2hw.fifo_overflow.q;
+
+  vco_decoder_window #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t)
+  ) u_window (
+      .clk_i         (clk_i),
+      .rst_ni        (rst_ni),
+      .rx_win_i      (fifo_win_h2d),
+      .rx_win_o      (fifo_win_d2h),
+      .rx_count_i    (fifo_data_o[31:0]),
+      .rx_timestamp_i(fifo_data_o[63:32]),
+      .rx_valid_i    (~fifo_empty),
+      .two_words_i   (reg2hw.fifo_control.timestamp.q),
+      .clear_i       (~fifo_enable),
+      .rx_ready_o    (fifo_pop)
+  );
+
+  // The trigger is raised when the level reaches the watermark (clamped to
+  // 1..FIFO_DEPTH) and held until the FIFO is empty, so that the DMA drains
+  // the FIFO in one burst
+  always_comb begin
+    watermark = reg2hw.fifo_watermark.q;
+    if (watermark == '0) watermark = FifoLevelWidth'(1);
+    else if (watermark > FifoLevelWidth'(FIFO_DEPTH)) watermark = FifoLevelWidth'(FIFO_DEPTH);
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      burst_q <= 1'b0;
+    end else if (fifo_empty) begin
+      burst_q <= 1'b0;
+    end else if (fifo_level >= watermark) begin
+      burst_q <= 1'b1;
+    end
+  end
+
+  assign trigger = ~fifo_empty & (burst_q | (fifo_level >= watermark));
+
+  // DMA trigger: every output sample, or the watermark trigger with the FIFO
+  assign refresh_notif_o = fifo_enable ? trigger : sample_valid;
 
   // VCO counter
   // The VCO counter is a 32-bit counter that counts the number of ticks
@@ -7,7 +7,7 @@
 package vco_decoder_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 6;
+  parameter int BlockAw = 8;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -30,6 +30,27 @@ package vco_decoder_reg_pkg;
 
   typedef struct packed {logic q;} vco_decoder_reg2hw_manual_refresh_train2_reg_t;
 
+  typedef struct packed {
+    struct packed {logic q;} enable;
+    struct packed {logic q;} timestamp;
+  } vco_decoder_reg2hw_fifo_control_reg_t;
+
+  typedef struct packed {logic [7:0] q;} vco_decoder_reg2hw_fifo_watermark_reg_t;
+
+  typedef struct packed {logic [15:0] q;} vco_decoder_reg2hw_fifo_overflow_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [9:0] q;} count;
+    struct packed {logic [4:0] q;} shift;
+  } vco_decoder_reg2hw_oversampling_reg_t;
+
+  typedef struct packed {logic [31:0] q;} vco_decoder_reg2hw_double_tap_gap_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} enable;
+    struct packed {logic q;} tag;
+  } vco_decoder_reg2hw_packing_reg_t;
+
   typedef struct packed {
     logic [30:0] d;
     logic        de;
@@ -55,39 +76,75 @@ package vco_decoder_reg_pkg;
     logic        de;
   } vco_decoder_hw2reg_vco_decoder_cnt_reg_t;
 
+  typedef struct packed {
+    logic [7:0] d;
+    logic       de;
+  } vco_decoder_hw2reg_fifo_level_reg_t;
+
+  typedef struct packed {
+    logic [15:0] d;
+    logic        de;
+  } vco_decoder_hw2reg_fifo_overflow_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } vco_decoder_hw2reg_timestamp_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    vco_decoder_reg2hw_refresh_cycles_reg_t refresh_cycles;  // [69:38]
-    vco_decoder_reg2hw_counter_limit_reg_t counter_limit;  // [37:6]
-    vco_decoder_reg2hw_manual_trigger_reg_t manual_trigger;  // [5:5]
-    vco_decoder_reg2hw_enable_reg_t enable;  // [4:3]
-    vco_decoder_reg2hw_manual_refresh_train0_reg_t manual_refresh_train0;  // [2:2]
-    vco_decoder_reg2hw_manual_refresh_train1_reg_t manual_refresh_train1;  // [1:1]
-    vco_decoder_reg2hw_manual_refresh_train2_reg_t manual_refresh_train2;  // [0:0]
+    vco_decoder_reg2hw_refresh_cycles_reg_t refresh_cycles;  // [144:113]
+    vco_decoder_reg2hw_counter_limit_reg_t counter_limit;  // [112:81]
+    vco_decoder_reg2hw_manual_trigger_reg_t manual_trigger;  // [80:80]
+    vco_decoder_reg2hw_enable_reg_t enable;  // [79:78]
+    vco_decoder_reg2hw_manual_refresh_train0_reg_t manual_refresh_train0;  // [77:77]
+    vco_decoder_reg2hw_manual_refresh_train1_reg_t manual_refresh_train1;  // [76:76]
+    vco_decoder_reg2hw_manual_refresh_train2_reg_t manual_refresh_train2;  // [75:75]
+    vco_decoder_reg2hw_fifo_control_reg_t fifo_control;  // [74:73]
+    vco_decoder_reg2hw_fifo_watermark_reg_t fifo_watermark;  // [72:65]
+    vco_decoder_reg2hw_fifo_overflow_reg_t fifo_overflow;  // [64:49]
+    vco_decoder_reg2hw_oversampling_reg_t oversampling;  // [48:34]
+    vco_decoder_reg2hw_double_tap_gap_reg_t double_tap_gap;  // [33:2]
+    vco_decoder_reg2hw_packing_reg_t packing;  // [1:0]
   } vco_decoder_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    vco_decoder_hw2reg_adc_p_fine_out_reg_t   adc_p_fine_out;    // [150:119]
-    vco_decoder_hw2reg_adc_n_fine_out_reg_t   adc_n_fine_out;    // [118:87]
-    vco_decoder_hw2reg_adc_p_coarse_out_reg_t adc_p_coarse_out;  // [86:60]
-    vco_decoder_hw2reg_adc_n_coarse_out_reg_t adc_n_coarse_out;  // [59:33]
-    vco_decoder_hw2reg_vco_decoder_cnt_reg_t  vco_decoder_cnt;   // [32:0]
+    vco_decoder_hw2reg_adc_p_fine_out_reg_t   adc_p_fine_out;    // [209:178]
+    vco_decoder_hw2reg_adc_n_fine_out_reg_t   adc_n_fine_out;    // [177:146]
+    vco_decoder_hw2reg_adc_p_coarse_out_reg_t adc_p_coarse_out;  // [145:119]
+    vco_decoder_hw2reg_adc_n_coarse_out_reg_t adc_n_coarse_out;  // [118:92]
+    vco_decoder_hw2reg_vco_decoder_cnt_reg_t  vco_decoder_cnt;   // [91:59]
+    vco_decoder_hw2reg_fifo_level_reg_t       fifo_level;        // [58:50]
+    vco_decoder_hw2reg_fifo_overflow_reg_t    fifo_overflow;     // [49:33]
+    vco_decoder_hw2reg_timestamp_reg_t        timestamp;         // [32:0]
   } vco_decoder_hw2reg_t;
 
   // Register offsets
-  parameter logic [BlockAw-1:0] VCO_DECODER_REFRESH_CYCLES_OFFSET = 6'h0;
-  parameter logic [BlockAw-1:0] VCO_DECODER_COUNTER_LIMIT_OFFSET = 6'h4;
-  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_TRIGGER_OFFSET = 6'h8;
-  parameter logic [BlockAw-1:0] VCO_DECODER_ENABLE_OFFSET = 6'hc;
-  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_P_FINE_OUT_OFFSET = 6'h10;
-  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_N_FINE_OUT_OFFSET = 6'h14;
-  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_P_COARSE_OUT_OFFSET = 6'h18;
-  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_N_COARSE_OUT_OFFSET = 6'h1c;
-  parameter logic [BlockAw-1:0] VCO_DECODER_VCO_DECODER_CNT_OFFSET = 6'h20;
-  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN0_OFFSET = 6'h24;
-  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN1_OFFSET = 6'h28;
-  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN2_OFFSET = 6'h2c;
+  parameter logic [BlockAw-1:0] VCO_DECODER_REFRESH_CYCLES_OFFSET = 8'h0;
+  parameter logic [BlockAw-1:0] VCO_DECODER_COUNTER_LIMIT_OFFSET = 8'h4;
+  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_TRIGGER_OFFSET = 8'h8;
+  parameter logic [BlockAw-1:0] VCO_DECODER_ENABLE_OFFSET = 8'hc;
+  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_P_FINE_OUT_OFFSET = 8'h10;
+  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_N_FINE_OUT_OFFSET = 8'h14;
+  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_P_COARSE_OUT_OFFSET = 8'h18;
+  parameter logic [BlockAw-1:0] VCO_DECODER_ADC_N_COARSE_OUT_OFFSET = 8'h1c;
+  parameter logic [BlockAw-1:0] VCO_DECODER_VCO_DECODER_CNT_OFFSET = 8'h20;
+  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN0_OFFSET = 8'h24;
+  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN1_OFFSET = 8'h28;
+  parameter logic [BlockAw-1:0] VCO_DECODER_MANUAL_REFRESH_TRAIN2_OFFSET = 8'h2c;
+  parameter logic [BlockAw-1:0] VCO_DECODER_FIFO_CONTROL_OFFSET = 8'h30;
+  parameter logic [BlockAw-1:0] VCO_DECODER_FIFO_LEVEL_OFFSET = 8'h34;
+  parameter logic [BlockAw-1:0] VCO_DECODER_FIFO_WATERMARK_OFFSET = 8'h38;
+  parameter logic [BlockAw-1:0] VCO_DECODER_FIFO_OVERFLOW_OFFSET = 8'h3c;
+  parameter logic [BlockAw-1:0] VCO_DECODER_TIMESTAMP_OFFSET = 8'h40;
+  parameter logic [BlockAw-1:0] VCO_DECODER_OVERSAMPLING_OFFSET = 8'h44;
+  parameter logic [BlockAw-1:0] VCO_DECODER_DOUBLE_TAP_GAP_OFFSET = 8'h48;
+  parameter logic [BlockAw-1:0] VCO_DECODER_PACKING_OFFSET = 8'h4c;
+
+  // Window parameters
+  parameter logic [BlockAw-1:0] VCO_DECODER_FIFO_DATA_OFFSET = 8'h80;
+  parameter int unsigned VCO_DECODER_FIFO_DATA_SIZE = 'h4;
 
   // Register index
   typedef enum int {
@@ -102,11 +159,19 @@ package vco_decoder_reg_pkg;
     VCO_DECODER_VCO_DECODER_CNT,
     VCO_DECODER_MANUAL_REFRESH_TRAIN0,
     VCO_DECODER_MANUAL_REFRESH_TRAIN1,
-    VCO_DECODER_MANUAL_REFRESH_TRAIN2
+    VCO_DECODER_MANUAL_REFRESH_TRAIN2,
+    VCO_DECODER_FIFO_CONTROL,
+    VCO_DECODER_FIFO_LEVEL,
+    VCO_DECODER_FIFO_WATERMARK,
+    VCO_DECODER_FIFO_OVERFLOW,
+    VCO_DECODER_TIMESTAMP,
+    VCO_DECODER_OVERSAMPLING,
+    VCO_DECODER_DOUBLE_TAP_GAP,
+    VCO_DECODER_PACKING
   } vco_decoder_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] VCO_DECODER_PERMIT[12] = '{
+  parameter logic [3:0] VCO_DECODER_PERMIT[20] = '{
       4'b1111,  // index[ 0] VCO_DECODER_REFRESH_CYCLES
       4'b1111,  // index[ 1] VCO_DECODER_COUNTER_LIMIT
       4'b0001,  // index[ 2] VCO_DECODER_MANUAL_TRIGGER
@@ -118,7 +183,15 @@ package vco_decoder_reg_pkg;
       4'b1111,  // index[ 8] VCO_DECODER_VCO_DECODER_CNT
       4'b0001,  // index[ 9] VCO_DECODER_MANUAL_REFRESH_TRAIN0
       4'b0001,  // index[10] VCO_DECODER_MANUAL_REFRESH_TRAIN1
-      4'b0001  // index[11] VCO_DECODER_MANUAL_REFRESH_TRAIN2
+      4'b0001,  // index[11] VCO_DECODER_MANUAL_REFRESH_TRAIN2
+      4'b0001,  // index[12] VCO_DECODER_FIFO_CONTROL
+      4'b0001,  // index[13] VCO_DECODER_FIFO_LEVEL
+      4'b0001,  // index[14] VCO_DECODER_FIFO_WATERMARK
+      4'b0011,  // index[15] VCO_DECODER_FIFO_OVERFLOW
+      4'b1111,  // index[16] VCO_DECODER_TIMESTAMP
+      4'b0111,  // index[17] VCO_DECODER_OVERSAMPLING
+      4'b1111,  // index[18] VCO_DECODER_DOUBLE_TAP_GAP
+      4'b0001  // index[19] VCO_DECODER_PACKING
   };
 
 endpackage
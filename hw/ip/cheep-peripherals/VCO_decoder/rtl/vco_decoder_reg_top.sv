@@ -10,15 +10,20 @@
 module vco_decoder_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 6
+    parameter int AW = 8
 ) (
     input logic clk_i,
     input logic rst_ni,
     input reg_req_t reg_req_i,
     output reg_rsp_t reg_rsp_o,
+
+    // Output port for window
+    output reg_req_t [1-1:0] reg_req_win_o,
+    input  reg_rsp_t [1-1:0] reg_rsp_win_i,
+
     // To HW
     output vco_decoder_reg_pkg::vco_decoder_reg2hw_t reg2hw,  // Write
-    input vco_decoder_reg_pkg::vco_decoder_hw2reg_t hw2reg,  // Read
+    input  vco_decoder_reg_pkg::vco_decoder_hw2reg_t hw2reg,  // Read
 
 
     // Config
@@ -48,8 +53,43 @@ module vco_decoder_reg_top #(
   reg_rsp_t reg_intf_rsp;
 
 
-  assign reg_intf_req = reg_req_i;
-  assign reg_rsp_o = reg_intf_rsp;
+  logic [0:0] reg_steer;
+
+  reg_req_t [2-1:0] reg_intf_demux_req;
+  reg_rsp_t [2-1:0] reg_intf_demux_rsp;
+
+  // demux connection
+  assign reg_intf_req = reg_intf_demux_req[1];
+  assign reg_intf_demux_rsp[1] = reg_intf_rsp;
+
+  assign reg_req_win_o[0] = reg_intf_demux_req[0];
+  assign reg_intf_demux_rsp[0] = reg_rsp_win_i[0];
+
+  // Create Socket_1n
+  reg_demux #(
+      .NoPorts(2),
+      .req_t  (reg_req_t),
+      .rsp_t  (reg_rsp_t)
+  ) i_reg_demux (
+      .clk_i,
+      .rst_ni,
+      .in_req_i(reg_req_i),
+      .in_rsp_o(reg_rsp_o),
+      .out_req_o(reg_intf_demux_req),
+      .out_rsp_i(reg_intf_demux_rsp),
+      .in_select_i(reg_steer)
+  );
+
+
+  // Create steering logic
+  always_comb begin
+    reg_steer = 1;  // Default set to register
+
+    // TODO: Can below codes be unique case () inside ?
+    if (reg_req_i.addr[AW-1:0] >= 128 && reg_req_i.addr[AW-1:0] < 132) begin
+      reg_steer = 0;
+    end
+  end
 
 
   assign reg_we = reg_intf_req.valid & reg_intf_req.write;
@@ -107,6 +147,35 @@ module vco_decoder_reg_top #(
   logic manual_refresh_train2_qs;
   logic manual_refresh_train2_wd;
   logic manual_refresh_train2_we;
+  logic fifo_control_enable_qs;
+  logic fifo_control_enable_wd;
+  logic fifo_control_enable_we;
+  logic fifo_control_timestamp_qs;
+  logic fifo_control_timestamp_wd;
+  logic fifo_control_timestamp_we;
+  logic [7:0] fifo_level_qs;
+  logic [7:0] fifo_watermark_qs;
+  logic [7:0] fifo_watermark_wd;
+  logic fifo_watermark_we;
+  logic [15:0] fifo_overflow_qs;
+  logic [15:0] fifo_overflow_wd;
+  logic fifo_overflow_we;
+  logic [31:0] timestamp_qs;
+  logic [9:0] oversampling_count_qs;
+  logic [9:0] oversampling_count_wd;
+  logic oversampling_count_we;
+  logic [4:0] oversampling_shift_qs;
+  logic [4:0] oversampling_shift_wd;
+  logic oversampling_shift_we;
+  logic [31:0] double_tap_gap_qs;
+  logic [31:0] double_tap_gap_wd;
+  logic double_tap_gap_we;
+  logic packing_enable_qs;
+  logic packing_enable_wd;
+  logic packing_enable_we;
+  logic packing_tag_qs;
+  logic packing_tag_wd;
+  logic packing_tag_we;
 
   // Register instances
   // R[refresh_cycles]: V(False)
@@ -460,9 +529,304 @@ module vco_decoder_reg_top #(
   );
 
 
+  // R[fifo_control]: V(False)
+
+  //   F[enable]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_fifo_control_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fifo_control_enable_we),
+      .wd(fifo_control_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fifo_control.enable.q),
+
+      // to register interface (read)
+      .qs(fifo_control_enable_qs)
+  );
+
+
+  //   F[timestamp]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_fifo_control_timestamp (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fifo_control_timestamp_we),
+      .wd(fifo_control_timestamp_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fifo_control.timestamp.q),
+
+      // to register interface (read)
+      .qs(fifo_control_timestamp_qs)
+  );
+
+
+  // R[fifo_level]: V(False)
+
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_fifo_level (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.fifo_level.de),
+      .d (hw2reg.fifo_level.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(fifo_level_qs)
+  );
+
+
+  // R[fifo_watermark]: V(False)
+
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_fifo_watermark (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fifo_watermark_we),
+      .wd(fifo_watermark_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fifo_watermark.q),
+
+      // to register interface (read)
+      .qs(fifo_watermark_qs)
+  );
+
+
+  // R[fifo_overflow]: V(False)
+
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_fifo_overflow (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fifo_overflow_we),
+      .wd(fifo_overflow_wd),
+
+      // from internal hardware
+      .de(hw2reg.fifo_overflow.de),
+      .d (hw2reg.fifo_overflow.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fifo_overflow.q),
+
+      // to register interface (read)
+      .qs(fifo_overflow_qs)
+  );
+
+
+  // R[timestamp]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_timestamp (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.timestamp.de),
+      .d (hw2reg.timestamp.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(timestamp_qs)
+  );
+
+
+  // R[oversampling]: V(False)
 
+  //   F[count]: 9:0
+  prim_subreg #(
+      .DW      (10),
+      .SWACCESS("RW"),
+      .RESVAL  (10'h0)
+  ) u_oversampling_count (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(oversampling_count_we),
+      .wd(oversampling_count_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.oversampling.count.q),
+
+      // to register interface (read)
+      .qs(oversampling_count_qs)
+  );
+
+
+  //   F[shift]: 20:16
+  prim_subreg #(
+      .DW      (5),
+      .SWACCESS("RW"),
+      .RESVAL  (5'h0)
+  ) u_oversampling_shift (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(oversampling_shift_we),
+      .wd(oversampling_shift_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.oversampling.shift.q),
+
+      // to register interface (read)
+      .qs(oversampling_shift_qs)
+  );
+
+
+  // R[double_tap_gap]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_double_tap_gap (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(double_tap_gap_we),
+      .wd(double_tap_gap_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.double_tap_gap.q),
+
+      // to register interface (read)
+      .qs(double_tap_gap_qs)
+  );
+
+
+  // R[packing]: V(False)
+
+  //   F[enable]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_packing_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(packing_enable_we),
+      .wd(packing_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.packing.enable.q),
+
+      // to register interface (read)
+      .qs(packing_enable_qs)
+  );
+
+
+  //   F[tag]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_packing_tag (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(packing_tag_we),
+      .wd(packing_tag_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.packing.tag.q),
 
-  logic [11:0] addr_hit;
+      // to register interface (read)
+      .qs(packing_tag_qs)
+  );
+
+
+
+
+  logic [19:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == VCO_DECODER_REFRESH_CYCLES_OFFSET);
@@ -477,6 +841,14 @@ module vco_decoder_reg_top #(
     addr_hit[9] = (reg_addr == VCO_DECODER_MANUAL_REFRESH_TRAIN0_OFFSET);
     addr_hit[10] = (reg_addr == VCO_DECODER_MANUAL_REFRESH_TRAIN1_OFFSET);
     addr_hit[11] = (reg_addr == VCO_DECODER_MANUAL_REFRESH_TRAIN2_OFFSET);
+    addr_hit[12] = (reg_addr == VCO_DECODER_FIFO_CONTROL_OFFSET);
+    addr_hit[13] = (reg_addr == VCO_DECODER_FIFO_LEVEL_OFFSET);
+    addr_hit[14] = (reg_addr == VCO_DECODER_FIFO_WATERMARK_OFFSET);
+    addr_hit[15] = (reg_addr == VCO_DECODER_FIFO_OVERFLOW_OFFSET);
+    addr_hit[16] = (reg_addr == VCO_DECODER_TIMESTAMP_OFFSET);
+    addr_hit[17] = (reg_addr == VCO_DECODER_OVERSAMPLING_OFFSET);
+    addr_hit[18] = (reg_addr == VCO_DECODER_DOUBLE_TAP_GAP_OFFSET);
+    addr_hit[19] = (reg_addr == VCO_DECODER_PACKING_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -495,7 +867,15 @@ module vco_decoder_reg_top #(
                (addr_hit[ 8] & (|(VCO_DECODER_PERMIT[ 8] & ~reg_be))) |
                (addr_hit[ 9] & (|(VCO_DECODER_PERMIT[ 9] & ~reg_be))) |
                (addr_hit[10] & (|(VCO_DECODER_PERMIT[10] & ~reg_be))) |
-               (addr_hit[11] & (|(VCO_DECODER_PERMIT[11] & ~reg_be)))));
+               (addr_hit[11] & (|(VCO_DECODER_PERMIT[11] & ~reg_be))) |
+               (addr_hit[12] & (|(VCO_DECODER_PERMIT[12] & ~reg_be))) |
+               (addr_hit[13] & (|(VCO_DECODER_PERMIT[13] & ~reg_be))) |
+               (addr_hit[14] & (|(VCO_DECODER_PERMIT[14] & ~reg_be))) |
+               (addr_hit[15] & (|(VCO_DECODER_PERMIT[15] & ~reg_be))) |
+               (addr_hit[16] & (|(VCO_DECODER_PERMIT[16] & ~reg_be))) |
+               (addr_hit[17] & (|(VCO_DECODER_PERMIT[17] & ~reg_be))) |
+               (addr_hit[18] & (|(VCO_DECODER_PERMIT[18] & ~reg_be))) |
+               (addr_hit[19] & (|(VCO_DECODER_PERMIT[19] & ~reg_be)))));
   end
 
   assign refresh_cycles_we = addr_hit[0] & reg_we & !reg_error;
@@ -537,6 +917,33 @@ module vco_decoder_reg_top #(
   assign manual_refresh_train2_we = addr_hit[11] & reg_we & !reg_error;
   assign manual_refresh_train2_wd = reg_wdata[0];
 
+  assign fifo_control_enable_we = addr_hit[12] & reg_we & !reg_error;
+  assign fifo_control_enable_wd = reg_wdata[0];
+
+  assign fifo_control_timestamp_we = addr_hit[12] & reg_we & !reg_error;
+  assign fifo_control_timestamp_wd = reg_wdata[1];
+
+  assign fifo_watermark_we = addr_hit[14] & reg_we & !reg_error;
+  assign fifo_watermark_wd = reg_wdata[7:0];
+
+  assign fifo_overflow_we = addr_hit[15] & reg_we & !reg_error;
+  assign fifo_overflow_wd = reg_wdata[15:0];
+
+  assign oversampling_count_we = addr_hit[17] & reg_we & !reg_error;
+  assign oversampling_count_wd = reg_wdata[9:0];
+
+  assign oversampling_shift_we = addr_hit[17] & reg_we & !reg_error;
+  assign oversampling_shift_wd = reg_wdata[20:16];
+
+  assign double_tap_gap_we = addr_hit[18] & reg_we & !reg_error;
+  assign double_tap_gap_wd = reg_wdata[31:0];
+
+  assign packing_enable_we = addr_hit[19] & reg_we & !reg_error;
+  assign packing_enable_wd = reg_wdata[0];
+
+  assign packing_tag_we = addr_hit[19] & reg_we & !reg_error;
+  assign packing_tag_wd = reg_wdata[1];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -590,6 +997,41 @@ module vco_decoder_reg_top #(
         reg_rdata_next[0] = manual_refresh_train2_qs;
       end
 
+      addr_hit[12]: begin
+        reg_rdata_next[0] = fifo_control_enable_qs;
+        reg_rdata_next[1] = fifo_control_timestamp_qs;
+      end
+
+      addr_hit[13]: begin
+        reg_rdata_next[7:0] = fifo_level_qs;
+      end
+
+      addr_hit[14]: begin
+        reg_rdata_next[7:0] = fifo_watermark_qs;
+      end
+
+      addr_hit[15]: begin
+        reg_rdata_next[15:0] = fifo_overflow_qs;
+      end
+
+      addr_hit[16]: begin
+        reg_rdata_next[31:0] = timestamp_qs;
+      end
+
+      addr_hit[17]: begin
+        reg_rdata_next[9:0] = oversampling_count_qs;
+        reg_rdata_next[20:16] = oversampling_shift_qs;
+      end
+
+      addr_hit[18]: begin
+        reg_rdata_next[31:0] = double_tap_gap_qs;
+      end
+
+      addr_hit[19]: begin
+        reg_rdata_next[0] = packing_enable_qs;
+        reg_rdata_next[1] = packing_tag_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -611,12 +1053,13 @@ module vco_decoder_reg_top #(
 endmodule
 
 module vco_decoder_reg_top_intf #(
-    parameter  int AW = 6,
+    parameter  int AW = 8,
     localparam int DW = 32
 ) (
     input logic clk_i,
     input logic rst_ni,
     REG_BUS.in regbus_slave,
+    REG_BUS.out regbus_win_mst[1-1:0],
     // To HW
     output vco_decoder_reg_pkg::vco_decoder_reg2hw_t reg2hw,  // Write
     input vco_decoder_reg_pkg::vco_decoder_hw2reg_t hw2reg,  // Read
@@ -641,6 +1084,13 @@ module vco_decoder_reg_top_intf #(
   `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
   `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
 
+  reg_bus_req_t s_reg_win_req[1-1:0];
+  reg_bus_rsp_t s_reg_win_rsp[1-1:0];
+  for (genvar i = 0; i < 1; i++) begin : gen_assign_window_structs
+    `REG_BUS_ASSIGN_TO_REQ(s_reg_win_req[i], regbus_win_mst[i])
+    `REG_BUS_ASSIGN_FROM_RSP(regbus_win_mst[i], s_reg_win_rsp[i])
+  end
+
 
 
   vco_decoder_reg_top #(
@@ -652,6 +1102,8 @@ module vco_decoder_reg_top_intf #(
       .rst_ni,
       .reg_req_i(s_reg_req),
       .reg_rsp_o(s_reg_rsp),
+      .reg_req_win_o(s_reg_win_req),
+      .reg_rsp_win_i(s_reg_win_rsp),
       .reg2hw,  // Write
       .hw2reg,  // Read
       .devmode_i
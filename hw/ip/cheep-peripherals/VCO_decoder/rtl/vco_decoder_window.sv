@@ -0,0 +1,50 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vco_decoder_window.sv
+// Description: Read window of the VCO decoder sample FIFO. Each entry is
+//              read as the decoder count, followed by its timestamp when
+//              two_words_i is set; reading the last word pops the entry.
+
+module vco_decoder_window #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  reg_req_t        rx_win_i,
+    output reg_rsp_t        rx_win_o,
+    input  logic     [31:0] rx_count_i,
+    input  logic     [31:0] rx_timestamp_i,
+    input  logic            rx_valid_i,
+    input  logic            two_words_i,
+    input  logic            clear_i,
+    output logic            rx_ready_o
+);
+  logic [vco_decoder_reg_pkg::BlockAw-1:0] rx_addr;
+  logic rx_win_error;
+  logic rx_read;
+  logic word_q;  // 1 when the timestamp of the head entry is next
+
+  assign rx_addr = rx_win_i.addr;
+  assign rx_win_error = (rx_win_i.write == 1'b1) && (rx_addr != vco_decoder_reg_pkg::VCO_DECODER_FIFO_DATA_OFFSET);
+  assign rx_read = rx_win_i.valid & ~rx_win_i.write & rx_valid_i;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      word_q <= 1'b0;
+    end else if (clear_i || !two_words_i) begin
+      word_q <= 1'b0;
+    end else if (rx_read) begin
+      word_q <= ~word_q;
+    end
+  end
+
+  assign rx_ready_o = rx_read & (~two_words_i | word_q);
+  assign rx_win_o.rdata = word_q ? rx_timestamp_i : rx_count_i;
+  assign rx_win_o.error = rx_win_error;
+  assign rx_win_o.ready = 1'b1;
+
+endmodule : vco_decoder_window
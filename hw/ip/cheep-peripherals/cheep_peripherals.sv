@@ -32,6 +32,7 @@ module cheep_peripherals (
     // Notifications (shared between both iDACs)
     output logic idac_refresh_o,
     output logic idac_refresh_notif_o,
+    output logic idac_feedback_notif_o,
 
     // VCO decoder signals
     input reg_pkg::reg_req_t vco_decoder_req_i,
@@ -86,6 +87,10 @@ module cheep_peripherals (
     input logic dsm_in_i,
     output logic dsm_clk_o,
 
+    // Interrupt controller signals
+    input reg_pkg::reg_req_t irq_ctrl_req_i,
+    output reg_pkg::reg_rsp_t irq_ctrl_rsp_o,
+
     // Interrupts
     output [core_v_mini_mcu_pkg::NEXT_INT-1:0] ext_int_vector_o
 );
@@ -96,27 +101,36 @@ module cheep_peripherals (
   // System clock
   logic system_clk;
 
+  // Interrupt sources
+  logic ses_data_valid;
+  logic cic_data_valid;
+  logic [IrqCtrlNumSources-1:0] irq_ctrl_intr;
+
   // --------------
   // OUTPUT CONTROL
   // --------------
-  assign system_clk_o                                        = system_clk;
-  assign ext_int_vector_o[core_v_mini_mcu_pkg::NEXT_INT-1:0] = '0;
+  assign system_clk_o                                                        = system_clk;
+  assign ext_int_vector_o[core_v_mini_mcu_pkg::NEXT_INT-1:IrqCtrlNumSources] = '0;
+  assign ext_int_vector_o[IrqCtrlNumSources-1:0]                             = irq_ctrl_intr;
 
-  assign system_clk                                          = ref_clk_i;
+  assign system_clk                                                          = ref_clk_i;
 
   idac_ctrl u_idac_ctrl (
-      .clk_i          (system_clk),
-      .rst_ni         (rst_ni),
-      .req_i          (idac_ctrl_req_i),
-      .rsp_o          (idac_ctrl_rsp_o),
-      .enable_1_o     (idac1_enable_o),
-      .current_1_o    (idac1_current_o),
-      .calibration_1_o(idac1_calibration_o),
-      .enable_2_o     (idac2_enable_o),
-      .current_2_o    (idac2_current_o),
-      .calibration_2_o(idac2_calibration_o),
-      .refresh_o      (idac_refresh_o),
-      .refresh_notif_o(idac_refresh_notif_o)
+      .clk_i           (system_clk),
+      .rst_ni          (rst_ni),
+      .req_i           (idac_ctrl_req_i),
+      .rsp_o           (idac_ctrl_rsp_o),
+      .enable_1_o      (idac1_enable_o),
+      .current_1_o     (idac1_current_o),
+      .calibration_1_o (idac1_calibration_o),
+      .enable_2_o      (idac2_enable_o),
+      .current_2_o     (idac2_current_o),
+      .calibration_2_o (idac2_calibration_o),
+      .xing_i          (dlc_xing_o),
+      .dir_i           (dlc_dir_o),
+      .refresh_o       (idac_refresh_o),
+      .refresh_notif_o (idac_refresh_notif_o),
+      .feedback_notif_o(idac_feedback_notif_o)
   );
 
   vco_decoder u_vco_decoder (
@@ -175,7 +189,22 @@ module cheep_peripherals (
       .ses_filter_req_i(ses_filter_req_i),
       .ses_filter_rsp_o(ses_filter_rsp_o),
       .dsm_in_i        (dsm_in_i),
-      .dsm_clk_o       (dsm_clk_o)
+      .dsm_clk_o       (dsm_clk_o),
+      .ses_data_valid_o(ses_data_valid),
+      .cic_data_valid_o(cic_data_valid)
+  );
+
+  irq_ctrl u_irq_ctrl (
+      .clk_i           (system_clk),
+      .rst_ni          (rst_ni),
+      .req_i           (irq_ctrl_req_i),
+      .rsp_o           (irq_ctrl_rsp_o),
+      .ses_data_valid_i(ses_data_valid),
+      .cic_data_valid_i(cic_data_valid),
+      .vco_overflow_i  (vco_counter_overflow_o),
+      .idac_refresh_i  (idac_refresh_notif_o),
+      .dlc_done_i      (dlc_done_o),
+      .intr_o          (irq_ctrl_intr)
   );
 
 endmodule
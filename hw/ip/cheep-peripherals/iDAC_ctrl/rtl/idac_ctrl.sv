@@ -5,6 +5,22 @@
 // File: idac_ctrl.sv
 // Author: David Mallasen
 // Description: HEEPidermis iDAC controller
+//
+// The iDACs are driven by the CURRENT register or, per channel, by the
+// waveform generator (DDS_CONTROL.ENABLE_x). On each refresh counter trigger,
+// an enabled channel outputs the sample at its phase and advances the phase
+// by its frequency, which itself advances by the chirp rate. The sample is
+// read from the shared 64-entry waveform RAM (WAVE_RAM window), indexed by the
+// 6 MSBs of the phase plus the phase offset, or is a square wave. It is
+// scaled by the amplitude, added to the offset and clamped to the iDAC range,
+// so sines, squares and chirps are generated without DMA traffic.
+//
+// Per channel, the iDACs can instead be driven by the closed-loop tracking
+// code of the channel (FEEDBACK_CONTROL.ENABLE_x), which follows the dLC level
+// crossings: each crossing steps the code up or down by FEEDBACK_STEP, at most
+// once every FEEDBACK_SLEW + 1 cycles and within FEEDBACK_LIMITS. The codes are
+// readable in FEEDBACK_CODE, and each step pulses feedback_notif_o so that the
+// DMA can record the code trajectory.
 
 module idac_ctrl #(
     parameter int unsigned DELAY_CC = idac_pkg::IdacTrigger2drDelayCc
@@ -24,24 +40,39 @@ module idac_ctrl #(
     output logic [idac_pkg::IdacCurrentWidth-1:0] current_2_o,
     output logic [idac_pkg::IdacCalibrationWidth-1:0] calibration_2_o,
 
+    // dLC level crossings (dir_i: 0 upward, 1 downward)
+    input logic xing_i,
+    input logic dir_i,
+
     output logic refresh_o,
-    output logic refresh_notif_o
+    output logic refresh_notif_o,
+    output logic feedback_notif_o
 );
 
+  // Hardware --> Registers
+  idac_ctrl_reg_pkg::idac_ctrl_hw2reg_t hw2reg;
+
   // Registers --> hardware
   idac_ctrl_reg_pkg::idac_ctrl_reg2hw_t reg2hw;
 
+  // Waveform RAM window interface
+  reg_pkg::reg_req_t wave_win_h2d;
+  reg_pkg::reg_rsp_t wave_win_d2h;
+
   // iDAC controller registers
   idac_ctrl_reg_top #(
       .reg_req_t(reg_pkg::reg_req_t),
       .reg_rsp_t(reg_pkg::reg_rsp_t)
   ) u_idac_ctrl_reg_top (
-      .clk_i    (clk_i),
-      .rst_ni   (rst_ni),
-      .reg_req_i(req_i),
-      .reg_rsp_o(rsp_o),
-      .reg2hw   (reg2hw),
-      .devmode_i(1'b0)
+      .clk_i        (clk_i),
+      .rst_ni       (rst_ni),
+      .reg_req_i    (req_i),
+      .reg_rsp_o    (rsp_o),
+      .reg_req_win_o(wave_win_h2d),
+      .reg_rsp_win_i(wave_win_d2h),
+      .reg2hw       (reg2hw),
+      .hw2reg       (hw2reg),
+      .devmode_i    (1'b0)
   );
 
 
@@ -50,7 +81,7 @@ module idac_ctrl #(
   // output a trigger signal that can be catched by other blocks that do provide
   // data to the iDAC.
   // The iDAC refresh signal will be controlled (below) by the writing to the
-  // current or calibration registers.
+  // current or calibration registers, or by the steps of the waveform generator.
 
   counter_trigger #(
       .TRAIN_LENGTH(1)
@@ -62,8 +93,192 @@ module idac_ctrl #(
       .trigger_o(refresh_notif_o)
   );
 
+  // Waveform generator
+  // Each channel has a phase accumulator and a chirp accumulator, reset while
+  // the channel is disabled together with its current code, so that it
+  // restarts from the first sample. The waveform sample is a signed 8-bit
+  // value, and the current codes are readable in DDS_CURRENT.
+  localparam int unsigned WaveRamDepth = idac_ctrl_reg_pkg::IDAC_CTRL_WAVE_RAM_SIZE / 4;
+  localparam int unsigned WaveAddrWidth = $clog2(WaveRamDepth);
+
+  logic [1:0]                                 dds_enable;
+  logic [1:0]                                 dds_square;
+  logic [1:0][                          31:0] dds_frequency;
+  logic [1:0][                          31:0] dds_phase;
+  logic [1:0][                          31:0] dds_chirp;
+  logic [1:0][                           7:0] dds_amplitude;
+  logic [1:0][                           7:0] dds_offset;
+  logic [1:0][             WaveAddrWidth-1:0] wave_addr;
+  logic [1:0][                           7:0] wave_sample;
+  logic [1:0][idac_pkg::IdacCurrentWidth-1:0] dds_current;
+  logic                                       dds_step;
+
+  assign dds_enable = {reg2hw.dds_control.enable_2.q, reg2hw.dds_control.enable_1.q};
+  assign dds_square = {reg2hw.dds_control.square_2.q, reg2hw.dds_control.square_1.q};
+  assign dds_frequency = {reg2hw.dds_frequency_2.q, reg2hw.dds_frequency_1.q};
+  assign dds_phase = {reg2hw.dds_phase_2.q, reg2hw.dds_phase_1.q};
+  assign dds_chirp = {reg2hw.dds_chirp_2.q, reg2hw.dds_chirp_1.q};
+  assign dds_amplitude = {reg2hw.dds_amplitude.amplitude_2.q, reg2hw.dds_amplitude.amplitude_1.q};
+  assign dds_offset = {reg2hw.dds_offset.offset_2.q, reg2hw.dds_offset.offset_1.q};
+
+  // The generator is stepped by the refresh counter
+  assign dds_step = refresh_notif_o & |dds_enable;
+
+  idac_ctrl_wave_ram #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .DEPTH    (WaveRamDepth)
+  ) u_wave_ram (
+      .clk_i    (clk_i),
+      .rst_ni   (rst_ni),
+      .win_i    (wave_win_h2d),
+      .win_o    (wave_win_d2h),
+      .raddr_1_i(wave_addr[0]),
+      .rdata_1_o(wave_sample[0]),
+      .raddr_2_i(wave_addr[1]),
+      .rdata_2_o(wave_sample[1])
+  );
+
+  for (genvar i = 0; i < 2; i++) begin : gen_dds
+    logic [                          31:0] phase_q;
+    logic [                          31:0] chirp_q;
+    logic [                          31:0] phase;
+    logic [                           7:0] wave;
+    logic [                          16:0] scaled;
+    logic [                           9:0] level;
+    logic [idac_pkg::IdacCurrentWidth-1:0] current_q;
+
+    assign phase = phase_q + dds_phase[i];
+    assign wave_addr[i] = phase[31-:WaveAddrWidth];
+
+    // Square wave: high during the first half of the period
+    assign wave = dds_square[i] ? (phase[31] ? 8'h80 : 8'h7f) : wave_sample[i];
+
+    // offset + wave * amplitude / 256, clamped to the iDAC range
+    assign scaled = $signed(wave) * $signed({1'b0, dds_amplitude[i]});
+    assign level = $signed({2'b00, dds_offset[i]}) + $signed({scaled[16], scaled[16:8]});
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) begin
+        phase_q   <= '0;
+        chirp_q   <= '0;
+        current_q <= '0;
+      end else if (!dds_enable[i]) begin
+        phase_q   <= '0;
+        chirp_q   <= '0;
+        current_q <= '0;
+      end else if (refresh_notif_o) begin
+        if ($signed(level) < 0) current_q <= '0;
+        else if (level > 10'd255) current_q <= '1;
+        else current_q <= level[7:0];
+        phase_q <= phase_q + dds_frequency[i] + chirp_q;
+        chirp_q <= chirp_q + dds_chirp[i];
+      end
+    end
+
+    assign dds_current[i] = current_q;
+  end
+
+  assign hw2reg.dds_current.current_1.d = dds_current[0];
+  assign hw2reg.dds_current.current_1.de = 1'b1;
+  assign hw2reg.dds_current.current_2.d = dds_current[1];
+  assign hw2reg.dds_current.current_2.de = 1'b1;
+
+  // Closed-loop current tracking
+  // The crossings are accumulated in a saturating pending count (+-127), and
+  // one step is taken towards it whenever the slew counter has expired. Each
+  // channel has its own loop code, stepped by the shared crossings while its
+  // loop is enabled; while it is disabled, the code follows the CURRENT
+  // register of the channel.
+  logic        [1:0]      fb_enable;
+  logic                   fb_active;
+  logic                   fb_up;
+  logic                   fb_down;
+  logic                   fb_step;
+  logic        [1:0][7:0] fb_seed;
+  logic signed      [7:0] fb_pending_q;
+  logic signed      [8:0] fb_pending_d;
+  logic            [15:0] fb_slew_q;
+  logic        [1:0][7:0] fb_code;
+  logic        [1:0][7:0] fb_code_next;
+
+  assign fb_enable = {reg2hw.feedback_control.enable_2.q, reg2hw.feedback_control.enable_1.q};
+  assign fb_active = |fb_enable;
+  assign fb_seed = {reg2hw.current.current_2, reg2hw.current.current_1};
+
+  // An upward crossing steps the code up, unless the polarity is inverted
+  assign fb_up = xing_i & (dir_i == reg2hw.feedback_control.invert.q);
+  assign fb_down = xing_i & (dir_i != reg2hw.feedback_control.invert.q);
+  assign fb_step = fb_active & (fb_slew_q == '0) & (fb_pending_q != '0);
+
+  always_comb begin
+    fb_pending_d = 9'(fb_pending_q) + 9'(fb_up) - 9'(fb_down);
+    if (fb_step) fb_pending_d = fb_pending_q[7] ? fb_pending_d + 9'sd1 : fb_pending_d - 9'sd1;
+    if (fb_pending_d > 9'sd127) fb_pending_d = 9'sd127;
+    else if (fb_pending_d < -9'sd127) fb_pending_d = -9'sd127;
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      fb_pending_q     <= '0;
+      fb_slew_q        <= '0;
+      feedback_notif_o <= 1'b0;
+    end else begin
+      feedback_notif_o <= fb_step;
+      if (!fb_active) begin
+        fb_pending_q <= '0;
+        fb_slew_q    <= '0;
+      end else begin
+        fb_pending_q <= fb_pending_d[7:0];
+        if (fb_step) fb_slew_q <= reg2hw.feedback_slew.q;
+        else if (fb_slew_q != '0) fb_slew_q <= fb_slew_q - 1;
+      end
+    end
+  end
+
+  for (genvar i = 0; i < 2; i++) begin : gen_fb
+    logic        [7:0] code_q;
+    logic        [7:0] code_d;
+    logic        [8:0] code_up;
+    logic signed [9:0] code_down;
+
+    assign code_up = {1'b0, code_q} + {1'b0, reg2hw.feedback_step.q};
+    assign code_down = $signed({2'b00, code_q}) - $signed({2'b00, reg2hw.feedback_step.q});
+
+    always_comb begin
+      code_d = code_q;
+      if (!fb_enable[i]) begin
+        code_d = fb_seed[i];
+      end else if (fb_step && !fb_pending_q[7]) begin
+        if (code_up > {1'b0, reg2hw.feedback_limits.max.q}) code_d = reg2hw.feedback_limits.max.q;
+        else code_d = code_up[7:0];
+      end else if (fb_step) begin
+        if (code_down < $signed({2'b00, reg2hw.feedback_limits.min.q})) code_d = reg2hw.feedback_limits.min.q;
+        else code_d = code_down[7:0];
+      end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) begin
+        code_q <= '0;
+      end else begin
+        code_q <= code_d;
+      end
+    end
+
+    assign fb_code[i] = code_q;
+    assign fb_code_next[i] = code_d;
+  end
+
+  // FEEDBACK_CODE is updated together with the loop codes, so it already holds
+  // the new codes when feedback_notif_o is raised
+  assign hw2reg.feedback_code.code_1.d = fb_code_next[0];
+  assign hw2reg.feedback_code.code_1.de = 1'b1;
+  assign hw2reg.feedback_code.code_2.d = fb_code_next[1];
+  assign hw2reg.feedback_code.code_2.de = 1'b1;
+
   // The refresh_train signals the iDAC that it should obtain the new values from the
-  // calibration and current_in registers
+  // calibration and current_in registers, the waveform generator or the loop
   /* verilator lint_off UNUSED */
   logic [DELAY_CC-1:0] refresh_train;
   /* verilator lint_on UNUSED */
@@ -72,18 +287,18 @@ module idac_ctrl #(
     if (!rst_ni) begin
       refresh_train <= '0;
     end else if (reg2hw.enable.idac1_enable || reg2hw.enable.idac2_enable) begin : refresh_ff_train
-      refresh_train[0] <= req_i.write && req_i.valid;
+      refresh_train[0] <= (req_i.write && req_i.valid) || dds_step || fb_step;
       refresh_train[DELAY_CC-1:1] <= refresh_train[DELAY_CC-2:0];
     end else begin : soft_reset
       refresh_train <= '0;
     end
   end
 
-  assign current_1_o = reg2hw.current.current_1;
+  assign current_1_o = fb_enable[0] ? fb_code[0] : dds_enable[0] ? dds_current[0] : reg2hw.current.current_1;
   assign calibration_1_o = reg2hw.calibration_1;
   assign enable_1_o = reg2hw.enable.idac1_enable;
 
-  assign current_2_o = reg2hw.current.current_2;
+  assign current_2_o = fb_enable[1] ? fb_code[1] : dds_enable[1] ? dds_current[1] : reg2hw.current.current_2;
   assign calibration_2_o = reg2hw.calibration_2;
   assign enable_2_o = reg2hw.enable.idac2_enable;
 
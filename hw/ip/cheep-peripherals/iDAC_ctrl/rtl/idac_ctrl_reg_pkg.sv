@@ -7,7 +7,7 @@
 package idac_ctrl_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 5;
+  parameter int BlockAw = 9;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -31,23 +31,127 @@ package idac_ctrl_reg_pkg;
     struct packed {logic [7:0] q;} current_2;
   } idac_ctrl_reg2hw_current_reg_t;
 
+  typedef struct packed {
+    struct packed {logic q;} enable_1;
+    struct packed {logic q;} enable_2;
+    struct packed {logic q;} square_1;
+    struct packed {logic q;} square_2;
+  } idac_ctrl_reg2hw_dds_control_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_frequency_1_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_frequency_2_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_phase_1_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_phase_2_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_chirp_1_reg_t;
+
+  typedef struct packed {logic [31:0] q;} idac_ctrl_reg2hw_dds_chirp_2_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [7:0] q;} amplitude_1;
+    struct packed {logic [7:0] q;} amplitude_2;
+  } idac_ctrl_reg2hw_dds_amplitude_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [7:0] q;} offset_1;
+    struct packed {logic [7:0] q;} offset_2;
+  } idac_ctrl_reg2hw_dds_offset_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} enable_1;
+    struct packed {logic q;} enable_2;
+    struct packed {logic q;} invert;
+  } idac_ctrl_reg2hw_feedback_control_reg_t;
+
+  typedef struct packed {logic [7:0] q;} idac_ctrl_reg2hw_feedback_step_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [7:0] q;} min;
+    struct packed {logic [7:0] q;} max;
+  } idac_ctrl_reg2hw_feedback_limits_reg_t;
+
+  typedef struct packed {logic [15:0] q;} idac_ctrl_reg2hw_feedback_slew_reg_t;
+
+  typedef struct packed {
+    struct packed {
+      logic [7:0] d;
+      logic       de;
+    } code_1;
+    struct packed {
+      logic [7:0] d;
+      logic       de;
+    } code_2;
+  } idac_ctrl_hw2reg_feedback_code_reg_t;
+
+  typedef struct packed {
+    struct packed {
+      logic [7:0] d;
+      logic       de;
+    } current_1;
+    struct packed {
+      logic [7:0] d;
+      logic       de;
+    } current_2;
+  } idac_ctrl_hw2reg_dds_current_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    idac_ctrl_reg2hw_refresh_cycles_reg_t refresh_cycles;  // [60:29]
-    idac_ctrl_reg2hw_manual_trigger_reg_t manual_trigger;  // [28:28]
-    idac_ctrl_reg2hw_enable_reg_t enable;  // [27:26]
-    idac_ctrl_reg2hw_calibration_1_reg_t calibration_1;  // [25:21]
-    idac_ctrl_reg2hw_calibration_2_reg_t calibration_2;  // [20:16]
-    idac_ctrl_reg2hw_current_reg_t current;  // [15:0]
+    idac_ctrl_reg2hw_refresh_cycles_reg_t refresh_cycles;  // [331:300]
+    idac_ctrl_reg2hw_manual_trigger_reg_t manual_trigger;  // [299:299]
+    idac_ctrl_reg2hw_enable_reg_t enable;  // [298:297]
+    idac_ctrl_reg2hw_calibration_1_reg_t calibration_1;  // [296:292]
+    idac_ctrl_reg2hw_calibration_2_reg_t calibration_2;  // [291:287]
+    idac_ctrl_reg2hw_current_reg_t current;  // [286:271]
+    idac_ctrl_reg2hw_dds_control_reg_t dds_control;  // [270:267]
+    idac_ctrl_reg2hw_dds_frequency_1_reg_t dds_frequency_1;  // [266:235]
+    idac_ctrl_reg2hw_dds_frequency_2_reg_t dds_frequency_2;  // [234:203]
+    idac_ctrl_reg2hw_dds_phase_1_reg_t dds_phase_1;  // [202:171]
+    idac_ctrl_reg2hw_dds_phase_2_reg_t dds_phase_2;  // [170:139]
+    idac_ctrl_reg2hw_dds_chirp_1_reg_t dds_chirp_1;  // [138:107]
+    idac_ctrl_reg2hw_dds_chirp_2_reg_t dds_chirp_2;  // [106:75]
+    idac_ctrl_reg2hw_dds_amplitude_reg_t dds_amplitude;  // [74:59]
+    idac_ctrl_reg2hw_dds_offset_reg_t dds_offset;  // [58:43]
+    idac_ctrl_reg2hw_feedback_control_reg_t feedback_control;  // [42:40]
+    idac_ctrl_reg2hw_feedback_step_reg_t feedback_step;  // [39:32]
+    idac_ctrl_reg2hw_feedback_limits_reg_t feedback_limits;  // [31:16]
+    idac_ctrl_reg2hw_feedback_slew_reg_t feedback_slew;  // [15:0]
   } idac_ctrl_reg2hw_t;
 
+  // HW -> register type
+  typedef struct packed {
+    idac_ctrl_hw2reg_feedback_code_reg_t feedback_code;  // [35:18]
+    idac_ctrl_hw2reg_dds_current_reg_t   dds_current;    // [17:0]
+  } idac_ctrl_hw2reg_t;
+
   // Register offsets
-  parameter logic [BlockAw-1:0] IDAC_CTRL_REFRESH_CYCLES_OFFSET = 5'h0;
-  parameter logic [BlockAw-1:0] IDAC_CTRL_MANUAL_TRIGGER_OFFSET = 5'h4;
-  parameter logic [BlockAw-1:0] IDAC_CTRL_ENABLE_OFFSET = 5'h8;
-  parameter logic [BlockAw-1:0] IDAC_CTRL_CALIBRATION_1_OFFSET = 5'hc;
-  parameter logic [BlockAw-1:0] IDAC_CTRL_CALIBRATION_2_OFFSET = 5'h10;
-  parameter logic [BlockAw-1:0] IDAC_CTRL_CURRENT_OFFSET = 5'h14;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_REFRESH_CYCLES_OFFSET = 9'h0;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_MANUAL_TRIGGER_OFFSET = 9'h4;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_ENABLE_OFFSET = 9'h8;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_CALIBRATION_1_OFFSET = 9'hc;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_CALIBRATION_2_OFFSET = 9'h10;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_CURRENT_OFFSET = 9'h14;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_CONTROL_OFFSET = 9'h18;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_FREQUENCY_1_OFFSET = 9'h1c;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_FREQUENCY_2_OFFSET = 9'h20;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_PHASE_1_OFFSET = 9'h24;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_PHASE_2_OFFSET = 9'h28;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_CHIRP_1_OFFSET = 9'h2c;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_CHIRP_2_OFFSET = 9'h30;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_AMPLITUDE_OFFSET = 9'h34;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_OFFSET_OFFSET = 9'h38;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_FEEDBACK_CONTROL_OFFSET = 9'h3c;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_FEEDBACK_STEP_OFFSET = 9'h40;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_FEEDBACK_LIMITS_OFFSET = 9'h44;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_FEEDBACK_SLEW_OFFSET = 9'h48;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_FEEDBACK_CODE_OFFSET = 9'h4c;
+  parameter logic [BlockAw-1:0] IDAC_CTRL_DDS_CURRENT_OFFSET = 9'h50;
+
+  // Window parameters
+  parameter logic [BlockAw-1:0] IDAC_CTRL_WAVE_RAM_OFFSET = 9'h100;
+  parameter int unsigned IDAC_CTRL_WAVE_RAM_SIZE = 'h100;
 
   // Register index
   typedef enum int {
@@ -56,17 +160,47 @@ package idac_ctrl_reg_pkg;
     IDAC_CTRL_ENABLE,
     IDAC_CTRL_CALIBRATION_1,
     IDAC_CTRL_CALIBRATION_2,
-    IDAC_CTRL_CURRENT
+    IDAC_CTRL_CURRENT,
+    IDAC_CTRL_DDS_CONTROL,
+    IDAC_CTRL_DDS_FREQUENCY_1,
+    IDAC_CTRL_DDS_FREQUENCY_2,
+    IDAC_CTRL_DDS_PHASE_1,
+    IDAC_CTRL_DDS_PHASE_2,
+    IDAC_CTRL_DDS_CHIRP_1,
+    IDAC_CTRL_DDS_CHIRP_2,
+    IDAC_CTRL_DDS_AMPLITUDE,
+    IDAC_CTRL_DDS_OFFSET,
+    IDAC_CTRL_FEEDBACK_CONTROL,
+    IDAC_CTRL_FEEDBACK_STEP,
+    IDAC_CTRL_FEEDBACK_LIMITS,
+    IDAC_CTRL_FEEDBACK_SLEW,
+    IDAC_CTRL_FEEDBACK_CODE,
+    IDAC_CTRL_DDS_CURRENT
   } idac_ctrl_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] IDAC_CTRL_PERMIT[6] = '{
-      4'b1111,  // index[0] IDAC_CTRL_REFRESH_CYCLES
-      4'b0001,  // index[1] IDAC_CTRL_MANUAL_TRIGGER
-      4'b0001,  // index[2] IDAC_CTRL_ENABLE
-      4'b0001,  // index[3] IDAC_CTRL_CALIBRATION_1
-      4'b0001,  // index[4] IDAC_CTRL_CALIBRATION_2
-      4'b0011  // index[5] IDAC_CTRL_CURRENT
+  parameter logic [3:0] IDAC_CTRL_PERMIT[21] = '{
+      4'b1111,  // index[ 0] IDAC_CTRL_REFRESH_CYCLES
+      4'b0001,  // index[ 1] IDAC_CTRL_MANUAL_TRIGGER
+      4'b0001,  // index[ 2] IDAC_CTRL_ENABLE
+      4'b0001,  // index[ 3] IDAC_CTRL_CALIBRATION_1
+      4'b0001,  // index[ 4] IDAC_CTRL_CALIBRATION_2
+      4'b0011,  // index[ 5] IDAC_CTRL_CURRENT
+      4'b0001,  // index[ 6] IDAC_CTRL_DDS_CONTROL
+      4'b1111,  // index[ 7] IDAC_CTRL_DDS_FREQUENCY_1
+      4'b1111,  // index[ 8] IDAC_CTRL_DDS_FREQUENCY_2
+      4'b1111,  // index[ 9] IDAC_CTRL_DDS_PHASE_1
+      4'b1111,  // index[10] IDAC_CTRL_DDS_PHASE_2
+      4'b1111,  // index[11] IDAC_CTRL_DDS_CHIRP_1
+      4'b1111,  // index[12] IDAC_CTRL_DDS_CHIRP_2
+      4'b0011,  // index[13] IDAC_CTRL_DDS_AMPLITUDE
+      4'b0011,  // index[14] IDAC_CTRL_DDS_OFFSET
+      4'b0001,  // index[15] IDAC_CTRL_FEEDBACK_CONTROL
+      4'b0001,  // index[16] IDAC_CTRL_FEEDBACK_STEP
+      4'b0011,  // index[17] IDAC_CTRL_FEEDBACK_LIMITS
+      4'b0011,  // index[18] IDAC_CTRL_FEEDBACK_SLEW
+      4'b0011,  // index[19] IDAC_CTRL_FEEDBACK_CODE
+      4'b0011  // index[20] IDAC_CTRL_DDS_CURRENT
   };
 
 endpackage
@@ -10,14 +10,20 @@
 module idac_ctrl_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 5
+    parameter int AW = 9
 ) (
     input logic clk_i,
     input logic rst_ni,
     input reg_req_t reg_req_i,
     output reg_rsp_t reg_rsp_o,
+
+    // Output port for window
+    output reg_req_t [1-1:0] reg_req_win_o,
+    input  reg_rsp_t [1-1:0] reg_rsp_win_i,
+
     // To HW
     output idac_ctrl_reg_pkg::idac_ctrl_reg2hw_t reg2hw,  // Write
+    input  idac_ctrl_reg_pkg::idac_ctrl_hw2reg_t hw2reg,  // Read
 
 
     // Config
@@ -47,8 +53,43 @@ module idac_ctrl_reg_top #(
   reg_rsp_t reg_intf_rsp;
 
 
-  assign reg_intf_req = reg_req_i;
-  assign reg_rsp_o = reg_intf_rsp;
+  logic [0:0] reg_steer;
+
+  reg_req_t [2-1:0] reg_intf_demux_req;
+  reg_rsp_t [2-1:0] reg_intf_demux_rsp;
+
+  // demux connection
+  assign reg_intf_req = reg_intf_demux_req[1];
+  assign reg_intf_demux_rsp[1] = reg_intf_rsp;
+
+  assign reg_req_win_o[0] = reg_intf_demux_req[0];
+  assign reg_intf_demux_rsp[0] = reg_rsp_win_i[0];
+
+  // Create Socket_1n
+  reg_demux #(
+      .NoPorts(2),
+      .req_t  (reg_req_t),
+      .rsp_t  (reg_rsp_t)
+  ) i_reg_demux (
+      .clk_i,
+      .rst_ni,
+      .in_req_i(reg_req_i),
+      .in_rsp_o(reg_rsp_o),
+      .out_req_o(reg_intf_demux_req),
+      .out_rsp_i(reg_intf_demux_rsp),
+      .in_select_i(reg_steer)
+  );
+
+
+  // Create steering logic
+  always_comb begin
+    reg_steer = 1;  // Default set to register
+
+    // TODO: Can below codes be unique case () inside ?
+    if (reg_req_i.addr[AW-1:0] >= 256) begin
+      reg_steer = 0;
+    end
+  end
 
 
   assign reg_we = reg_intf_req.valid & reg_intf_req.write;
@@ -91,6 +132,73 @@ module idac_ctrl_reg_top #(
   logic [7:0] current_current_2_qs;
   logic [7:0] current_current_2_wd;
   logic current_current_2_we;
+  logic dds_control_enable_1_qs;
+  logic dds_control_enable_1_wd;
+  logic dds_control_enable_1_we;
+  logic dds_control_enable_2_qs;
+  logic dds_control_enable_2_wd;
+  logic dds_control_enable_2_we;
+  logic dds_control_square_1_qs;
+  logic dds_control_square_1_wd;
+  logic dds_control_square_1_we;
+  logic dds_control_square_2_qs;
+  logic dds_control_square_2_wd;
+  logic dds_control_square_2_we;
+  logic [31:0] dds_frequency_1_qs;
+  logic [31:0] dds_frequency_1_wd;
+  logic dds_frequency_1_we;
+  logic [31:0] dds_frequency_2_qs;
+  logic [31:0] dds_frequency_2_wd;
+  logic dds_frequency_2_we;
+  logic [31:0] dds_phase_1_qs;
+  logic [31:0] dds_phase_1_wd;
+  logic dds_phase_1_we;
+  logic [31:0] dds_phase_2_qs;
+  logic [31:0] dds_phase_2_wd;
+  logic dds_phase_2_we;
+  logic [31:0] dds_chirp_1_qs;
+  logic [31:0] dds_chirp_1_wd;
+  logic dds_chirp_1_we;
+  logic [31:0] dds_chirp_2_qs;
+  logic [31:0] dds_chirp_2_wd;
+  logic dds_chirp_2_we;
+  logic [7:0] dds_amplitude_amplitude_1_qs;
+  logic [7:0] dds_amplitude_amplitude_1_wd;
+  logic dds_amplitude_amplitude_1_we;
+  logic [7:0] dds_amplitude_amplitude_2_qs;
+  logic [7:0] dds_amplitude_amplitude_2_wd;
+  logic dds_amplitude_amplitude_2_we;
+  logic [7:0] dds_offset_offset_1_qs;
+  logic [7:0] dds_offset_offset_1_wd;
+  logic dds_offset_offset_1_we;
+  logic [7:0] dds_offset_offset_2_qs;
+  logic [7:0] dds_offset_offset_2_wd;
+  logic dds_offset_offset_2_we;
+  logic feedback_control_enable_1_qs;
+  logic feedback_control_enable_1_wd;
+  logic feedback_control_enable_1_we;
+  logic feedback_control_enable_2_qs;
+  logic feedback_control_enable_2_wd;
+  logic feedback_control_enable_2_we;
+  logic feedback_control_invert_qs;
+  logic feedback_control_invert_wd;
+  logic feedback_control_invert_we;
+  logic [7:0] feedback_step_qs;
+  logic [7:0] feedback_step_wd;
+  logic feedback_step_we;
+  logic [7:0] feedback_limits_min_qs;
+  logic [7:0] feedback_limits_min_wd;
+  logic feedback_limits_min_we;
+  logic [7:0] feedback_limits_max_qs;
+  logic [7:0] feedback_limits_max_wd;
+  logic feedback_limits_max_we;
+  logic [15:0] feedback_slew_qs;
+  logic [15:0] feedback_slew_wd;
+  logic feedback_slew_we;
+  logic [7:0] feedback_code_code_1_qs;
+  logic [7:0] feedback_code_code_2_qs;
+  logic [7:0] dds_current_current_1_qs;
+  logic [7:0] dds_current_current_2_qs;
 
   // Register instances
   // R[refresh_cycles]: V(False)
@@ -309,135 +417,975 @@ module idac_ctrl_reg_top #(
   );
 
 
+  // R[dds_control]: V(False)
 
+  //   F[enable_1]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_dds_control_enable_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-  logic [5:0] addr_hit;
-  always_comb begin
-    addr_hit = '0;
-    addr_hit[0] = (reg_addr == IDAC_CTRL_REFRESH_CYCLES_OFFSET);
-    addr_hit[1] = (reg_addr == IDAC_CTRL_MANUAL_TRIGGER_OFFSET);
-    addr_hit[2] = (reg_addr == IDAC_CTRL_ENABLE_OFFSET);
-    addr_hit[3] = (reg_addr == IDAC_CTRL_CALIBRATION_1_OFFSET);
-    addr_hit[4] = (reg_addr == IDAC_CTRL_CALIBRATION_2_OFFSET);
-    addr_hit[5] = (reg_addr == IDAC_CTRL_CURRENT_OFFSET);
-  end
+      // from register interface
+      .we(dds_control_enable_1_we),
+      .wd(dds_control_enable_1_wd),
 
-  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
 
-  // Check sub-word write is permitted
-  always_comb begin
-    wr_err = (reg_we &
-              ((addr_hit[0] & (|(IDAC_CTRL_PERMIT[0] & ~reg_be))) |
-               (addr_hit[1] & (|(IDAC_CTRL_PERMIT[1] & ~reg_be))) |
-               (addr_hit[2] & (|(IDAC_CTRL_PERMIT[2] & ~reg_be))) |
-               (addr_hit[3] & (|(IDAC_CTRL_PERMIT[3] & ~reg_be))) |
-               (addr_hit[4] & (|(IDAC_CTRL_PERMIT[4] & ~reg_be))) |
-               (addr_hit[5] & (|(IDAC_CTRL_PERMIT[5] & ~reg_be)))));
-  end
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_control.enable_1.q),
 
-  assign refresh_cycles_we = addr_hit[0] & reg_we & !reg_error;
-  assign refresh_cycles_wd = reg_wdata[31:0];
+      // to register interface (read)
+      .qs(dds_control_enable_1_qs)
+  );
 
-  assign manual_trigger_we = addr_hit[1] & reg_we & !reg_error;
-  assign manual_trigger_wd = reg_wdata[0];
 
-  assign enable_idac1_enable_we = addr_hit[2] & reg_we & !reg_error;
-  assign enable_idac1_enable_wd = reg_wdata[0];
+  //   F[enable_2]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_dds_control_enable_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-  assign enable_idac2_enable_we = addr_hit[2] & reg_we & !reg_error;
-  assign enable_idac2_enable_wd = reg_wdata[1];
+      // from register interface
+      .we(dds_control_enable_2_we),
+      .wd(dds_control_enable_2_wd),
 
-  assign calibration_1_we = addr_hit[3] & reg_we & !reg_error;
-  assign calibration_1_wd = reg_wdata[4:0];
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
 
-  assign calibration_2_we = addr_hit[4] & reg_we & !reg_error;
-  assign calibration_2_wd = reg_wdata[4:0];
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_control.enable_2.q),
 
-  assign current_current_1_we = addr_hit[5] & reg_we & !reg_error;
-  assign current_current_1_wd = reg_wdata[7:0];
+      // to register interface (read)
+      .qs(dds_control_enable_2_qs)
+  );
 
-  assign current_current_2_we = addr_hit[5] & reg_we & !reg_error;
-  assign current_current_2_wd = reg_wdata[15:8];
 
-  // Read data return
-  always_comb begin
-    reg_rdata_next = '0;
-    unique case (1'b1)
-      addr_hit[0]: begin
-        reg_rdata_next[31:0] = refresh_cycles_qs;
-      end
+  //   F[square_1]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_dds_control_square_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-      addr_hit[1]: begin
-        reg_rdata_next[0] = manual_trigger_qs;
-      end
+      // from register interface
+      .we(dds_control_square_1_we),
+      .wd(dds_control_square_1_wd),
 
-      addr_hit[2]: begin
-        reg_rdata_next[0] = enable_idac1_enable_qs;
-        reg_rdata_next[1] = enable_idac2_enable_qs;
-      end
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
 
-      addr_hit[3]: begin
-        reg_rdata_next[4:0] = calibration_1_qs;
-      end
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_control.square_1.q),
 
-      addr_hit[4]: begin
-        reg_rdata_next[4:0] = calibration_2_qs;
-      end
+      // to register interface (read)
+      .qs(dds_control_square_1_qs)
+  );
 
-      addr_hit[5]: begin
-        reg_rdata_next[7:0]  = current_current_1_qs;
-        reg_rdata_next[15:8] = current_current_2_qs;
-      end
 
-      default: begin
-        reg_rdata_next = '1;
-      end
-    endcase
-  end
+  //   F[square_2]: 3:3
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_dds_control_square_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-  // Unused signal tieoff
+      // from register interface
+      .we(dds_control_square_2_we),
+      .wd(dds_control_square_2_wd),
 
-  // wdata / byte enable are not always fully used
-  // add a blanket unused statement to handle lint waivers
-  logic unused_wdata;
-  logic unused_be;
-  assign unused_wdata = ^reg_wdata;
-  assign unused_be = ^reg_be;
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
 
-  // Assertions for Register Interface
-  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_control.square_2.q),
 
-endmodule
+      // to register interface (read)
+      .qs(dds_control_square_2_qs)
+  );
 
-module idac_ctrl_reg_top_intf #(
-    parameter  int AW = 5,
-    localparam int DW = 32
-) (
-    input logic clk_i,
-    input logic rst_ni,
-    REG_BUS.in regbus_slave,
-    // To HW
-    output idac_ctrl_reg_pkg::idac_ctrl_reg2hw_t reg2hw,  // Write
-    // Config
-    input devmode_i  // If 1, explicit error return for unmapped register access
-);
-  localparam int unsigned STRB_WIDTH = DW / 8;
 
-  `include "register_interface/typedef.svh"
-  `include "register_interface/assign.svh"
+  // R[dds_frequency_1]: V(False)
 
-  // Define structs for reg_bus
-  typedef logic [AW-1:0] addr_t;
-  typedef logic [DW-1:0] data_t;
-  typedef logic [STRB_WIDTH-1:0] strb_t;
-  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_frequency_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-  reg_bus_req_t s_reg_req;
-  reg_bus_rsp_t s_reg_rsp;
+      // from register interface
+      .we(dds_frequency_1_we),
+      .wd(dds_frequency_1_wd),
 
-  // Assign SV interface to structs
-  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
-  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_frequency_1.q),
+
+      // to register interface (read)
+      .qs(dds_frequency_1_qs)
+  );
+
+
+  // R[dds_frequency_2]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_frequency_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_frequency_2_we),
+      .wd(dds_frequency_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_frequency_2.q),
+
+      // to register interface (read)
+      .qs(dds_frequency_2_qs)
+  );
+
+
+  // R[dds_phase_1]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_phase_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_phase_1_we),
+      .wd(dds_phase_1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_phase_1.q),
+
+      // to register interface (read)
+      .qs(dds_phase_1_qs)
+  );
+
+
+  // R[dds_phase_2]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_phase_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_phase_2_we),
+      .wd(dds_phase_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_phase_2.q),
+
+      // to register interface (read)
+      .qs(dds_phase_2_qs)
+  );
+
+
+  // R[dds_chirp_1]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_chirp_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_chirp_1_we),
+      .wd(dds_chirp_1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_chirp_1.q),
+
+      // to register interface (read)
+      .qs(dds_chirp_1_qs)
+  );
+
+
+  // R[dds_chirp_2]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dds_chirp_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_chirp_2_we),
+      .wd(dds_chirp_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_chirp_2.q),
+
+      // to register interface (read)
+      .qs(dds_chirp_2_qs)
+  );
+
+
+  // R[dds_amplitude]: V(False)
+
+  //   F[amplitude_1]: 7:0
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_dds_amplitude_amplitude_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_amplitude_amplitude_1_we),
+      .wd(dds_amplitude_amplitude_1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_amplitude.amplitude_1.q),
+
+      // to register interface (read)
+      .qs(dds_amplitude_amplitude_1_qs)
+  );
+
+
+  //   F[amplitude_2]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_dds_amplitude_amplitude_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_amplitude_amplitude_2_we),
+      .wd(dds_amplitude_amplitude_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_amplitude.amplitude_2.q),
+
+      // to register interface (read)
+      .qs(dds_amplitude_amplitude_2_qs)
+  );
+
+
+  // R[dds_offset]: V(False)
+
+  //   F[offset_1]: 7:0
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_dds_offset_offset_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_offset_offset_1_we),
+      .wd(dds_offset_offset_1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_offset.offset_1.q),
+
+      // to register interface (read)
+      .qs(dds_offset_offset_1_qs)
+  );
+
+
+  //   F[offset_2]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_dds_offset_offset_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dds_offset_offset_2_we),
+      .wd(dds_offset_offset_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dds_offset.offset_2.q),
+
+      // to register interface (read)
+      .qs(dds_offset_offset_2_qs)
+  );
+
+
+  // R[feedback_control]: V(False)
+
+  //   F[enable_1]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_feedback_control_enable_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_control_enable_1_we),
+      .wd(feedback_control_enable_1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_control.enable_1.q),
+
+      // to register interface (read)
+      .qs(feedback_control_enable_1_qs)
+  );
+
+
+  //   F[enable_2]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_feedback_control_enable_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_control_enable_2_we),
+      .wd(feedback_control_enable_2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_control.enable_2.q),
+
+      // to register interface (read)
+      .qs(feedback_control_enable_2_qs)
+  );
+
+
+  //   F[invert]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_feedback_control_invert (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_control_invert_we),
+      .wd(feedback_control_invert_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_control.invert.q),
+
+      // to register interface (read)
+      .qs(feedback_control_invert_qs)
+  );
+
+
+  // R[feedback_step]: V(False)
+
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h1)
+  ) u_feedback_step (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_step_we),
+      .wd(feedback_step_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_step.q),
+
+      // to register interface (read)
+      .qs(feedback_step_qs)
+  );
+
+
+  // R[feedback_limits]: V(False)
+
+  //   F[min]: 7:0
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_feedback_limits_min (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_limits_min_we),
+      .wd(feedback_limits_min_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_limits.min.q),
+
+      // to register interface (read)
+      .qs(feedback_limits_min_qs)
+  );
+
+
+  //   F[max]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'hff)
+  ) u_feedback_limits_max (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_limits_max_we),
+      .wd(feedback_limits_max_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_limits.max.q),
+
+      // to register interface (read)
+      .qs(feedback_limits_max_qs)
+  );
+
+
+  // R[feedback_slew]: V(False)
+
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_feedback_slew (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(feedback_slew_we),
+      .wd(feedback_slew_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.feedback_slew.q),
+
+      // to register interface (read)
+      .qs(feedback_slew_qs)
+  );
+
+
+  // R[feedback_code]: V(False)
+
+  //   F[code_1]: 7:0
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_feedback_code_code_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.feedback_code.code_1.de),
+      .d (hw2reg.feedback_code.code_1.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(feedback_code_code_1_qs)
+  );
+
+
+  //   F[code_2]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_feedback_code_code_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.feedback_code.code_2.de),
+      .d (hw2reg.feedback_code.code_2.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(feedback_code_code_2_qs)
+  );
+
+
+  // R[dds_current]: V(False)
+
+  //   F[current_1]: 7:0
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_dds_current_current_1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.dds_current.current_1.de),
+      .d (hw2reg.dds_current.current_1.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(dds_current_current_1_qs)
+  );
+
+
+  //   F[current_2]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RO"),
+      .RESVAL  (8'h0)
+  ) u_dds_current_current_2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.dds_current.current_2.de),
+      .d (hw2reg.dds_current.current_2.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(dds_current_current_2_qs)
+  );
+
+
+
+
+  logic [20:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == IDAC_CTRL_REFRESH_CYCLES_OFFSET);
+    addr_hit[1] = (reg_addr == IDAC_CTRL_MANUAL_TRIGGER_OFFSET);
+    addr_hit[2] = (reg_addr == IDAC_CTRL_ENABLE_OFFSET);
+    addr_hit[3] = (reg_addr == IDAC_CTRL_CALIBRATION_1_OFFSET);
+    addr_hit[4] = (reg_addr == IDAC_CTRL_CALIBRATION_2_OFFSET);
+    addr_hit[5] = (reg_addr == IDAC_CTRL_CURRENT_OFFSET);
+    addr_hit[6] = (reg_addr == IDAC_CTRL_DDS_CONTROL_OFFSET);
+    addr_hit[7] = (reg_addr == IDAC_CTRL_DDS_FREQUENCY_1_OFFSET);
+    addr_hit[8] = (reg_addr == IDAC_CTRL_DDS_FREQUENCY_2_OFFSET);
+    addr_hit[9] = (reg_addr == IDAC_CTRL_DDS_PHASE_1_OFFSET);
+    addr_hit[10] = (reg_addr == IDAC_CTRL_DDS_PHASE_2_OFFSET);
+    addr_hit[11] = (reg_addr == IDAC_CTRL_DDS_CHIRP_1_OFFSET);
+    addr_hit[12] = (reg_addr == IDAC_CTRL_DDS_CHIRP_2_OFFSET);
+    addr_hit[13] = (reg_addr == IDAC_CTRL_DDS_AMPLITUDE_OFFSET);
+    addr_hit[14] = (reg_addr == IDAC_CTRL_DDS_OFFSET_OFFSET);
+    addr_hit[15] = (reg_addr == IDAC_CTRL_FEEDBACK_CONTROL_OFFSET);
+    addr_hit[16] = (reg_addr == IDAC_CTRL_FEEDBACK_STEP_OFFSET);
+    addr_hit[17] = (reg_addr == IDAC_CTRL_FEEDBACK_LIMITS_OFFSET);
+    addr_hit[18] = (reg_addr == IDAC_CTRL_FEEDBACK_SLEW_OFFSET);
+    addr_hit[19] = (reg_addr == IDAC_CTRL_FEEDBACK_CODE_OFFSET);
+    addr_hit[20] = (reg_addr == IDAC_CTRL_DDS_CURRENT_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[ 0] & (|(IDAC_CTRL_PERMIT[ 0] & ~reg_be))) |
+               (addr_hit[ 1] & (|(IDAC_CTRL_PERMIT[ 1] & ~reg_be))) |
+               (addr_hit[ 2] & (|(IDAC_CTRL_PERMIT[ 2] & ~reg_be))) |
+               (addr_hit[ 3] & (|(IDAC_CTRL_PERMIT[ 3] & ~reg_be))) |
+               (addr_hit[ 4] & (|(IDAC_CTRL_PERMIT[ 4] & ~reg_be))) |
+               (addr_hit[ 5] & (|(IDAC_CTRL_PERMIT[ 5] & ~reg_be))) |
+               (addr_hit[ 6] & (|(IDAC_CTRL_PERMIT[ 6] & ~reg_be))) |
+               (addr_hit[ 7] & (|(IDAC_CTRL_PERMIT[ 7] & ~reg_be))) |
+               (addr_hit[ 8] & (|(IDAC_CTRL_PERMIT[ 8] & ~reg_be))) |
+               (addr_hit[ 9] & (|(IDAC_CTRL_PERMIT[ 9] & ~reg_be))) |
+               (addr_hit[10] & (|(IDAC_CTRL_PERMIT[10] & ~reg_be))) |
+               (addr_hit[11] & (|(IDAC_CTRL_PERMIT[11] & ~reg_be))) |
+               (addr_hit[12] & (|(IDAC_CTRL_PERMIT[12] & ~reg_be))) |
+               (addr_hit[13] & (|(IDAC_CTRL_PERMIT[13] & ~reg_be))) |
+               (addr_hit[14] & (|(IDAC_CTRL_PERMIT[14] & ~reg_be))) |
+               (addr_hit[15] & (|(IDAC_CTRL_PERMIT[15] & ~reg_be))) |
+               (addr_hit[16] & (|(IDAC_CTRL_PERMIT[16] & ~reg_be))) |
+               (addr_hit[17] & (|(IDAC_CTRL_PERMIT[17] & ~reg_be))) |
+               (addr_hit[18] & (|(IDAC_CTRL_PERMIT[18] & ~reg_be))) |
+               (addr_hit[19] & (|(IDAC_CTRL_PERMIT[19] & ~reg_be))) |
+               (addr_hit[20] & (|(IDAC_CTRL_PERMIT[20] & ~reg_be)))));
+  end
+
+  assign refresh_cycles_we = addr_hit[0] & reg_we & !reg_error;
+  assign refresh_cycles_wd = reg_wdata[31:0];
+
+  assign manual_trigger_we = addr_hit[1] & reg_we & !reg_error;
+  assign manual_trigger_wd = reg_wdata[0];
+
+  assign enable_idac1_enable_we = addr_hit[2] & reg_we & !reg_error;
+  assign enable_idac1_enable_wd = reg_wdata[0];
+
+  assign enable_idac2_enable_we = addr_hit[2] & reg_we & !reg_error;
+  assign enable_idac2_enable_wd = reg_wdata[1];
+
+  assign calibration_1_we = addr_hit[3] & reg_we & !reg_error;
+  assign calibration_1_wd = reg_wdata[4:0];
+
+  assign calibration_2_we = addr_hit[4] & reg_we & !reg_error;
+  assign calibration_2_wd = reg_wdata[4:0];
+
+  assign current_current_1_we = addr_hit[5] & reg_we & !reg_error;
+  assign current_current_1_wd = reg_wdata[7:0];
+
+  assign current_current_2_we = addr_hit[5] & reg_we & !reg_error;
+  assign current_current_2_wd = reg_wdata[15:8];
+
+  assign dds_control_enable_1_we = addr_hit[6] & reg_we & !reg_error;
+  assign dds_control_enable_1_wd = reg_wdata[0];
+
+  assign dds_control_enable_2_we = addr_hit[6] & reg_we & !reg_error;
+  assign dds_control_enable_2_wd = reg_wdata[1];
+
+  assign dds_control_square_1_we = addr_hit[6] & reg_we & !reg_error;
+  assign dds_control_square_1_wd = reg_wdata[2];
+
+  assign dds_control_square_2_we = addr_hit[6] & reg_we & !reg_error;
+  assign dds_control_square_2_wd = reg_wdata[3];
+
+  assign dds_frequency_1_we = addr_hit[7] & reg_we & !reg_error;
+  assign dds_frequency_1_wd = reg_wdata[31:0];
+
+  assign dds_frequency_2_we = addr_hit[8] & reg_we & !reg_error;
+  assign dds_frequency_2_wd = reg_wdata[31:0];
+
+  assign dds_phase_1_we = addr_hit[9] & reg_we & !reg_error;
+  assign dds_phase_1_wd = reg_wdata[31:0];
+
+  assign dds_phase_2_we = addr_hit[10] & reg_we & !reg_error;
+  assign dds_phase_2_wd = reg_wdata[31:0];
+
+  assign dds_chirp_1_we = addr_hit[11] & reg_we & !reg_error;
+  assign dds_chirp_1_wd = reg_wdata[31:0];
+
+  assign dds_chirp_2_we = addr_hit[12] & reg_we & !reg_error;
+  assign dds_chirp_2_wd = reg_wdata[31:0];
+
+  assign dds_amplitude_amplitude_1_we = addr_hit[13] & reg_we & !reg_error;
+  assign dds_amplitude_amplitude_1_wd = reg_wdata[7:0];
+
+  assign dds_amplitude_amplitude_2_we = addr_hit[13] & reg_we & !reg_error;
+  assign dds_amplitude_amplitude_2_wd = reg_wdata[15:8];
+
+  assign dds_offset_offset_1_we = addr_hit[14] & reg_we & !reg_error;
+  assign dds_offset_offset_1_wd = reg_wdata[7:0];
+
+  assign dds_offset_offset_2_we = addr_hit[14] & reg_we & !reg_error;
+  assign dds_offset_offset_2_wd = reg_wdata[15:8];
+
+  assign feedback_control_enable_1_we = addr_hit[15] & reg_we & !reg_error;
+  assign feedback_control_enable_1_wd = reg_wdata[0];
+
+  assign feedback_control_enable_2_we = addr_hit[15] & reg_we & !reg_error;
+  assign feedback_control_enable_2_wd = reg_wdata[1];
+
+  assign feedback_control_invert_we = addr_hit[15] & reg_we & !reg_error;
+  assign feedback_control_invert_wd = reg_wdata[2];
+
+  assign feedback_step_we = addr_hit[16] & reg_we & !reg_error;
+  assign feedback_step_wd = reg_wdata[7:0];
+
+  assign feedback_limits_min_we = addr_hit[17] & reg_we & !reg_error;
+  assign feedback_limits_min_wd = reg_wdata[7:0];
+
+  assign feedback_limits_max_we = addr_hit[17] & reg_we & !reg_error;
+  assign feedback_limits_max_wd = reg_wdata[15:8];
+
+  assign feedback_slew_we = addr_hit[18] & reg_we & !reg_error;
+  assign feedback_slew_wd = reg_wdata[15:0];
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[31:0] = refresh_cycles_qs;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[0] = manual_trigger_qs;
+      end
+
+      addr_hit[2]: begin
+        reg_rdata_next[0] = enable_idac1_enable_qs;
+        reg_rdata_next[1] = enable_idac2_enable_qs;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[4:0] = calibration_1_qs;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[4:0] = calibration_2_qs;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[7:0]  = current_current_1_qs;
+        reg_rdata_next[15:8] = current_current_2_qs;
+      end
+
+      addr_hit[6]: begin
+        reg_rdata_next[0] = dds_control_enable_1_qs;
+        reg_rdata_next[1] = dds_control_enable_2_qs;
+        reg_rdata_next[2] = dds_control_square_1_qs;
+        reg_rdata_next[3] = dds_control_square_2_qs;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[31:0] = dds_frequency_1_qs;
+      end
+
+      addr_hit[8]: begin
+        reg_rdata_next[31:0] = dds_frequency_2_qs;
+      end
+
+      addr_hit[9]: begin
+        reg_rdata_next[31:0] = dds_phase_1_qs;
+      end
+
+      addr_hit[10]: begin
+        reg_rdata_next[31:0] = dds_phase_2_qs;
+      end
+
+      addr_hit[11]: begin
+        reg_rdata_next[31:0] = dds_chirp_1_qs;
+      end
+
+      addr_hit[12]: begin
+        reg_rdata_next[31:0] = dds_chirp_2_qs;
+      end
+
+      addr_hit[13]: begin
+        reg_rdata_next[7:0]  = dds_amplitude_amplitude_1_qs;
+        reg_rdata_next[15:8] = dds_amplitude_amplitude_2_qs;
+      end
+
+      addr_hit[14]: begin
+        reg_rdata_next[7:0]  = dds_offset_offset_1_qs;
+        reg_rdata_next[15:8] = dds_offset_offset_2_qs;
+      end
+
+      addr_hit[15]: begin
+        reg_rdata_next[0] = feedback_control_enable_1_qs;
+        reg_rdata_next[1] = feedback_control_enable_2_qs;
+        reg_rdata_next[2] = feedback_control_invert_qs;
+      end
+
+      addr_hit[16]: begin
+        reg_rdata_next[7:0] = feedback_step_qs;
+      end
+
+      addr_hit[17]: begin
+        reg_rdata_next[7:0]  = feedback_limits_min_qs;
+        reg_rdata_next[15:8] = feedback_limits_max_qs;
+      end
+
+      addr_hit[18]: begin
+        reg_rdata_next[15:0] = feedback_slew_qs;
+      end
+
+      addr_hit[19]: begin
+        reg_rdata_next[7:0]  = feedback_code_code_1_qs;
+        reg_rdata_next[15:8] = feedback_code_code_2_qs;
+      end
+
+      addr_hit[20]: begin
+        reg_rdata_next[7:0]  = dds_current_current_1_qs;
+        reg_rdata_next[15:8] = dds_current_current_2_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module idac_ctrl_reg_top_intf #(
+    parameter  int AW = 9,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    REG_BUS.out regbus_win_mst[1-1:0],
+    // To HW
+    output idac_ctrl_reg_pkg::idac_ctrl_reg2hw_t reg2hw,  // Write
+    input idac_ctrl_reg_pkg::idac_ctrl_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+  reg_bus_req_t s_reg_win_req[1-1:0];
+  reg_bus_rsp_t s_reg_win_rsp[1-1:0];
+  for (genvar i = 0; i < 1; i++) begin : gen_assign_window_structs
+    `REG_BUS_ASSIGN_TO_REQ(s_reg_win_req[i], regbus_win_mst[i])
+    `REG_BUS_ASSIGN_FROM_RSP(regbus_win_mst[i], s_reg_win_rsp[i])
+  end
 
 
 
@@ -450,7 +1398,10 @@ module idac_ctrl_reg_top_intf #(
       .rst_ni,
       .reg_req_i(s_reg_req),
       .reg_rsp_o(s_reg_rsp),
+      .reg_req_win_o(s_reg_win_req),
+      .reg_rsp_win_i(s_reg_win_rsp),
       .reg2hw,  // Write
+      .hw2reg,  // Read
       .devmode_i
   );
 
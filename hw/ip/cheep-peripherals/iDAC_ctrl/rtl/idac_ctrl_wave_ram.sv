@@ -0,0 +1,48 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: idac_ctrl_wave_ram.sv
+// Description: Waveform RAM of the iDAC controller, written and read through
+//              the WAVE_RAM window (one 8-bit sample per word), with a read
+//              port for each channel of the waveform generator.
+
+module idac_ctrl_wave_ram #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int unsigned DEPTH = 64,
+    parameter int unsigned WIDTH = 8,
+    localparam int unsigned AddrWidth = $clog2(DEPTH)
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  reg_req_t                 win_i,
+    output reg_rsp_t                 win_o,
+    input  logic     [AddrWidth-1:0] raddr_1_i,
+    output logic     [    WIDTH-1:0] rdata_1_o,
+    input  logic     [AddrWidth-1:0] raddr_2_i,
+    output logic     [    WIDTH-1:0] rdata_2_o
+);
+  logic [WIDTH-1:0] mem_q[DEPTH];
+  logic [AddrWidth-1:0] win_addr;
+
+  // The window is word-addressed
+  assign win_addr = win_i.addr[AddrWidth+1:2];
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      mem_q <= '{default: '0};
+    end else if (win_i.valid && win_i.write && win_i.wstrb[0]) begin
+      mem_q[win_addr] <= win_i.wdata[WIDTH-1:0];
+    end
+  end
+
+  assign rdata_1_o = mem_q[raddr_1_i];
+  assign rdata_2_o = mem_q[raddr_2_i];
+
+  assign win_o.rdata = 32'(mem_q[win_addr]);
+  assign win_o.error = 1'b0;
+  assign win_o.ready = 1'b1;
+
+endmodule : idac_ctrl_wave_ram
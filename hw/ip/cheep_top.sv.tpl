@@ -107,6 +107,7 @@ ${pad.x_heep_system_interface}
   logic [idac_pkg::IdacCalibrationWidth-1:0] idac2_calibration;
   logic idac_refresh;
   logic idac_refresh_notif;
+  logic idac_feedback_notif;
   reg_req_t idac_ctrl_req;
   reg_rsp_t idac_ctrl_rsp;
 
@@ -146,6 +147,10 @@ ${pad.x_heep_system_interface}
   reg_req_t ses_filter_req;
   reg_rsp_t ses_filter_rsp;
 
+  // Peripheral interrupt controller signals
+  reg_req_t irq_ctrl_req;
+  reg_rsp_t irq_ctrl_rsp;
+
   // DMA control signals
   logic [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_slot_tx;
   logic [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_slot_rx;
@@ -382,6 +387,7 @@ ${pad.core_v_mini_mcu_bonding}
     .idac2_calibration_o    (idac2_calibration),
     .idac_refresh_o         (idac_refresh),
     .idac_refresh_notif_o   (idac_refresh_notif),
+    .idac_feedback_notif_o  (idac_feedback_notif),
     .vco_decoder_req_i      (vco_decoder_req),
     .vco_decoder_rsp_o      (vco_decoder_rsp),
     .vcop_enable_o         (vcop_enable),
@@ -418,6 +424,9 @@ ${pad.core_v_mini_mcu_bonding}
 
     .dsm_in_i             (dsm_in_in_x),
     .dsm_clk_o            (dsm_clk_out_x),
+
+    .irq_ctrl_req_i       (irq_ctrl_req),
+    .irq_ctrl_rsp_o       (irq_ctrl_rsp),
     .ext_int_vector_o     (ext_int_vector)
   );
 
@@ -426,7 +435,7 @@ ${pad.core_v_mini_mcu_bonding}
   assign ext_dma_slot_tx[0] = '0;
 
   // DMA DAC ext slots
-  assign ext_dma_slot_rx[1] = '0;
+  assign ext_dma_slot_rx[1] = idac_feedback_notif;
   assign ext_dma_slot_tx[1] = idac_refresh_notif;
 
   // External peripherals bus
@@ -473,7 +482,9 @@ ${pad.core_v_mini_mcu_bonding}
     .cic_req_o                    (cic_req),
     .cic_resp_i                   (cic_rsp),
     .ses_filter_req_o             (ses_filter_req),
-    .ses_filter_resp_i            (ses_filter_rsp)
+    .ses_filter_resp_i            (ses_filter_rsp),
+    .irq_ctrl_req_o               (irq_ctrl_req),
+    .irq_ctrl_resp_i              (irq_ctrl_rsp)
   );
 
 
@@ -92,6 +92,11 @@ package cheep_pkg;
   localparam logic [31:0] CheepCICStartAddr = EXT_PERIPHERAL_START_ADDRESS + 32'h${CIC_start_address};
   localparam logic [31:0] CheepCICEndAddr = CheepCICStartAddr + 32'h${CIC_size};
 
+  // Peripheral interrupt controller
+  localparam int unsigned CheepIRQCtrlIdx = 32'd7;
+  localparam logic [31:0] CheepIRQCtrlStartAddr = EXT_PERIPHERAL_START_ADDRESS + 32'h${IRQ_ctrl_start_address};
+  localparam logic [31:0] CheepIRQCtrlEndAddr = CheepIRQCtrlStartAddr + 32'h${IRQ_ctrl_size};
+
   // External peripherals address map
   localparam addr_map_rule_t [ExtPeriphNSlave-1:0] ExtPeriphAddrRules = '{
     '{idx: CheepiDACCtrlIdx, start_addr: CheepiDACCtrlStartAddr, end_addr: CheepiDACCtrlEndAddr},
@@ -100,6 +105,15 @@ package cheep_pkg;
     '{idx: CheepREFsCtrlIdx, start_addr: CheepREFsCtrlStartAddr, end_addr: CheepREFsCtrlEndAddr},
     '{idx: CheepaMUXCtrlIdx, start_addr: CheepaMUXCtrlStartAddr, end_addr: CheepaMUXCtrlEndAddr},
     '{idx: CheepdLCIdx, start_addr: CheepdLCStartAddr, end_addr: CheepdLCEndAddr},
-    '{idx: CheepCICIdx, start_addr: CheepCICStartAddr, end_addr: CheepCICEndAddr}
+    '{idx: CheepCICIdx, start_addr: CheepCICStartAddr, end_addr: CheepCICEndAddr},
+    '{idx: CheepIRQCtrlIdx, start_addr: CheepIRQCtrlStartAddr, end_addr: CheepIRQCtrlEndAddr}
   };
+
+  // ----------
+  // INTERRUPTS
+  // ----------
+
+  // Peripheral interrupt sources, mapped to the external interrupt vector
+  // (PLIC sources EXT_INTR_0 and following)
+  localparam int unsigned IrqCtrlNumSources = 32'd5;
 endpackage
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 EPFL contributors
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: benchmark-charts.py
+# Description: Plot the benchmark reports of make benchmark-throughput (and
+#              make benchmark-power) into PNG charts.
+
+import argparse
+import csv
+import pathlib
+import sys
+
+try:
+    import matplotlib
+
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+except ImportError:
+    print("benchmark-charts.py needs matplotlib (pip install matplotlib)")
+    sys.exit(1)
+
+# Throughput metrics: column, axis label, log scale
+THROUGHPUT_METRICS = [
+    ("samples_per_s", "Samples/s", True),
+    ("bus_cycles_per_sample", "Bus cycles per sample", False),
+    ("cpu_busy", "CPU-busy fraction", False),
+]
+
+
+def read_csv(path: pathlib.Path):
+    with open(path, "r", encoding="utf-8") as f:
+        return list(csv.DictReader(f))
+
+
+def plot_throughput(rows, out_dir: pathlib.Path):
+    """
+    One bar per kernel configuration, one subplot per metric.
+    """
+    labels = [f"{r['kernel']}\n{r['config']}" for r in rows]
+    fig, axes = plt.subplots(len(THROUGHPUT_METRICS), 1, figsize=(max(6, 0.6 * len(rows)), 9), sharex=True)
+    for ax, (col, label, log) in zip(axes, THROUGHPUT_METRICS):
+        ax.bar(range(len(rows)), [float(r[col]) for r in rows], color="tab:blue")
+        ax.set_ylabel(label)
+        if log:
+            ax.set_yscale("log")
+        ax.grid(axis="y", alpha=0.3)
+    axes[-1].set_xticks(range(len(rows)))
+    axes[-1].set_xticklabels(labels, fontsize=8)
+    axes[0].set_title("Throughput per kernel and configuration")
+    fig.tight_layout()
+    out = out_dir / "throughput.png"
+    fig.savefig(out, dpi=150)
+    print(f"Chart written to {out}")
+
+
+def plot_generic(name, rows, out_dir: pathlib.Path):
+    """
+    One bar per row (labelled by the first column), one subplot per numeric column.
+    """
+    key = list(rows[0].keys())[0]
+    cols = []
+    for col in list(rows[0].keys())[1:]:
+        try:
+            [float(r[col]) for r in rows]
+            cols.append(col)
+        except ValueError:
+            pass
+    if not cols:
+        return
+    fig, axes = plt.subplots(len(cols), 1, figsize=(max(6, 0.6 * len(rows)), 3 * len(cols)), sharex=True, squeeze=False)
+    for ax, col in zip(axes[:, 0], cols):
+        ax.bar(range(len(rows)), [float(r[col]) for r in rows], color="tab:orange")
+        ax.set_ylabel(col)
+        ax.grid(axis="y", alpha=0.3)
+    axes[-1, 0].set_xticks(range(len(rows)))
+    axes[-1, 0].set_xticklabels([r[key] for r in rows], fontsize=8)
+    fig.tight_layout()
+    out = out_dir / f"{name}.png"
+    fig.savefig(out, dpi=150)
+    print(f"Chart written to {out}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark charts")
+    parser.add_argument("reports", type=pathlib.Path, nargs="+", help="Benchmark reports (CSV)")
+    parser.add_argument("out_dir", type=pathlib.Path, help="Output directory")
+    args = parser.parse_args()
+
+    args.out_dir.mkdir(parents=True, exist_ok=True)
+    for report in args.reports:
+        rows = read_csv(report)
+        if not rows:
+            print(f"{report} is empty, skipping")
+        elif "samples_per_s" in rows[0]:
+            plot_throughput(rows, args.out_dir)
+        else:
+            plot_generic(report.stem, rows, args.out_dir)
+
+
+if __name__ == "__main__":
+    main()
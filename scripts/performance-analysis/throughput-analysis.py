@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 EPFL contributors
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: throughput-analysis.py
+# Description: Run the throughput benchmarks on the Verilator model and collect
+#              the samples/s, bus cycles per sample and CPU-busy fraction of
+#              each kernel configuration into a CSV file.
+#
+# Each benchmark firmware opens one measurement window per configuration
+# (sw/external/lib/drivers/bench-ctl) and reports it on the UART as
+#   BENCH <kernel> <config> <samples> <busy cycles>
+# The windows are also measured by the testbench bus monitor (BUS_MONITOR=gpio),
+# which gives their length and bus load. Both are matched by their order.
+
+import argparse
+import csv
+import os
+import pathlib
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, str(pathlib.Path(__file__).resolve().parents[1] / "sim"))
+import regression  # noqa: E402
+from regression import BColors, SimResult  # noqa: E402
+
+# Default system clock frequency of the testbench in kHz
+CLK_KHZ = 100000
+
+
+def parse_bench_lines(uart_log: pathlib.Path):
+    """
+    Parse the measurement windows reported by the firmware.
+    """
+    windows = []
+    if not uart_log.exists():
+        return windows
+    with open(uart_log, "r", encoding="utf-8", errors="replace") as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 5 and fields[0] == "BENCH":
+                windows.append({
+                    "kernel": fields[1],
+                    "config": int(fields[2]),
+                    "samples": int(fields[3]),
+                    "busy_cycles": int(fields[4]),
+                })
+    return windows
+
+
+def parse_bus_windows(bus_csv: pathlib.Path):
+    """
+    Parse the windows of the bus monitor: length and bus cycles (granted
+    transactions plus stall cycles, summed over the system crossbar slaves).
+    """
+    windows = {}
+    if not bus_csv.exists():
+        return []
+    with open(bus_csv, "r", encoding="utf-8") as f:
+        for row in csv.DictReader(f):
+            win = windows.setdefault(int(row["window"]), {"cycles": int(row["cycles"]), "bus_cycles": 0})
+            if row["class"] == "slave":
+                win["bus_cycles"] += int(row["transactions"]) + int(row["stall_cycles"])
+    return [windows[i] for i in sorted(windows)]
+
+
+def collect(job, clk_khz):
+    """
+    Match the firmware and bus monitor windows of a job.
+    """
+    bench = parse_bench_lines(job.run_dir / "uart.log")
+    bus = parse_bus_windows(job.run_dir / "bus_monitor.csv")
+    if len(bench) != len(bus):
+        print(
+            BColors.WARNING
+            + f"{job.name}: {len(bench)} firmware windows but {len(bus)} bus monitor windows"
+            + BColors.ENDC
+        )
+    rows = []
+    for b, w in zip(bench, bus):
+        samples = max(b["samples"], 1)
+        cycles = max(w["cycles"], 1)
+        rows.append({
+            "kernel": b["kernel"],
+            "config": b["config"],
+            "samples": b["samples"],
+            "cycles": w["cycles"],
+            "samples_per_s": f"{b['samples'] * clk_khz * 1e3 / cycles:.1f}",
+            "bus_cycles_per_sample": f"{w['bus_cycles'] / samples:.2f}",
+            "cpu_busy": f"{min(b['busy_cycles'] / cycles, 1.0):.4f}",
+        })
+    return rows
+
+
+def main():
+    """
+    Builds the Verilator model and the benchmark firmware, runs the benchmarks
+    in parallel and writes the throughput table.
+    It exits with error if any benchmark failed.
+    """
+    parser = argparse.ArgumentParser(description="Throughput benchmark suite")
+    parser.add_argument(
+        "manifest", type=pathlib.Path, nargs="+", help="Benchmark manifest(s) (hjson)"
+    )
+    parser.add_argument("output", type=pathlib.Path, help="Output CSV file")
+    parser.add_argument(
+        "-j", "--jobs", type=int, default=os.cpu_count(), help="Number of parallel simulations"
+    )
+    parser.add_argument(
+        "--clk-khz", type=float, default=CLK_KHZ, help="System clock frequency in kHz"
+    )
+    parser.add_argument(
+        "--no-build", action="store_true", help="Use the already compiled Verilator model"
+    )
+    args = parser.parse_args()
+
+    jobs = []
+    for manifest in args.manifest:
+        jobs += regression.load_manifest(manifest)
+    for job in jobs:
+        job.plusargs += ["+bus_monitor=gpio", "+bus_monitor_out=bus_monitor.csv"]
+
+    out_dir = args.output.resolve().parent / "throughput"
+    out_dir.mkdir(parents=True, exist_ok=True)
+
+    if not args.no_build:
+        regression.build_model([])
+    sim_dir = regression.find_model("sim")
+    runnable = [job for job in jobs if regression.build_firmware(job, out_dir)]
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        list(pool.map(lambda job: regression.run_job(job, "verilator", sim_dir), runnable))
+
+    rows = []
+    for job in jobs:
+        regression.check_job(job)
+        color = BColors.OKGREEN if job.result == SimResult.PASSED else BColors.FAIL
+        print(color + f"{job.name}: {job.result}" + BColors.ENDC, flush=True)
+        if job.result == SimResult.PASSED:
+            rows += collect(job, args.clk_khz)
+
+    fields = ["kernel", "config", "samples", "cycles", "samples_per_s", "bus_cycles_per_sample", "cpu_busy"]
+    with open(args.output, "w", encoding="utf-8", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    print(BColors.BOLD + f"{'kernel':<10} {'config':>6} {'samples/s':>12} {'bus cyc/smp':>12} {'cpu busy':>9}" + BColors.ENDC)
+    for row in rows:
+        print(
+            f"{row['kernel']:<10} {row['config']:>6} {row['samples_per_s']:>12}"
+            + f" {row['bus_cycles_per_sample']:>12} {float(row['cpu_busy']):>9.1%}"
+        )
+    print(f"Throughput table written to {args.output}")
+
+    if any(job.result != SimResult.PASSED for job in jobs):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
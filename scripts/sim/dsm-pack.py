@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 EPFL contributors
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: dsm-pack.py
+# Description: Pack a text ΔΣ bitstream (one bit per line: 1, or 0/-1) into the
+#              binary format streamed by the Verilator testbench (+dsm_source),
+#              8 bits per byte, LSB first.
+
+import argparse
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack a text ΔΣ bitstream into a binary file")
+    parser.add_argument("input", help="Text bitstream (one bit per line)")
+    parser.add_argument("output", help="Packed binary bitstream")
+    args = parser.parse_args()
+
+    out = bytearray()
+    nbits = 0
+    with open(args.input, "r", encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line[0] not in "01-":
+                continue
+            if nbits % 8 == 0:
+                out.append(0)
+            if line[0] == "1":
+                out[-1] |= 1 << (nbits % 8)
+            nbits += 1
+
+    if nbits == 0:
+        print(f"No bits found in {args.input}", file=sys.stderr)
+        sys.exit(1)
+    if nbits % 8 != 0:
+        print(f"Warning: {nbits} bits, the last byte is padded with zeros", file=sys.stderr)
+
+    with open(args.output, "wb") as f:
+        f.write(out)
+    print(f"{nbits} bits written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
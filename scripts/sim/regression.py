@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 EPFL contributors
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: regression.py
+# Description: Run a manifest of firmware images in parallel on a single
+#              Verilator model and/or on the virtual platform (tb/vp), and
+#              collect the results into one report.
+
+import argparse
+import csv
+import glob
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+import hjson
+
+# Root directory of the repository
+ROOT_DIR = pathlib.Path(__file__).resolve().parents[2]
+
+# Timeout for a single simulation in seconds
+SIM_TIMEOUT_S = 1800
+
+# Virtual platform binary (make vp-build)
+VP_BIN = ROOT_DIR / "build" / "sim-vp" / "cheep_vp"
+
+# Simulation platforms
+PLATFORMS = ["verilator", "vp"]
+
+
+class BColors:
+    """
+    Colors in the terminal output.
+    """
+
+    OKBLUE = "\033[94m"
+    OKGREEN = "\033[92m"
+    WARNING = "\033[93m"
+    FAIL = "\033[91m"
+    ENDC = "\033[0m"
+    BOLD = "\033[1m"
+
+
+class SimResult:
+    """
+    Possible simulation results.
+    """
+
+    PASSED = "Passed"
+    FAILED = "Failed"
+    NO_EXIT = "No exit value"
+    TIMED_OUT = "Timed out"
+    BUILD_FAILED = "Build failed"
+    MISMATCH = "Mismatch"
+
+
+class Run:
+    """
+    The result of a job on one platform.
+    """
+
+    def __init__(self):
+        self.result = None
+        self.sim_exit_value = None
+        self.sim_cycles = 0
+        self.wall_s = 0.0
+        self.uart = None
+
+
+class Job:
+    """
+    A regression job: a firmware image, its plusargs and the expected result.
+    """
+
+    def __init__(self, desc: dict, defaults: dict):
+        cfg = dict(defaults)
+        cfg.update(desc)
+        if "app" not in cfg and "firmware" not in cfg:
+            raise ValueError(f"Job {desc} has neither 'app' nor 'firmware'")
+        self.app = cfg.get("app")
+        self.name = cfg.get("name", self.app or pathlib.Path(cfg["firmware"]).stem)
+        self.firmware = cfg.get("firmware")
+        self.boot_mode = cfg.get("boot_mode", "force")
+        self.max_cycles = int(cfg.get("max_cycles", 2000000))
+        self.exit_value = int(cfg.get("exit_value", 0))
+        self.plusargs = list(cfg.get("plusargs", []))
+        self.result = None
+        self.runs = {}
+        self.run_dir = None
+
+
+def load_manifest(manifest: pathlib.Path):
+    """
+    Load the jobs from an hjson manifest.
+    """
+    with open(manifest, "r", encoding="utf-8") as f:
+        data = hjson.load(f)
+    defaults = data.get("defaults", {})
+    return [Job(job, defaults) for job in data["jobs"]]
+
+
+def build_model(make_args):
+    """
+    Build the Verilator model once for all the jobs.
+    """
+    print(BColors.OKBLUE + "Building Verilator model..." + BColors.ENDC, flush=True)
+    res = subprocess.run(
+        ["make", "-C", str(ROOT_DIR), "verilator-build"] + make_args,
+        capture_output=True,
+        check=False,
+    )
+    if res.returncode != 0:
+        print(BColors.FAIL + "Error building the Verilator model." + BColors.ENDC)
+        print(res.stderr.decode("utf-8"), flush=True)
+        sys.exit(1)
+
+
+def build_vp():
+    """
+    Build the virtual platform.
+    """
+    print(BColors.OKBLUE + "Building virtual platform..." + BColors.ENDC, flush=True)
+    res = subprocess.run(["make", "-C", str(ROOT_DIR), "vp-build"], capture_output=True, check=False)
+    if res.returncode != 0:
+        print(BColors.FAIL + "Error building the virtual platform." + BColors.ENDC)
+        print(res.stderr.decode("utf-8"), flush=True)
+        sys.exit(1)
+
+
+def find_model(target, build_root=None):
+    """
+    Find the directory of the compiled Verilator model. Without a build root,
+    the most recently built model of the target is used.
+    """
+    if build_root is not None:
+        dirs = [str(build_root / f"{target}-verilator")]
+    else:
+        dirs = glob.glob(str(ROOT_DIR / "build" / f"verilator-{target}-*" / f"{target}-verilator"))
+        dirs.sort(key=lambda d: os.path.getmtime(d), reverse=True)
+    for sim_dir in dirs:
+        if os.path.isfile(os.path.join(sim_dir, "Vtb_system")):
+            return pathlib.Path(sim_dir)
+    print(BColors.FAIL + f"No compiled Verilator model found for target '{target}'." + BColors.ENDC)
+    sys.exit(1)
+
+
+def build_firmware(job: Job, out_dir: pathlib.Path):
+    """
+    Build the application of a job and copy its firmware to the job directory.
+    Applications share the software build directory, so they are built sequentially.
+    """
+    job.run_dir = out_dir / job.name
+    job.run_dir.mkdir(parents=True, exist_ok=True)
+    if job.firmware is not None:
+        job.firmware = str(pathlib.Path(job.firmware).resolve())
+        return True
+
+    print(BColors.OKBLUE + f"Compiling {job.name}..." + BColors.ENDC, flush=True)
+    res = subprocess.run(
+        ["make", "-C", str(ROOT_DIR), "app", f"PROJECT={job.app}", f"BOOT_MODE={job.boot_mode}"],
+        capture_output=True,
+        check=False,
+    )
+    if res.returncode != 0:
+        print(BColors.FAIL + f"Error compiling {job.name}." + BColors.ENDC)
+        print(res.stderr.decode("utf-8"), flush=True)
+        job.result = SimResult.BUILD_FAILED
+        return False
+    shutil.copy(ROOT_DIR / "build" / "sw" / "app" / "main.hex", job.run_dir / "main.hex")
+    job.firmware = str(job.run_dir / "main.hex")
+    return True
+
+
+def run_job(job: Job, platform: str, sim_dir: pathlib.Path):
+    """
+    Run a job on the shared Verilator model or on the virtual platform, in its
+    own directory.
+    """
+    run = Run()
+    job.runs[platform] = run
+    run_dir = job.run_dir if platform == "verilator" else job.run_dir / platform
+    run_dir.mkdir(parents=True, exist_ok=True)
+    perf_report = run_dir / "perf.json"
+    if perf_report.exists():
+        perf_report.unlink()
+
+    if platform == "verilator":
+        # The model opens some files relative to the working directory (e.g.,
+        # the VCO phase LUT and the PDM stimuli): link them into the job
+        # directory.
+        for f in glob.glob(str(sim_dir / "*.hex")) + glob.glob(str(sim_dir / "*.txt")):
+            link = run_dir / os.path.basename(f)
+            if not link.exists():
+                link.symlink_to(f)
+        cmd = [
+            str(sim_dir / "Vtb_system"),
+            "--log_level=LOG_LOW",
+            "--trace=false",
+            "--no_err=true",
+        ]
+    else:
+        cmd = [
+            str(VP_BIN),
+            "--log_level=LOG_LOW",
+            "--no_err=true",
+            f"+phase_lut={ROOT_DIR / 'hw/vendor/analog-library/VCO/Verilog/phase_lut.hex'}",
+            f"+pdm_file={ROOT_DIR / 'hw/vendor/x-heep/hw/ip/pdm2pcm/tb/signals/pdm.txt'}",
+            f"+uart_log={run_dir / 'uart.log'}",
+        ]
+    cmd += [
+        f"+firmware={job.firmware}",
+        f"+boot_mode={job.boot_mode}",
+        f"+max_cycles={job.max_cycles}",
+        f"+perf_report={perf_report}",
+    ] + job.plusargs
+
+    start = time.time()
+    try:
+        with open(run_dir / "sim.log", "w", encoding="utf-8") as log:
+            subprocess.run(
+                cmd,
+                cwd=run_dir,
+                stdout=log,
+                stderr=subprocess.STDOUT,
+                timeout=SIM_TIMEOUT_S,
+                check=False,
+            )
+    except subprocess.TimeoutExpired:
+        run.result = SimResult.TIMED_OUT
+    run.wall_s = time.time() - start
+    uart_log = run_dir / "uart.log"
+    if uart_log.exists():
+        run.uart = uart_log.read_text(encoding="utf-8", errors="replace")
+    if run.result is not None:
+        return job, platform
+
+    # Collect the results from the testbench performance report
+    if not perf_report.exists():
+        run.result = SimResult.FAILED
+        return job, platform
+    with open(perf_report, "r", encoding="utf-8") as f:
+        perf = json.load(f)
+    run.sim_cycles = perf["sim_cycles"]
+    if not perf["exit_valid"]:
+        run.result = SimResult.NO_EXIT
+    else:
+        run.sim_exit_value = perf["exit_value"]
+        run.result = SimResult.PASSED if run.sim_exit_value == job.exit_value else SimResult.FAILED
+    return job, platform
+
+
+def check_job(job: Job):
+    """
+    Set the overall result of a job. With both platforms, the exit value and
+    the UART output of the virtual platform must match the Verilator ones.
+    """
+    if job.result is not None:
+        return
+    for run in job.runs.values():
+        if run.result != SimResult.PASSED:
+            job.result = run.result
+            return
+    if len(job.runs) == 2:
+        ref, vp = job.runs["verilator"], job.runs["vp"]
+        if ref.sim_exit_value != vp.sim_exit_value or ref.uart != vp.uart:
+            job.result = SimResult.MISMATCH
+            return
+    job.result = SimResult.PASSED
+
+
+def write_report(jobs, platforms, threads, report: pathlib.Path):
+    """
+    Write the regression report in CSV format (one row per job and platform),
+    with the thread count of the Verilator model.
+    """
+    with open(report, "w", encoding="utf-8", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow([
+            "name", "platform", "threads", "result", "exit_value", "expected", "sim_cycles", "wall_s", "khz"
+        ])
+        for job in jobs:
+            for platform in platforms:
+                run = job.runs.get(platform, Run())
+                khz = run.sim_cycles / run.wall_s / 1e3 if run.wall_s > 0 else 0
+                writer.writerow([
+                    job.name,
+                    platform,
+                    threads if platform == "verilator" else "",
+                    run.result if run.result is not None else job.result,
+                    "" if run.sim_exit_value is None else run.sim_exit_value,
+                    job.exit_value,
+                    run.sim_cycles,
+                    f"{run.wall_s:.3f}",
+                    f"{khz:.2f}",
+                ])
+
+
+def print_results(jobs, platforms):
+    """
+    Print the results of the regression.
+    """
+    print(BColors.BOLD + "=================================" + BColors.ENDC)
+    print(BColors.BOLD + "Results:" + BColors.ENDC)
+    print(BColors.BOLD + "=================================" + BColors.ENDC)
+    for job in jobs:
+        color = BColors.OKGREEN if job.result == SimResult.PASSED else BColors.FAIL
+        line = f"{job.name:<24} {job.result:<14}"
+        for platform in platforms:
+            run = job.runs.get(platform, Run())
+            exit_str = "-" if run.sim_exit_value is None else str(run.sim_exit_value)
+            line += f" {platform}: exit {exit_str:>4} {run.sim_cycles:>10} cycles {run.wall_s:>8.1f} s"
+        line += f" (expected {job.exit_value})"
+        if len(platforms) == 2 and job.runs["vp"].wall_s > 0:
+            line += f" speedup {job.runs['verilator'].wall_s / job.runs['vp'].wall_s:.0f}x"
+        print(color + line + BColors.ENDC)
+    passed = sum(job.result == SimResult.PASSED for job in jobs)
+    color = BColors.OKGREEN if passed == len(jobs) else BColors.FAIL
+    print(color + f"{passed} out of {len(jobs)} jobs passed." + BColors.ENDC)
+    print(BColors.BOLD + "=================================" + BColors.ENDC, flush=True)
+
+
+def main():
+    """
+    Builds the Verilator model (and/or the virtual platform) and the firmware
+    of every job in the manifest, then runs the jobs in parallel and reports the
+    results.
+    It exits with error if any job failed.
+    """
+    parser = argparse.ArgumentParser(description="Parallel Verilator regression runner")
+    parser.add_argument(
+        "manifest", type=pathlib.Path, help="Regression manifest (hjson)"
+    )
+    parser.add_argument(
+        "-j", "--jobs", type=int, default=os.cpu_count(), help="Number of parallel simulations"
+    )
+    parser.add_argument(
+        "-o", "--outdir", type=pathlib.Path, default=ROOT_DIR / "build" / "regression",
+        help="Output directory (one subdirectory per job, plus the report)",
+    )
+    parser.add_argument(
+        "--target", default="sim", help="FuseSoC target of the Verilator model (sim, sim_mt, sim_savable)"
+    )
+    parser.add_argument(
+        "--threads", type=int, default=0,
+        help="Number of threads of the sim_mt model (VERILATOR_THREADS in the top makefile)",
+    )
+    parser.add_argument(
+        "--build-root", type=pathlib.Path, default=None,
+        help="FuseSoC build root of the Verilator model (VERILATOR_BUILD_ROOT in the top makefile)",
+    )
+    parser.add_argument(
+        "--no-build", action="store_true", help="Use the already compiled Verilator model"
+    )
+    parser.add_argument(
+        "--platform", choices=PLATFORMS + ["both"], default="verilator",
+        help="Simulation platform (both: also compare the exit value and UART output)",
+    )
+    args = parser.parse_args()
+    if (args.target == "sim_mt") != (args.threads > 0):
+        parser.error("--threads <N> (N > 0) is required with, and only with, --target sim_mt")
+
+    jobs = load_manifest(args.manifest)
+    args.outdir.mkdir(parents=True, exist_ok=True)
+
+    # Build the model and the firmware images
+    platforms = PLATFORMS if args.platform == "both" else [args.platform]
+    sim_dir = None
+    if "verilator" in platforms:
+        if args.build_root is not None:
+            args.build_root = args.build_root.resolve()
+        if not args.no_build:
+            make_args = [
+                f"VERILATOR_SAVABLE={int(args.target == 'sim_savable')}",
+                f"VERILATOR_THREADS={args.threads}",
+            ]
+            if args.build_root is not None:
+                make_args.append(f"VERILATOR_BUILD_ROOT={args.build_root}")
+            build_model(make_args)
+        sim_dir = find_model(args.target, args.build_root)
+    if "vp" in platforms and not args.no_build:
+        build_vp()
+    runnable = [job for job in jobs if build_firmware(job, args.outdir)]
+
+    # Run the jobs in parallel
+    print(
+        BColors.OKBLUE + f"Running {len(runnable)} jobs on {args.jobs} workers..." + BColors.ENDC,
+        flush=True,
+    )
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [
+            pool.submit(run_job, job, platform, sim_dir) for job in runnable for platform in platforms
+        ]
+        for future in as_completed(futures):
+            job, platform = future.result()
+            result = job.runs[platform].result
+            color = BColors.OKGREEN if result == SimResult.PASSED else BColors.FAIL
+            print(color + f"{job.name} ({platform}): {result}" + BColors.ENDC, flush=True)
+    for job in jobs:
+        check_job(job)
+
+    report = args.outdir / "report.csv"
+    write_report(jobs, platforms, args.threads, report)
+    print_results(jobs, platforms)
+    print(f"Report written to {report}")
+
+    if any(job.result != SimResult.PASSED for job in jobs):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
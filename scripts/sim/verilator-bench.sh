@@ -0,0 +1,44 @@
+# Benchmark the Verilator model throughput for different thread counts
+# Usage: verilator-bench.sh "<threads> [threads] ..." <cycles> <report.csv>
+#
+# For each thread count, build the corresponding Verilator model (0 means
+# single-threaded) and run the current firmware without waveform dumping for
+# at most <cycles> clock cycles. Each thread count is built in its own build
+# root (VERILATOR_BUILD_ROOT in the top makefile), so no model is reused. The
+# throughput printed by the testbench at the end of the simulation is collected
+# in <report.csv>.
+
+THREAD_LIST=$1
+CYCLES=$2
+REPORT=$3
+
+ROOT_DIR=$(git rev-parse --show-toplevel)
+LOG_DIR=$ROOT_DIR/build/sim-common
+
+echo "threads,cycles,wall_s,khz" > $REPORT
+for threads in $THREAD_LIST; do
+    LOG_FILE=$LOG_DIR/verilator-bench-t$threads.log
+    echo "### Building Verilator model with VERILATOR_THREADS=$threads..."
+    make -C $ROOT_DIR verilator-build VERILATOR_THREADS=$threads > $LOG_FILE 2>&1
+    if [ $? -ne 0 ]; then
+        echo "### ERROR: build failed (see $LOG_FILE)"
+        exit 1
+    fi
+    echo "### Running $CYCLES cycles with VERILATOR_THREADS=$threads..."
+    make -C $ROOT_DIR verilator-opt VERILATOR_THREADS=$threads MAX_CYCLES=$CYCLES LOG_LEVEL=LOG_LOW >> $LOG_FILE 2>&1
+    RESULT=$(grep -oE "Simulated [0-9]+ cycles in [0-9.]+ s \([0-9.]+ kHz\)" $LOG_FILE | tail -n 1)
+    if [ -z "$RESULT" ]; then
+        echo "### ERROR: no throughput report found (see $LOG_FILE)"
+        exit 1
+    fi
+    SIM_CYCLES=$(echo $RESULT | awk '{print $2}')
+    WALL_S=$(echo $RESULT | awk '{print $5}')
+    KHZ=$(echo $RESULT | awk '{print $7}' | tr -d '(')
+    echo "$threads,$SIM_CYCLES,$WALL_S,$KHZ" >> $REPORT
+    echo "    $RESULT"
+done
+
+echo "### Report written to $REPORT"
+column -s, -t $REPORT
+
+exit 0
@@ -0,0 +1,25 @@
+# Report the evaluation time spent in each module of the Verilator model
+# Usage: verilator-profile.sh <verilator_sim_dir> <report.txt>
+#
+# The model must be built with VERILATOR_PROF=1 (--prof-cfuncs and gprof
+# instrumentation) and run at least once, so that gmon.out exists in the
+# simulation directory.
+
+SIM_DIR=$1
+REPORT=$2
+
+if [ ! -f $SIM_DIR/gmon.out ]; then
+    echo "### ERROR: $SIM_DIR/gmon.out not found (run a simulation built with VERILATOR_PROF=1 first)"
+    exit 1
+fi
+if ! command -v gprof > /dev/null || ! command -v verilator_profcfunc > /dev/null; then
+    echo "### ERROR: gprof and verilator_profcfunc are required"
+    exit 1
+fi
+
+gprof $SIM_DIR/Vtb_system $SIM_DIR/gmon.out > $SIM_DIR/gprof.out
+verilator_profcfunc $SIM_DIR/gprof.out > $REPORT
+echo "### Profile written to $REPORT"
+sed -n '/Overall summary by type/,/^$/p; /Overall summary by design/,/^$/p' $REPORT
+
+exit 0
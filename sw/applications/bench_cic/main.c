@@ -0,0 +1,67 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_cic/main.c
+// Description: Throughput benchmark of the CIC decimation filter. For each
+//              decimation factor, the CPU drains a fixed number of outputs
+//              from the filter FIFO. Each acquisition is a measurement window
+//              (see bench_util.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "pdm2pcm_regs.h"
+#include "mmio.h"
+#include "cheep.h"
+#include "bench_util.h"
+
+// Number of filter outputs of each acquisition
+#define NUM_OUTPUTS 16
+
+// ΔΣ clock division (must be even)
+#define CIC_CLKDIV 16
+
+// Decimation factors under test
+static const uint16_t decimations[] = {15, 32, 64};
+
+int32_t cic_output[NUM_OUTPUTS];
+
+int main(int argc, char *argv[])
+{
+    if (bench_init() != 0) return EXIT_FAILURE;
+
+    mmio_region_t pdm2pcm_base_addr = mmio_region_from_addr((uintptr_t)CIC_START_ADDRESS);
+
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CLKDIVIDX_REG_OFFSET, CIC_CLKDIV);
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET, 0b1111);
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_DELAY_COMB_REG_OFFSET, 1);
+
+    for (uint32_t i = 0; i < sizeof(decimations)/sizeof(decimations[0]); i++) {
+
+        mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMCIC_REG_OFFSET, decimations[i]);
+
+        bench_start();
+        mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CONTROL_REG_OFFSET, 1);
+
+        int count = 0;
+        while (count < NUM_OUTPUTS) {
+            uint32_t status = mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_STATUS_REG_OFFSET);
+            if (!(status & 1)) {
+                cic_output[count++] = mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_RXDATA_REG_OFFSET);
+            }
+        }
+
+        mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CONTROL_REG_OFFSET, 0);
+        bench_stop("cic", decimations[i], NUM_OUTPUTS);
+
+        // Drop the outputs left in the FIFO before the next acquisition
+        while (!(mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_STATUS_REG_OFFSET) & 1)) {
+            mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_RXDATA_REG_OFFSET);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_idac/main.c
+// Description: Throughput benchmark of the iDAC waveform injection. For each
+//              iDAC refresh rate, the DAC DMA streams a waveform from SRAM to
+//              the iDACs while the CPU sleeps, and then the waveform generator
+//              of the iDAC controller injects the same waveform without the
+//              DMA. Each injection is a measurement window (see bench_util.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "csr.h"
+#include "hart.h"
+#include "timer_sdk.h"
+
+#include "iDAC_ctrl.h"
+#include "bench_util.h"
+
+#define INTR_TIMER (1 << 7)
+#define INTR_DMA_TRANS_DONE (1 << 19)
+
+#define DAC_DMA 1
+
+// Number of waveform samples of each injection
+#define NUM_SAMPLES 256
+
+// iDAC refresh rates under test (system clock cycles per sample)
+static const uint16_t refresh_rates[] = {100, 200};
+
+dma_target_t dac_tgt_src;
+dma_target_t dac_tgt_dst;
+dma_trans_t dac_trans;
+
+volatile int32_t transactions_intr_flag = 0;
+volatile int32_t timer_intr_flag = 0;
+
+// Both iDAC currents of each sample (iDAC1 in the LSBs, iDAC2 in the MSBs)
+uint16_t waveform[NUM_SAMPLES];
+
+// One period of the same triangle for the waveform generator
+int8_t dds_waveform[IDAC_CTRL_WAVE_RAM_SIZE_WORDS];
+
+void dma_intr_handler_trans_done(uint8_t channel){
+    if(channel == DAC_DMA ) transactions_intr_flag ++;
+}
+
+uint8_t dma_window_ratio_warning_threshold(){
+    return 0;
+}
+
+void __attribute__((aligned(4), interrupt)) handler_irq_timer(void) {
+    timer_arm_stop();
+    timer_irq_clear();
+    timer_intr_flag ++;
+    return;
+}
+
+int main() {
+
+    if (bench_init() != 0) return EXIT_FAILURE;
+
+    // Triangle on iDAC1 and its complement on iDAC2
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        uint8_t v = i < NUM_SAMPLES/2 ? 2*i : 2*(NUM_SAMPLES - 1 - i);
+        waveform[i] = ((uint16_t)(0xFF - v) << 8) | v;
+    }
+
+    iDACs_enable(true, true);
+    iDAC1_calibrate(16);
+    iDAC2_calibrate(16);
+
+    dma_init(NULL);
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    CSR_SET_BITS(CSR_REG_MIE, INTR_TIMER | INTR_DMA_TRANS_DONE);
+
+    for (uint32_t i = 0; i < sizeof(refresh_rates)/sizeof(refresh_rates[0]); i++) {
+
+        iDACs_set_refresh_rate(refresh_rates[i]);
+
+        // DAC DMA: waveform -> iDACs current register
+        dac_tgt_src.ptr = (uint8_t*) waveform;
+        dac_tgt_src.trig = DMA_TRIG_MEMORY;
+        dac_tgt_src.inc_d1_du = 1;
+        dac_tgt_src.type = DMA_DATA_TYPE_HALF_WORD;
+
+        dac_tgt_dst.ptr = (uint8_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_CURRENT_REG_OFFSET);
+        dac_tgt_dst.inc_d1_du = 0;
+        dac_tgt_dst.trig = DMA_TRIG_SLOT_EXT_TX;
+        dac_tgt_dst.type = DMA_DATA_TYPE_HALF_WORD;
+
+        dac_trans.src   = &dac_tgt_src;
+        dac_trans.dst   = &dac_tgt_dst;
+        dac_trans.dim   = DMA_DIM_CONF_1D;
+        dac_trans.channel = DAC_DMA;
+        dac_trans.win_du = 0;
+        dac_trans.end = DMA_TRANS_END_INTR;
+        dac_trans.size_d1_du = NUM_SAMPLES;
+        dac_trans.mode = DMA_TRANS_MODE_SINGLE;
+        dac_trans.hw_fifo_en = false;
+
+        dma_config_flags_t res;
+        res = dma_validate_transaction(&dac_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+        if( res != DMA_CONFIG_OK ) return EXIT_FAILURE;
+        res = dma_load_transaction(&dac_trans);
+        if( res != DMA_CONFIG_OK ) return EXIT_FAILURE;
+
+        transactions_intr_flag = 0;
+        bench_start();
+        if(dma_launch(&dac_trans) != DMA_CONFIG_OK) return EXIT_FAILURE;
+
+        while( transactions_intr_flag == 0 ) {
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+            if ( transactions_intr_flag == 0 ) {
+                wait_for_interrupt();
+            }
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        bench_stop("idac", refresh_rates[i], NUM_SAMPLES);
+    }
+
+    // Waveform generator: one period of the triangle every NUM_SAMPLES steps
+    // on iDAC1, and half a period later (its complement) on iDAC2
+    for (int i = 0; i < IDAC_CTRL_WAVE_RAM_SIZE_WORDS; i++) {
+        int v = i < IDAC_CTRL_WAVE_RAM_SIZE_WORDS/2 ? i : IDAC_CTRL_WAVE_RAM_SIZE_WORDS - 1 - i;
+        dds_waveform[i] = (int8_t)(v * 512 / IDAC_CTRL_WAVE_RAM_SIZE_WORDS - 128);
+    }
+    iDACs_dds_load_wave(dds_waveform);
+    iDACs_dds_set_levels(255, 128, 255, 128);
+    iDAC1_dds_set_frequency((uint32_t)(((uint64_t)1 << 32) / NUM_SAMPLES));
+    iDAC2_dds_set_frequency((uint32_t)(((uint64_t)1 << 32) / NUM_SAMPLES));
+    iDAC2_dds_set_phase(0x80000000);
+
+    for (uint32_t i = 0; i < sizeof(refresh_rates)/sizeof(refresh_rates[0]); i++) {
+
+        iDACs_set_refresh_rate(refresh_rates[i]);
+
+        timer_cycles_init();
+        timer_irq_enable();
+
+        timer_intr_flag = 0;
+        bench_start();
+        iDACs_dds_control(true, true, false, false);
+        timer_arm_start(NUM_SAMPLES * (refresh_rates[i] + 1));
+
+        while( timer_intr_flag == 0 ) {
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+            if ( timer_intr_flag == 0 ) {
+                wait_for_interrupt();
+            }
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        iDACs_dds_control(false, false, false, false);
+        bench_stop("idac_dds", refresh_rates[i], NUM_SAMPLES);
+    }
+
+    iDACs_enable(false, false);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_ses/main.c
+// Description: Throughput benchmark of the SES decimation filter. For each
+//              system clock division, the CPU polls a fixed number of filter
+//              outputs. Each acquisition is a measurement window (see
+//              bench_util.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "SES_filter.h"
+#include "bench_util.h"
+
+// Number of filter outputs of each acquisition
+#define NUM_OUTPUTS 16
+
+#define SES_WINDOW_SIZE 4
+#define SES_DECIM_FACTOR 32
+#define SES_ACTIVATED_STAGES 0b1111
+
+// ΔΣ clock divisions under test
+static const uint16_t sysclk_divisions[] = {16, 32, 64, 128};
+
+uint32_t ses_output[NUM_OUTPUTS];
+
+int main() {
+
+    if (bench_init() != 0) return EXIT_FAILURE;
+
+    SES_set_window_size(SES_WINDOW_SIZE);
+    SES_set_decim_factor(SES_DECIM_FACTOR);
+    SES_set_activated_stages(SES_ACTIVATED_STAGES);
+    SES_set_gain(0, 15);
+    for (uint8_t s = 1; s < 6; s++) SES_set_gain(s, 0);
+
+    for (uint32_t i = 0; i < sizeof(sysclk_divisions)/sizeof(sysclk_divisions[0]); i++) {
+
+        SES_set_sysclk_division(sysclk_divisions[i]);
+
+        bench_start();
+        SES_set_control_reg(true);
+
+        // Read the output FIFO while it holds data
+        int n = 0;
+        while (n < NUM_OUTPUTS) {
+            if (SES_get_status() & (1 << SES_STATUS_DATA_VALID_BIT)) {
+                ses_output[n] = SES_get_filtered_output();
+                n++;
+            }
+        }
+
+        SES_set_control_reg(false);
+        bench_stop("ses", sysclk_divisions[i], NUM_OUTPUTS);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_spi/main.c
+// Description: Throughput benchmark of the SPI slave readout. The measurement
+//              window (see bench_util.h) raises GPIO 0, which makes the
+//              testbench SPI master read a buffer through the SPI slave
+//              (SPI_READ=<addr>:<bytes>:gpio). The SPI slave works without
+//              the CPU, so the firmware sleeps for the length of the transfer.
+//              Run with SPI_SCK_DIV=BENCH_SPI_SCK_DIV and <bytes>=BENCH_SPI_BYTES.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "hart.h"
+#include "timer_sdk.h"
+
+#include "bench_util.h"
+
+#define INTR_TIMER (1 << 7)
+
+// Must match the SPI_READ and SPI_SCK_DIV options of the testbench
+#define BENCH_SPI_BYTES 1024
+#define BENCH_SPI_SCK_DIV 4
+
+// SPI slave read: command, address and dummy cycles, then 32 SCK periods per
+// word, each of 2*SCK_DIV system clock cycles
+#define SPI_READ_OVERHEAD_SCK 121
+#define SPI_READ_CYCLES (2 * BENCH_SPI_SCK_DIV * (SPI_READ_OVERHEAD_SCK + 8 * BENCH_SPI_BYTES))
+
+void __attribute__((aligned(4), interrupt)) handler_irq_timer(void) {
+    timer_arm_stop();
+    timer_irq_clear();
+    return;
+}
+
+int main() {
+
+    if (bench_init() != 0) return EXIT_FAILURE;
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    CSR_SET_BITS(CSR_REG_MIE, INTR_TIMER);
+
+    timer_cycles_init();
+    timer_irq_enable();
+
+    bench_start();
+    timer_arm_start(SPI_READ_CYCLES);
+    wait_for_interrupt();
+    bench_stop("spi", BENCH_SPI_SCK_DIV, BENCH_SPI_BYTES / 4);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_vco_dlc/main.c
+// Description: Throughput benchmark of the VCO + dLC acquisition chain. For
+//              each VCO refresh rate, the ADC DMA streams a fixed number of
+//              VCO counts through the dLC into SRAM while the CPU sleeps.
+//              Each acquisition is a measurement window (see bench_util.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "csr.h"
+#include "hart.h"
+#include "timer_sdk.h"
+
+#include "dlc.h"
+#include "VCO_decoder.h"
+#include "bench_util.h"
+
+#define INTR_TIMER (1 << 7)
+#define INTR_DMA_TRANS_DONE (1 << 19)
+
+#define ADC_DMA 0
+
+// Number of VCO samples of each acquisition
+#define NUM_SAMPLES 256
+
+// VCO refresh rates under test (system clock cycles per sample)
+static const uint16_t refresh_rates[] = {50, 100, 200};
+
+dma_target_t adc_tgt_src;
+dma_target_t adc_tgt_dst;
+dma_trans_t adc_trans;
+
+volatile int32_t transactions_intr_flag = 0;
+
+// dLC results buffer
+int16_t dlc_results[NUM_SAMPLES];
+
+void dma_intr_handler_trans_done(uint8_t channel){
+    if(channel == ADC_DMA ) transactions_intr_flag ++;
+}
+
+uint8_t dma_window_ratio_warning_threshold(){
+    return 0;
+}
+
+void __attribute__((aligned(4), interrupt)) handler_irq_timer(void) {
+    timer_arm_stop();
+    timer_irq_clear();
+    return;
+}
+
+int main() {
+
+    if (bench_init() != 0) return EXIT_FAILURE;
+
+    dma_init(NULL);
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    CSR_SET_BITS(CSR_REG_MIE, INTR_TIMER | INTR_DMA_TRANS_DONE);
+
+    // dLC with the same parameters as test_dlc_vco
+    uint32_t* dlvl_log_level_width    = DLC_START_ADDRESS + DLC_DLVL_LOG_LEVEL_WIDTH_REG_OFFSET;
+    uint32_t* dlvl_n_bits             = DLC_START_ADDRESS + DLC_DLVL_N_BITS_REG_OFFSET;
+    uint32_t* dlvl_format             = DLC_START_ADDRESS + DLC_DLVL_FORMAT_REG_OFFSET;
+    uint32_t* dlvl_mask               = DLC_START_ADDRESS + DLC_DLVL_MASK_REG_OFFSET;
+    uint32_t* dt_mask                 = DLC_START_ADDRESS + DLC_DT_MASK_REG_OFFSET;
+    uint32_t* dlc_size                = DLC_START_ADDRESS + DLC_TRANS_SIZE_REG_OFFSET;
+    uint32_t* dlc_hysteresis_en       = DLC_START_ADDRESS + DLC_HYSTERESIS_EN_REG_OFFSET;
+    uint32_t* dlc_init_level          = DLC_START_ADDRESS + DLC_CURR_LVL_REG_OFFSET;
+    uint32_t* dlc_discard_bits        = DLC_START_ADDRESS + DLC_DISCARD_BITS_REG_OFFSET;
+
+    *dlvl_format = 0;
+    *dlvl_log_level_width = 7;
+    *dlvl_n_bits = 1;
+    *dlvl_mask = (1 << (*dlvl_n_bits)) - 1;
+    *dt_mask = (1 << 6) - 1;
+    *dlc_hysteresis_en = 1;
+    *dlc_discard_bits = 0;
+
+    VCOp_enable(true);
+    VCOn_enable(false);
+
+    for (uint32_t i = 0; i < sizeof(refresh_rates)/sizeof(refresh_rates[0]); i++) {
+
+        VCO_set_refresh_rate(refresh_rates[i]);
+
+        // Let the VCO settle and start the dLC from the current level
+        timer_wait_us(20);
+        *dlc_init_level = (VCO_get_count() >> *dlvl_log_level_width);
+
+        // ADC DMA: VCO count register -> dLC (HW FIFO) -> dlc_results
+        adc_tgt_src.ptr = (uint8_t *) (volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_VCO_DECODER_CNT_REG_OFFSET);
+        adc_tgt_src.trig = DMA_TRIG_SLOT_EXT_RX;
+        adc_tgt_src.inc_d1_du = 0;
+        adc_tgt_src.type = DMA_DATA_TYPE_HALF_WORD;
+
+        adc_tgt_dst.ptr = (uint8_t *) dlc_results;
+        adc_tgt_dst.inc_d1_du = 1;
+        adc_tgt_dst.trig = DMA_TRIG_MEMORY;
+        adc_tgt_dst.type = DMA_DATA_TYPE_HALF_WORD;
+
+        adc_trans.src   = &adc_tgt_src;
+        adc_trans.dst   = &adc_tgt_dst;
+        adc_trans.dim   = DMA_DIM_CONF_1D;
+        adc_trans.channel = ADC_DMA;
+        adc_trans.win_du = 0;
+        adc_trans.end = DMA_TRANS_END_INTR;
+        adc_trans.mode = DMA_TRANS_MODE_SINGLE;
+        adc_trans.hw_fifo_en = true;
+
+        // The dLC closes the transaction after NUM_SAMPLES samples
+        *dlc_size = NUM_SAMPLES;
+        adc_trans.size_d1_du = *dlc_size;
+
+        dma_config_flags_t res;
+        res = dma_validate_transaction(&adc_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+        if( res != DMA_CONFIG_OK ) return EXIT_FAILURE;
+        res = dma_load_transaction(&adc_trans);
+        if( res != DMA_CONFIG_OK ) return EXIT_FAILURE;
+
+        transactions_intr_flag = 0;
+        bench_start();
+        if(dma_launch(&adc_trans) != DMA_CONFIG_OK) return EXIT_FAILURE;
+
+        while( transactions_intr_flag == 0 ) {
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+            if ( transactions_intr_flag == 0 ) {
+                wait_for_interrupt();
+            }
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        bench_stop("vco_dlc", refresh_rates[i], NUM_SAMPLES);
+    }
+
+    VCOp_enable(false);
+
+    return EXIT_SUCCESS;
+}
@@ -37,7 +37,7 @@ int basic_test() {
     uint32_t status;
     do{
         status = SES_get_status();
-    } while (status != 0b11);
+    } while ((status & 0b11) != 0b11);
 
 
     //Get the SES filter output
@@ -45,8 +45,9 @@ int basic_test() {
 
     int i = 0;
     while (i < NUMBER_OUTPUT) {
+        // Read the output FIFO while it holds data
         uint32_t status = SES_get_status();
-        if (detect_rising_edge(status, 0b10)) {
+        if (status & (1 << SES_STATUS_DATA_VALID_BIT)) {
             ses_output[i] = SES_get_filtered_output();
             i++;
         }
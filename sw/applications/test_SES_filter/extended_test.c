@@ -34,7 +34,7 @@ int extended_test() {
     uint32_t status;
     do{
         status = SES_get_status();
-    } while (status != 0b11);
+    } while ((status & 0b11) != 0b11);
 
 
     //Get the SES filter output or wait until the end
@@ -43,8 +43,9 @@ int extended_test() {
 
     int i = 0;
     while (i < SES_SAMPLE_NUMBER) {
+        // Read the output FIFO while it holds data
         uint32_t status = SES_get_status();
-        if (detect_rising_edge(status, 0b10)) {
+        if (status & (1 << SES_STATUS_DATA_VALID_BIT)) {
             ses_output[i] = SES_get_filtered_output();
             i++;
         }
@@ -53,7 +54,8 @@ int extended_test() {
     int i = 0;
     while (i < NUMBER_OUTPUT) {
         uint32_t status = SES_get_status();
-        if (detect_rising_edge(status, 0b10)) {
+        if (status & (1 << SES_STATUS_DATA_VALID_BIT)) {
+            SES_get_filtered_output();
             i++;
         }
     }
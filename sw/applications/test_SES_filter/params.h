@@ -0,0 +1,18 @@
+// Generated by tb/models/ref_groundtruth.cpp (see the application Makefile)
+
+#ifndef PARAMS_H
+#define PARAMS_H
+
+#define SES_WINDOW_SIZE 4
+#define SES_DECIM_FACTOR 32
+#define SES_ACTIVATED_STAGES 63
+#define SES_GAIN_STAGE_0 10
+#define SES_GAIN_STAGE_1 2
+#define SES_GAIN_STAGE_2 2
+#define SES_GAIN_STAGE_3 2
+#define SES_GAIN_STAGE_4 2
+#define SES_GAIN_STAGE_5 2
+#define SES_SAMPLE_NUMBER 161
+#define SES_SYSCLK_DIVISION 128
+
+#endif
@@ -17,19 +17,10 @@
 //#define PRINTF_OUTPUT
 
 #ifndef EXTENDED_TEST
-#define SES_SAMPLE_NUMBER 161
-
-#define SES_WINDOW_SIZE 4
-#define SES_DECIM_FACTOR 32
-#define SES_SYSCLK_DIVISION 128
-#define SES_ACTIVATED_STAGES 0b111111
-
-#define SES_GAIN_STAGE_0 10
-#define SES_GAIN_STAGE_1 2
-#define SES_GAIN_STAGE_2 2
-#define SES_GAIN_STAGE_3 2
-#define SES_GAIN_STAGE_4 2
-#define SES_GAIN_STAGE_5 2
+// Parameters of the ground truth, generated with the reference model by the
+// Makefile of the application (e.g., make app PROJECT=test_SES_filter
+// SES_WINDOW_SIZE=5)
+#include "params.h"
 
 #else
 #define SES_SAMPLE_NUMBER 32769
@@ -0,0 +1,107 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_VCO_double_tap/main.c
+// Description: Test of the double-tap mode of the VCO decoder. The conversions
+//              are timestamped in the sample FIFO: in double-tap mode they are
+//              DOUBLE_TAP_GAP cycles later than the single-tap ones (2 cycles
+//              at least), and with a gap longer than the refresh period the
+//              triggers during the gap are skipped, so the conversions are two
+//              periods apart.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "VCO_decoder.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// The counter trigger fires every REFRESH_CYCLES + 1 cycles
+#define REFRESH_CYCLES 999
+#define REFRESH_PERIOD (REFRESH_CYCLES + 1)
+
+// Polling bound, well above the refresh periods waited for
+#define POLL_LIMIT 100000
+
+// Timestamp of a single-tap conversion, the phase reference of the triggers
+static uint32_t ts_ref;
+
+// Read the timestamps of two consecutive conversions with the given gap. The
+// FIFO is drained first, and its first entry is discarded, so that no entry
+// of the previous mode is taken.
+static int read_pair(uint32_t gap_cycles, uint32_t *ts_a, uint32_t *ts_b) {
+    VCO_set_double_tap(0);
+    VCO_set_double_tap(gap_cycles);
+    while (VCO_get_fifo_level() != 0) {
+        VCO_fifo_read();
+        VCO_fifo_read();
+    }
+    for (uint32_t i = 0; VCO_get_fifo_level() < 3; i++) {
+        if (i >= POLL_LIMIT) return -1;
+    }
+    VCO_fifo_read();
+    VCO_fifo_read();
+    VCO_fifo_read();
+    *ts_a = VCO_fifo_read();
+    VCO_fifo_read();
+    *ts_b = VCO_fifo_read();
+    PRINTF("Gap %u: conversions at %u and %u\n", gap_cycles, *ts_a, *ts_b);
+    return 0;
+}
+
+// Check that the conversions with the given gap are period cycles apart, and
+// offset cycles after the single-tap ones (modulo the refresh period)
+static int check_gap(uint32_t gap_cycles, uint32_t period, uint32_t offset) {
+    uint32_t ts_a, ts_b;
+    if (read_pair(gap_cycles, &ts_a, &ts_b) != 0) return -1;
+    if (ts_b - ts_a != period) return -1;
+    if ((ts_b - ts_ref) % REFRESH_PERIOD != offset) return -1;
+    return 0;
+}
+
+int main() {
+    // VCOp only, so that every count is positive
+    VCOp_enable(true);
+    VCOn_enable(false);
+    VCO_set_refresh_rate(REFRESH_CYCLES);
+    VCO_fifo_enable(true, true);
+
+    // Single tap: one conversion per trigger
+    uint32_t ts_a;
+    if (read_pair(0, &ts_a, &ts_ref) != 0) return 1;
+    if (ts_ref - ts_a != REFRESH_PERIOD) return 2;
+
+    // Double tap: the conversion is the second refresh, gap cycles later
+    if (check_gap(100, REFRESH_PERIOD, 100) != 0) return 3;
+    if (check_gap(2, REFRESH_PERIOD, 2) != 0) return 4;
+
+    // The gap is at least 2 cycles
+    if (check_gap(1, REFRESH_PERIOD, 2) != 0) return 5;
+
+    // A gap of one period: the second refresh is the next trigger
+    if (check_gap(REFRESH_PERIOD, REFRESH_PERIOD, 0) != 0) return 6;
+
+    // A gap longer than the period: the trigger during the gap is skipped
+    if (check_gap(REFRESH_PERIOD + 5, 2 * REFRESH_PERIOD, 5) != 0) return 7;
+
+    VCO_set_double_tap(0);
+    VCO_fifo_enable(false, false);
+    VCO_set_refresh_rate(0);
+    VCOp_enable(false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
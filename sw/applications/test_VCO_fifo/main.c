@@ -0,0 +1,163 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_VCO_fifo/main.c
+// Description: Test of the sample FIFO of the VCO decoder: the TIMESTAMP
+//              register, the timestamps of the FIFO entries (one refresh
+//              period apart), the watermark DMA trigger (the DMA does not read
+//              the FIFO before it holds FIFO_WATERMARK entries) and the
+//              overflow counter.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "VCO_decoder.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// DMA channel of the VCO decoder trigger (external rx slot 0)
+#define ADC_DMA 0
+
+// The counter trigger fires every REFRESH_CYCLES + 1 cycles
+#define REFRESH_CYCLES 999
+#define REFRESH_PERIOD (REFRESH_CYCLES + 1)
+
+// Depth of the sample FIFO (FIFO_DEPTH parameter of vco_decoder)
+#define FIFO_DEPTH 16
+
+#define NUM_ENTRIES 4
+#define WATERMARK 4
+#define DMA_WORDS (2 * WATERMARK)
+#define EMPTY_WORD 0xdeadbeef
+
+// Polling bound, well above the refresh periods waited for
+#define POLL_LIMIT 100000
+
+static uint32_t dma_results[DMA_WORDS];
+
+static dma_target_t adc_tgt_src;
+static dma_target_t adc_tgt_dst;
+static dma_trans_t adc_trans;
+
+// Wait until the FIFO holds at least level entries
+static int wait_level(uint32_t level) {
+    for (uint32_t i = 0; i < POLL_LIMIT; i++) {
+        if (VCO_get_fifo_level() >= level) return 0;
+    }
+    return -1;
+}
+
+int main() {
+    // VCOp only, so that every count is positive
+    VCOp_enable(true);
+    VCOn_enable(false);
+    VCO_set_refresh_rate(REFRESH_CYCLES);
+
+    // TIMESTAMP counts the cycles since the FIFO was enabled
+    if (VCO_get_timestamp() != 0) return 1;
+    VCO_set_fifo_watermark(WATERMARK);
+    VCO_fifo_enable(true, true);
+    uint32_t ts0 = VCO_get_timestamp();
+    uint32_t ts1 = VCO_get_timestamp();
+    if (ts0 == 0 || ts1 <= ts0) return 2;
+
+    // Two-word entries: each count is followed by its timestamp, and the
+    // conversions are one refresh period apart
+    if (wait_level(NUM_ENTRIES) != 0) return 3;
+    uint32_t count[NUM_ENTRIES];
+    uint32_t ts[NUM_ENTRIES];
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        count[i] = VCO_fifo_read();
+        ts[i] = VCO_fifo_read();
+        PRINTF("Entry %d: count %u at %u\n", i, count[i], ts[i]);
+        if (count[i] == 0) return 4;
+        if (i > 0 && ts[i] - ts[i - 1] != REFRESH_PERIOD) return 5;
+    }
+    if (ts[NUM_ENTRIES - 1] >= VCO_get_timestamp()) return 6;
+
+    // Watermark trigger: the DMA reads the FIFO (one word per entry) only
+    // once it holds WATERMARK entries, and then drains it
+    VCO_fifo_enable(false, false);
+    VCO_clear_overflow_count();
+    for (int i = 0; i < DMA_WORDS; i++) dma_results[i] = EMPTY_WORD;
+
+    dma_init(NULL);
+
+    adc_tgt_src.ptr = (uint8_t *) (volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_DATA_REG_OFFSET);
+    adc_tgt_src.trig = DMA_TRIG_SLOT_EXT_RX;
+    adc_tgt_src.inc_d1_du = 0;
+    adc_tgt_src.type = DMA_DATA_TYPE_WORD;
+
+    adc_tgt_dst.ptr = (uint8_t *) dma_results;
+    adc_tgt_dst.inc_d1_du = 1;
+    adc_tgt_dst.trig = DMA_TRIG_MEMORY;
+    adc_tgt_dst.type = DMA_DATA_TYPE_WORD;
+
+    adc_trans.src = &adc_tgt_src;
+    adc_trans.dst = &adc_tgt_dst;
+    adc_trans.dim = DMA_DIM_CONF_1D;
+    adc_trans.channel = ADC_DMA;
+    adc_trans.size_d1_du = DMA_WORDS;
+    adc_trans.win_du = 0;
+    adc_trans.end = DMA_TRANS_END_POLLING;
+    adc_trans.mode = DMA_TRANS_MODE_SINGLE;
+
+    if (dma_validate_transaction(&adc_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK) return 7;
+    if (dma_load_transaction(&adc_trans) != DMA_CONFIG_OK) return 7;
+
+    // Enabled before the launch: with the FIFO disabled, every conversion
+    // triggers the DMA
+    VCO_fifo_enable(true, false);
+    if (dma_launch(&adc_trans) != DMA_CONFIG_OK) return 7;
+
+    // One entry below the watermark, for a whole refresh period
+    for (uint32_t i = 0; VCO_get_fifo_level() != WATERMARK - 1; i++) {
+        if (i >= POLL_LIMIT) return 8;
+    }
+    if (dma_results[0] != EMPTY_WORD) return 9;
+
+    for (uint32_t i = 0; !dma_is_ready(ADC_DMA); i++) {
+        if (i >= POLL_LIMIT) return 10;
+    }
+    for (int i = 0; i < DMA_WORDS; i++) {
+        PRINTF("DMA word %d: %u\n", i, dma_results[i]);
+        if (dma_results[i] == 0 || dma_results[i] == EMPTY_WORD) return 11;
+    }
+    if (VCO_get_overflow_count() != 0) return 12;
+
+    // Overflow: nobody reads the full FIFO, so the next conversions are
+    // dropped and counted
+    VCO_fifo_enable(false, false);
+    VCO_fifo_enable(true, false);
+    if (wait_level(FIFO_DEPTH) != 0) return 13;
+    for (uint32_t i = 0; VCO_get_overflow_count() < 2; i++) {
+        if (i >= POLL_LIMIT) return 14;
+    }
+    if (VCO_get_fifo_level() != FIFO_DEPTH) return 15;
+    VCO_clear_overflow_count();
+    if (VCO_get_overflow_count() > 1) return 16;
+
+    // Disabling the FIFO flushes it and stops the timestamp counter
+    VCO_fifo_enable(false, false);
+    if (VCO_get_fifo_level() != 0 || VCO_get_timestamp() != 0) return 17;
+
+    VCO_set_refresh_rate(0);
+    VCOp_enable(false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
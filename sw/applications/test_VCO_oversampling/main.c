@@ -0,0 +1,100 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_VCO_oversampling/main.c
+// Description: Test of the accumulate-and-dump oversampling of the VCO
+//              decoder. The conversions are triggered manually and each VCOp
+//              count is recomputed from the coarse and fine outputs
+//              (VCO_decode). A single conversion must update the count
+//              register; with OVERSAMPLING.COUNT = M, the register must hold
+//              its value over M - 1 conversions and then take the sum of the
+//              last M counts, shifted right by OVERSAMPLING.SHIFT.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "VCO_decoder.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// The counter trigger does not shift the train with a zero limit, so the
+// manual trigger needs a refresh period longer than the whole test
+#define REFRESH_CYCLES 0x7fffffff
+
+// Cycles between two manual conversions (at least the refresh train)
+#define CONVERSION_WAIT 200
+
+// Decoder state of VCOp
+static vco_decode_state_t vcop_state;
+
+// Trigger one conversion and return its VCOp count
+static uint32_t convert(void) {
+    VCO_trigger();
+    for (int i = 0; i < CONVERSION_WAIT; i++) {
+        asm volatile ("nop");
+    }
+    return VCO_decode(&vcop_state, VCOp_get_coarse(), VCOp_get_fine());
+}
+
+// Check M conversions with oversampling: the count register only changes on
+// the last one, to the shifted sum
+static int check_oversampling(uint32_t m, uint32_t shift) {
+    VCO_set_oversampling(m, shift);
+    uint32_t held = VCO_get_count();
+    uint32_t sum = 0;
+    for (uint32_t k = 0; k < m; k++) {
+        sum += convert();
+        if (k + 1 < m && VCO_get_count() != held) return -1;
+    }
+    uint32_t expected = (uint32_t)((int32_t)sum >> shift);
+    PRINTF("M=%u SHIFT=%u: %u (expected %u)\n", m, shift, VCO_get_count(), expected);
+    return VCO_get_count() == expected ? 0 : -1;
+}
+
+int main() {
+    // VCOp only: the output sample is its count
+    VCOp_enable(true);
+    VCOn_enable(false);
+    VCO_set_refresh_rate(REFRESH_CYCLES);
+    VCO_set_oversampling(0, 0);
+
+    // First conversion, to load the decoder state
+    convert();
+
+    // Without oversampling, every conversion updates the count
+    for (int k = 0; k < 3; k++) {
+        uint32_t count = convert();
+        PRINTF("Single conversion: %u (expected %u)\n", VCO_get_count(), count);
+        if (count == 0) return 1;
+        if (VCO_get_count() != count) return 2;
+    }
+
+    // Accumulate-and-dump: sum only, averaging and a partial shift
+    if (check_oversampling(3, 0) != 0) return 3;
+    if (check_oversampling(4, 2) != 0) return 4;
+    if (check_oversampling(8, 1) != 0) return 5;
+
+    // Back to single conversions
+    VCO_set_oversampling(1, 0);
+    uint32_t count = convert();
+    if (VCO_get_count() != count) return 6;
+
+    VCO_set_refresh_rate(0);
+    VCOp_enable(false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_VCO_packing/main.c
+// Description: Test of the dual-channel output of the VCO decoder. The
+//              conversions are triggered manually and the count of each VCO is
+//              recomputed from its coarse and fine outputs (VCO_decode). Each
+//              output sample is read both from the count register and from
+//              FIFO_DATA: without packing it is the difference of the counts;
+//              packed, it holds the P count in bits 15:0 and the N count in
+//              bits 31:16, clamped to the field, with the channel in the MSB
+//              of each field when tagged, and a zero N field while VCOn is
+//              disabled.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "VCO_decoder.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// The counter trigger does not shift the train with a zero limit, so the
+// manual trigger needs a refresh period longer than the whole test
+#define REFRESH_CYCLES 0x7fffffff
+
+// Cycles between two manual conversions (at least the refresh train)
+#define CONVERSION_WAIT 200
+
+// Decoder state of each VCO (0: P, 1: N)
+static vco_decode_state_t vco_state[2];
+
+// Trigger one conversion and return the count of each VCO
+static void convert(uint32_t *p_count, uint32_t *n_count) {
+    VCO_trigger();
+    for (int i = 0; i < CONVERSION_WAIT; i++) {
+        asm volatile ("nop");
+    }
+    *p_count = VCO_decode(&vco_state[0], VCOp_get_coarse(), VCOp_get_fine());
+    *n_count = VCO_decode(&vco_state[1], VCOn_get_coarse(), VCOn_get_fine());
+}
+
+// Field of a packed sample: the count clamped to the field range
+static uint32_t field(uint32_t count, bool enabled, bool tag) {
+    uint32_t field_max = tag ? 0x7fff : 0xffff;
+    if (!enabled || (int32_t)count < 0) return 0;
+    return count > field_max ? field_max : count;
+}
+
+// Check the output sample of one conversion, in the count register and in
+// the FIFO
+static int check_sample(bool packing, bool tag, bool n_enabled) {
+    uint32_t p_count, n_count;
+    convert(&p_count, &n_count);
+    uint32_t expected;
+    if (packing) {
+        uint32_t p_field = field(p_count, true, tag);
+        uint32_t n_field = field(n_count, n_enabled, tag) | (tag ? 0x8000 : 0);
+        expected = (n_field << 16) | p_field;
+    } else {
+        expected = p_count - n_count;
+    }
+    PRINTF("P %u, N %u: sample 0x%08x (expected 0x%08x)\n", p_count, n_count, VCO_get_count(), expected);
+    if (p_count == 0) return -1;
+    if (VCO_get_count() != expected) return -1;
+    if (VCO_get_fifo_level() != 1) return -1;
+    if (VCO_fifo_read() != expected) return -1;
+    return 0;
+}
+
+int main() {
+    VCOp_enable(true);
+    VCOn_enable(true);
+    VCO_set_refresh_rate(REFRESH_CYCLES);
+    VCO_set_packing(false, false);
+
+    // First conversion, to load the decoder state
+    uint32_t p_count, n_count;
+    convert(&p_count, &n_count);
+
+    // One-word FIFO entries
+    VCO_fifo_enable(true, false);
+
+    // Difference of the counts
+    if (check_sample(false, false, true) != 0) return 1;
+
+    // P count in bits 15:0, N count in bits 31:16
+    VCO_set_packing(true, false);
+    if (check_sample(true, false, true) != 0) return 2;
+
+    // Channel tag: bit 15 is 0 and bit 31 is 1, with 15-bit counts
+    VCO_set_packing(true, true);
+    if (check_sample(true, true, true) != 0) return 3;
+    uint32_t sample = VCO_get_count();
+    if (VCO_PACKED_TAG(VCO_PACKED_P(sample)) != 0 || VCO_PACKED_TAG(VCO_PACKED_N(sample)) != 1) return 4;
+
+    // A disabled VCO has a zero field, still tagged
+    VCOn_enable(false);
+    if (check_sample(true, true, false) != 0) return 5;
+    if (VCO_PACKED_N(VCO_get_count()) != 0x8000) return 6;
+    VCO_set_packing(true, false);
+    if (check_sample(true, false, false) != 0) return 7;
+    if (VCO_PACKED_N(VCO_get_count()) != 0) return 8;
+
+    VCO_set_packing(false, false);
+    VCO_fifo_enable(false, false);
+    VCO_set_refresh_rate(0);
+    VCOp_enable(false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
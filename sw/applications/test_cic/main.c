@@ -32,6 +32,7 @@
 #include "pdm2pcm_regs.h"
 #include "mmio.h"
 #include "groundtruth.h"
+#include "params.h"
 #include "cheep.h"
 
 /* By default, printfs are activated for FPGA and disabled for simulation. */
@@ -54,13 +55,14 @@ int main(int argc, char *argv[])
     // Changed to reflect the new address in HEEPidermis
     mmio_region_t pdm2pcm_base_addr = mmio_region_from_addr((uintptr_t)CIC_START_ADDRESS);
 
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CLKDIVIDX_REG_OFFSET, 16); // need to be an even number
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMCIC_REG_OFFSET, 15); // Can be odd or even
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET, 0b1111);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_DELAY_COMB_REG_OFFSET, 1);
+    // Parameters of the ground truth (params.h, generated by the Makefile)
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CLKDIVIDX_REG_OFFSET, CIC_CLKDIVIDX); // need to be an even number
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMCIC_REG_OFFSET, CIC_DECIM_FACTOR); // Can be odd or even
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET, CIC_ACTIVATED_STAGES);
+    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CIC_DELAY_COMB_REG_OFFSET, CIC_DELAY_COMB);
     mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CONTROL_REG_OFFSET, 1);
 
-    int const COUNT = 5;
+    int const COUNT = CIC_OUTPUT_NUMBER;
 
     int count = 0;
     int finish = 0;
@@ -0,0 +1,12 @@
+// Generated by tb/models/ref_groundtruth.cpp (see the application Makefile)
+
+#ifndef PARAMS_H
+#define PARAMS_H
+
+#define CIC_DECIM_FACTOR 15
+#define CIC_ACTIVATED_STAGES 15
+#define CIC_DELAY_COMB 1
+#define CIC_OUTPUT_NUMBER 5
+#define CIC_CLKDIVIDX 16
+
+#endif
@@ -0,0 +1,122 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_iDAC_dds/main.c
+// Description: Test of the waveform generator of the iDAC controller. A known
+//              ramp is loaded into the waveform RAM and the generator is
+//              stepped with the manual trigger: each current code must be the
+//              sample at the phase of the channel, scaled, offset and clamped.
+//              Disabling a channel must clear its current code and restart it
+//              from the first sample.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "iDAC_ctrl.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define WAVE_SAMPLES IDAC_CTRL_WAVE_RAM_SIZE_WORDS
+
+// One waveform RAM entry per step, indexed by the 6 MSBs of the phase
+#define PHASE_STEP (1u << 26)
+
+// Channel 1: full ramp, down to the lower clamp
+#define FREQUENCY_1 1
+#define PHASE_1 0
+#define AMPLITUDE_1 255
+#define OFFSET_1 128
+
+// Channel 2: three entries per step from a quarter period, up to the upper clamp
+#define FREQUENCY_2 3
+#define PHASE_2 16
+#define AMPLITUDE_2 128
+#define OFFSET_2 200
+
+// Steps checked, more than one period
+#define NUM_STEPS 80
+
+// Cycles for a trigger to reach DDS_CURRENT
+#define STEP_WAIT 10
+
+static int8_t wave[WAVE_SAMPLES];
+
+// offset + sample * amplitude / 256, clamped to the iDAC range
+static uint8_t expected_current(uint32_t index, int32_t amplitude, int32_t offset) {
+    int32_t level = offset + ((wave[index % WAVE_SAMPLES] * amplitude) >> 8);
+    return level < 0 ? 0 : level > 255 ? 255 : level;
+}
+
+static void step(void) {
+    iDACs_trigger();
+    for (int i = 0; i < STEP_WAIT; i++) {
+        asm volatile ("nop");
+    }
+}
+
+int main() {
+    // Ramp over the whole sample range
+    for (int i = 0; i < WAVE_SAMPLES; i++) {
+        wave[i] = (int8_t)(4 * i - 128);
+    }
+    iDACs_dds_load_wave(wave);
+
+    // The generator is stepped by the manual trigger only
+    iDACs_set_refresh_rate(0);
+    iDAC1_dds_set_frequency(FREQUENCY_1 * PHASE_STEP);
+    iDAC2_dds_set_frequency(FREQUENCY_2 * PHASE_STEP);
+    iDAC1_dds_set_phase(PHASE_1 * PHASE_STEP);
+    iDAC2_dds_set_phase(PHASE_2 * PHASE_STEP);
+    iDAC1_dds_set_chirp(0);
+    iDAC2_dds_set_chirp(0);
+    iDACs_dds_set_levels(AMPLITUDE_1, OFFSET_1, AMPLITUDE_2, OFFSET_2);
+    iDACs_enable(true, true);
+    iDACs_dds_control(true, true, false, false);
+
+    // No sample before the first step
+    if (iDAC1_dds_get_current() != 0 || iDAC2_dds_get_current() != 0) return 1;
+
+    for (uint32_t k = 0; k < NUM_STEPS; k++) {
+        step();
+        uint8_t current_1 = expected_current(PHASE_1 + FREQUENCY_1 * k, AMPLITUDE_1, OFFSET_1);
+        uint8_t current_2 = expected_current(PHASE_2 + FREQUENCY_2 * k, AMPLITUDE_2, OFFSET_2);
+        PRINTF("Step %u: %u, %u (expected %u, %u)\n", k, iDAC1_dds_get_current(), iDAC2_dds_get_current(), current_1, current_2);
+        if (iDAC1_dds_get_current() != current_1) return 2;
+        if (iDAC2_dds_get_current() != current_2) return 3;
+    }
+
+    // Disabling channel 1 clears its current code, and channel 2 goes on
+    uint8_t current_2 = iDAC2_dds_get_current();
+    iDACs_dds_control(false, true, false, false);
+    for (int i = 0; i < STEP_WAIT; i++) {
+        asm volatile ("nop");
+    }
+    if (iDAC1_dds_get_current() != 0) return 4;
+    if (iDAC2_dds_get_current() != current_2) return 5;
+
+    // Enabled again, it restarts from the first sample
+    iDACs_dds_control(true, true, false, false);
+    if (iDAC1_dds_get_current() != 0) return 6;
+    step();
+    if (iDAC1_dds_get_current() != expected_current(PHASE_1, AMPLITUDE_1, OFFSET_1)) return 7;
+    if (iDAC2_dds_get_current() != expected_current(PHASE_2 + FREQUENCY_2 * NUM_STEPS, AMPLITUDE_2, OFFSET_2)) return 8;
+
+    iDACs_dds_control(false, false, false, false);
+    iDACs_enable(false, false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
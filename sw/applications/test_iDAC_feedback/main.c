@@ -0,0 +1,198 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_iDAC_feedback/main.c
+// Description: Test of the closed-loop current tracking of the iDAC controller.
+//              The DMA streams a ramp through the dLC, so that every sample is
+//              a level crossing, while the slew limit holds the steps: the
+//              first crossing is a step, and the pending count saturates at
+//              +-127, so exactly 128 steps are taken. The DMA records
+//              FEEDBACK_CODE on each step through the feedback trigger (DMA
+//              channel 1, RX slot), and each channel steps its own code from
+//              its CURRENT field, which a disabled channel follows.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "dlc.h"
+#include "iDAC_ctrl.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// DMA channel of the dLC hardware FIFO
+#define DLC_DMA 0
+// DMA channel of the iDAC feedback trigger (external rx slot 1)
+#define FEEDBACK_DMA 1
+
+// One crossing per sample: one level per LSB, 7-bit delta levels
+#define CROSSINGS 200
+#define DLVL_N_BITS 7
+#define DT_N_BITS 8
+
+// The first crossing is a step, and the next ones saturate the pending count
+#define PENDING_MAX 127
+#define STEPS (1 + PENDING_MAX)
+
+// Slew limit while the crossings are fed (longer than the whole ramp), and
+// while the pending steps are applied (longer than one DMA transfer)
+#define FEED_SLEW 10000
+#define DRAIN_SLEW 20
+
+// Polling bound, well above the transfers waited for
+#define POLL_LIMIT 100000
+
+// Cycles waited for a step that must not come
+#define SETTLE_WAIT (4 * (DRAIN_SLEW + 1) * PENDING_MAX)
+
+static int16_t ramp_up[CROSSINGS];
+static int16_t ramp_down[CROSSINGS];
+static int16_t dlc_results[CROSSINGS];
+static uint32_t codes[STEPS];
+
+static dma_target_t dlc_tgt_src;
+static dma_target_t dlc_tgt_dst;
+static dma_trans_t dlc_trans;
+
+static dma_target_t fb_tgt_src;
+static dma_target_t fb_tgt_dst;
+static dma_trans_t fb_trans;
+
+static int wait_dma(uint8_t channel) {
+    for (uint32_t i = 0; !dma_is_ready(channel); i++) {
+        if (i >= POLL_LIMIT) return -1;
+    }
+    return 0;
+}
+
+// Feed the samples through the dLC, starting from start_level, and check the
+// recorded FEEDBACK_CODE values against code_1 and code_2 (code_2 + 1 and
+// code_2 - 1 per step if step_2 is 1 and -1). Returns 0 or the failed check.
+static int run_ramp(const int16_t *samples, int16_t start_level, uint32_t code_1, int32_t step_1, uint32_t code_2, int32_t step_2) {
+    // Level crossing: every sample is one level away from the previous one
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_FORMAT_REG_OFFSET) = 1;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_LOG_LEVEL_WIDTH_REG_OFFSET) = 0;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_N_BITS_REG_OFFSET) = DLVL_N_BITS;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_MASK_REG_OFFSET) = (1 << DLVL_N_BITS) - 1;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DT_MASK_REG_OFFSET) = (1 << DT_N_BITS) - 1;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_HYSTERESIS_EN_REG_OFFSET) = 0;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DISCARD_BITS_REG_OFFSET) = 0;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_BYPASS_REG_OFFSET) = 0;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_CURR_LVL_REG_OFFSET) = (uint16_t)start_level;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_TRANS_SIZE_REG_OFFSET) = CROSSINGS;
+
+    // The feedback DMA records FEEDBACK_CODE on every step
+    fb_tgt_src.ptr = (uint8_t *) (volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET);
+    fb_tgt_src.trig = DMA_TRIG_SLOT_EXT_RX;
+    fb_tgt_src.inc_d1_du = 0;
+    fb_tgt_src.type = DMA_DATA_TYPE_WORD;
+
+    fb_tgt_dst.ptr = (uint8_t *) codes;
+    fb_tgt_dst.inc_d1_du = 1;
+    fb_tgt_dst.trig = DMA_TRIG_MEMORY;
+    fb_tgt_dst.type = DMA_DATA_TYPE_WORD;
+
+    fb_trans.src = &fb_tgt_src;
+    fb_trans.dst = &fb_tgt_dst;
+    fb_trans.dim = DMA_DIM_CONF_1D;
+    fb_trans.channel = FEEDBACK_DMA;
+    fb_trans.size_d1_du = STEPS;
+    fb_trans.win_du = 0;
+    fb_trans.end = DMA_TRANS_END_POLLING;
+    fb_trans.mode = DMA_TRANS_MODE_SINGLE;
+    fb_trans.hw_fifo_en = false;
+
+    if (dma_validate_transaction(&fb_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK) return 1;
+    if (dma_load_transaction(&fb_trans) != DMA_CONFIG_OK) return 1;
+    if (dma_launch(&fb_trans) != DMA_CONFIG_OK) return 1;
+
+    // The dLC DMA streams the samples through the hardware FIFO
+    dlc_tgt_src.ptr = (uint8_t *) samples;
+    dlc_tgt_src.trig = DMA_TRIG_MEMORY;
+    dlc_tgt_src.inc_d1_du = 1;
+    dlc_tgt_src.type = DMA_DATA_TYPE_HALF_WORD;
+
+    dlc_tgt_dst.ptr = (uint8_t *) dlc_results;
+    dlc_tgt_dst.inc_d1_du = 1;
+    dlc_tgt_dst.trig = DMA_TRIG_MEMORY;
+    dlc_tgt_dst.type = DMA_DATA_TYPE_HALF_WORD;
+
+    dlc_trans.src = &dlc_tgt_src;
+    dlc_trans.dst = &dlc_tgt_dst;
+    dlc_trans.dim = DMA_DIM_CONF_1D;
+    dlc_trans.channel = DLC_DMA;
+    dlc_trans.size_d1_du = CROSSINGS;
+    dlc_trans.win_du = 0;
+    dlc_trans.end = DMA_TRANS_END_POLLING;
+    dlc_trans.mode = DMA_TRANS_MODE_SINGLE;
+    dlc_trans.hw_fifo_en = true;
+
+    if (dma_validate_transaction(&dlc_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK) return 2;
+    if (dma_load_transaction(&dlc_trans) != DMA_CONFIG_OK) return 2;
+    if (dma_launch(&dlc_trans) != DMA_CONFIG_OK) return 2;
+    if (wait_dma(DLC_DMA) != 0) return 3;
+
+    // Only the first crossing has been applied; the pending steps are taken
+    // now, one per DRAIN_SLEW + 1 cycles
+    iDACs_feedback_config(1, 0, 255, DRAIN_SLEW);
+    if (wait_dma(FEEDBACK_DMA) != 0) return 4;
+    for (uint32_t k = 0; k < STEPS; k++) {
+        uint32_t expected = (code_1 + step_1 * (k + 1)) | ((code_2 + step_2 * (k + 1)) << IDAC_CTRL_FEEDBACK_CODE_CODE_2_OFFSET);
+        PRINTF("Step %u: 0x%04x (expected 0x%04x)\n", k, codes[k], expected);
+        if (codes[k] != expected) return 5;
+    }
+
+    // The crossings beyond the saturation are lost: no more steps
+    for (int i = 0; i < SETTLE_WAIT; i++) {
+        asm volatile ("nop");
+    }
+    if (*(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET) != codes[STEPS - 1]) return 6;
+    return 0;
+}
+
+int main() {
+    for (int i = 0; i < CROSSINGS; i++) {
+        ramp_up[i] = i + 1;
+        ramp_down[i] = CROSSINGS - 1 - i;
+    }
+
+    dma_init(NULL);
+    iDACs_enable(true, true);
+
+    // Upward crossings, both loops from their own CURRENT field
+    iDACs_set_currents(10, 50);
+    iDACs_feedback_config(1, 0, 255, FEED_SLEW);
+    iDACs_feedback_control(true, true, false);
+    if (iDAC1_feedback_get_code() != 10 || iDAC2_feedback_get_code() != 50) return 1;
+    int err = run_ramp(ramp_up, 0, 10, 1, 50, 1);
+    if (err != 0) return 1 + err;
+    if (iDAC1_feedback_get_code() != 10 + STEPS || iDAC2_feedback_get_code() != 50 + STEPS) return 8;
+
+    // Downward crossings, loop 2 only: the code of iDAC 1 follows CURRENT
+    iDACs_feedback_control(false, false, false);
+    iDACs_set_currents(30, 250);
+    iDACs_feedback_config(1, 0, 255, FEED_SLEW);
+    iDACs_feedback_control(false, true, false);
+    err = run_ramp(ramp_down, CROSSINGS, 30, 0, 250, -1);
+    if (err != 0) return 10 + err;
+    if (iDAC1_feedback_get_code() != 30 || iDAC2_feedback_get_code() != 250 - STEPS) return 17;
+
+    iDACs_feedback_control(false, false, false);
+    iDACs_enable(false, false);
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
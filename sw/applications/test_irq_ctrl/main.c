@@ -0,0 +1,264 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: test_irq_ctrl/main.c
+// Description: Test of the peripheral interrupt controller. Each of the five
+//              sources (SES and CIC outputs, VCO counter overflow, iDAC
+//              refresh and end of a dLC transaction) is raised by its own
+//              peripheral while it is disabled in INTR_ENABLE: it must be
+//              pending without reaching the CPU, and be cleared only by a
+//              write 1 to its own INTR_STATE bit. Raised again, it must call
+//              its handler as soon as it is enabled. Finally, the CPU sleeps
+//              in wfi until a periodic iDAC refresh wakes it up. On a failure,
+//              the exit code is 10 * (source + 1) + the failed step, or 60 +
+//              the failed step of the wake-up.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "cheep.h"
+#include "csr.h"
+#include "hart.h"
+#include "dlc.h"
+#include "pdm2pcm_regs.h"
+#include "ext_irq.h"
+#include "IRQ_ctrl.h"
+#include "SES_filter.h"
+#include "VCO_decoder.h"
+#include "iDAC_ctrl.h"
+
+#define PRINTF_IN_SIM 0
+#define PRINTF_IN_FPGA 1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif PRINTF_IN_FPGA && !TARGET_SIM
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// Polling bound, well above the time to the first output of the filters
+#define POLL_LIMIT 200000
+
+// Cycles for the last event of a stopped source to reach INTR_STATE, and for
+// an enabled source to reach its handler
+#define SETTLE_WAIT 100
+
+// VCO counter overflow every VCO_COUNTER_LIMIT + 1 rising edges of VCOp
+#define VCO_COUNTER_LIMIT 10
+
+// dLC transaction of a few samples
+#define DLC_SAMPLES 4
+
+// Period of the iDAC refresh that wakes up the CPU
+#define WAKEUP_CYCLES 5000
+
+// mstatus.MIE
+#define MSTATUS_MIE 0x8
+
+static volatile uint32_t irq_count[IRQ_CTRL_NUM_SOURCES];
+
+static void ses_handler(void) { irq_count[IRQ_CTRL_SRC_SES_DATA_VALID]++; }
+static void cic_handler(void) { irq_count[IRQ_CTRL_SRC_CIC_DATA_VALID]++; }
+static void vco_handler(void) { irq_count[IRQ_CTRL_SRC_VCO_OVERFLOW]++; }
+static void idac_handler(void) { irq_count[IRQ_CTRL_SRC_IDAC_REFRESH]++; }
+static void dlc_handler(void) { irq_count[IRQ_CTRL_SRC_DLC_DONE]++; }
+
+static const ext_irq_handler_t handlers[IRQ_CTRL_NUM_SOURCES] = {
+    [IRQ_CTRL_SRC_SES_DATA_VALID] = ses_handler,
+    [IRQ_CTRL_SRC_CIC_DATA_VALID] = cic_handler,
+    [IRQ_CTRL_SRC_VCO_OVERFLOW]   = vco_handler,
+    [IRQ_CTRL_SRC_IDAC_REFRESH]   = idac_handler,
+    [IRQ_CTRL_SRC_DLC_DONE]       = dlc_handler,
+};
+
+static int16_t dlc_samples[DLC_SAMPLES] = {1, 2, 3, 4};
+static int16_t dlc_results[DLC_SAMPLES];
+
+static dma_target_t dlc_tgt_src;
+static dma_target_t dlc_tgt_dst;
+static dma_trans_t dlc_trans;
+
+static void wait_cycles(uint32_t cycles) {
+    for (uint32_t i = 0; i < cycles; i++) {
+        asm volatile ("nop");
+    }
+}
+
+// Feed a few samples through the dLC: its transaction ends with the DMA one
+static int run_dlc(void) {
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_FORMAT_REG_OFFSET) = 1;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_N_BITS_REG_OFFSET) = 7;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DLVL_MASK_REG_OFFSET) = 0x7f;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_DT_MASK_REG_OFFSET) = 0xff;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_CURR_LVL_REG_OFFSET) = 0;
+    *(volatile uint32_t *)(DLC_START_ADDRESS + DLC_TRANS_SIZE_REG_OFFSET) = DLC_SAMPLES;
+
+    dlc_tgt_src.ptr = (uint8_t *) dlc_samples;
+    dlc_tgt_src.trig = DMA_TRIG_MEMORY;
+    dlc_tgt_src.inc_d1_du = 1;
+    dlc_tgt_src.type = DMA_DATA_TYPE_HALF_WORD;
+
+    dlc_tgt_dst.ptr = (uint8_t *) dlc_results;
+    dlc_tgt_dst.inc_d1_du = 1;
+    dlc_tgt_dst.trig = DMA_TRIG_MEMORY;
+    dlc_tgt_dst.type = DMA_DATA_TYPE_HALF_WORD;
+
+    dlc_trans.src = &dlc_tgt_src;
+    dlc_trans.dst = &dlc_tgt_dst;
+    dlc_trans.dim = DMA_DIM_CONF_1D;
+    dlc_trans.channel = 0;
+    dlc_trans.size_d1_du = DLC_SAMPLES;
+    dlc_trans.win_du = 0;
+    dlc_trans.end = DMA_TRANS_END_POLLING;
+    dlc_trans.mode = DMA_TRANS_MODE_SINGLE;
+    dlc_trans.hw_fifo_en = true;
+
+    if (dma_validate_transaction(&dlc_trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK) return -1;
+    if (dma_load_transaction(&dlc_trans) != DMA_CONFIG_OK) return -1;
+    if (dma_launch(&dlc_trans) != DMA_CONFIG_OK) return -1;
+    for (uint32_t i = 0; !dma_is_ready(0); i++) {
+        if (i >= POLL_LIMIT) return -1;
+    }
+    return 0;
+}
+
+// Start the peripheral of a source
+static int start_source(uint32_t source) {
+    switch (source) {
+        case IRQ_CTRL_SRC_SES_DATA_VALID:
+            SES_set_window_size(4);
+            SES_set_decim_factor(32);
+            SES_set_sysclk_division(128);
+            SES_set_activated_stages(63);
+            for (uint8_t stage = 0; stage < 6; stage++) {
+                SES_set_gain(stage, 2);
+            }
+            SES_set_control_reg(true);
+            return 0;
+        case IRQ_CTRL_SRC_CIC_DATA_VALID:
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_CLKDIVIDX_REG_OFFSET) = 16;
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_DECIMCIC_REG_OFFSET) = 15;
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET) = 15;
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_CIC_DELAY_COMB_REG_OFFSET) = 1;
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_CONTROL_REG_OFFSET) = 1;
+            return 0;
+        case IRQ_CTRL_SRC_VCO_OVERFLOW:
+            VCO_set_counter_limit(VCO_COUNTER_LIMIT);
+            VCOp_enable(true);
+            return 0;
+        case IRQ_CTRL_SRC_IDAC_REFRESH:
+            // One refresh pulse
+            iDACs_trigger();
+            return 0;
+        case IRQ_CTRL_SRC_DLC_DONE:
+            return run_dlc();
+        default:
+            return -1;
+    }
+}
+
+// Stop the peripheral of a source, so that it raises no more events
+static void stop_source(uint32_t source) {
+    switch (source) {
+        case IRQ_CTRL_SRC_SES_DATA_VALID:
+            SES_set_control_reg(false);
+            break;
+        case IRQ_CTRL_SRC_CIC_DATA_VALID:
+            *(volatile uint32_t *)(CIC_START_ADDRESS + PDM2PCM_CONTROL_REG_OFFSET) = 0;
+            break;
+        case IRQ_CTRL_SRC_VCO_OVERFLOW:
+            VCOp_enable(false);
+            break;
+        default:
+            break;
+    }
+}
+
+// Raise the event of a source once and wait until it is pending
+static int raise_event(uint32_t source) {
+    if (start_source(source) != 0) return -1;
+    for (uint32_t i = 0; !(IRQ_ctrl_get_pending() & (1 << source)); i++) {
+        if (i >= POLL_LIMIT) return -1;
+    }
+    stop_source(source);
+    wait_cycles(SETTLE_WAIT);
+    return 0;
+}
+
+// Check the pending bit, the write 1 to clear and the enable of one source.
+// Returns 0 or the failed step.
+static int check_source(uint32_t source) {
+    uint32_t bit = 1 << source;
+    uint32_t others = ((1 << IRQ_CTRL_NUM_SOURCES) - 1) & ~bit;
+
+    // Routed to its handler, but disabled in the controller
+    irq_count[source] = 0;
+    if (ext_irq_enable(source, handlers[source]) != 0) return 1;
+    IRQ_ctrl_enable(source, false);
+    if (IRQ_ctrl_get_enabled() & bit) return 1;
+
+    // Pending, without reaching the CPU
+    if (raise_event(source) != 0) return 2;
+    PRINTF("Source %u: pending 0x%02x, %u interrupts\n", source, IRQ_ctrl_get_pending(), irq_count[source]);
+    if (irq_count[source] != 0) return 3;
+
+    // Writing 0, or 1 to the other bits, keeps it pending; writing 1 to its
+    // own bit clears it
+    IRQ_ctrl_clear(0);
+    IRQ_ctrl_clear(others);
+    if (!(IRQ_ctrl_get_pending() & bit)) return 4;
+    IRQ_ctrl_clear(bit);
+    if (IRQ_ctrl_get_pending() & bit) return 4;
+
+    // Pending again: enabling it calls the handler once, which clears it
+    if (raise_event(source) != 0) return 5;
+    if (irq_count[source] != 0) return 5;
+    IRQ_ctrl_enable(source, true);
+    wait_cycles(SETTLE_WAIT);
+    PRINTF("Source %u enabled: pending 0x%02x, %u interrupts\n", source, IRQ_ctrl_get_pending(), irq_count[source]);
+    if (irq_count[source] != 1) return 6;
+    if (IRQ_ctrl_get_pending() & bit) return 6;
+
+    if (ext_irq_disable(source) != 0) return 7;
+    return 0;
+}
+
+int main() {
+    dma_init(NULL);
+    if (ext_irq_init() != 0) return 1;
+    CSR_SET_BITS(CSR_REG_MSTATUS, MSTATUS_MIE);
+
+    // Every source starts disabled and cleared
+    if (IRQ_ctrl_get_enabled() != 0 || IRQ_ctrl_get_pending() != 0) return 2;
+
+    iDACs_set_refresh_rate(0);
+    for (uint32_t source = 0; source < IRQ_CTRL_NUM_SOURCES; source++) {
+        int err = check_source(source);
+        if (err != 0) return 10 * (source + 1) + err;
+    }
+
+    // Wake-up: with mstatus.MIE cleared, the CPU sleeps until the iDAC
+    // refresh is pending, and takes the interrupt once MIE is set again
+    irq_count[IRQ_CTRL_SRC_IDAC_REFRESH] = 0;
+    if (ext_irq_enable(IRQ_CTRL_SRC_IDAC_REFRESH, idac_handler) != 0) return 61;
+    iDACs_set_refresh_rate(WAKEUP_CYCLES);
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, MSTATUS_MIE);
+    if (irq_count[IRQ_CTRL_SRC_IDAC_REFRESH] != 0) return 62;
+    wait_for_interrupt();
+    if (!(IRQ_ctrl_get_pending() & (1 << IRQ_CTRL_SRC_IDAC_REFRESH))) return 63;
+    CSR_SET_BITS(CSR_REG_MSTATUS, MSTATUS_MIE);
+    iDACs_set_refresh_rate(0);
+    wait_cycles(SETTLE_WAIT);
+    PRINTF("Wake-up: %u interrupts\n", irq_count[IRQ_CTRL_SRC_IDAC_REFRESH]);
+    if (irq_count[IRQ_CTRL_SRC_IDAC_REFRESH] != 1) return 64;
+    if (ext_irq_disable(IRQ_CTRL_SRC_IDAC_REFRESH) != 0) return 65;
+
+    PRINTF("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+// Copyright 2025 EPFL contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Description: Drivers for the peripheral interrupt controller. Each source
+//              is pending from the rising edge of its event until it is
+//              cleared, and an enabled pending source drives its PLIC line
+//              (EXT_INTR_0 + source, see ext_irq.h).
+
+#ifndef IRQ_CTRL_H
+#define IRQ_CTRL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "IRQ_ctrl_regs.h"
+#include "cheep.h"
+
+// Interrupt sources (bit of INTR_STATE and INTR_ENABLE)
+#define IRQ_CTRL_SRC_SES_DATA_VALID IRQ_CTRL_INTR_STATE_SES_DATA_VALID_BIT
+#define IRQ_CTRL_SRC_CIC_DATA_VALID IRQ_CTRL_INTR_STATE_CIC_DATA_VALID_BIT
+#define IRQ_CTRL_SRC_VCO_OVERFLOW   IRQ_CTRL_INTR_STATE_VCO_OVERFLOW_BIT
+#define IRQ_CTRL_SRC_IDAC_REFRESH   IRQ_CTRL_INTR_STATE_IDAC_REFRESH_BIT
+#define IRQ_CTRL_SRC_DLC_DONE       IRQ_CTRL_INTR_STATE_DLC_DONE_BIT
+
+// Number of interrupt sources
+#define IRQ_CTRL_NUM_SOURCES 5
+
+/**
+* @brief Enable/disable an interrupt source.
+*
+* @param source Interrupt source (IRQ_CTRL_SRC_*).
+* @param enable enable=true to enable the source, enable=false to disable it.
+*/
+static inline void IRQ_ctrl_enable(uint32_t source, bool enable) {
+    // Reset the enable bit to 0 and then set it to the new value
+    *(volatile uint32_t *)(IRQ_CTRL_START_ADDRESS + IRQ_CTRL_INTR_ENABLE_REG_OFFSET) &= ~((uint32_t)1 << source);
+    *(volatile uint32_t *)(IRQ_CTRL_START_ADDRESS + IRQ_CTRL_INTR_ENABLE_REG_OFFSET) |= (uint32_t) enable << source;
+}
+
+/**
+* @brief Get the enabled interrupt sources (one bit per source).
+*/
+static inline uint32_t IRQ_ctrl_get_enabled() {
+    return *(volatile uint32_t *)(IRQ_CTRL_START_ADDRESS + IRQ_CTRL_INTR_ENABLE_REG_OFFSET);
+}
+
+/**
+* @brief Get the pending interrupt sources (one bit per source), enabled or not.
+*/
+static inline uint32_t IRQ_ctrl_get_pending() {
+    return *(volatile uint32_t *)(IRQ_CTRL_START_ADDRESS + IRQ_CTRL_INTR_STATE_REG_OFFSET);
+}
+
+/**
+* @brief Clear pending interrupt sources.
+*
+* @param mask Sources to clear (one bit per source).
+*/
+static inline void IRQ_ctrl_clear(uint32_t mask) {
+    *(volatile uint32_t *)(IRQ_CTRL_START_ADDRESS + IRQ_CTRL_INTR_STATE_REG_OFFSET) = mask;
+}
+
+#endif // IRQ_CTRL_H
@@ -0,0 +1,41 @@
+// Generated register defines for IRQ_ctrl
+
+// Copyright information found in source file:
+// Copyright 2025 EPFL contributors
+
+// Licensing information found in source file:
+// 
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#ifndef _IRQ_CTRL_REG_DEFS_
+#define _IRQ_CTRL_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define IRQ_CTRL_PARAM_REG_WIDTH 32
+
+// Pending interrupts, set on the rising edge of their event (write 1 to
+// clear)
+#define IRQ_CTRL_INTR_STATE_REG_OFFSET 0x0
+#define IRQ_CTRL_INTR_STATE_SES_DATA_VALID_BIT 0
+#define IRQ_CTRL_INTR_STATE_CIC_DATA_VALID_BIT 1
+#define IRQ_CTRL_INTR_STATE_VCO_OVERFLOW_BIT 2
+#define IRQ_CTRL_INTR_STATE_IDAC_REFRESH_BIT 3
+#define IRQ_CTRL_INTR_STATE_DLC_DONE_BIT 4
+
+// Interrupt enables (an enabled pending interrupt drives its external
+// interrupt line)
+#define IRQ_CTRL_INTR_ENABLE_REG_OFFSET 0x4
+#define IRQ_CTRL_INTR_ENABLE_SES_DATA_VALID_BIT 0
+#define IRQ_CTRL_INTR_ENABLE_CIC_DATA_VALID_BIT 1
+#define IRQ_CTRL_INTR_ENABLE_VCO_OVERFLOW_BIT 2
+#define IRQ_CTRL_INTR_ENABLE_IDAC_REFRESH_BIT 3
+#define IRQ_CTRL_INTR_ENABLE_DLC_DONE_BIT 4
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _IRQ_CTRL_REG_DEFS_
+// End generated register defines for IRQ_ctrl
\ No newline at end of file
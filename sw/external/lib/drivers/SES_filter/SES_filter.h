@@ -14,6 +14,12 @@
 #include "SES_filter_regs.h"
 #include "cheep.h"
 
+// Bits of the status register
+#define SES_STATUS_ACTIVE_BIT       0
+#define SES_STATUS_DATA_VALID_BIT   1
+#define SES_STATUS_WATERMARK_BIT    2
+#define SES_STATUS_OVERFLOW_BIT     3
+
 /*
 * @brief Set the control register.
 * 
@@ -26,7 +32,7 @@ static inline void SES_set_control_reg(bool control){
 }
 
 /*
-* @brief Get the status of the SES filter ({Data valid, Control}).
+* @brief Get the status of the SES filter ({Overflow, Watermark, Data valid, Control}).
 */
 static inline uint32_t SES_get_status() {
     return *(volatile uint32_t *)(SES_FILTER_START_ADDRESS + SES_FILTER_SES_STATUS_REG_OFFSET) & 
@@ -88,6 +94,38 @@ static inline void SES_set_gain(uint8_t stage, uint32_t gain) {
     }
 }
 
+/*
+* @brief Get the number of filtered outputs in the output FIFO.
+*/
+static inline uint32_t SES_get_fifo_level() {
+    return *(volatile uint32_t *)(SES_FILTER_START_ADDRESS + SES_FILTER_SES_FIFO_LEVEL_REG_OFFSET) &
+            SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_MASK;
+}
+
+/*
+* @brief Set the output FIFO watermark.
+* 
+* @param watermark FIFO level that raises the DMA trigger (0 or 1: on every output).
+*/
+static inline void SES_set_fifo_watermark(uint32_t watermark) {
+    *(volatile uint32_t *)(SES_FILTER_START_ADDRESS + SES_FILTER_SES_FIFO_WATERMARK_REG_OFFSET) = watermark;
+}
+
+/*
+* @brief Get the number of filtered outputs dropped because the output FIFO was full.
+*/
+static inline uint32_t SES_get_overflow_count() {
+    return *(volatile uint32_t *)(SES_FILTER_START_ADDRESS + SES_FILTER_SES_FIFO_OVERFLOW_REG_OFFSET) &
+            SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_MASK;
+}
+
+/*
+* @brief Clear the count of dropped outputs.
+*/
+static inline void SES_clear_overflow_count() {
+    *(volatile uint32_t *)(SES_FILTER_START_ADDRESS + SES_FILTER_SES_FIFO_OVERFLOW_REG_OFFSET) = 0;
+}
+
 /*
 * @brief Get the SES filtered output.
 */
@@ -20,9 +20,10 @@ extern "C" {
 #define SES_FILTER_SES_CONTROL_REG_OFFSET 0x0
 #define SES_FILTER_SES_CONTROL_SES_CONTROL_BIT 0
 
-// status register of the SES filter
+// status register of the SES filter ({overflow, watermark, data valid,
+// control})
 #define SES_FILTER_SES_STATUS_REG_OFFSET 0x4
-#define SES_FILTER_SES_STATUS_SES_STATUS_MASK 0x3
+#define SES_FILTER_SES_STATUS_SES_STATUS_MASK 0xf
 #define SES_FILTER_SES_STATUS_SES_STATUS_OFFSET 0
 #define SES_FILTER_SES_STATUS_SES_STATUS_FIELD \
   ((bitfield_field32_t) { .mask = SES_FILTER_SES_STATUS_SES_STATUS_MASK, .index = SES_FILTER_SES_STATUS_SES_STATUS_OFFSET })
@@ -83,8 +84,31 @@ extern "C" {
 #define SES_FILTER_SES_GAIN_STAGE_GAIN_STG_5_FIELD \
   ((bitfield_field32_t) { .mask = SES_FILTER_SES_GAIN_STAGE_GAIN_STG_5_MASK, .index = SES_FILTER_SES_GAIN_STAGE_GAIN_STG_5_OFFSET })
 
+// Number of filtered outputs in the output FIFO
+#define SES_FILTER_SES_FIFO_LEVEL_REG_OFFSET 0x1c
+#define SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_MASK 0xff
+#define SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_OFFSET 0
+#define SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_FIELD \
+  ((bitfield_field32_t) { .mask = SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_MASK, .index = SES_FILTER_SES_FIFO_LEVEL_SES_FIFO_LEVEL_OFFSET })
+
+// Output FIFO level that raises the DMA trigger, which then stays high until
+// the FIFO is empty (0 and 1: raised while the FIFO is not empty)
+#define SES_FILTER_SES_FIFO_WATERMARK_REG_OFFSET 0x20
+#define SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_MASK 0xff
+#define SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_OFFSET 0
+#define SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_FIELD \
+  ((bitfield_field32_t) { .mask = SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_MASK, .index = SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_OFFSET })
+
+// Number of filtered outputs dropped because the output FIFO was full
+// (saturating, write 0 to clear)
+#define SES_FILTER_SES_FIFO_OVERFLOW_REG_OFFSET 0x24
+#define SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_MASK 0xffff
+#define SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_OFFSET 0
+#define SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_FIELD \
+  ((bitfield_field32_t) { .mask = SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_MASK, .index = SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_OFFSET })
+
 // Memory area: Filtered output
-#define SES_FILTER_RX_DATA_REG_OFFSET 0x1c
+#define SES_FILTER_RX_DATA_REG_OFFSET 0x28
 #define SES_FILTER_RX_DATA_SIZE_WORDS 1
 #define SES_FILTER_RX_DATA_SIZE_BYTES 4
 #ifdef __cplusplus
@@ -115,6 +115,150 @@ static inline void VCO_set_manual_refresh_train(uint8_t train_id, uint32_t value
     }
 }
 
+/**
+* @brief Set the double-tap measurement mode. Each refresh trigger refreshes the
+* VCOs twice, gap_cycles apart, and the count of the second refresh (the
+* oscillations during the gap) is the conversion result. The triggers during
+* the gap are skipped, so a gap longer than the refresh period lowers the
+* conversion rate to one every ceil(gap_cycles / period) periods.
+* 
+* @param gap_cycles Cycles between the two refreshes (0: single tap, at least 2 otherwise; 1 acts as 2).
+*/
+static inline void VCO_set_double_tap(uint32_t gap_cycles) {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_DOUBLE_TAP_GAP_REG_OFFSET) = gap_cycles;
+}
+
+/**
+* @brief Set the oversampling of the decoder count. Each output sample (count
+* register, DMA trigger and sample FIFO) is the sum of num_conversions consecutive
+* conversions, shifted right by shift.
+* 
+* @param num_conversions Conversions per output sample (0 or 1: no oversampling).
+* @param shift Arithmetic right shift of the sum (log2(num_conversions) to average).
+*/
+static inline void VCO_set_oversampling(uint32_t num_conversions, uint32_t shift) {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_OVERSAMPLING_REG_OFFSET) =
+        ((num_conversions & VCO_DECODER_OVERSAMPLING_COUNT_MASK) << VCO_DECODER_OVERSAMPLING_COUNT_OFFSET) |
+        ((shift & VCO_DECODER_OVERSAMPLING_SHIFT_MASK) << VCO_DECODER_OVERSAMPLING_SHIFT_OFFSET);
+}
+
+/**
+* @brief Enable/disable the dual-channel output. Each output sample (count
+* register, DMA trigger and sample FIFO) then packs the P count in bits 15:0
+* and the N count in bits 31:16, clamped to the field range, instead of their
+* difference. Read the fields with VCO_PACKED_P() and VCO_PACKED_N().
+* 
+* @param enable enable=true to pack both counts in one word.
+* @param tag tag=true to tag each field with its channel in its MSB (0: P, 1: N), leaving 15 bits per count.
+*/
+static inline void VCO_set_packing(bool enable, bool tag) {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_PACKING_REG_OFFSET) =
+        ((uint32_t) enable << VCO_DECODER_PACKING_ENABLE_BIT) |
+        ((uint32_t) tag << VCO_DECODER_PACKING_TAG_BIT);
+}
+
+// Fields of a packed sample. With the channel tag, the count is in bits 14:0
+// of the field (VCO_PACKED_COUNT) and the channel in bit 15 (VCO_PACKED_TAG).
+#define VCO_PACKED_P(sample) ((uint32_t)(sample) & 0xffff)
+#define VCO_PACKED_N(sample) (((uint32_t)(sample) >> 16) & 0xffff)
+#define VCO_PACKED_COUNT(field) ((field) & 0x7fff)
+#define VCO_PACKED_TAG(field) (((field) >> 15) & 1)
+
+/**
+* @brief Enable/disable the sample FIFO. Disabling it flushes the FIFO.
+* 
+* @param enable enable=true to push each conversion into the FIFO and trigger the DMA on the watermark.
+* @param timestamp timestamp=true to read each entry as two words (count, timestamp).
+*/
+static inline void VCO_fifo_enable(bool enable, bool timestamp) {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_CONTROL_REG_OFFSET) =
+        ((uint32_t) enable << VCO_DECODER_FIFO_CONTROL_ENABLE_BIT) |
+        ((uint32_t) timestamp << VCO_DECODER_FIFO_CONTROL_TIMESTAMP_BIT);
+}
+
+/**
+* @brief Get the number of entries in the sample FIFO.
+*/
+static inline uint32_t VCO_get_fifo_level() {
+    return *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_LEVEL_REG_OFFSET) &
+            VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_MASK;
+}
+
+/**
+* @brief Set the sample FIFO watermark.
+* 
+* @param watermark FIFO level that raises the DMA trigger (0 or 1: on every conversion).
+*/
+static inline void VCO_set_fifo_watermark(uint32_t watermark) {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_WATERMARK_REG_OFFSET) = watermark;
+}
 
+/**
+* @brief Get the number of conversions dropped because the sample FIFO was full.
+*/
+static inline uint32_t VCO_get_overflow_count() {
+    return *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_OVERFLOW_REG_OFFSET) &
+            VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_MASK;
+}
+
+/**
+* @brief Clear the count of dropped conversions.
+*/
+static inline void VCO_clear_overflow_count() {
+    *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_OVERFLOW_REG_OFFSET) = 0;
+}
+
+/**
+* @brief Get the current timestamp (system clock cycles since the sample FIFO was enabled).
+*/
+static inline uint32_t VCO_get_timestamp() {
+    return *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_TIMESTAMP_REG_OFFSET);
+}
+
+/**
+* @brief Read the next word of the sample FIFO: the count of the head entry, or
+* its timestamp after the count when the timestamps are enabled. Also the source
+* address of the DMA (fixed increment).
+*/
+static inline uint32_t VCO_fifo_read() {
+    return *(volatile uint32_t *)(VCO_DECODER_START_ADDRESS + VCO_DECODER_FIFO_DATA_REG_OFFSET);
+}
+
+// Number of phases of a VCO period (vco_computation)
+#define VCO_NUM_PHASES 62
+
+/**
+* @brief Previous outputs of one VCO, kept by VCO_decode() between conversions.
+*/
+typedef struct {
+    uint32_t coarse;
+    uint32_t fine;
+} vco_decode_state_t;
+
+/**
+* @brief Fine phase of a VCO from its fine output, as computed by vco_computation:
+* the number of set phases 30:1, mirrored by the phase 0.
+*/
+static inline uint32_t VCO_fine_phase(uint32_t phases) {
+    uint32_t binaryph = __builtin_popcount(phases >> 1);
+    return ((phases & 1) ? binaryph : (VCO_NUM_PHASES - 1) - binaryph) & 0x3f;
+}
+
+/**
+* @brief Count of a VCO since its previous conversion, recomputed from its coarse
+* and fine outputs as vco_computation does.
+* 
+* @param state Previous outputs of the VCO, updated with the new ones.
+* @param coarse Coarse output (VCOp_get_coarse() or VCOn_get_coarse()).
+* @param phases Fine output (VCOp_get_fine() or VCOn_get_fine()).
+*/
+static inline uint32_t VCO_decode(vco_decode_state_t *state, uint32_t coarse, uint32_t phases) {
+    uint32_t fine = VCO_fine_phase(phases);
+    uint32_t coarse_diff = (coarse - state->coarse) & VCO_DECODER_ADC_P_COARSE_OUT_ADC_P_COARSE_OUT_MASK;
+    uint32_t count = VCO_NUM_PHASES * coarse_diff + (fine - state->fine);
+    state->coarse = coarse;
+    state->fine = fine;
+    return count;
+}
 
 #endif  // VCO_DECODER_H
\ No newline at end of file
@@ -74,6 +74,69 @@ extern "C" {
 #define VCO_DECODER_MANUAL_REFRESH_TRAIN2_REG_OFFSET 0x2c
 #define VCO_DECODER_MANUAL_REFRESH_TRAIN2_MANUAL_REFRESH_TRAIN2_BIT 0
 
+// Control of the sample FIFO
+#define VCO_DECODER_FIFO_CONTROL_REG_OFFSET 0x30
+#define VCO_DECODER_FIFO_CONTROL_ENABLE_BIT 0
+#define VCO_DECODER_FIFO_CONTROL_TIMESTAMP_BIT 1
+
+// Number of entries in the sample FIFO
+#define VCO_DECODER_FIFO_LEVEL_REG_OFFSET 0x34
+#define VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_MASK 0xff
+#define VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_OFFSET 0
+#define VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_FIELD \
+  ((bitfield_field32_t) { .mask = VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_MASK, .index = VCO_DECODER_FIFO_LEVEL_FIFO_LEVEL_OFFSET })
+
+// Sample FIFO level that raises the DMA trigger, which then stays high until
+// the FIFO is empty (0 and 1: raised while the FIFO is not empty)
+#define VCO_DECODER_FIFO_WATERMARK_REG_OFFSET 0x38
+#define VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_MASK 0xff
+#define VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_OFFSET 0
+#define VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_FIELD \
+  ((bitfield_field32_t) { .mask = VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_MASK, .index = VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_OFFSET })
+
+// Number of conversions dropped because the sample FIFO was full
+// (saturating, write 0 to clear)
+#define VCO_DECODER_FIFO_OVERFLOW_REG_OFFSET 0x3c
+#define VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_MASK 0xffff
+#define VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_OFFSET 0
+#define VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_FIELD \
+  ((bitfield_field32_t) { .mask = VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_MASK, .index = VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_OFFSET })
+
+// Free-running counter of system clock cycles, captured with each conversion
+// pushed into the sample FIFO (reset when the FIFO is disabled)
+#define VCO_DECODER_TIMESTAMP_REG_OFFSET 0x40
+
+// Oversampling of the decoder count: each output sample is the sum of COUNT
+// consecutive conversions, shifted right by SHIFT
+#define VCO_DECODER_OVERSAMPLING_REG_OFFSET 0x44
+#define VCO_DECODER_OVERSAMPLING_COUNT_MASK 0x3ff
+#define VCO_DECODER_OVERSAMPLING_COUNT_OFFSET 0
+#define VCO_DECODER_OVERSAMPLING_COUNT_FIELD \
+  ((bitfield_field32_t) { .mask = VCO_DECODER_OVERSAMPLING_COUNT_MASK, .index = VCO_DECODER_OVERSAMPLING_COUNT_OFFSET })
+#define VCO_DECODER_OVERSAMPLING_SHIFT_MASK 0x1f
+#define VCO_DECODER_OVERSAMPLING_SHIFT_OFFSET 16
+#define VCO_DECODER_OVERSAMPLING_SHIFT_FIELD \
+  ((bitfield_field32_t) { .mask = VCO_DECODER_OVERSAMPLING_SHIFT_MASK, .index = VCO_DECODER_OVERSAMPLING_SHIFT_OFFSET })
+
+// Double-tap measurement: cycles between the refresh of the trigger and a
+// second refresh, whose count (the oscillations during the gap) is the
+// conversion result. 0: single tap. The gap is at least 2 cycles (1 acts as
+// 2). The triggers during the gap are skipped, so with a gap longer than the
+// refresh period the conversions are ceil(gap / period) periods apart.
+#define VCO_DECODER_DOUBLE_TAP_GAP_REG_OFFSET 0x48
+
+// Dual-channel output: each output sample packs the P and N counts in one
+// word, instead of their difference
+#define VCO_DECODER_PACKING_REG_OFFSET 0x4c
+#define VCO_DECODER_PACKING_ENABLE_BIT 0
+#define VCO_DECODER_PACKING_TAG_BIT 1
+
+// Memory area: Head of the sample FIFO: the decoder count, followed by its
+// timestamp when FIFO_CONTROL.TIMESTAMP is set. Reading the last word of an
+// entry pops it.
+#define VCO_DECODER_FIFO_DATA_REG_OFFSET 0x80
+#define VCO_DECODER_FIFO_DATA_SIZE_WORDS 1
+#define VCO_DECODER_FIFO_DATA_SIZE_BYTES 4
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,45 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_util.c
+// Description: Measurement windows for the throughput benchmarks
+
+#include <stdio.h>
+
+#include "bench_util.h"
+#include "csr.h"
+#include "vcd_util.h"
+
+/**********************************/
+/* ---- LOCAL VARIABLES ---- */
+/**********************************/
+
+// CPU cycle counter at the start of the window
+static uint32_t start_cycles;
+
+/**************************************/
+/* ---- FUNCTIONS IMPLEMENTATION ---- */
+/**************************************/
+
+// Initialize the measurement windows
+int bench_init(void) {
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    return vcd_init();
+}
+
+// Open a measurement window
+void bench_start(void) {
+    CSR_READ(CSR_REG_MCYCLE, &start_cycles);
+    vcd_enable();
+}
+
+// Close the measurement window and report it
+void bench_stop(const char *kernel, uint32_t config, uint32_t samples) {
+    uint32_t stop_cycles;
+    vcd_disable();
+    CSR_READ(CSR_REG_MCYCLE, &stop_cycles);
+    printf("BENCH %s %u %u %u\n", kernel, (unsigned int) config, (unsigned int) samples,
+           (unsigned int) (stop_cycles - start_cycles));
+}
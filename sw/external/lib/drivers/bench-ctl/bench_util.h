@@ -0,0 +1,43 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: bench_util.h
+// Description: Measurement windows for the throughput benchmarks
+
+#ifndef BENCH_UTIL_H_
+#define BENCH_UTIL_H_
+
+#include <stdint.h>
+
+/********************************/
+/* ---- EXPORTED FUNCTIONS ---- */
+/********************************/
+
+/**
+ * @brief Initialize the measurement windows (GPIO 0 and cycle counter)
+ * 
+ * @return int 0 if success, -1 otherwise
+ */
+int bench_init(void);
+
+/**
+ * @brief Open a measurement window
+ * 
+ * GPIO 0 is raised for the whole window, so that the testbench can measure
+ * it (e.g., BUS_MONITOR=gpio), and the CPU cycle counter is sampled. The
+ * counter is stopped while the CPU sleeps.
+ */
+void bench_start(void);
+
+/**
+ * @brief Close the measurement window and report it on the UART as
+ *        'BENCH <kernel> <config> <samples> <busy cycles>'
+ * 
+ * @param kernel Kernel name
+ * @param config Kernel configuration (e.g., clock divider)
+ * @param samples Number of samples processed in the window
+ */
+void bench_stop(const char *kernel, uint32_t config, uint32_t samples);
+
+#endif /* BENCH_UTIL_H_ */
@@ -7,17 +7,31 @@
 // Date: 20/06/2023
 // Description: External interrupt driver
 
+#include <stddef.h>
+
 #include "ext_irq.h"
 #include "core_v_mini_mcu.h"
 #include "rv_plic.h"
 #include "cheep.h"
+#include "csr.h"
 #include "vcd_util.h"
+#include "IRQ_ctrl.h"
+
+// Machine external interrupt enable (mie.MEIE)
+#define EXT_IRQ_MEIE (1 << 11)
 
 /******************************/
 /* ---- GLOBAL VARIABLES ---- */
 /******************************/
 
+// Handlers of the peripheral interrupt sources
+static ext_irq_handler_t ext_irq_handlers[IRQ_CTRL_NUM_SOURCES];
 
+/*******************************/
+/* ---- FUNCTION PROTOTYPES ---- */
+/*******************************/
+
+static void ext_irq_dispatch(uint32_t id);
 
 /**********************************/
 /* ---- FUNCTION DEFINITIONS ---- */
@@ -27,12 +41,75 @@ int ext_irq_init(void) {
     // Initialize PLIC for external interrupts
     if (plic_Init() != kPlicOk)
         return -1;
+    if (plic_target_set_threshold(0) != kPlicOk)
+        return -1;
+
+    // Start with all the peripheral sources disabled and cleared
+    for (uint32_t i = 0; i < IRQ_CTRL_NUM_SOURCES; i++) {
+        IRQ_ctrl_enable(i, false);
+        ext_irq_handlers[i] = NULL;
+    }
+    IRQ_ctrl_clear((1 << IRQ_CTRL_NUM_SOURCES) - 1);
+
+    // EXT_INTR_0 stays enabled in the PLIC, as it always was; it fires once
+    // its source (IRQ_CTRL_SRC_SES_DATA_VALID) is enabled in the controller
+    if (plic_assign_external_irq_handler(EXT_INTR_0, (void *)ext_irq_dispatch) != kPlicOk)
+        return -1;
     if (plic_irq_set_priority(EXT_INTR_0, 1) != kPlicOk)
         return -1;
     if (plic_irq_set_enabled(EXT_INTR_0, kPlicToggleEnabled) != kPlicOk)
         return -1;
 
+    // Enable the machine external interrupt
+    CSR_SET_BITS(CSR_REG_MIE, EXT_IRQ_MEIE);
+
     // Return success
     return 0;
 }
 
+int ext_irq_enable(uint32_t source, ext_irq_handler_t handler) {
+    if (source >= IRQ_CTRL_NUM_SOURCES)
+        return -1;
+
+    ext_irq_handlers[source] = handler;
+    if (plic_assign_external_irq_handler(EXT_INTR_0 + source, (void *)ext_irq_dispatch) != kPlicOk)
+        return -1;
+    if (plic_irq_set_priority(EXT_INTR_0 + source, 1) != kPlicOk)
+        return -1;
+    if (plic_irq_set_enabled(EXT_INTR_0 + source, kPlicToggleEnabled) != kPlicOk)
+        return -1;
+
+    // Discard the events that happened before the source was enabled
+    IRQ_ctrl_clear(1 << source);
+    IRQ_ctrl_enable(source, true);
+
+    // Return success
+    return 0;
+}
+
+int ext_irq_disable(uint32_t source) {
+    if (source >= IRQ_CTRL_NUM_SOURCES)
+        return -1;
+
+    IRQ_ctrl_enable(source, false);
+    IRQ_ctrl_clear(1 << source);
+    if (plic_irq_set_enabled(EXT_INTR_0 + source, kPlicToggleDisabled) != kPlicOk)
+        return -1;
+    ext_irq_handlers[source] = NULL;
+
+    // Return success
+    return 0;
+}
+
+// Called by the PLIC driver with the claimed interrupt: the pending bit is
+// cleared before the completion, so that the (level-sensitive) PLIC source
+// does not fire again for the same event
+static void ext_irq_dispatch(uint32_t id) {
+    uint32_t source = id - EXT_INTR_0;
+    if (source >= IRQ_CTRL_NUM_SOURCES)
+        return;
+
+    IRQ_ctrl_clear(1 << source);
+    if (ext_irq_handlers[source] != NULL)
+        ext_irq_handlers[source]();
+}
@@ -7,19 +7,47 @@
 // Date: 20/06/2023
 // Description: Header file for external IRQ driver
 
+#include <stdint.h>
+
 #include "rv_plic.h"
+#include "IRQ_ctrl.h"
 
 /********************************/
 /* ---- EXPORTED VARIABLES ---- */
 /********************************/
 
+/**
+ * @brief Handler of a peripheral interrupt source, called from the machine
+ * external interrupt after its pending bit has been cleared.
+ */
+typedef void (*ext_irq_handler_t)(void);
 
 /********************************/
 /* ---- EXPORTED FUNCTIONS ---- */
 /********************************/
 
 /**
- * @brief Initialize external interrupt handler.
+ * @brief Initialize external interrupt handler: reset the PLIC, enable
+ * EXT_INTR_0 in it and enable the machine external interrupt (mie.MEIE).
+ * All the peripheral sources start disabled in the interrupt controller, and
+ * global interrupts (mstatus.MIE) are left to the application.
  * @return 0 if successful, -1 otherwise.
  */
 int ext_irq_init(void);
+
+/**
+ * @brief Route a peripheral interrupt source to the CPU: enable its PLIC
+ * line (EXT_INTR_0 + source) and the source in the interrupt controller.
+ * @param source Interrupt source (IRQ_CTRL_SRC_*).
+ * @param handler Handler of the source (NULL for none, e.g., to only wake
+ * up the CPU from wait_for_interrupt()).
+ * @return 0 if successful, -1 otherwise.
+ */
+int ext_irq_enable(uint32_t source, ext_irq_handler_t handler);
+
+/**
+ * @brief Disable a peripheral interrupt source and clear it.
+ * @param source Interrupt source (IRQ_CTRL_SRC_*).
+ * @return 0 if successful, -1 otherwise.
+ */
+int ext_irq_disable(uint32_t source);
@@ -61,4 +61,184 @@ static inline void iDACs_set_refresh_rate(uint32_t num_cycles) {
     *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_REFRESH_CYCLES_REG_OFFSET) = num_cycles;
 }
 
+/**
+* @brief Trigger a single step of the refresh counter (waveform generator step and
+*           iDAC refresh trigger).
+*/
+static inline void iDACs_trigger() {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_MANUAL_TRIGGER_REG_OFFSET) = 1;
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_MANUAL_TRIGGER_REG_OFFSET) = 0;
+}
+
+/**
+* @brief Phase increment (DDS_FREQUENCY) of a waveform of frequency f_hz when
+*           the waveform generator is stepped at f_step_hz (system clock
+*           frequency / (refresh cycles + 1)).
+*/
+#define IDAC_DDS_PHASE_INCREMENT(f_hz, f_step_hz) ((uint32_t)(((uint64_t)(f_hz) << 32) / (f_step_hz)))
+
+/**
+* @brief Control the waveform generator. An enabled channel drives its iDAC with
+*           the waveform instead of the current register, and is stepped by the
+*           refresh counter (iDACs_set_refresh_rate()). Disabling a channel resets
+*           its phase, chirp and current code.
+*
+* @param enable1 enable1=true to drive the iDAC 1 with the waveform generator.
+* @param enable2 enable2=true to drive the iDAC 2 with the waveform generator.
+* @param square1 square1=true for a square wave on iDAC 1, otherwise the waveform RAM.
+* @param square2 square2=true for a square wave on iDAC 2, otherwise the waveform RAM.
+*/
+static inline void iDACs_dds_control(bool enable1, bool enable2, bool square1, bool square2) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_CONTROL_REG_OFFSET) =
+        ((uint32_t)enable1 << IDAC_CTRL_DDS_CONTROL_ENABLE_1_BIT) |
+        ((uint32_t)enable2 << IDAC_CTRL_DDS_CONTROL_ENABLE_2_BIT) |
+        ((uint32_t)square1 << IDAC_CTRL_DDS_CONTROL_SQUARE_1_BIT) |
+        ((uint32_t)square2 << IDAC_CTRL_DDS_CONTROL_SQUARE_2_BIT);
+}
+
+/**
+* @brief Load one period of the waveform (64 signed samples) into the waveform RAM,
+*           shared by both channels.
+*
+* @param samples IDAC_CTRL_WAVE_RAM_SIZE_WORDS samples, from -128 to 127.
+*/
+static inline void iDACs_dds_load_wave(const int8_t *samples) {
+    for (uint32_t i = 0; i < IDAC_CTRL_WAVE_RAM_SIZE_WORDS; i++) {
+        *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_WAVE_RAM_REG_OFFSET + 4 * i) = (uint8_t)samples[i];
+    }
+}
+
+/**
+* @brief Set the frequency of the waveform of the iDAC 1 (initial frequency of a chirp).
+*
+* @param phase_increment Phase increment per step, in 2^-32 periods (see IDAC_DDS_PHASE_INCREMENT).
+*/
+static inline void iDAC1_dds_set_frequency(uint32_t phase_increment) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_FREQUENCY_1_REG_OFFSET) = phase_increment;
+}
+
+/**
+* @brief Set the frequency of the waveform of the iDAC 2 (initial frequency of a chirp).
+*
+* @param phase_increment Phase increment per step, in 2^-32 periods (see IDAC_DDS_PHASE_INCREMENT).
+*/
+static inline void iDAC2_dds_set_frequency(uint32_t phase_increment) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_FREQUENCY_2_REG_OFFSET) = phase_increment;
+}
+
+/**
+* @brief Set the phase offset of the waveform of the iDAC 1.
+*
+* @param phase Phase offset, in 2^-32 periods (e.g., 0x40000000 for 90 degrees).
+*/
+static inline void iDAC1_dds_set_phase(uint32_t phase) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_PHASE_1_REG_OFFSET) = phase;
+}
+
+/**
+* @brief Set the phase offset of the waveform of the iDAC 2.
+*
+* @param phase Phase offset, in 2^-32 periods (e.g., 0x40000000 for 90 degrees).
+*/
+static inline void iDAC2_dds_set_phase(uint32_t phase) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_PHASE_2_REG_OFFSET) = phase;
+}
+
+/**
+* @brief Set the chirp rate of the waveform of the iDAC 1.
+*
+* @param rate Phase increment added to the frequency at each step (negative for a down-chirp, 0 for a constant frequency).
+*/
+static inline void iDAC1_dds_set_chirp(int32_t rate) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_CHIRP_1_REG_OFFSET) = (uint32_t)rate;
+}
+
+/**
+* @brief Set the chirp rate of the waveform of the iDAC 2.
+*
+* @param rate Phase increment added to the frequency at each step (negative for a down-chirp, 0 for a constant frequency).
+*/
+static inline void iDAC2_dds_set_chirp(int32_t rate) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_CHIRP_2_REG_OFFSET) = (uint32_t)rate;
+}
+
+/**
+* @brief Set the amplitude and offset of the waveforms of both iDACs. Each current
+*           code is offset + sample * amplitude / 256, clamped to 0-255.
+*
+* @param amplitude1 Amplitude of the iDAC 1 waveform (0-255)
+* @param offset1 Offset of the iDAC 1 waveform (0-255)
+* @param amplitude2 Amplitude of the iDAC 2 waveform (0-255)
+* @param offset2 Offset of the iDAC 2 waveform (0-255)
+*/
+static inline void iDACs_dds_set_levels(uint8_t amplitude1, uint8_t offset1, uint8_t amplitude2, uint8_t offset2) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_AMPLITUDE_REG_OFFSET) = (uint32_t)amplitude1 | ((uint32_t)amplitude2 << IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_OFFSET);
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_OFFSET_REG_OFFSET) = (uint32_t)offset1 | ((uint32_t)offset2 << IDAC_CTRL_DDS_OFFSET_OFFSET_2_OFFSET);
+}
+
+/**
+* @brief Get the current code of the iDAC 1 waveform (0 while the channel is disabled).
+*/
+static inline uint8_t iDAC1_dds_get_current() {
+    return *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_CURRENT_REG_OFFSET) & IDAC_CTRL_DDS_CURRENT_CURRENT_1_MASK;
+}
+
+/**
+* @brief Get the current code of the iDAC 2 waveform (0 while the channel is disabled).
+*/
+static inline uint8_t iDAC2_dds_get_current() {
+    return (*(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_DDS_CURRENT_REG_OFFSET) >> IDAC_CTRL_DDS_CURRENT_CURRENT_2_OFFSET) & IDAC_CTRL_DDS_CURRENT_CURRENT_2_MASK;
+}
+
+/**
+* @brief Configure the closed-loop current tracking. Each dLC level crossing steps
+*           the loop code by step, at most once every slew + 1 cycles (faster
+*           crossings are accumulated), and the code is clamped to min-max.
+*
+* @param step Code step per crossing.
+* @param min Lowest loop code.
+* @param max Highest loop code.
+* @param slew Minimum spacing between two steps, in clock cycles minus one.
+*/
+static inline void iDACs_feedback_config(uint8_t step, uint8_t min, uint8_t max, uint16_t slew) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_STEP_REG_OFFSET) = step;
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_LIMITS_REG_OFFSET) = (uint32_t)min | ((uint32_t)max << IDAC_CTRL_FEEDBACK_LIMITS_MAX_OFFSET);
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_SLEW_REG_OFFSET) = slew;
+}
+
+/**
+* @brief Control the closed-loop current tracking. An enabled channel drives its iDAC
+*           with its own loop code, which takes precedence over the waveform generator.
+*           Both codes are stepped by the same crossings, and each one starts from
+*           the current register of its channel.
+*
+* @param enable1 enable1=true to drive the iDAC 1 with the loop code.
+* @param enable2 enable2=true to drive the iDAC 2 with the loop code.
+* @param invert invert=false to step the code up on an upward crossing, invert=true to step it down.
+*/
+static inline void iDACs_feedback_control(bool enable1, bool enable2, bool invert) {
+    *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_CONTROL_REG_OFFSET) =
+        ((uint32_t)enable1 << IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT) |
+        ((uint32_t)enable2 << IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_2_BIT) |
+        ((uint32_t)invert << IDAC_CTRL_FEEDBACK_CONTROL_INVERT_BIT);
+}
+
+/**
+* @brief Get the loop code of the iDAC 1 (its current register while its loop is
+*           disabled). The successive values of FEEDBACK_CODE, with the code of the
+*           iDAC 2 in bits 15:8, are the tracked signal, and can be recorded by the
+*           DMA using the iDAC feedback trigger (DMA slot 1, RX).
+*/
+static inline uint8_t iDAC1_feedback_get_code() {
+    return *(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET) & IDAC_CTRL_FEEDBACK_CODE_CODE_1_MASK;
+}
+
+/**
+* @brief Get the loop code of the iDAC 2 (its current register while its loop is
+*           disabled).
+*/
+static inline uint8_t iDAC2_feedback_get_code() {
+    return (*(volatile uint32_t *)(IDAC_CTRL_START_ADDRESS + IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET) >> IDAC_CTRL_FEEDBACK_CODE_CODE_2_OFFSET) & IDAC_CTRL_FEEDBACK_CODE_CODE_2_MASK;
+}
+
 #endif  // IDAC_CTRL_H
\ No newline at end of file
@@ -53,6 +53,126 @@ extern "C" {
 #define IDAC_CTRL_CURRENT_CURRENT_2_FIELD \
   ((bitfield_field32_t) { .mask = IDAC_CTRL_CURRENT_CURRENT_2_MASK, .index = IDAC_CTRL_CURRENT_CURRENT_2_OFFSET })
 
+// Control of the waveform generator. An enabled channel drives its iDAC with
+// the generated waveform instead of the current register, updated on every
+// refresh counter trigger.
+#define IDAC_CTRL_DDS_CONTROL_REG_OFFSET 0x18
+#define IDAC_CTRL_DDS_CONTROL_ENABLE_1_BIT 0
+#define IDAC_CTRL_DDS_CONTROL_ENABLE_2_BIT 1
+#define IDAC_CTRL_DDS_CONTROL_SQUARE_1_BIT 2
+#define IDAC_CTRL_DDS_CONTROL_SQUARE_2_BIT 3
+
+// Phase increment of channel 1 per refresh counter trigger, in 2^-32 periods
+// (initial frequency of a chirp)
+#define IDAC_CTRL_DDS_FREQUENCY_1_REG_OFFSET 0x1c
+
+// Phase increment of channel 2 per refresh counter trigger, in 2^-32 periods
+// (initial frequency of a chirp)
+#define IDAC_CTRL_DDS_FREQUENCY_2_REG_OFFSET 0x20
+
+// Phase offset of channel 1, in 2^-32 periods
+#define IDAC_CTRL_DDS_PHASE_1_REG_OFFSET 0x24
+
+// Phase offset of channel 2, in 2^-32 periods
+#define IDAC_CTRL_DDS_PHASE_2_REG_OFFSET 0x28
+
+// Frequency increment of channel 1 per refresh counter trigger (two's
+// complement, 0: constant frequency)
+#define IDAC_CTRL_DDS_CHIRP_1_REG_OFFSET 0x2c
+
+// Frequency increment of channel 2 per refresh counter trigger (two's
+// complement, 0: constant frequency)
+#define IDAC_CTRL_DDS_CHIRP_2_REG_OFFSET 0x30
+
+// Amplitude of the waveforms: the waveform samples (-128 to 127) are scaled
+// by AMPLITUDE/256
+#define IDAC_CTRL_DDS_AMPLITUDE_REG_OFFSET 0x34
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_1_MASK 0xff
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_1_OFFSET 0
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_1_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_1_MASK, .index = IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_1_OFFSET })
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_MASK 0xff
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_OFFSET 8
+#define IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_MASK, .index = IDAC_CTRL_DDS_AMPLITUDE_AMPLITUDE_2_OFFSET })
+
+// Offset of the waveforms: the current code is OFFSET plus the scaled
+// sample, clamped to 0-255
+#define IDAC_CTRL_DDS_OFFSET_REG_OFFSET 0x38
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_1_MASK 0xff
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_1_OFFSET 0
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_1_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_OFFSET_OFFSET_1_MASK, .index = IDAC_CTRL_DDS_OFFSET_OFFSET_1_OFFSET })
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_2_MASK 0xff
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_2_OFFSET 8
+#define IDAC_CTRL_DDS_OFFSET_OFFSET_2_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_OFFSET_OFFSET_2_MASK, .index = IDAC_CTRL_DDS_OFFSET_OFFSET_2_OFFSET })
+
+// Closed-loop current tracking: each dLC level crossing steps the loop code
+// of every enabled channel up or down. Each channel has its own code, loaded
+// from its CURRENT field while its loop is disabled
+#define IDAC_CTRL_FEEDBACK_CONTROL_REG_OFFSET 0x3c
+#define IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT 0
+#define IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_2_BIT 1
+#define IDAC_CTRL_FEEDBACK_CONTROL_INVERT_BIT 2
+
+// Code step applied per level crossing
+#define IDAC_CTRL_FEEDBACK_STEP_REG_OFFSET 0x40
+#define IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_MASK 0xff
+#define IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_OFFSET 0
+#define IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_MASK, .index = IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_OFFSET })
+
+// Range of the loop code
+#define IDAC_CTRL_FEEDBACK_LIMITS_REG_OFFSET 0x44
+#define IDAC_CTRL_FEEDBACK_LIMITS_MIN_MASK 0xff
+#define IDAC_CTRL_FEEDBACK_LIMITS_MIN_OFFSET 0
+#define IDAC_CTRL_FEEDBACK_LIMITS_MIN_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_LIMITS_MIN_MASK, .index = IDAC_CTRL_FEEDBACK_LIMITS_MIN_OFFSET })
+#define IDAC_CTRL_FEEDBACK_LIMITS_MAX_MASK 0xff
+#define IDAC_CTRL_FEEDBACK_LIMITS_MAX_OFFSET 8
+#define IDAC_CTRL_FEEDBACK_LIMITS_MAX_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_LIMITS_MAX_MASK, .index = IDAC_CTRL_FEEDBACK_LIMITS_MAX_OFFSET })
+
+// Slew limit: two steps are at least SLEW + 1 clock cycles apart. Crossings
+// that arrive faster are accumulated (up to +-127) and applied one step at a
+// time
+#define IDAC_CTRL_FEEDBACK_SLEW_REG_OFFSET 0x48
+#define IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_MASK 0xffff
+#define IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_OFFSET 0
+#define IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_MASK, .index = IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_OFFSET })
+
+// Loop codes, i.e., the tracked signal. Each code follows the CURRENT field
+// of its channel while its loop is disabled
+#define IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET 0x4c
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_1_MASK 0xff
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_1_OFFSET 0
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_1_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_CODE_CODE_1_MASK, .index = IDAC_CTRL_FEEDBACK_CODE_CODE_1_OFFSET })
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_2_MASK 0xff
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_2_OFFSET 8
+#define IDAC_CTRL_FEEDBACK_CODE_CODE_2_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_FEEDBACK_CODE_CODE_2_MASK, .index = IDAC_CTRL_FEEDBACK_CODE_CODE_2_OFFSET })
+
+// Current codes of the waveform generator, updated on every refresh counter
+// trigger. Cleared while the channel is disabled
+#define IDAC_CTRL_DDS_CURRENT_REG_OFFSET 0x50
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_1_MASK 0xff
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_1_OFFSET 0
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_1_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_CURRENT_CURRENT_1_MASK, .index = IDAC_CTRL_DDS_CURRENT_CURRENT_1_OFFSET })
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_2_MASK 0xff
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_2_OFFSET 8
+#define IDAC_CTRL_DDS_CURRENT_CURRENT_2_FIELD \
+  ((bitfield_field32_t) { .mask = IDAC_CTRL_DDS_CURRENT_CURRENT_2_MASK, .index = IDAC_CTRL_DDS_CURRENT_CURRENT_2_OFFSET })
+
+// Memory area: Waveform RAM shared by both channels: one period of 64 signed
+// 8-bit samples, one per word, indexed by the 6 MSBs of the phase
+#define IDAC_CTRL_WAVE_RAM_REG_OFFSET 0x100
+#define IDAC_CTRL_WAVE_RAM_SIZE_WORDS 64
+#define IDAC_CTRL_WAVE_RAM_SIZE_BYTES 256
+#define IDAC_CTRL_WAVE_RAM_MASK  0xff
 #ifdef __cplusplus
 }  // extern "C"
 #endif
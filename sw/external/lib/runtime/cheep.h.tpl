@@ -58,6 +58,11 @@ extern "C" {
 #define CIC_SIZE 0x${CIC_size}
 #define CIC_END_ADDRESS (CIC_START_ADDRESS + CIC_SIZE)
 
+// Peripheral interrupt controller registers
+#define IRQ_CTRL_START_ADDRESS (EXT_PERIPHERAL_START_ADDRESS + 0x${IRQ_ctrl_start_address})
+#define IRQ_CTRL_SIZE 0x${IRQ_ctrl_size}
+#define IRQ_CTRL_END_ADDRESS (IRQ_CTRL_START_ADDRESS + IRQ_CTRL_SIZE)
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
@@ -0,0 +1,130 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: ref_cic.hh
+// Description: Bit-accurate reference model of the CIC filter of pdm2pcm
+//              (cic_integrators.sv, decimator.sv, cic_combs.sv), as used by
+//              HEEPidermis without the half-band and FIR stages.
+
+#if !defined(REF_CIC_HH_)
+#define REF_CIC_HH_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+// Number of integrator and comb stages
+#define REF_CIC_STAGES 6
+
+// Depth of the comb delay lines and width of the decimation counter
+#define REF_CIC_DELAY_DEPTH 16
+#define REF_CIC_DELAY_MASK 0xf
+#define REF_CIC_DECIM_MASK 0xf
+
+// Data path width of the HEEPidermis instance
+#define REF_CIC_WIDTH 24
+
+class RefCic
+{
+private:
+    uint32_t mask;
+    uint32_t acc[REF_CIC_STAGES];
+    uint32_t decim_counter;
+    uint32_t comb[REF_CIC_STAGES];
+
+    // Comb delay lines (circular, pos[i] is the most recent input)
+    uint32_t prev[REF_CIC_STAGES][REF_CIC_DELAY_DEPTH];
+    unsigned int pos[REF_CIC_STAGES];
+
+public:
+    // Configuration (CIC_ACTIVATED_STAGES, CIC_DELAY_COMB and DECIMCIC
+    // registers). It may be changed between samples.
+    uint32_t activated;
+    uint32_t delay_comb;
+    uint32_t decim;
+
+    RefCic(unsigned int width = REF_CIC_WIDTH)
+    {
+        this->mask = width >= 32 ? 0xffffffff : (1u << width) - 1;
+        this->activated = 0;
+        this->delay_comb = 0;
+        this->decim = 0;
+        this->clear();
+    }
+
+    // Clear of the filter state (first divided clock edge after enable)
+    void clear()
+    {
+        for (unsigned int i = 0; i < REF_CIC_STAGES; i++) {
+            this->acc[i] = 0;
+            this->comb[i] = 0;
+            for (unsigned int j = 0; j < REF_CIC_DELAY_DEPTH; j++) this->prev[i][j] = 0;
+            this->pos[i] = 0;
+        }
+        this->decim_counter = 0;
+    }
+
+    // Index of the highest activated stage, plus one (0 if none)
+    static unsigned int msbIndex(uint32_t activated)
+    {
+        unsigned int msb = 0;
+        for (unsigned int i = 0; i < REF_CIC_STAGES; i++) {
+            if ((activated >> i) & 1) msb = i + 1;
+        }
+        return msb;
+    }
+
+    // One PDM sample (the divided clock edge at which pdm_core sends the
+    // stored bit to the integrators; the core takes one bit every two
+    // edges). Returns true when the combs are enabled: the PCM output
+    // written to the FIFO is the comb output before the update.
+    bool sample(uint8_t bit, uint32_t *pcm)
+    {
+        unsigned int msb = msbIndex(this->activated);
+        uint32_t decim = this->decim & REF_CIC_DECIM_MASK;
+        uint32_t delay = this->delay_comb & REF_CIC_DELAY_MASK;
+
+        // ±1 input
+        uint32_t data = (bit & 1) ? 1 : this->mask;
+        uint32_t integr_out = msb != 0 ? this->acc[msb - 1] : data;
+        bool combs_en = this->decim_counter == decim;
+        if (combs_en) *pcm = msb != 0 ? this->comb[msb - 1] : integr_out;
+
+        // Integrators (from the last stage, so that each one sees the
+        // previous output of the one before)
+        for (int i = REF_CIC_STAGES - 1; i >= 0; i--) {
+            uint32_t in = i != 0 ? this->acc[i - 1] : data;
+            if ((this->activated >> i) & 1) this->acc[i] = (this->acc[i] + in) & this->mask;
+        }
+        this->decim_counter = combs_en ? 0 : (this->decim_counter + 1) & REF_CIC_DECIM_MASK;
+
+        // Combs: y = x - x[n - delay]
+        if (combs_en) {
+            for (int i = REF_CIC_STAGES - 1; i >= 0; i--) {
+                if (!((this->activated >> i) & 1)) continue;
+                uint32_t in = i != 0 ? this->comb[i - 1] : integr_out;
+                uint32_t *line = this->prev[i];
+                uint32_t delayed = delay != 0 ? line[(this->pos[i] + delay - 1) & REF_CIC_DELAY_MASK] : 0;
+                this->comb[i] = (in - delayed) & this->mask;
+                this->pos[i] = (this->pos[i] - 1) & REF_CIC_DELAY_MASK;
+                line[this->pos[i]] = in;
+            }
+        }
+        return combs_en;
+    }
+
+    // Process n PDM bits and append the PCM outputs. Returns the number of
+    // outputs appended.
+    size_t process(const uint8_t *bits, size_t n, std::vector<uint32_t>& out)
+    {
+        size_t size = out.size();
+        uint32_t pcm;
+        for (size_t i = 0; i < n; i++) {
+            if (this->sample(bits[i], &pcm)) out.push_back(pcm);
+        }
+        return out.size() - size;
+    }
+};
+
+#endif // REF_CIC_HH_
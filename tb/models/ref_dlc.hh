@@ -0,0 +1,149 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: ref_dlc.hh
+// Description: Bit-accurate reference model of the delta-level crossing
+//              encoder (dlc.sv): level crossings with optional hysteresis,
+//              sign-magnitude or two's complement delta levels, delta-level
+//              and delta-time overflow packets.
+
+#if !defined(REF_DLC_HH_)
+#define REF_DLC_HH_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+class RefDlc
+{
+private:
+    uint16_t sdiff_cnt;    // samples since the last packet
+    bool dir_d1;           // direction of the last level change
+
+    // Packet: {delta time, direction, delta levels}, or {delta time, delta
+    // levels} when the delta levels are in two's complement
+    uint16_t packet(uint16_t dt, uint16_t dlvl, bool dir)
+    {
+        uint32_t dt_dir = this->dlvl_format ? dt : ((uint32_t)dt << 1) | dir;
+        return ((dt_dir << this->dlvl_n_bits) | dlvl) & 0xffff;
+    }
+
+public:
+    // Configuration (dLC registers)
+    uint16_t hysteresis_en;
+    uint16_t dlvl_log_level_width;
+    uint16_t discard_bits;
+    uint16_t dlvl_n_bits;
+    uint16_t dlvl_mask;
+    uint16_t dlvl_format;    // 1: two's complement, 0: sign-magnitude
+    uint16_t dt_mask;
+    uint16_t bypass;
+
+    // Current level (CURR_LVL register, also written by software)
+    uint16_t curr_lvl;
+
+    // Level crossings detected (dlc_xing_o pulses) and direction of the
+    // last one (dlc_dir_o, true when downward)
+    uint64_t crossings;
+    bool xing_dir;
+
+    RefDlc()
+    {
+        this->hysteresis_en = 0;
+        this->dlvl_log_level_width = 0;
+        this->discard_bits = 0;
+        this->dlvl_n_bits = 0;
+        this->dlvl_mask = 0;
+        this->dlvl_format = 0;
+        this->dt_mask = 0;
+        this->bypass = 0;
+        this->curr_lvl = 0;
+        this->crossings = 0;
+        this->xing_dir = false;
+        this->reset();
+    }
+
+    // Reset of the encoder state (the configuration is kept)
+    void reset()
+    {
+        this->sdiff_cnt = 0;
+        this->dir_d1 = false;
+    }
+
+    // Process one input sample and append the packets it produces to out
+    // (any container with push_back, e.g. std::vector or std::deque)
+    template <typename T>
+    void push(uint32_t data, T& out)
+    {
+        uint16_t mask = this->dlvl_mask;
+        bool bypass = this->bypass & 1;
+
+        // Input level and difference with the current level
+        int16_t din = (int16_t)(data >> this->discard_bits) >> this->dlvl_log_level_width;
+        uint16_t dlvl = din - (int16_t)this->curr_lvl;
+
+        // Level crossing (in the direction of the previous one with hysteresis)
+        bool xing = false;
+        bool dir = false;
+        if (dlvl != 0) {
+            dir = dlvl >> 15;
+            xing = this->hysteresis_en ? this->dir_d1 == dir : true;
+            this->curr_lvl = (uint16_t)din;
+            this->dir_d1 = dir;
+        }
+        bool sdiff_cnt_en = !xing;
+        uint16_t dlvl_abs = sdiff_cnt_en ? this->sdiff_cnt + 1 : (dlvl & 0x8000 ? -dlvl : dlvl);
+        bool dlvl_ovf = !bypass && xing && (dlvl_abs & ~mask);
+        if (xing) {
+            this->crossings++;
+            this->xing_dir = dir;
+        }
+
+        // Regular packet
+        if (xing && !dlvl_ovf) {
+            if (bypass) out.push_back(data & 0xffff);
+            else out.push_back(this->packet(this->sdiff_cnt, (this->dlvl_format ? dlvl : dlvl_abs) & mask, dir));
+        }
+
+        // Delta-time overflow (checked on the counter before the increment)
+        bool dt_ovf = sdiff_cnt_en && this->sdiff_cnt == this->dt_mask;
+        if (!bypass) {
+            if (xing && !dlvl_ovf) this->sdiff_cnt = 1;
+            else if (sdiff_cnt_en) this->sdiff_cnt = dlvl_abs;
+        }
+
+        if (dlvl_ovf) {
+            // Delta-level overflow: full-scale packets, then the remainder
+            // (the RTL never leaves the overflow state with a null mask: a
+            // single packet is output instead)
+            uint16_t ovf_dwn_cnt = dlvl_abs;
+            while (true) {
+                uint16_t add_res = ovf_dwn_cnt - mask;
+                bool end = (add_res & 0x8000) || add_res == 0 || mask == 0;
+                out.push_back(this->packet(this->sdiff_cnt, end ? ovf_dwn_cnt & mask : mask, dir));
+                this->sdiff_cnt = end ? 1 : 0;
+                ovf_dwn_cnt = add_res;
+                if (end) break;
+            }
+        } else if (dt_ovf) {
+            // Delta-time overflow: empty packet with a full-scale delta time
+            if (bypass) {
+                out.push_back(data & 0xffff);
+            } else {
+                out.push_back(this->packet(this->dt_mask, 0, false));
+                this->sdiff_cnt = 1;
+            }
+        }
+    }
+
+    // Process n samples. Returns the number of packets appended.
+    size_t process(const uint32_t *data, size_t n, std::vector<uint16_t>& out)
+    {
+        size_t size = out.size();
+        for (size_t i = 0; i < n; i++) this->push(data[i], out);
+        return out.size() - size;
+    }
+};
+
+#endif // REF_DLC_HH_
@@ -0,0 +1,327 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: ref_groundtruth.cpp
+// Description: Ground truth generator for the filter test applications. Runs
+//              the reference models on a ΔΣ bitstream and writes the outputs
+//              as a C array, together with the parameters used.
+
+// System libraries
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// User libraries
+#include "vp_log.hh"
+#include "tb_dsm.hh"
+#include "ref_ses_filter.hh"
+#include "ref_cic.hh"
+#include "ref_dlc.hh"
+
+// Defines
+// -------
+// Lines of the pdm2pcm_dummy input file read before it stops the simulation
+#define MAX_SAMPLES 65536
+#define PDM_DUMMY_FILENAME "hw/vendor/x-heep/hw/ip/pdm2pcm/tb/signals/pdm.txt"
+
+// Function prototypes
+// -------------------
+// Process runtime parameters
+std::string getCmdOption(int argc, char* argv[], const std::string& option);
+
+// Parse an unsigned parameter (decimal, 0x or 0b prefix)
+static bool parseUint(const std::string& str, const char *name, uint32_t *val);
+
+// Write the parameters and the ground truth headers
+static bool writeParams(const std::string& filename,
+                        const std::vector<std::pair<std::string, std::string> >& defines);
+static bool writeArray(const std::string& filename, const std::string& type,
+                       const std::string& name, bool hex, const std::vector<uint32_t>& data);
+
+// Global variables
+// ----------------
+// ΔΣ bitstream source
+TbDsmSource dsm_source;
+
+int main(int argc, char *argv[])
+{
+    // COMMAND-LINE OPTIONS
+    // --------------------
+    const option longopts[] = {
+        {"help", no_argument, NULL, 'h'},
+        {"log_level", required_argument, NULL, 'l'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hl:", longopts, NULL)) >= 0) {
+        switch (opt) {
+        case 'h':
+            printf("Usage: %s [OPTIONS] +filter=<ses|cic> [+PLUSARGS]\n", argv[0]);
+            printf("Options:\n");
+            printf("  -h, --help\t\t\tPrint this help message\n");
+            printf("  -l, --log_level=LOG_LEVEL\tSet the log level\n");
+            printf("Plusargs:\n");
+            printf("  +filter=<ses|cic>\t\tReference model to run\n");
+            printf("  +input=<spec>\t\t\tΔΣ bitstream, same as +dsm_source (default: %s)\n", PDM_DUMMY_FILENAME);
+            printf("  +samples=<N>\t\t\tInput bits to process (default: %d)\n", MAX_SAMPLES);
+            printf("  +outputs=<N>\t\t\tOutputs checked by the firmware (<PREFIX>_OUTPUT_NUMBER)\n");
+            printf("  +length=<N>\t\t\tOutputs written to the array (default: +outputs, or all)\n");
+            printf("  +skip_zeros=1\t\t\tSkip the outputs before the first non-zero one\n");
+            printf("  +window=<N>\t\t\tSES window size\n");
+            printf("  +decim=<N>\t\t\tDecimation factor\n");
+            printf("  +stages=<mask>\t\tActivated stages\n");
+            printf("  +gains=<G0,...,G5>\t\tSES stage gains\n");
+            printf("  +delay=<N>\t\t\tCIC comb delay\n");
+            printf("  +dlc=<W:N:T[:H[:D[:F]]]>\tEncode the outputs with the dLC: log2 of the level\n");
+            printf("  \t\t\t\twidth, delta-level bits, delta-time bits, hysteresis,\n");
+            printf("  \t\t\t\tdiscarded bits and two's complement format\n");
+            printf("  +output=<file>\t\tGround truth header (default: standard output)\n");
+            printf("  +params=<file>\t\tParameters header (default: none)\n");
+            printf("  +prefix=<name>\t\tPrefix of the parameter names (default: SES or CIC)\n");
+            printf("  +defines=<NAME=VAL,...>\tAdditional parameters\n");
+            printf("  +array=<name>\t\t\tArray name (default: groundtruth)\n");
+            printf("  +type=<type>\t\t\tArray element type (default: uint32_t)\n");
+            printf("  +format=<dec|hex>\t\tArray element format (default: dec)\n");
+            exit(0);
+            break;
+        case 'l':
+            vpSetLogLvl(optarg);
+            break;
+        default:
+            printf("Usage: %s [OPTIONS] +filter=<ses|cic> [+PLUSARGS]\n", argv[0]);
+            printf("Try '%s --help' for more information.\n", argv[0]);
+            exit(1);
+            break;
+        }
+    }
+
+    // Parse the remaining command-line arguments
+    // ------------------------------------------
+    std::string filter = getCmdOption(argc, argv, "+filter=");
+    bool ses = filter == "ses";
+    if (!ses && filter != "cic") {
+        VP_ERR("Unknown filter '%s' (ses or cic)", filter.c_str());
+        exit(EXIT_FAILURE);
+    }
+    std::string prefix = getCmdOption(argc, argv, "+prefix=");
+    if (prefix.empty()) prefix = ses ? "SES" : "CIC";
+
+    // Parameters, in the order they are written
+    std::vector<std::pair<std::string, std::string> > defines;
+    uint32_t samples = MAX_SAMPLES;
+    uint32_t outputs = 0;
+    uint32_t length = 0;
+    uint32_t window = 0;
+    uint32_t decim = 0;
+    uint32_t stages = 0;
+    uint32_t delay = 0;
+    std::string str;
+    bool ok = true;
+    if (!(str = getCmdOption(argc, argv, "+samples=")).empty()) ok &= parseUint(str, "samples", &samples);
+    if (!(str = getCmdOption(argc, argv, "+outputs=")).empty()) ok &= parseUint(str, "outputs", &outputs);
+    if (!(str = getCmdOption(argc, argv, "+length=")).empty()) ok &= parseUint(str, "length", &length);
+    if (!(str = getCmdOption(argc, argv, "+window=")).empty()) ok &= parseUint(str, "window", &window);
+    if (!(str = getCmdOption(argc, argv, "+decim=")).empty()) ok &= parseUint(str, "decim", &decim);
+    if (!(str = getCmdOption(argc, argv, "+stages=")).empty()) ok &= parseUint(str, "stages", &stages);
+    if (!(str = getCmdOption(argc, argv, "+delay=")).empty()) ok &= parseUint(str, "delay", &delay);
+    uint32_t gains[REF_SES_STAGES] = {0};
+    str = getCmdOption(argc, argv, "+gains=");
+    for (unsigned int k = 0; k < REF_SES_STAGES && !str.empty(); k++) {
+        size_t sep = str.find(',');
+        ok &= parseUint(str.substr(0, sep), "gains", &gains[k]);
+        str = sep != std::string::npos ? str.substr(sep + 1) : "";
+    }
+    bool skip_zeros = getCmdOption(argc, argv, "+skip_zeros=") == "1";
+
+    // dLC configuration (same register values as the firmware)
+    bool dlc_en = false;
+    RefDlc dlc;
+    str = getCmdOption(argc, argv, "+dlc=");
+    if (!str.empty()) {
+        uint32_t field[6] = {0, 0, 0, 0, 0, 0};
+        unsigned int n = 0;
+        for (; n < 6 && !str.empty(); n++) {
+            size_t sep = str.find(':');
+            ok &= parseUint(str.substr(0, sep), "dlc", &field[n]);
+            str = sep != std::string::npos ? str.substr(sep + 1) : "";
+        }
+        if (n < 3 || field[1] > 15 || field[2] > 16) {
+            VP_ERR("Invalid dLC configuration '%s'", getCmdOption(argc, argv, "+dlc=").c_str());
+            ok = false;
+        }
+        dlc.dlvl_log_level_width = field[0];
+        dlc.dlvl_n_bits = field[1];
+        dlc.dlvl_mask = (1 << field[1]) - 1;
+        dlc.dt_mask = (1 << field[2]) - 1;
+        dlc.hysteresis_en = field[3];
+        dlc.discard_bits = field[4];
+        dlc.dlvl_format = field[5];
+        dlc_en = true;
+    }
+    if (!ok) exit(EXIT_FAILURE);
+
+    // ΔΣ input
+    std::string input = getCmdOption(argc, argv, "+input=");
+    if (input.empty()) input = PDM_DUMMY_FILENAME;
+    if (!dsm_source.open(input)) exit(EXIT_FAILURE);
+    std::vector<uint8_t> bits(samples);
+    for (uint32_t i = 0; i < samples; i++) bits[i] = dsm_source.getBit(i);
+
+    // RUN THE MODELS
+    // --------------
+    std::vector<uint32_t> data;
+    if (ses) {
+        RefSesFilter model;
+        model.window_size = window;
+        model.decim_factor = decim;
+        model.activated = stages;
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) model.gain[k] = gains[k];
+        model.process(bits.data(), bits.size(), data);
+
+        defines.push_back(std::make_pair(prefix + "_WINDOW_SIZE", std::to_string(window)));
+        defines.push_back(std::make_pair(prefix + "_DECIM_FACTOR", std::to_string(decim)));
+        defines.push_back(std::make_pair(prefix + "_ACTIVATED_STAGES", std::to_string(stages)));
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            defines.push_back(std::make_pair(prefix + "_GAIN_STAGE_" + std::to_string(k), std::to_string(gains[k])));
+        }
+    } else {
+        RefCic model;
+        model.decim = decim;
+        model.activated = stages;
+        model.delay_comb = delay;
+        model.process(bits.data(), bits.size(), data);
+
+        defines.push_back(std::make_pair(prefix + "_DECIM_FACTOR", std::to_string(decim)));
+        defines.push_back(std::make_pair(prefix + "_ACTIVATED_STAGES", std::to_string(stages)));
+        defines.push_back(std::make_pair(prefix + "_DELAY_COMB", std::to_string(delay)));
+    }
+    VP_LOG(LOG_HIGH, "%s: %u input bits, %zu outputs", filter.c_str(), samples, data.size());
+
+    // Outputs read by the firmware
+    size_t first = 0;
+    if (skip_zeros) {
+        while (first < data.size() && data[first] == 0) first++;
+    }
+    data.erase(data.begin(), data.begin() + first);
+    // The array may hold more outputs than the firmware checks
+    if (length == 0) length = outputs;
+    if (length != 0 && data.size() > length) data.resize(length);
+    if (data.size() < length || data.size() < outputs) {
+        VP_WARN("Only %zu outputs out of %u: increase +samples", data.size(), std::max(length, outputs));
+    }
+    if (outputs != 0) defines.push_back(std::make_pair(prefix + "_OUTPUT_NUMBER", std::to_string(outputs)));
+
+    // dLC packets
+    if (dlc_en) {
+        std::vector<uint16_t> packets;
+        dlc.process(data.data(), data.size(), packets);
+        VP_LOG(LOG_HIGH, "dLC: %lu level crossings, %zu packets", dlc.crossings, packets.size());
+        data.assign(packets.begin(), packets.end());
+    }
+
+    // Additional parameters
+    str = getCmdOption(argc, argv, "+defines=");
+    while (!str.empty()) {
+        size_t sep = str.find(',');
+        std::string def = str.substr(0, sep);
+        size_t eq = def.find('=');
+        if (eq != std::string::npos) defines.push_back(std::make_pair(def.substr(0, eq), def.substr(eq + 1)));
+        str = sep != std::string::npos ? str.substr(sep + 1) : "";
+    }
+
+    // WRITE THE HEADERS
+    // -----------------
+    std::string params_file = getCmdOption(argc, argv, "+params=");
+    if (!params_file.empty() && !writeParams(params_file, defines)) exit(EXIT_FAILURE);
+
+    std::string type = getCmdOption(argc, argv, "+type=");
+    std::string name = getCmdOption(argc, argv, "+array=");
+    bool hex = getCmdOption(argc, argv, "+format=") == "hex";
+    if (!writeArray(getCmdOption(argc, argv, "+output="), type.empty() ? "uint32_t" : type,
+                    name.empty() ? "groundtruth" : name, hex, data)) {
+        exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+std::string getCmdOption(int argc, char* argv[], const std::string& option)
+{
+    std::string cmd;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find(option) == 0) {
+            cmd = arg.substr(option.length());
+        }
+    }
+    return cmd;
+}
+
+static bool parseUint(const std::string& str, const char *name, uint32_t *val)
+{
+    const char *start = str.c_str();
+    int base = 0;
+    if (str.compare(0, 2, "0b") == 0) {
+        start += 2;
+        base = 2;
+    }
+    char *end;
+    errno = 0;
+    unsigned long v = strtoul(start, &end, base);
+    if (*start == '\0' || *end != '\0' || errno != 0 || v > UINT32_MAX) {
+        VP_ERR("Invalid %s value '%s'", name, str.c_str());
+        return false;
+    }
+    *val = v;
+    return true;
+}
+
+static bool writeParams(const std::string& filename,
+                        const std::vector<std::pair<std::string, std::string> >& defines)
+{
+    FILE *fp = fopen(filename.c_str(), "w");
+    if (fp == NULL) {
+        VP_ERR("Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    // Include guard from the file name
+    std::string guard = filename.substr(filename.find_last_of('/') + 1);
+    for (size_t i = 0; i < guard.size(); i++) guard[i] = isalnum(guard[i]) ? toupper(guard[i]) : '_';
+
+    fprintf(fp, "// Generated by tb/models/ref_groundtruth.cpp (see the application Makefile)\n\n");
+    fprintf(fp, "#ifndef %s\n#define %s\n\n", guard.c_str(), guard.c_str());
+    for (size_t i = 0; i < defines.size(); i++) {
+        fprintf(fp, "#define %s %s\n", defines[i].first.c_str(), defines[i].second.c_str());
+    }
+    fprintf(fp, "\n#endif\n");
+    fclose(fp);
+    return true;
+}
+
+static bool writeArray(const std::string& filename, const std::string& type,
+                       const std::string& name, bool hex, const std::vector<uint32_t>& data)
+{
+    FILE *fp = filename.empty() ? stdout : fopen(filename.c_str(), "w");
+    if (fp == NULL) {
+        VP_ERR("Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    fprintf(fp, "// Generated by tb/models/ref_groundtruth.cpp (see the application Makefile)\n\n");
+    fprintf(fp, "#include <stdint.h>\n\n%s %s[] = {\n", type.c_str(), name.c_str());
+    for (size_t i = 0; i < data.size(); i++) {
+        if (hex) fprintf(fp, "0x%08x,\n", data[i]);
+        else fprintf(fp, "\t%u,\n", data[i]);
+    }
+    fprintf(fp, "};\n");
+    if (fp != stdout) fclose(fp);
+    return true;
+}
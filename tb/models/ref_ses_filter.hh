@@ -0,0 +1,242 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: ref_ses_filter.hh
+// Description: Bit-accurate reference model of the SES filter (ses_filter.sv
+//              and ses_stage.sv): cascade of exponential smoothing stages on
+//              the 1-bit ΔΣ input, followed by the decimator.
+
+#if !defined(REF_SES_FILTER_HH_)
+#define REF_SES_FILTER_HH_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+// Number of stages (SesStageNumber)
+#define REF_SES_STAGES 6
+
+// Width of the register fields
+#define REF_SES_WINDOW_MASK 0x1f
+#define REF_SES_DECIM_MASK 0x3ff
+#define REF_SES_GAIN_MASK 0x1f
+#define REF_SES_GAIN_BITS 5
+
+// Data path width of the HEEPidermis instance (MAXIMUM_WIDTH)
+#define REF_SES_WIDTH 24
+
+class RefSesFilter
+{
+private:
+    uint32_t mask;
+    uint32_t r[REF_SES_STAGES];    // r_summed_value of each stage
+    uint32_t decim_counter;
+
+public:
+    // Configuration (SES_WINDOW_SIZE, SES_DECIM_FACTOR, SES_ACTIVATED_STAGES
+    // and SES_GAIN_STAGE registers). It may be changed between edges.
+    uint32_t window_size;
+    uint32_t decim_factor;
+    uint32_t activated;
+    uint32_t gain[REF_SES_STAGES];
+
+    RefSesFilter(unsigned int width = REF_SES_WIDTH)
+    {
+        this->mask = width >= 32 ? 0xffffffff : (1u << width) - 1;
+        this->window_size = 0;
+        this->decim_factor = 0;
+        this->activated = 0;
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->gain[k] = 0;
+        this->reset();
+    }
+
+    // Reset of the filter state (rst_ni)
+    void reset()
+    {
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->r[k] = 0;
+        this->decim_counter = 0;
+    }
+
+    // Set the gains from the packed SES_GAIN_STAGE register
+    void setGainStage(uint32_t gain_stage)
+    {
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            this->gain[k] = (gain_stage >> (REF_SES_GAIN_BITS * k)) & REF_SES_GAIN_MASK;
+        }
+    }
+
+    // Index of the highest activated stage, plus one (0 if none): the output
+    // multiplexer selects the input when no stage is activated
+    static unsigned int msbIndex(uint32_t activated)
+    {
+        unsigned int msb = 0;
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            if ((activated >> k) & 1) msb = k + 1;
+        }
+        return msb;
+    }
+
+    // Rising edge of the filter clock with the ΔΣ input bit. Returns true
+    // when the decimator registers a new output (filtered_data), which is
+    // the multiplexer output before the edge.
+    bool edge(uint8_t bit, uint32_t *filtered)
+    {
+        uint32_t out[REF_SES_STAGES + 1];
+        uint32_t window = this->window_size & REF_SES_WINDOW_MASK;
+        out[0] = bit & 1;
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) out[k + 1] = this->r[k] >> window;
+
+        bool valid = false;
+        if (this->decim_counter >= (this->decim_factor & REF_SES_DECIM_MASK)) {
+            *filtered = out[msbIndex(this->activated)];
+            this->decim_counter = 1;
+            valid = true;
+        } else {
+            this->decim_counter = (this->decim_counter + 1) & REF_SES_DECIM_MASK;
+        }
+
+        // r += (in << Wg) - (r >> Ww), truncated to MAXIMUM_WIDTH
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            if ((this->activated >> k) & 1) {
+                uint32_t shifted = (out[k] << (this->gain[k] & REF_SES_GAIN_MASK)) & this->mask;
+                this->r[k] = (this->r[k] + shifted + (~out[k + 1] + 1)) & this->mask;
+            } else {
+                this->r[k] = 0;
+            }
+        }
+        return valid;
+    }
+
+    // Process n input bits (one per filter clock edge) and append the
+    // decimated outputs. The configuration is read once, and only the
+    // stages up to the highest activated one are updated. Returns the
+    // number of outputs appended.
+    size_t process(const uint8_t *bits, size_t n, std::vector<uint32_t>& out)
+    {
+        const uint32_t mask = this->mask;
+        const uint32_t window = this->window_size & REF_SES_WINDOW_MASK;
+        const uint32_t decim = this->decim_factor & REF_SES_DECIM_MASK;
+        const unsigned int msb = msbIndex(this->activated);
+        uint32_t gain[REF_SES_STAGES];
+        bool active[REF_SES_STAGES];
+        uint32_t r[REF_SES_STAGES];
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            gain[k] = this->gain[k] & REF_SES_GAIN_MASK;
+            active[k] = (this->activated >> k) & 1;
+            r[k] = this->r[k];
+        }
+        uint32_t counter = this->decim_counter;
+        size_t size = out.size();
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t in = bits[i] & 1;
+            if (counter >= decim) {
+                out.push_back(msb != 0 ? r[msb - 1] >> window : in);
+                counter = 1;
+            } else {
+                counter = (counter + 1) & REF_SES_DECIM_MASK;
+            }
+            for (unsigned int k = 0; k < msb; k++) {
+                uint32_t r_out = r[k] >> window;
+                if (active[k]) r[k] = (r[k] + ((in << gain[k]) & mask) - r_out) & mask;
+                else r[k] = 0;
+                in = r_out;
+            }
+        }
+
+        // The stages above the highest activated one are held in reset
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->r[k] = (k < msb || n == 0) ? r[k] : 0;
+        this->decim_counter = counter;
+        return out.size() - size;
+    }
+};
+
+// Number of filters of a bank (one 256-bit SIMD register of 32-bit lanes)
+#define REF_SES_BANK_LANES 8
+
+// Bank of SES filters fed with the same input, sharing the activated stages
+// and the decimation factor, with a window size and gains per lane. Each
+// stage of the bank is one SIMD vector (GCC/Clang vector extension, lowered
+// to variable shifts with AVX2), so a bank costs about as much as a single
+// filter.
+class RefSesFilterBank
+{
+public:
+    typedef uint32_t Lanes __attribute__((vector_size(4 * REF_SES_BANK_LANES)));
+
+private:
+    uint32_t mask;
+    Lanes r[REF_SES_STAGES];
+    uint32_t decim_counter;
+
+public:
+    // Shared configuration
+    uint32_t decim_factor;
+    uint32_t activated;
+
+    // Configuration of each lane
+    uint32_t window_size[REF_SES_BANK_LANES];
+    uint32_t gain[REF_SES_STAGES][REF_SES_BANK_LANES];
+
+    RefSesFilterBank(unsigned int width = REF_SES_WIDTH)
+    {
+        this->mask = width >= 32 ? 0xffffffff : (1u << width) - 1;
+        this->decim_factor = 0;
+        this->activated = 0;
+        for (unsigned int l = 0; l < REF_SES_BANK_LANES; l++) {
+            this->window_size[l] = 0;
+            for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->gain[k][l] = 0;
+        }
+        this->reset();
+    }
+
+    void reset()
+    {
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->r[k] = Lanes{};
+        this->decim_counter = 0;
+    }
+
+    // Process n input bits and append the decimated outputs of each lane to
+    // out[lane]. Returns the number of outputs appended to each lane.
+    size_t process(const uint8_t *bits, size_t n, std::vector<uint32_t> out[REF_SES_BANK_LANES])
+    {
+        const uint32_t decim = this->decim_factor & REF_SES_DECIM_MASK;
+        const unsigned int msb = RefSesFilter::msbIndex(this->activated);
+        Lanes window = Lanes{}, gain[REF_SES_STAGES], keep[REF_SES_STAGES], r[REF_SES_STAGES];
+        for (unsigned int l = 0; l < REF_SES_BANK_LANES; l++) window[l] = this->window_size[l] & REF_SES_WINDOW_MASK;
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+            for (unsigned int l = 0; l < REF_SES_BANK_LANES; l++) gain[k][l] = this->gain[k][l] & REF_SES_GAIN_MASK;
+            // Inactive stages are held at 0
+            keep[k] = Lanes{} + (((this->activated >> k) & 1) ? this->mask : 0);
+            r[k] = this->r[k];
+        }
+        const Lanes mask = Lanes{} + this->mask;
+        uint32_t counter = this->decim_counter;
+        size_t count = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            Lanes in = Lanes{} + (uint32_t)(bits[i] & 1);
+            if (counter >= decim) {
+                Lanes filtered = msb != 0 ? r[msb - 1] >> window : in;
+                for (unsigned int l = 0; l < REF_SES_BANK_LANES; l++) out[l].push_back(filtered[l]);
+                counter = 1;
+                count++;
+            } else {
+                counter = (counter + 1) & REF_SES_DECIM_MASK;
+            }
+            // All the stages are updated, so that the state stays in registers
+            for (unsigned int k = 0; k < REF_SES_STAGES; k++) {
+                Lanes r_out = r[k] >> window;
+                r[k] = (r[k] + ((in << gain[k]) & mask) - r_out) & keep[k];
+                in = r_out;
+            }
+        }
+
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) this->r[k] = (k < msb || n == 0) ? r[k] : Lanes{};
+        this->decim_counter = counter;
+        return count;
+    }
+};
+
+#endif // REF_SES_FILTER_HH_
@@ -0,0 +1,705 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: ref_sweep.cpp
+// Description: Design-space exploration of the SES filter and CIC settings.
+//              Runs the reference models on a set of ΔΣ inputs for every
+//              combination of the swept parameters, on all the cores, and
+//              ranks the configurations by ENOB, output rate and power. The
+//              results and their Pareto front are written as CSV files.
+
+// System libraries
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <map>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// User libraries
+#include "vp_log.hh"
+#include "tb_dsm.hh"
+#include "ref_ses_filter.hh"
+#include "ref_cic.hh"
+
+// Defines
+// -------
+#define SES_SIGNAL_DIR "hw/ip/cheep-peripherals/SES_filter/tb/signal/"
+// (SES_tdata_real.txt, 4589 bits, is too short for the slowest settings)
+#define DEFAULT_INPUTS SES_SIGNAL_DIR "SES_tdata_EAPs.txt," SES_SIGNAL_DIR "SES_tdata_LFPs.txt"
+#define DEFAULT_ENERGY_TABLE "config/energy_table.cfg"
+#define DEFAULT_OUTPUT "build/ref-models/sweep.csv"
+
+// Input bits of the sources without a length (sine, PCM with +samples)
+#define DEFAULT_SAMPLES 131072
+
+// Oversampling ratio of the signal of the inputs (the EAP and LFP test
+// signals are below 1/4096 cycles per bit)
+#define DEFAULT_OSR 1024
+
+// System clock (same default as the throughput benchmarks)
+#define DEFAULT_CLK_KHZ 100000
+
+// Fraction of the input discarded at each end (edge effects of the reference)
+#define EDGE_FRACTION 0.05
+
+// Outputs needed for a measurement, and outputs used for the coarse search
+// of the filter delay
+#define MIN_OUTPUTS 16
+#define COARSE_OUTPUTS 1024
+
+// Types
+// -----
+// ΔΣ input
+typedef struct {
+    std::string name;
+    std::vector<uint8_t> bits;
+} sweep_input_t;
+
+// Filter configuration (the clock division only changes the rates)
+typedef struct {
+    uint32_t window;                    // SES
+    uint32_t decim;
+    uint32_t stages;                    // activated stages
+    uint32_t gains[REF_SES_STAGES];     // SES
+    uint32_t delay;                     // CIC
+    std::vector<double> snr;            // per input (NAN: input too short)
+} sweep_config_t;
+
+// Configuration at a given clock division
+typedef struct {
+    size_t config;
+    uint32_t clkdiv;
+    double enob;                        // mean over the inputs
+    double rate_hz;
+    double power_uw;
+    bool pareto;
+} sweep_point_t;
+
+// Function prototypes
+// -------------------
+// Process runtime parameters
+std::string getCmdOption(int argc, char* argv[], const std::string& option);
+
+// Parse an unsigned parameter (decimal, 0x or 0b prefix)
+static bool parseUint(const std::string& str, const char *name, uint32_t *val);
+
+// Parse a list of values: comma-separated values or ranges 'first:last[:step]'
+static bool parseList(const std::string& str, const char *name, std::vector<uint32_t>& list);
+
+// Load the per-event energy table (see tb/verilator/tb_energy.hh)
+static bool loadEnergyTable(const std::string& filename, std::map<std::string, double>& table);
+
+// Run fn(0) ... fn(n - 1) on the worker threads
+static void parallelFor(size_t n, unsigned int threads, const std::function<void(size_t)>& fn);
+
+// Zero-phase brickwall low-pass of the ±1 bitstream with the cutoff in
+// cycles per input bit
+static void referenceSignal(const std::vector<uint8_t>& bits, double cutoff, std::vector<double>& ref);
+
+// SNR of the outputs y (output m taken after input first + m * period)
+// against the reference delayed by the filter, searched around delay
+static double measureSnr(const std::vector<double>& y, size_t first, size_t period,
+                         size_t delay, size_t settle, const std::vector<double>& ref);
+
+static double enob(double snr);
+
+// Write the points as CSV
+static bool writeCsv(const std::string& filename, bool ses, const std::vector<sweep_input_t>& inputs,
+                     const std::vector<sweep_config_t>& configs, const std::vector<sweep_point_t>& points,
+                     bool pareto_only);
+
+// Global variables
+// ----------------
+// ΔΣ bitstream source (tb_dsm.cpp)
+TbDsmSource dsm_source;
+
+int main(int argc, char *argv[])
+{
+    // COMMAND-LINE OPTIONS
+    // --------------------
+    const option longopts[] = {
+        {"help", no_argument, NULL, 'h'},
+        {"log_level", required_argument, NULL, 'l'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hl:", longopts, NULL)) >= 0) {
+        switch (opt) {
+        case 'h':
+            printf("Usage: %s [OPTIONS] +filter=<ses|cic> [+PLUSARGS]\n", argv[0]);
+            printf("Options:\n");
+            printf("  -h, --help\t\t\tPrint this help message\n");
+            printf("  -l, --log_level=LOG_LEVEL\tSet the log level\n");
+            printf("Plusargs (lists are comma-separated values or ranges FIRST:LAST[:STEP]):\n");
+            printf("  +filter=<ses|cic>\t\tFilter to sweep\n");
+            printf("  +inputs=<spec,...>\t\tΔΣ inputs, same as +dsm_source (default: SES_tdata_EAPs.txt,\n");
+            printf("  \t\t\t\tSES_tdata_LFPs.txt)\n");
+            printf("  +samples=<N>\t\t\tMaximum input bits (default: %d for the sources without a length)\n",
+                   DEFAULT_SAMPLES);
+            printf("  +window=<list>\t\tSES window sizes (default: 2:7)\n");
+            printf("  +decim=<list>\t\t\tDecimation factors (default: 8,16,32,64,128 for the SES,\n");
+            printf("  \t\t\t\t1:15 for the CIC)\n");
+            printf("  +stages=<list>\t\tNumbers of activated stages (default: 1:6)\n");
+            printf("  +gain0=<list>\t\t\tSES gain of the first stage (default: 0:12:2)\n");
+            printf("  +gain=<list>\t\t\tSES gain of the other stages (default: 0:3)\n");
+            printf("  +sysclk_div=<list>\t\tSES clock divisions (default: 16,32,64,128)\n");
+            printf("  +delay=<list>\t\t\tCIC comb delays (default: 1,2)\n");
+            printf("  +clkdividx=<list>\t\tCIC clock divider values (default: 4,8,16,32)\n");
+            printf("  +osr=<N>\t\t\tOversampling ratio of the signal: its band is 1/(2 x OSR) of the\n");
+            printf("  \t\t\t\tinput bit rate (default: %d)\n", DEFAULT_OSR);
+            printf("  +clk_khz=<N>\t\t\tSystem clock frequency in kHz (default: %d)\n", DEFAULT_CLK_KHZ);
+            printf("  +energy_table=<file>\t\tPer-event energy table (default: %s)\n", DEFAULT_ENERGY_TABLE);
+            printf("  +threads=<N>\t\t\tWorker threads (default: all the cores)\n");
+            printf("  +output=<file>\t\tRanked results (default: %s); the Pareto front is\n", DEFAULT_OUTPUT);
+            printf("  \t\t\t\twritten to <file>-pareto.csv\n");
+            exit(0);
+            break;
+        case 'l':
+            vpSetLogLvl(optarg);
+            break;
+        default:
+            printf("Usage: %s [OPTIONS] +filter=<ses|cic> [+PLUSARGS]\n", argv[0]);
+            printf("Try '%s --help' for more information.\n", argv[0]);
+            exit(1);
+            break;
+        }
+    }
+
+    // Parse the remaining command-line arguments
+    // ------------------------------------------
+    std::string filter = getCmdOption(argc, argv, "+filter=");
+    bool ses = filter == "ses";
+    if (!ses && filter != "cic") {
+        VP_ERR("Unknown filter '%s' (ses or cic)", filter.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+    std::string str;
+    bool ok = true;
+    uint32_t samples = 0;
+    uint32_t clk_khz = DEFAULT_CLK_KHZ;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t osr = DEFAULT_OSR;
+    if (!(str = getCmdOption(argc, argv, "+samples=")).empty()) ok &= parseUint(str, "samples", &samples);
+    if (!(str = getCmdOption(argc, argv, "+clk_khz=")).empty()) ok &= parseUint(str, "clk_khz", &clk_khz);
+    if (!(str = getCmdOption(argc, argv, "+threads=")).empty()) ok &= parseUint(str, "threads", &threads);
+    if (!(str = getCmdOption(argc, argv, "+osr=")).empty()) ok &= parseUint(str, "osr", &osr);
+    if (threads == 0) threads = 1;
+    if (osr == 0) osr = 1;
+
+    // Swept parameters
+    std::vector<uint32_t> windows, decims, stages, gain0s, gains, clkdivs, delays;
+    ok &= parseList(getCmdOption(argc, argv, "+window="), "window", windows);
+    ok &= parseList(getCmdOption(argc, argv, "+decim="), "decim", decims);
+    ok &= parseList(getCmdOption(argc, argv, "+stages="), "stages", stages);
+    ok &= parseList(getCmdOption(argc, argv, "+gain0="), "gain0", gain0s);
+    ok &= parseList(getCmdOption(argc, argv, "+gain="), "gain", gains);
+    ok &= parseList(getCmdOption(argc, argv, ses ? "+sysclk_div=" : "+clkdividx="), ses ? "sysclk_div" : "clkdividx", clkdivs);
+    ok &= parseList(getCmdOption(argc, argv, "+delay="), "delay", delays);
+    if (!ok) exit(EXIT_FAILURE);
+    if (windows.empty()) parseList("2:7", "window", windows);
+    if (decims.empty()) parseList(ses ? "8,16,32,64,128" : "1:15", "decim", decims);
+    if (stages.empty()) parseList("1:6", "stages", stages);
+    if (gain0s.empty()) parseList("0:12:2", "gain0", gain0s);
+    if (gains.empty()) parseList("0:3", "gain", gains);
+    if (clkdivs.empty()) parseList(ses ? "16,32,64,128" : "4,8,16,32", "clkdiv", clkdivs);
+    if (delays.empty()) parseList("1,2", "delay", delays);
+
+    // Register field limits
+    for (uint32_t n : stages) ok &= n >= 1 && n <= REF_SES_STAGES;
+    if (ses) {
+        for (uint32_t w : windows) ok &= w <= REF_SES_WINDOW_MASK;
+        for (uint32_t d : decims) ok &= d <= REF_SES_DECIM_MASK;
+        for (uint32_t g : gain0s) ok &= g <= REF_SES_GAIN_MASK;
+        for (uint32_t g : gains) ok &= g <= REF_SES_GAIN_MASK;
+        for (uint32_t c : clkdivs) ok &= c >= 2;
+    } else {
+        for (uint32_t d : decims) ok &= d <= REF_CIC_DECIM_MASK;
+        for (uint32_t d : delays) ok &= d <= REF_CIC_DELAY_MASK;
+        for (uint32_t c : clkdivs) ok &= c <= 0xffff;
+    }
+    if (!ok) {
+        VP_ERR("Swept value out of the register range");
+        exit(EXIT_FAILURE);
+    }
+
+    // Energy per event
+    std::map<std::string, double> energy;
+    str = getCmdOption(argc, argv, "+energy_table=");
+    if (!loadEnergyTable(str.empty() ? DEFAULT_ENERGY_TABLE : str, energy)) exit(EXIT_FAILURE);
+
+    // ΔΣ inputs
+    std::vector<sweep_input_t> inputs;
+    str = getCmdOption(argc, argv, "+inputs=");
+    if (str.empty()) str = DEFAULT_INPUTS;
+    while (!str.empty()) {
+        size_t sep = str.find(',');
+        std::string spec = str.substr(0, sep);
+        str = sep != std::string::npos ? str.substr(sep + 1) : "";
+        TbDsmSource source;
+        if (!source.open(spec)) exit(EXIT_FAILURE);
+        uint64_t length = source.getLength();
+        if (length == 0 || (samples != 0 && samples < length)) length = samples != 0 ? samples : DEFAULT_SAMPLES;
+
+        sweep_input_t input;
+        input.name = spec.substr(spec.find_last_of('/') + 1);
+        input.name = input.name.substr(0, input.name.find_first_of(".:"));
+        input.bits.resize(length);
+        for (uint64_t i = 0; i < length; i++) input.bits[i] = source.getBit(i);
+        VP_LOG(LOG_MEDIUM, "Input %s: %lu bits", input.name.c_str(), length);
+        inputs.push_back(input);
+    }
+
+    // Configurations. The SES configurations are grouped by decimation factor
+    // and activated stages, which the lanes of a filter bank share.
+    std::vector<sweep_config_t> configs;
+    for (uint32_t d : decims) {
+        for (uint32_t n : stages) {
+            sweep_config_t config;
+            memset(config.gains, 0, sizeof(config.gains));
+            config.decim = d;
+            config.stages = (1 << n) - 1;
+            config.window = 0;
+            config.delay = 0;
+            config.snr.assign(inputs.size(), NAN);
+            if (ses) {
+                for (uint32_t w : windows) {
+                    for (uint32_t g0 : gain0s) {
+                        for (uint32_t g : gains) {
+                            config.window = w;
+                            config.gains[0] = g0;
+                            for (unsigned int k = 1; k < REF_SES_STAGES; k++) config.gains[k] = g;
+                            configs.push_back(config);
+                        }
+                    }
+                }
+            } else {
+                for (uint32_t delay : delays) {
+                    config.delay = delay;
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+    VP_LOG(LOG_LOW, "Sweeping %zu %s configurations x %zu clock divisions on %zu inputs (%u threads)",
+           configs.size(), ses ? "SES" : "CIC", clkdivs.size(), inputs.size(), threads);
+
+    // REFERENCE SIGNALS
+    // -----------------
+    // Signal band of each input: the outputs are compared to it, so that the
+    // noise left above the band and the aliases lower the SNR
+    std::vector<std::vector<double> > refs(inputs.size());
+    parallelFor(inputs.size(), threads, [&](size_t i) {
+        referenceSignal(inputs[i].bits, 0.5 / osr, refs[i]);
+    });
+
+    // RUN THE MODELS
+    // --------------
+    // Work items: (SES filter bank or CIC configuration, input)
+    std::vector<std::vector<size_t> > groups;
+    for (size_t c = 0; c < configs.size(); c++) {
+        bool same = !groups.empty() && groups.back().size() < (ses ? REF_SES_BANK_LANES : 1) &&
+                    configs[groups.back()[0]].decim == configs[c].decim &&
+                    configs[groups.back()[0]].stages == configs[c].stages;
+        if (same) groups.back().push_back(c);
+        else groups.push_back(std::vector<size_t>(1, c));
+    }
+    std::atomic<size_t> done(0);
+    parallelFor(groups.size() * inputs.size(), threads, [&](size_t item) {
+        const std::vector<size_t>& group = groups[item / inputs.size()];
+        size_t i = item % inputs.size();
+        const std::vector<uint8_t>& bits = inputs[i].bits;
+        const sweep_config_t& first = configs[group[0]];
+        unsigned int msb = RefSesFilter::msbIndex(first.stages);
+        std::vector<uint32_t> out[REF_SES_BANK_LANES];
+        std::vector<double> y;
+
+        if (ses) {
+            // Unused lanes repeat the first configuration
+            RefSesFilterBank bank;
+            bank.decim_factor = first.decim;
+            bank.activated = first.stages;
+            for (unsigned int l = 0; l < REF_SES_BANK_LANES; l++) {
+                const sweep_config_t& config = configs[group[l < group.size() ? l : 0]];
+                bank.window_size[l] = config.window;
+                for (unsigned int k = 0; k < REF_SES_STAGES; k++) bank.gain[k][l] = config.gains[k];
+            }
+            bank.process(bits.data(), bits.size(), out);
+
+            // Output m is registered at edge decim + m * period, before the
+            // edge input; each stage delays the signal by 2^window - 1
+            uint32_t period = std::max(first.decim, 1u);
+            for (size_t l = 0; l < group.size(); l++) {
+                sweep_config_t& config = configs[group[l]];
+                size_t delay = msb * ((1ul << config.window) - 1);
+                y.assign(out[l].begin(), out[l].end());
+                config.snr[i] = measureSnr(y, first.decim > 0 ? first.decim - 1 : 0, period,
+                                           delay, 4 * delay + period, refs[i]);
+            }
+        } else {
+            RefCic model;
+            model.decim = first.decim;
+            model.activated = first.stages;
+            model.delay_comb = first.delay;
+            model.process(bits.data(), bits.size(), out[0]);
+
+            // Output m is written at sample decim + m * period; the 24-bit
+            // outputs are signed
+            uint32_t period = first.decim + 1;
+            y.resize(out[0].size());
+            for (size_t m = 0; m < y.size(); m++) y[m] = (int32_t)(out[0][m] << (32 - REF_CIC_WIDTH)) >> (32 - REF_CIC_WIDTH);
+            size_t delay = (msb * (period * std::max(first.delay, 1u) - 1)) / 2 + period;
+            configs[group[0]].snr[i] = measureSnr(y, first.decim, period, delay, 4 * delay + period, refs[i]);
+        }
+        size_t count = ++done;
+        if (count % 64 == 0) VP_LOG(LOG_HIGH, "%zu/%zu runs", count, groups.size() * inputs.size());
+    });
+
+    // RATES AND POWER
+    // ---------------
+    double f_sys = clk_khz * 1e3;
+    std::string block = ses ? "ses" : "cic";
+    double e_on = energy[block + "_on"];
+    double e_sample = energy[block + "_sample"];
+    // Each output is read from the FIFO and stored in the SRAM
+    double e_output = energy[block + "_output"] + energy["reg_" + block] + energy["sram_write"];
+
+    std::vector<sweep_point_t> points;
+    size_t unmeasured = 0;
+    for (size_t c = 0; c < configs.size(); c++) {
+        // Only the configurations measured on all the inputs are ranked
+        double sum = 0.0;
+        for (double snr : configs[c].snr) sum += enob(snr);
+        if (std::isnan(sum)) {
+            unmeasured++;
+            continue;
+        }
+
+        for (uint32_t clkdiv : clkdivs) {
+            sweep_point_t point;
+            point.config = c;
+            point.clkdiv = clkdiv;
+            point.enob = sum / inputs.size();
+            double f_in;
+            if (ses) {
+                // One input bit per filter clock period (2 x sysclk_division / 2)
+                f_in = f_sys / (2 * (clkdiv >> 1));
+                point.rate_hz = f_in / std::max(configs[c].decim, 1u);
+            } else {
+                // clk_int_div divides by CLKDIVIDX / 2 (0 or 1: bypassed), and
+                // the PDM core takes one bit every two divided clock periods
+                uint32_t div = (clkdiv >> 1) & 0x7fff;
+                f_in = f_sys / (2 * (div < 2 ? 1 : div));
+                point.rate_hz = f_in / (configs[c].decim + 1);
+            }
+            point.power_uw = (f_sys * e_on + f_in * e_sample + point.rate_hz * e_output) * 1e-6;
+            point.pareto = true;
+            points.push_back(point);
+        }
+    }
+    if (unmeasured != 0) {
+        VP_WARN("%zu configurations not ranked: the inputs are too short for the filter to settle", unmeasured);
+    }
+    if (points.empty()) {
+        VP_ERR("No configuration could be measured: use longer inputs");
+        exit(EXIT_FAILURE);
+    }
+
+    // RANKING AND PARETO FRONT
+    // ------------------------
+    std::sort(points.begin(), points.end(), [](const sweep_point_t& a, const sweep_point_t& b) {
+        if (a.enob != b.enob) return a.enob > b.enob;
+        if (a.rate_hz != b.rate_hz) return a.rate_hz > b.rate_hz;
+        return a.power_uw < b.power_uw;
+    });
+
+    // A point is dominated when another one is at least as good on the ENOB,
+    // the output rate and the power, and better on one of them
+    parallelFor(points.size(), threads, [&](size_t p) {
+        const sweep_point_t& a = points[p];
+        for (size_t q = 0; q < points.size() && points[q].enob >= a.enob; q++) {
+            const sweep_point_t& b = points[q];
+            if (b.rate_hz >= a.rate_hz && b.power_uw <= a.power_uw &&
+                (b.enob > a.enob || b.rate_hz > a.rate_hz || b.power_uw < a.power_uw)) {
+                points[p].pareto = false;
+                break;
+            }
+        }
+    });
+
+    size_t n_pareto = 0;
+    for (const sweep_point_t& point : points) n_pareto += point.pareto;
+    VP_LOG(LOG_LOW, "%zu configurations ranked, %zu on the Pareto front", points.size(), n_pareto);
+    const sweep_config_t& best = configs[points[0].config];
+    if (ses) {
+        VP_LOG(LOG_LOW, "Best ENOB %.2f: window %u, decim %u, stages 0x%x, gains %u,%u, sysclk_div %u "
+               "(%.0f Hz, %.2f uW)", points[0].enob, best.window, best.decim, best.stages, best.gains[0],
+               best.gains[1], points[0].clkdiv, points[0].rate_hz, points[0].power_uw);
+    } else {
+        VP_LOG(LOG_LOW, "Best ENOB %.2f: decim %u, stages 0x%x, delay %u, clkdividx %u (%.0f Hz, %.2f uW)",
+               points[0].enob, best.decim, best.stages, best.delay, points[0].clkdiv, points[0].rate_hz,
+               points[0].power_uw);
+    }
+
+    // WRITE THE RESULTS
+    // -----------------
+    std::string output = getCmdOption(argc, argv, "+output=");
+    if (output.empty()) output = DEFAULT_OUTPUT;
+    std::string pareto = output;
+    if (pareto.size() > 4 && pareto.compare(pareto.size() - 4, 4, ".csv") == 0) pareto.resize(pareto.size() - 4);
+    pareto += "-pareto.csv";
+    if (!writeCsv(output, ses, inputs, configs, points, false)) exit(EXIT_FAILURE);
+    if (!writeCsv(pareto, ses, inputs, configs, points, true)) exit(EXIT_FAILURE);
+    VP_LOG(LOG_LOW, "Results written to %s and %s", output.c_str(), pareto.c_str());
+
+    exit(EXIT_SUCCESS);
+}
+
+std::string getCmdOption(int argc, char* argv[], const std::string& option)
+{
+    std::string cmd;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find(option) == 0) {
+            cmd = arg.substr(option.length());
+        }
+    }
+    return cmd;
+}
+
+static bool parseUint(const std::string& str, const char *name, uint32_t *val)
+{
+    const char *start = str.c_str();
+    int base = 0;
+    if (str.compare(0, 2, "0b") == 0) {
+        start += 2;
+        base = 2;
+    }
+    char *end;
+    errno = 0;
+    unsigned long v = strtoul(start, &end, base);
+    if (*start == '\0' || *end != '\0' || errno != 0 || v > UINT32_MAX) {
+        VP_ERR("Invalid %s value '%s'", name, str.c_str());
+        return false;
+    }
+    *val = v;
+    return true;
+}
+
+static bool parseList(const std::string& str, const char *name, std::vector<uint32_t>& list)
+{
+    std::string rest = str;
+    while (!rest.empty()) {
+        size_t sep = rest.find(',');
+        std::string item = rest.substr(0, sep);
+        rest = sep != std::string::npos ? rest.substr(sep + 1) : "";
+
+        // FIRST[:LAST[:STEP]]
+        uint32_t range[3] = {0, 0, 1};
+        unsigned int n = 0;
+        for (; n < 3 && !item.empty(); n++) {
+            size_t colon = item.find(':');
+            if (!parseUint(item.substr(0, colon), name, &range[n])) return false;
+            item = colon != std::string::npos ? item.substr(colon + 1) : "";
+        }
+        if (n == 1) range[1] = range[0];
+        if (!item.empty() || range[2] == 0 || range[1] < range[0]) {
+            VP_ERR("Invalid %s list '%s'", name, str.c_str());
+            return false;
+        }
+        for (uint64_t v = range[0]; v <= range[1]; v += range[2]) list.push_back(v);
+    }
+    return true;
+}
+
+static bool loadEnergyTable(const std::string& filename, std::map<std::string, double>& table)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        VP_ERR("Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name, block;
+        double energy_pj;
+        if (fields >> name >> block >> energy_pj) table[name] = energy_pj;
+    }
+    return true;
+}
+
+static void parallelFor(size_t n, unsigned int threads, const std::function<void(size_t)>& fn)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < n; i = next++) fn(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads && t < n; t++) pool.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread : pool) thread.join();
+}
+
+static void referenceSignal(const std::vector<uint8_t>& bits, double cutoff, std::vector<double>& ref)
+{
+    size_t size = 1;
+    while (size < bits.size()) size <<= 1;
+    std::vector<std::complex<double> > x(size);
+    for (size_t i = 0; i < bits.size(); i++) x[i] = bits[i] ? 1.0 : -1.0;
+
+    // In-place radix-2 FFT (inverse: conjugate twiddles, scaled afterwards)
+    auto fft = [&](bool inverse) {
+        for (size_t i = 1, j = 0; i < size; i++) {
+            size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(x[i], x[j]);
+        }
+        for (size_t len = 2; len <= size; len <<= 1) {
+            double angle = (inverse ? 2 : -2) * M_PI / len;
+            std::complex<double> step(cos(angle), sin(angle));
+            for (size_t i = 0; i < size; i += len) {
+                std::complex<double> w(1.0, 0.0);
+                for (size_t k = 0; k < len / 2; k++) {
+                    std::complex<double> u = x[i + k];
+                    std::complex<double> v = x[i + k + len / 2] * w;
+                    x[i + k] = u + v;
+                    x[i + k + len / 2] = u - v;
+                    w *= step;
+                }
+            }
+        }
+    };
+
+    fft(false);
+    size_t band = (size_t)(cutoff * size);
+    for (size_t k = band + 1; k < size - band; k++) x[k] = 0.0;
+    fft(true);
+
+    ref.resize(bits.size());
+    for (size_t i = 0; i < bits.size(); i++) ref[i] = x[i].real() / size;
+}
+
+static double measureSnr(const std::vector<double>& y, size_t first, size_t period,
+                         size_t delay, size_t settle, const std::vector<double>& ref)
+{
+    // Delays searched, and outputs compared (the same for all the delays):
+    // after the filter settled, and away from the ends of the reference
+    size_t n = ref.size();
+    size_t width = delay / 4 + 2 * period + 16;
+    size_t d_lo = delay > width ? delay - width : 0;
+    size_t d_hi = delay + width;
+    size_t lo = std::max((size_t)(EDGE_FRACTION * n), settle) + d_hi;
+    size_t hi = (size_t)((1.0 - EDGE_FRACTION) * n);
+    size_t m_lo = lo > first ? (lo - first + period - 1) / period : 0;
+    size_t m_hi = std::min(y.size(), hi > first ? (hi - first) / period : 0);
+    if (m_hi < m_lo + MIN_OUTPUTS) return NAN;
+
+    // Correlation coefficient of the outputs with the delayed reference
+    auto correlation = [&](size_t d, size_t stride) {
+        double sy = 0.0, sr = 0.0, syy = 0.0, srr = 0.0, syr = 0.0;
+        size_t count = 0;
+        for (size_t m = m_lo; m < m_hi; m += stride) {
+            double a = y[m];
+            double b = ref[first + m * period - d];
+            sy += a;
+            sr += b;
+            syy += a * a;
+            srr += b * b;
+            syr += a * b;
+            count++;
+        }
+        double cov = syr - sy * sr / count;
+        double var = (syy - sy * sy / count) * (srr - sr * sr / count);
+        return var > 0.0 ? cov / sqrt(var) : 0.0;
+    };
+
+    // Coarse search on a subset of the outputs, then refined on all of them
+    size_t stride = std::max((size_t)1, (m_hi - m_lo) / COARSE_OUTPUTS);
+    size_t step = std::max((size_t)1, period / 2);
+    size_t best_d = delay;
+    double best = -1.0;
+    for (size_t d = d_lo; d <= d_hi; d += step) {
+        double rho = correlation(d, stride);
+        if (rho > best) {
+            best = rho;
+            best_d = d;
+        }
+    }
+    size_t fine_lo = best_d > d_lo + step ? best_d - step : d_lo;
+    size_t fine_hi = std::min(best_d + step, d_hi);
+    best = -1.0;
+    for (size_t d = fine_lo; d <= fine_hi; d++) best = std::max(best, correlation(d, 1));
+
+    // Signal power over the power of the residual of the best linear fit
+    double rho2 = std::min(std::max(best, 0.0) * std::max(best, 0.0), 1.0 - 1e-15);
+    return rho2 / (1.0 - rho2);
+}
+
+static double enob(double snr)
+{
+    if (std::isnan(snr)) return NAN;
+    double snr_db = snr > 0.0 ? 10.0 * log10(snr) : -INFINITY;
+    return std::max((snr_db - 1.76) / 6.02, 0.0);
+}
+
+static bool writeCsv(const std::string& filename, bool ses, const std::vector<sweep_input_t>& inputs,
+                     const std::vector<sweep_config_t>& configs, const std::vector<sweep_point_t>& points,
+                     bool pareto_only)
+{
+    FILE *fp = fopen(filename.c_str(), "w");
+    if (fp == NULL) {
+        VP_ERR("Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+
+    // Register values, figures of merit, then the ENOB on each input
+    fprintf(fp, "rank,");
+    if (ses) {
+        fprintf(fp, "window_size,decim_factor,activated_stages,");
+        for (unsigned int k = 0; k < REF_SES_STAGES; k++) fprintf(fp, "gain_stage_%u,", k);
+        fprintf(fp, "sysclk_division,");
+    } else {
+        fprintf(fp, "decim_factor,activated_stages,delay_comb,clkdividx,");
+    }
+    fprintf(fp, "output_rate_hz,power_uw,enob_mean");
+    for (const sweep_input_t& input : inputs) fprintf(fp, ",enob_%s", input.name.c_str());
+    fprintf(fp, ",pareto\n");
+
+    for (size_t p = 0; p < points.size(); p++) {
+        const sweep_point_t& point = points[p];
+        const sweep_config_t& config = configs[point.config];
+        if (pareto_only && !point.pareto) continue;
+        fprintf(fp, "%zu,", p + 1);
+        if (ses) {
+            fprintf(fp, "%u,%u,0x%02x,", config.window, config.decim, config.stages);
+            for (unsigned int k = 0; k < REF_SES_STAGES; k++) fprintf(fp, "%u,", config.gains[k]);
+        } else {
+            fprintf(fp, "%u,0x%02x,%u,", config.decim, config.stages, config.delay);
+        }
+        fprintf(fp, "%u,%.1f,%.3f,%.2f", point.clkdiv, point.rate_hz, point.power_uw, point.enob);
+        for (double snr : config.snr) {
+            if (std::isnan(snr)) fprintf(fp, ",");
+            else fprintf(fp, ",%.2f", enob(snr));
+        }
+        fprintf(fp, ",%d\n", point.pareto);
+    }
+    fclose(fp);
+    return true;
+}
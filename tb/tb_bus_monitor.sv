@@ -0,0 +1,197 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_bus_monitor.sv
+// Description: Bus load monitor for the Verilator testbench (DPI). Counts the
+//              transactions, stall cycles, bytes and worst-case grant latency
+//              of each system crossbar master and slave and of each external
+//              peripheral, and reports them to the C++ testbench at the end
+//              of each time window (see tb/verilator/tb_busmon.hh). Windows
+//              are either a fixed number of cycles or the intervals in which
+//              GPIO 0 is high (measurement windows set by the firmware).
+
+`ifdef VERILATOR
+
+module tb_bus_monitor #(
+    parameter int unsigned NMASTER = core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER,
+    parameter int unsigned NSLAVE  = core_v_mini_mcu_pkg::SYSTEM_XBAR_NSLAVE,
+    parameter int unsigned NPERIPH = cheep_pkg::ExtPeriphNSlave
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input logic roi_i,   // GPIO 0 (measurement window)
+
+    // System crossbar
+    input obi_pkg::obi_req_t  [NMASTER-1:0] master_req_i,
+    input obi_pkg::obi_resp_t [NMASTER-1:0] master_resp_i,
+    input obi_pkg::obi_req_t  [ NSLAVE-1:0] slave_req_i,
+    input obi_pkg::obi_resp_t [ NSLAVE-1:0] slave_resp_i,
+
+    // External peripherals bus
+    input reg_pkg::reg_req_t [NPERIPH-1:0] periph_req_i,
+    input reg_pkg::reg_rsp_t [NPERIPH-1:0] periph_rsp_i
+);
+  import core_v_mini_mcu_pkg::*;
+  import cheep_pkg::*;
+
+  import "DPI-C" function int tb_bus_window();
+  import "DPI-C" function void tb_bus_port(input int cls, input int idx, input string name);
+  import "DPI-C" function void tb_bus_report(input int cls, input int idx, input int txns,
+                                             input int writes, input int stalls, input int bytes,
+                                             input int max_lat);
+  import "DPI-C" function void tb_bus_window_end(input int cycles);
+
+  // Port classes (see busmon_class_t in tb_busmon.hh)
+  localparam int ClsMaster = 0;
+  localparam int ClsSlave = 1;
+  localparam int ClsPeriph = 2;
+  localparam int NPorts = NMASTER + NSLAVE + NPERIPH;
+
+  int   window;  // > 0: window length in cycles, < 0: GPIO 0 windows
+  int   cycles;
+  logic roi_q;
+  int   txns    [NPorts];
+  int   writes  [NPorts];
+  int   stalls  [NPorts];
+  int   bytes   [NPorts];
+  int   lat     [NPorts];  // cycles waited by the pending request
+  int   max_lat [NPorts];
+
+  // Request, grant, write and byte count of each port in this cycle
+  logic req     [NPorts];
+  logic gnt     [NPorts];
+  logic we      [NPorts];
+  int   nbytes  [NPorts];
+
+  always_comb begin
+    for (int i = 0; i < NMASTER; i++) begin
+      req[i]    = master_req_i[i].req;
+      gnt[i]    = master_resp_i[i].gnt;
+      we[i]     = master_req_i[i].we;
+      nbytes[i] = $countones(master_req_i[i].be);
+    end
+    for (int i = 0; i < NSLAVE; i++) begin
+      req[NMASTER+i]    = slave_req_i[i].req;
+      gnt[NMASTER+i]    = slave_resp_i[i].gnt;
+      we[NMASTER+i]     = slave_req_i[i].we;
+      nbytes[NMASTER+i] = $countones(slave_req_i[i].be);
+    end
+    for (int i = 0; i < NPERIPH; i++) begin
+      req[NMASTER+NSLAVE+i]    = periph_req_i[i].valid;
+      gnt[NMASTER+NSLAVE+i]    = periph_rsp_i[i].ready;
+      we[NMASTER+NSLAVE+i]     = periph_req_i[i].write;
+      nbytes[NMASTER+NSLAVE+i] = periph_req_i[i].write ? $countones(periph_req_i[i].wstrb) : 4;
+    end
+  end
+
+  function automatic int port_class(int p);
+    if (p < NMASTER) return ClsMaster;
+    if (p < NMASTER + NSLAVE) return ClsSlave;
+    return ClsPeriph;
+  endfunction
+
+  function automatic int port_idx(int p);
+    if (p < NMASTER) return p;
+    if (p < NMASTER + NSLAVE) return p - NMASTER;
+    return p - NMASTER - NSLAVE;
+  endfunction
+
+  function automatic string master_name(int i);
+    if (i == CORE_INSTR_IDX) return "cpu_instr";
+    if (i == CORE_DATA_IDX) return "cpu_data";
+    if (i == DEBUG_MASTER_IDX) return "debug";
+    case ((i - DMA_READ_P0_IDX) % 3)
+      0: return $sformatf("dma%0d_read", (i - DMA_READ_P0_IDX) / 3);
+      1: return $sformatf("dma%0d_write", (i - DMA_READ_P0_IDX) / 3);
+      default: return $sformatf("dma%0d_addr", (i - DMA_READ_P0_IDX) / 3);
+    endcase
+  endfunction
+
+  function automatic string slave_name(int i);
+    if (i == ERROR_IDX) return "error";
+    if (i == DEBUG_IDX) return "debug";
+    if (i == AO_PERIPHERAL_IDX) return "ao_periph";
+    if (i == PERIPHERAL_IDX) return "periph";
+    if (i == FLASH_MEM_IDX) return "flash";
+    return $sformatf("ram%0d", i - ERROR_IDX - 1);
+  endfunction
+
+  function automatic string periph_name(int i);
+    if (i == CheepiDACCtrlIdx) return "idac_ctrl";
+    if (i == CheepVCODecoderIdx) return "vco_decoder";
+    if (i == CheepSESFilterIdx) return "ses_filter";
+    if (i == CheepREFsCtrlIdx) return "refs_ctrl";
+    if (i == CheepaMUXCtrlIdx) return "amux_ctrl";
+    if (i == CheepdLCIdx) return "dlc";
+    if (i == CheepCICIdx) return "cic";
+    if (i == CheepIRQCtrlIdx) return "irq_ctrl";
+    return $sformatf("periph%0d", i);
+  endfunction
+
+  // Report the counters of the current window
+  function automatic void report();
+    for (int p = 0; p < NPorts; p++) begin
+      tb_bus_report(port_class(p), port_idx(p), txns[p], writes[p], stalls[p], bytes[p], max_lat[p]);
+    end
+    tb_bus_window_end(cycles);
+  endfunction
+
+  // The monitor is opened by the C++ testbench before the first evaluation
+  initial begin
+    window = tb_bus_window();
+    if (window != 0) begin
+      for (int i = 0; i < NMASTER; i++) tb_bus_port(ClsMaster, i, master_name(i));
+      for (int i = 0; i < NSLAVE; i++) tb_bus_port(ClsSlave, i, slave_name(i));
+      for (int i = 0; i < NPERIPH; i++) tb_bus_port(ClsPeriph, i, periph_name(i));
+    end
+  end
+
+  // A window is reported on the first cycle after it ends. Fixed windows
+  // restart right away from the contribution of that cycle, GPIO 0 windows
+  // restart on the next rising edge of GPIO 0.
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      cycles <= 0;
+      roi_q  <= 1'b0;
+      for (int p = 0; p < NPorts; p++) begin
+        txns[p]    <= 0;
+        writes[p]  <= 0;
+        stalls[p]  <= 0;
+        bytes[p]   <= 0;
+        lat[p]     <= 0;
+        max_lat[p] <= 0;
+      end
+    end else if (window != 0) begin
+      automatic logic en = window > 0 || roi_i;
+      automatic logic restart = window > 0 ? cycles == window : roi_i && !roi_q;
+      roi_q <= roi_i;
+      if (window > 0 ? restart : roi_q && !roi_i) report();
+      if (!en) begin
+        cycles <= 0;
+        for (int p = 0; p < NPorts; p++) lat[p] <= 0;
+      end else begin
+        cycles <= restart ? 1 : cycles + 1;
+        for (int p = 0; p < NPorts; p++) begin
+          automatic logic done = req[p] && gnt[p];
+          automatic logic wait_ = req[p] && !gnt[p];
+          txns[p]   <= (restart ? 0 : txns[p]) + int'(done);
+          writes[p] <= (restart ? 0 : writes[p]) + int'(done && we[p]);
+          stalls[p] <= (restart ? 0 : stalls[p]) + int'(wait_);
+          bytes[p]  <= (restart ? 0 : bytes[p]) + (done ? nbytes[p] : 0);
+          if (done && (restart || lat[p] > max_lat[p])) max_lat[p] <= lat[p];
+          else if (restart) max_lat[p] <= 0;
+          lat[p] <= wait_ ? lat[p] + 1 : 0;
+        end
+      end
+    end
+  end
+
+  // Report the last, partial window (or the open GPIO 0 window)
+  final begin
+    if (window != 0 && cycles != 0) report();
+  end
+
+endmodule
+
+`endif  // VERILATOR
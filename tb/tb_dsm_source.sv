@@ -0,0 +1,46 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_dsm_source.sv
+// Description: ΔΣ bitstream source driven by the Verilator testbench (DPI).
+//              A new bit is output at each rising edge of dsm_clk_i. The bit
+//              index is part of the model state, so the stream is resumed at
+//              the right position after restoring a checkpoint.
+
+`ifdef VERILATOR
+
+module tb_dsm_source (
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic dsm_clk_i,
+    output logic dsm_data_o,
+    output logic active_o
+);
+
+  import "DPI-C" function int tb_dsm_active();
+  import "DPI-C" function bit tb_dsm_bit(input longint idx);
+
+  logic   dsm_clk_q;
+  longint bit_idx;
+
+  // The source is opened by the C++ testbench before the first evaluation
+  initial active_o = tb_dsm_active() != 0;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      dsm_clk_q  <= 1'b0;
+      bit_idx    <= '0;
+      dsm_data_o <= 1'b0;
+    end else begin
+      dsm_clk_q <= dsm_clk_i;
+      if (active_o && dsm_clk_i && !dsm_clk_q) begin
+        dsm_data_o <= tb_dsm_bit(bit_idx);
+        bit_idx    <= bit_idx + 1;
+      end
+    end
+  end
+
+endmodule
+
+`endif  // VERILATOR
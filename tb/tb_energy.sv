@@ -0,0 +1,249 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_energy.sv
+// Description: Activity counters for the RTL energy estimate of the Verilator
+//              testbench (DPI). Counts the retired instructions by class, the
+//              SRAM, DMA and peripheral accesses, the analog front-end and
+//              filter events and the cycles spent in each power state, and
+//              reports them at the end of the simulation. The C++ testbench
+//              weights them with a per-event energy table (see
+//              tb/verilator/tb_energy.hh).
+
+`ifdef VERILATOR
+
+module tb_energy #(
+    parameter int unsigned NMASTER = core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER,
+    parameter int unsigned NSLAVE  = core_v_mini_mcu_pkg::SYSTEM_XBAR_NSLAVE,
+    parameter int unsigned NPERIPH = cheep_pkg::ExtPeriphNSlave,
+    parameter int unsigned NBANKS  = core_v_mini_mcu_pkg::NUM_BANKS
+) (
+    input logic clk_i,   // system clock
+    input logic rst_ni,
+
+    // CPU
+    input logic        instr_done_i,
+    input logic [31:0] instr_i,       // decompressed instruction
+    input logic        sleep_i,
+
+    // Power gating (active high)
+    input logic              cpu_gated_i,
+    input logic              periph_gated_i,
+    input logic [NBANKS-1:0] sram_gated_i,
+
+    // System crossbar
+    input obi_pkg::obi_req_t  [NMASTER-1:0] master_req_i,
+    input obi_pkg::obi_resp_t [NMASTER-1:0] master_resp_i,
+    input obi_pkg::obi_req_t  [ NSLAVE-1:0] slave_req_i,
+    input obi_pkg::obi_resp_t [ NSLAVE-1:0] slave_resp_i,
+
+    // External peripherals bus
+    input reg_pkg::reg_req_t [NPERIPH-1:0] periph_req_i,
+    input reg_pkg::reg_rsp_t [NPERIPH-1:0] periph_rsp_i,
+
+    // Analog front-end and filters
+    input logic [1:0] vco_on_i,
+    input logic       vco_refresh_i,
+    input logic [1:0] idac_on_i,
+    input logic       idac_refresh_i,
+    input logic       dlc_xing_i,
+    input logic       ses_on_i,
+    input logic       ses_clk_i,
+    input logic       ses_valid_i,  // one cycle per filter output
+    input logic       cic_on_i,
+    input logic       cic_clk_i,
+    input logic       cic_valid_i
+);
+  import core_v_mini_mcu_pkg::*;
+  import cheep_pkg::*;
+
+  import "DPI-C" function int tb_energy_active();
+  import "DPI-C" function void tb_energy_count(input string name, input longint count);
+
+  // Events (the names are the keys of the energy table)
+  typedef enum int {
+    E_CYCLE,
+    E_CPU_ACTIVE,
+    E_CPU_SLEEP,
+    E_CPU_GATED,
+    E_PERIPH_ON,
+    E_INSTR_ALU,
+    E_INSTR_MUL,
+    E_INSTR_DIV,
+    E_INSTR_LOAD,
+    E_INSTR_STORE,
+    E_INSTR_BRANCH,
+    E_INSTR_SYSTEM,
+    E_SRAM_READ,
+    E_SRAM_WRITE,
+    E_SRAM_ON,
+    E_SRAM_GATED,
+    E_DMA_BEAT,
+    E_XHEEP_PERIPH,
+    E_VCO_ON,
+    E_VCO_REFRESH,
+    E_IDAC_ON,
+    E_IDAC_REFRESH,
+    E_DLC_XING,
+    E_SES_ON,
+    E_SES_SAMPLE,
+    E_SES_OUTPUT,
+    E_CIC_ON,
+    E_CIC_SAMPLE,
+    E_CIC_OUTPUT,
+    E_REG  // first register access event (one per external peripheral)
+  } event_e;
+  localparam int NEvents = E_REG + NPERIPH;
+
+  logic   active;
+  longint cnt            [NEvents];
+  longint skipped_cycles;  // incremented by tb_skip_cycles (tb_util.svh)
+  longint skipped_q;
+  logic   vco_refresh_q, idac_refresh_q, dlc_xing_q;
+  logic   ses_clk_q, cic_clk_q, cic_valid_q;
+
+  function automatic string event_name(int e);
+    case (e)
+      E_CYCLE:        return "cycle";
+      E_CPU_ACTIVE:   return "cpu_active";
+      E_CPU_SLEEP:    return "cpu_sleep";
+      E_CPU_GATED:    return "cpu_gated";
+      E_PERIPH_ON:    return "periph_on";
+      E_INSTR_ALU:    return "instr_alu";
+      E_INSTR_MUL:    return "instr_mul";
+      E_INSTR_DIV:    return "instr_div";
+      E_INSTR_LOAD:   return "instr_load";
+      E_INSTR_STORE:  return "instr_store";
+      E_INSTR_BRANCH: return "instr_branch";
+      E_INSTR_SYSTEM: return "instr_system";
+      E_SRAM_READ:    return "sram_read";
+      E_SRAM_WRITE:   return "sram_write";
+      E_SRAM_ON:      return "sram_on";
+      E_SRAM_GATED:   return "sram_gated";
+      E_DMA_BEAT:     return "dma_beat";
+      E_XHEEP_PERIPH: return "xheep_periph_access";
+      E_VCO_ON:       return "vco_on";
+      E_VCO_REFRESH:  return "vco_refresh";
+      E_IDAC_ON:      return "idac_on";
+      E_IDAC_REFRESH: return "idac_refresh";
+      E_DLC_XING:     return "dlc_crossing";
+      E_SES_ON:       return "ses_on";
+      E_SES_SAMPLE:   return "ses_sample";
+      E_SES_OUTPUT:   return "ses_output";
+      E_CIC_ON:       return "cic_on";
+      E_CIC_SAMPLE:   return "cic_sample";
+      E_CIC_OUTPUT:   return "cic_output";
+      default: begin
+        if (e - E_REG == CheepiDACCtrlIdx) return "reg_idac";
+        if (e - E_REG == CheepVCODecoderIdx) return "reg_vco";
+        if (e - E_REG == CheepSESFilterIdx) return "reg_ses";
+        if (e - E_REG == CheepREFsCtrlIdx) return "reg_refs";
+        if (e - E_REG == CheepaMUXCtrlIdx) return "reg_amux";
+        if (e - E_REG == CheepdLCIdx) return "reg_dlc";
+        if (e - E_REG == CheepCICIdx) return "reg_cic";
+        return $sformatf("reg_periph%0d", e - E_REG);
+      end
+    endcase
+  endfunction
+
+  // Instruction class (RV32IMC, after decompression)
+  function automatic event_e instr_class(logic [31:0] instr);
+    case (instr[6:0])
+      7'h03: return E_INSTR_LOAD;
+      7'h23: return E_INSTR_STORE;
+      7'h63, 7'h67, 7'h6f: return E_INSTR_BRANCH;
+      7'h0f, 7'h73: return E_INSTR_SYSTEM;
+      7'h33: begin
+        if (instr[31:25] == 7'b0000001) return instr[14] ? E_INSTR_DIV : E_INSTR_MUL;
+        return E_INSTR_ALU;
+      end
+      default: return E_INSTR_ALU;
+    endcase
+  endfunction
+
+  // The estimator is opened by the C++ testbench before the first evaluation
+  initial begin
+    active         = tb_energy_active() != 0;
+    skipped_cycles = 0;
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      for (int e = 0; e < NEvents; e++) cnt[e] <= 0;
+      skipped_q      <= skipped_cycles;
+      vco_refresh_q  <= 1'b0;
+      idac_refresh_q <= 1'b0;
+      dlc_xing_q     <= 1'b0;
+      ses_clk_q      <= 1'b0;
+      cic_clk_q      <= 1'b0;
+      cic_valid_q    <= 1'b0;
+    end else if (active) begin
+      // Cycles skipped by the idle fast-forward since the last edge are
+      // accounted with the current power state (the CPU sleeps through them)
+      automatic longint ncycles = 1 + skipped_cycles - skipped_q;
+      automatic int     sram_gated = $countones(sram_gated_i);
+      skipped_q <= skipped_cycles;
+
+      // Power states (a power-gated CPU is not counted as sleeping)
+      cnt[E_CYCLE]        <= cnt[E_CYCLE] + ncycles;
+      cnt[E_CPU_ACTIVE]   <= cnt[E_CPU_ACTIVE] + (sleep_i ? 0 : ncycles);
+      cnt[E_CPU_SLEEP]    <= cnt[E_CPU_SLEEP] + (sleep_i && !cpu_gated_i ? ncycles : 0);
+      cnt[E_CPU_GATED]    <= cnt[E_CPU_GATED] + (cpu_gated_i ? ncycles : 0);
+      cnt[E_PERIPH_ON]    <= cnt[E_PERIPH_ON] + (periph_gated_i ? 0 : ncycles);
+      cnt[E_SRAM_ON]      <= cnt[E_SRAM_ON] + (NBANKS - sram_gated) * ncycles;
+      cnt[E_SRAM_GATED]   <= cnt[E_SRAM_GATED] + sram_gated * ncycles;
+      cnt[E_VCO_ON]       <= cnt[E_VCO_ON] + $countones(vco_on_i) * ncycles;
+      cnt[E_IDAC_ON]      <= cnt[E_IDAC_ON] + $countones(idac_on_i) * ncycles;
+      cnt[E_SES_ON]       <= cnt[E_SES_ON] + (ses_on_i ? ncycles : 0);
+      cnt[E_CIC_ON]       <= cnt[E_CIC_ON] + (cic_on_i ? ncycles : 0);
+
+      // Retired instructions
+      if (instr_done_i) cnt[instr_class(instr_i)] <= cnt[instr_class(instr_i)] + 1;
+
+      // SRAM banks, DMA and X-HEEP peripherals (granted requests)
+      for (int i = 0; i < NBANKS; i++) begin
+        if (slave_req_i[ERROR_IDX+1+i].req && slave_resp_i[ERROR_IDX+1+i].gnt) begin
+          if (slave_req_i[ERROR_IDX+1+i].we) cnt[E_SRAM_WRITE] <= cnt[E_SRAM_WRITE] + 1;
+          else cnt[E_SRAM_READ] <= cnt[E_SRAM_READ] + 1;
+        end
+      end
+      for (int i = DMA_READ_P0_IDX; i < NMASTER; i++) begin
+        if (master_req_i[i].req && master_resp_i[i].gnt) cnt[E_DMA_BEAT] <= cnt[E_DMA_BEAT] + 1;
+      end
+      if ((slave_req_i[AO_PERIPHERAL_IDX].req && slave_resp_i[AO_PERIPHERAL_IDX].gnt) ||
+          (slave_req_i[PERIPHERAL_IDX].req && slave_resp_i[PERIPHERAL_IDX].gnt))
+        cnt[E_XHEEP_PERIPH] <= cnt[E_XHEEP_PERIPH] + 1;
+
+      // HEEPidermis peripheral registers
+      for (int i = 0; i < NPERIPH; i++) begin
+        if (periph_req_i[i].valid && periph_rsp_i[i].ready) cnt[E_REG+i] <= cnt[E_REG+i] + 1;
+      end
+
+      // Analog front-end and filter events (rising edges, or valid cycles for
+      // the SES outputs)
+      vco_refresh_q  <= vco_refresh_i;
+      idac_refresh_q <= idac_refresh_i;
+      dlc_xing_q     <= dlc_xing_i;
+      ses_clk_q      <= ses_clk_i;
+      cic_clk_q      <= cic_clk_i;
+      cic_valid_q    <= cic_valid_i;
+      if (vco_refresh_i && !vco_refresh_q) cnt[E_VCO_REFRESH] <= cnt[E_VCO_REFRESH] + 1;
+      if (idac_refresh_i && !idac_refresh_q) cnt[E_IDAC_REFRESH] <= cnt[E_IDAC_REFRESH] + 1;
+      if (dlc_xing_i && !dlc_xing_q) cnt[E_DLC_XING] <= cnt[E_DLC_XING] + 1;
+      if (ses_on_i && ses_clk_i && !ses_clk_q) cnt[E_SES_SAMPLE] <= cnt[E_SES_SAMPLE] + 1;
+      if (ses_valid_i) cnt[E_SES_OUTPUT] <= cnt[E_SES_OUTPUT] + 1;
+      if (cic_on_i && cic_clk_i && !cic_clk_q) cnt[E_CIC_SAMPLE] <= cnt[E_CIC_SAMPLE] + 1;
+      if (cic_valid_i && !cic_valid_q) cnt[E_CIC_OUTPUT] <= cnt[E_CIC_OUTPUT] + 1;
+    end
+  end
+
+  final begin
+    if (active) begin
+      for (int e = 0; e < NEvents; e++) tb_energy_count(event_name(e), cnt[e]);
+    end
+  end
+
+endmodule
+
+`endif  // VERILATOR
@@ -0,0 +1,97 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_profiler.sv
+// Description: Firmware profiler probe for the Verilator testbench (DPI).
+//              Reports the control transfers retired by the CPU (calls,
+//              returns, traps) so that the C++ profiler can follow the call
+//              stack, and samples the program counter every N cycles. In
+//              retire mode, every retired instruction is reported instead.
+
+`ifdef VERILATOR
+
+module tb_profiler (
+    input logic        clk_i,        // sampling clock
+    input logic        rst_ni,
+    input logic        cpu_clk_i,
+    input logic        instr_done_i,
+    input logic [31:0] pc_i,
+    input logic [31:0] instr_i,      // decompressed instruction
+    input logic        trap_i,       // trap entry (mcause saved)
+    input logic        sleep_i
+);
+
+  import "DPI-C" function int tb_prof_mode();
+  import "DPI-C" function int tb_prof_period();
+  import "DPI-C" function void tb_prof_retire(input int pc, input int kind);
+  import "DPI-C" function void tb_prof_sample(input int pc, input bit sleeping);
+
+  // Kind of the last control transfer (see prof_kind_t in tb_prof.hh)
+  typedef enum int {
+    KIND_NONE = 0,
+    KIND_CALL = 1,
+    KIND_RET  = 2,
+    KIND_MRET = 3,
+    KIND_TRAP = 4
+  } kind_e;
+
+  int    mode;
+  int    period;
+  int    sample_cnt;
+  kind_e kind_q;
+  kind_e kind;
+
+  // The profiler is opened by the C++ testbench before the first evaluation
+  initial begin
+    mode   = tb_prof_mode();
+    period = tb_prof_period();
+  end
+
+  // Control transfers: jal/jalr linking to ra or t0 are calls, jalr x0
+  // through ra or t0 are returns
+  always_comb begin
+    kind = KIND_NONE;
+    if ((instr_i[6:0] == 7'h6f || (instr_i[6:0] == 7'h67 && instr_i[14:12] == 3'b000)) &&
+        (instr_i[11:7] == 5'd1 || instr_i[11:7] == 5'd5)) begin
+      kind = KIND_CALL;
+    end else if (instr_i[6:0] == 7'h67 && instr_i[11:7] == 5'd0 && instr_i[31:20] == '0 &&
+                 (instr_i[19:15] == 5'd1 || instr_i[19:15] == 5'd5)) begin
+      kind = KIND_RET;
+    end else if (instr_i == 32'h3020_0073) begin
+      kind = KIND_MRET;
+    end
+  end
+
+  // Report the first instruction after each control transfer (all of them in
+  // retire mode)
+  always_ff @(posedge cpu_clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      kind_q <= KIND_NONE;
+    end else if (mode != 0) begin
+      if (trap_i) begin
+        kind_q <= KIND_TRAP;
+      end else if (instr_done_i) begin
+        if (mode == 2 || kind_q != KIND_NONE) tb_prof_retire(pc_i, kind_q);
+        kind_q <= kind;
+      end
+    end
+  end
+
+  // Program counter sampling
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      sample_cnt <= 0;
+    end else if (mode == 1) begin
+      if (sample_cnt >= period - 1) begin
+        sample_cnt <= 0;
+        tb_prof_sample(pc_i, sleep_i);
+      end else begin
+        sample_cnt <= sample_cnt + 1;
+      end
+    end
+  end
+
+endmodule
+
+`endif  // VERILATOR
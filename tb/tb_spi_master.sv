@@ -0,0 +1,45 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_spi_master.sv
+// Description: SPI master driven by the Verilator testbench (DPI). The C++
+//              model (tb/verilator/tb_spi.hh) is advanced at each system clock
+//              cycle and reads memory through the SPI slave.
+
+`ifdef VERILATOR
+
+module tb_spi_master #(
+    parameter int unsigned CLK_FREQ = 32'd100_000  // kHz
+) (
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic gpio_i,
+    input  logic miso_i,
+    output logic sck_o,
+    output logic cs_no,
+    output logic mosi_o,
+    output logic busy_o,
+    output logic active_o
+);
+
+  import "DPI-C" function int tb_spi_init(input int clk_freq_khz);
+  import "DPI-C" function int tb_spi_step(input bit gpio, input bit miso);
+
+  // The model is opened by the C++ testbench before the first evaluation
+  initial active_o = tb_spi_init(CLK_FREQ) != 0;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      busy_o <= 1'b0;
+      cs_no  <= 1'b1;
+      sck_o  <= 1'b0;
+      mosi_o <= 1'b0;
+    end else if (active_o) begin
+      {busy_o, cs_no, sck_o, mosi_o} <= 4'(tb_spi_step(gpio_i, miso_i));
+    end
+  end
+
+endmodule
+
+`endif  // VERILATOR
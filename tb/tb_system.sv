@@ -25,7 +25,10 @@ module tb_system #(
 
     // Exit signals
     inout wire        exit_valid_o,
-    inout wire [31:0] exit_value_o
+    inout wire [31:0] exit_value_o,
+
+    // GPIO 0 (waveform dump trigger, see vcd-ctl driver)
+    inout wire gpio_0_o
 );
   // Include testbench utils
   `include "tb_util.svh"
@@ -60,6 +63,11 @@ module tb_system #(
 
 `endif
 
+  // SPI slave (flash bus or, with Verilator, the testbench SPI master)
+  wire spi_slave_sck;
+  wire spi_slave_cs;
+  wire spi_slave_mosi;
+
   // GPIO
   wire clk_div;
 
@@ -158,9 +166,9 @@ module tb_system #(
       .exit_valid_o        (exit_valid_o),
       .gpio_0_io           (gpio),
 
-      .spi_slave_sck_i(spi_flash_sck),
-      .spi_slave_cs_i(spi_flash_cs_1),
-      .spi_slave_mosi_i(spi_flash_sd_0),
+      .spi_slave_sck_i(spi_slave_sck),
+      .spi_slave_cs_i(spi_slave_cs),
+      .spi_slave_mosi_i(spi_slave_mosi),
       .spi_slave_miso_io(spi_flash_sd_1),
 
       .spi_flash_sck_o  (spi_flash_sck),
@@ -178,15 +186,135 @@ module tb_system #(
       .exit_value_o           (exit_value_o[0])
   );
 
+  // SPI slave: driven by the SPI flash host (loopback) or, with Verilator, by
+  // the SPI master model enabled with +spi_read (see tb/verilator/tb_spi.hh).
+  // MISO stays on the flash bus, where the master samples it.
+`ifdef VERILATOR
+  logic spi_tb_sck;
+  logic spi_tb_cs_n;
+  logic spi_tb_mosi;
+  logic spi_tb_busy;
+  logic spi_tb_active;
+
+  tb_spi_master #(
+      .CLK_FREQ(CLK_FREQ)
+  ) u_tb_spi_master (
+      .clk_i   (ref_clk_i),
+      .rst_ni  (rst_ni),
+      .gpio_i  (gpio),
+      .miso_i  (spi_flash_sd_1),
+      .sck_o   (spi_tb_sck),
+      .cs_no   (spi_tb_cs_n),
+      .mosi_o  (spi_tb_mosi),
+      .busy_o  (spi_tb_busy),
+      .active_o(spi_tb_active)
+  );
+
+  assign spi_slave_sck  = spi_tb_active ? spi_tb_sck : spi_flash_sck;
+  assign spi_slave_cs   = spi_tb_active ? spi_tb_cs_n : spi_flash_cs_1;
+  assign spi_slave_mosi = spi_tb_active ? spi_tb_mosi : spi_flash_sd_0;
+`else
+  assign spi_slave_sck  = spi_flash_sck;
+  assign spi_slave_cs   = spi_flash_cs_1;
+  assign spi_slave_mosi = spi_flash_sd_0;
+`endif
+
+  // Firmware profiler probe (enabled with +fw_profile, see tb/verilator/tb_prof.hh)
+`ifdef VERILATOR
+  tb_profiler u_tb_profiler (
+      .clk_i       (ref_clk_i),
+      .rst_ni      (rst_ni),
+      .cpu_clk_i   (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.clk_i),
+      .instr_done_i(u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.instr_id_done),
+      .pc_i        (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.pc_id),
+      .instr_i     (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.instr_rdata_id),
+      .trap_i      (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.csr_save_cause),
+      .sleep_i     (u_cheep_top.u_core_v_mini_mcu.core_sleep)
+  );
+`endif
+
+  // Bus load monitor (enabled with +bus_monitor, see tb/verilator/tb_busmon.hh)
+`ifdef VERILATOR
+  tb_bus_monitor u_tb_bus_monitor (
+      .clk_i        (u_cheep_top.u_core_v_mini_mcu.clk_i),
+      .rst_ni       (rst_ni),
+      .roi_i        (gpio),
+      .master_req_i (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_master_req),
+      .master_resp_i(u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_master_resp),
+      .slave_req_i  (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_slave_req),
+      .slave_resp_i (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_slave_resp),
+      .periph_req_i (u_cheep_top.u_cheep_bus.ext_periph_req),
+      .periph_rsp_i (u_cheep_top.u_cheep_bus.ext_periph_rsp)
+  );
+`endif
+
+  // Activity counters for the energy estimate (enabled with +energy_table, see
+  // tb/verilator/tb_energy.hh)
+`ifdef VERILATOR
+  tb_energy u_tb_energy (
+      .clk_i         (u_cheep_top.u_core_v_mini_mcu.clk_i),
+      .rst_ni        (rst_ni),
+      .instr_done_i  (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.instr_id_done),
+      .instr_i       (u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.instr_rdata_id),
+      .sleep_i       (u_cheep_top.u_core_v_mini_mcu.core_sleep),
+      .cpu_gated_i   (~u_cheep_top.u_core_v_mini_mcu.cpu_subsystem_powergate_switch_no),
+      .periph_gated_i(~u_cheep_top.u_core_v_mini_mcu.peripheral_subsystem_powergate_switch_no),
+      .sram_gated_i  (~u_cheep_top.u_core_v_mini_mcu.memory_subsystem_banks_powergate_switch_n),
+      .master_req_i  (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_master_req),
+      .master_resp_i (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_master_resp),
+      .slave_req_i   (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_slave_req),
+      .slave_resp_i  (u_cheep_top.u_core_v_mini_mcu.system_bus_i.int_slave_resp),
+      .periph_req_i  (u_cheep_top.u_cheep_bus.ext_periph_req),
+      .periph_rsp_i  (u_cheep_top.u_cheep_bus.ext_periph_rsp),
+      .vco_on_i      ({u_cheep_top.u_cheep_peripherals.vcon_enable_o, u_cheep_top.u_cheep_peripherals.vcop_enable_o}),
+      .vco_refresh_i (u_cheep_top.u_cheep_peripherals.vco_refresh_o),
+      .idac_on_i     ({u_cheep_top.u_cheep_peripherals.idac2_enable_o, u_cheep_top.u_cheep_peripherals.idac1_enable_o}),
+      .idac_refresh_i(u_cheep_top.u_cheep_peripherals.idac_refresh_o),
+      .dlc_xing_i    (u_cheep_top.u_cheep_peripherals.dlc_xing_o),
+      .ses_on_i      (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.SES_activated),
+      .ses_clk_i     (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.ses_dsm_clk_o),
+      .ses_valid_i   (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.u_ses_filter.cdc_fifo_dst_valid),
+      .cic_on_i      (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.CIC_activated),
+      .cic_clk_i     (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.cic_dsm_clk_o),
+      .cic_valid_i   (u_cheep_top.u_cheep_peripherals.u_dsm_decimation.CIC_dataValid)
+  );
+`endif
+
+  // ΔΣ input: text file (pdm2pcm_dummy) or, with Verilator, the bitstream
+  // source selected with +dsm_source (see tb/verilator/tb_dsm.hh)
+  logic dsm_in_pdm;
+  logic dsm_clk_pdm;
+`ifdef VERILATOR
+  logic dsm_in_dpi;
+  logic dsm_dpi_active;
+
+  tb_dsm_source u_tb_dsm_source (
+      .clk_i     (ref_clk_i),
+      .rst_ni    (rst_ni),
+      .dsm_clk_i (dsm_clk),
+      .dsm_data_o(dsm_in_dpi),
+      .active_o  (dsm_dpi_active)
+  );
+
+  assign dsm_in      = dsm_dpi_active ? dsm_in_dpi : dsm_in_pdm;
+  assign dsm_clk_pdm = dsm_dpi_active ? 1'b0 : dsm_clk;
+`else
+  assign dsm_in      = dsm_in_pdm;
+  assign dsm_clk_pdm = dsm_clk;
+`endif
+
   pdm2pcm_dummy #(
       .filepath("../../../hw/vendor/x-heep/hw/ip/pdm2pcm/tb/signals/pdm.txt")
   ) pdm2pcm_dummy_i (
       .clk_i     (ref_clk_i),
       .rst_ni    (rst_ni),
-      .pdm_data_o(dsm_in),
-      .pdm_clk_i (dsm_clk)
+      .pdm_data_o(dsm_in_pdm),
+      .pdm_clk_i (dsm_clk_pdm)
   );
 
   // Exit value
   assign exit_value_o[31:1] = u_cheep_top.u_core_v_mini_mcu.exit_value_o[31:1];
+
+  // Waveform dump trigger
+  assign gpio_0_o = gpio;
 endmodule
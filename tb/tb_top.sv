@@ -524,6 +524,7 @@ module tb_top;
       .jtag_trst_ni        (jtag_trst_n),
       .jtag_tms_i          (jtag_tms),
       .jtag_tdi_i          (jtag_tdi),
-      .jtag_tdo_o          (jtag_tdo)
+      .jtag_tdo_o          (jtag_tdo),
+      .gpio_0_o            ()
   );
 endmodule
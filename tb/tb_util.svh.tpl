@@ -17,6 +17,8 @@ export "DPI-C" task tb_readHEX;
 export "DPI-C" task tb_loadHEX;
 export "DPI-C" task tb_getMemSize;
 export "DPI-C" task tb_set_exit_loop;
+export "DPI-C" task tb_writeWord;
+export "DPI-C" task tb_readWord;
 
 import core_v_mini_mcu_pkg::*;
 
@@ -133,6 +135,41 @@ task tb_writetoSram${bank.name()};
 endtask
 % endfor
 
+// Backdoor write of a 32-bit word to the SRAM bank mapped at 'addr'
+// (used by the C++ testbench to preload ELF segments and data blobs)
+task tb_writeWord;
+  input int addr;
+  input int data;
+  int w_addr;
+% for bank in xheep.iter_ram_banks():
+  if (addr >= ${bank.start_address()} && addr < ${bank.end_address()} &&
+      ((addr/4) & ${2**bank.il_level()-1}) == ${bank.il_offset()}) begin
+    w_addr = ((addr/4) >> ${bank.il_level()}) % ${bank.size()//4};
+    tb_writetoSram${bank.name()}(w_addr, data[31:24], data[23:16], data[15:8], data[7:0]);
+    return;
+  end
+% endfor
+  $error("tb_writeWord: address 0x%08x is not mapped to any SRAM bank", addr);
+endtask
+
+// Backdoor read of a 32-bit word from the SRAM bank mapped at 'addr' (used by
+// the C++ testbench to merge the partial words of a preload)
+task tb_readWord;
+  input int addr;
+  output int data;
+  int w_addr;
+% for bank in xheep.iter_ram_banks():
+  if (addr >= ${bank.start_address()} && addr < ${bank.end_address()} &&
+      ((addr/4) & ${2**bank.il_level()-1}) == ${bank.il_offset()}) begin
+    w_addr = ((addr/4) >> ${bank.il_level()}) % ${bank.size()//4};
+    data = `TOP.u_core_v_mini_mcu.memory_subsystem_i.ram${bank.name()}_i.tc_ram_i.sram[w_addr];
+    return;
+  end
+% endfor
+  data = 0;
+  $error("tb_readWord: address 0x%08x is not mapped to any SRAM bank", addr);
+endtask
+
 `ifndef VERILATOR
 
 % for bank in xheep.iter_ram_banks():
@@ -153,5 +190,138 @@ task tb_set_exit_loop;
     `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.soc_ctrl_i.testbench_set_exit_loop[0] = 1'b1;
 `endif
 endtask
+
+`ifdef VERILATOR
+// Re-open the host resources (DPI contexts and file descriptors) that are not
+// part of a Verilator checkpoint. Called by the testbench right after restoring
+// the model state from a checkpoint (see +restore_checkpoint).
+export "DPI-C" task tb_restore_handles;
+
+import "DPI-C" function chandle uartdpi_create(input string name, input string log_file_path);
+
+task tb_restore_handles;
+  string line;
+  // UART DPI: open a new pseudo-terminal and log file
+  u_uartdpi.ctx = uartdpi_create("uart", u_uartdpi.log_file_path);
+  // PDM stream: re-open the file and skip the samples consumed before the checkpoint
+  if (pdm2pcm_dummy_i.init == 1) begin
+    pdm2pcm_dummy_i.fpdm = $fopen(pdm2pcm_dummy_i.filepath, "r");
+    for (int i = 0; i <= pdm2pcm_dummy_i.lineidx; i = i + 1) begin
+      void'($fgets(line, pdm2pcm_dummy_i.fpdm));
+    end
+  end
+endtask
+
+// Idle fast-forward
+// The system is idle when the CPU sleeps in WFI, no DMA channel is moving data,
+// the DSM filters and timers are disabled and the UART is not transmitting.
+// In this condition, only the refresh counters of the VCO decoder and iDAC
+// controller, the FIFO timestamp and the double-tap gap of the VCO decoder and
+// the slew counter of the iDAC feedback loop advance, so the cycles up to the
+// next refresh trigger, second tap or feedback step can be skipped by updating
+// them directly.
+<%
+  dma = xheep.get_base_peripheral_domain().get_dma()
+  user_peripheral_domain = xheep.get_user_peripheral_domain()
+%>
+export "DPI-C" task tb_get_idle_cycles;
+export "DPI-C" task tb_skip_cycles;
+
+// Cycles left before a counter_trigger fires (0 if a trigger train is in flight)
+function automatic int tb_trigger_cycles(logic [31:0] count, logic [31:0] limit, logic trigger);
+  if (limit == '0) return 32'h7fff_ffff;  // counter disabled
+  if (trigger || count >= limit) return 0;
+  if (limit - count > 32'h7fff_ffff) return 32'h7fff_ffff;
+  return int'(limit - count);
+endfunction
+
+task tb_get_idle_cycles;
+  output int ncycles;
+  int cnt;
+  ncycles = 0;
+
+  // CPU sleeping
+  if (!`TOP.u_core_v_mini_mcu.core_sleep) return;
+
+  // DMA channels not issuing transactions
+% for ch in range(dma.get_num_channels()):
+  if (`TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.dma_subsystem_i.dma_i_gen[${ch}].dma_i.dma_read_req_o.req ||
+      `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.dma_subsystem_i.dma_i_gen[${ch}].dma_i.dma_write_req_o.req ||
+      `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.dma_subsystem_i.dma_i_gen[${ch}].dma_i.dma_addr_req_o.req ||
+      `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.dma_subsystem_i.dma_i_gen[${ch}].dma_i.hw_fifo_req_o.push ||
+      `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.dma_subsystem_i.dma_i_gen[${ch}].dma_i.hw_fifo_req_o.pop)
+    return;
+% endfor
+
+  // Timers disabled
+  if (`TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.rv_timer_0_1_i.reg2hw.ctrl[0].q ||
+      `TOP.u_core_v_mini_mcu.ao_peripheral_subsystem_i.rv_timer_0_1_i.reg2hw.ctrl[1].q)
+    return;
+% if user_peripheral_domain.contains_peripheral('rv_timer'):
+  if (`TOP.u_core_v_mini_mcu.peripheral_subsystem_i.rv_timer_2_3_i.reg2hw.ctrl[0].q ||
+      `TOP.u_core_v_mini_mcu.peripheral_subsystem_i.rv_timer_2_3_i.reg2hw.ctrl[1].q)
+    return;
+% endif
+
+  // DSM filters disabled
+  if (`TOP.u_cheep_peripherals.u_dsm_decimation.SES_activated ||
+      `TOP.u_cheep_peripherals.u_dsm_decimation.CIC_activated)
+    return;
+
+  // UART idle
+  if (u_uartdpi.txactive || u_uartdpi.rxactive) return;
+
+  // No SPI read in progress (the next scheduled one is handled by the C++ testbench)
+  if (u_tb_spi_master.busy_o) return;
+
+  // Cycles to the next refresh trigger
+  ncycles = tb_trigger_cycles(
+      `TOP.u_cheep_peripherals.u_vco_decoder.u_counter_trigger.count,
+      `TOP.u_cheep_peripherals.u_vco_decoder.reg2hw.refresh_cycles,
+      |`TOP.u_cheep_peripherals.u_vco_decoder.u_counter_trigger.trigger_o);
+  cnt = tb_trigger_cycles(
+      `TOP.u_cheep_peripherals.u_idac_ctrl.u_counter_trigger.count,
+      `TOP.u_cheep_peripherals.u_idac_ctrl.reg2hw.refresh_cycles,
+      |`TOP.u_cheep_peripherals.u_idac_ctrl.u_counter_trigger.trigger_o);
+  if (cnt < ncycles) ncycles = cnt;
+
+  // Cycles to the second tap of a double-tap measurement
+  if (`TOP.u_cheep_peripherals.u_vco_decoder.gap_active_q) begin
+    cnt = tb_trigger_cycles(
+        `TOP.u_cheep_peripherals.u_vco_decoder.gap_count_q,
+        `TOP.u_cheep_peripherals.u_vco_decoder.gap_cycles - 32'd1,
+        1'b0);
+    if (cnt < ncycles) ncycles = cnt;
+  end
+
+  // Cycles to the next pending step of the iDAC feedback loop
+  if (`TOP.u_cheep_peripherals.u_idac_ctrl.fb_active &&
+      `TOP.u_cheep_peripherals.u_idac_ctrl.fb_pending_q != '0) begin
+    cnt = int'(`TOP.u_cheep_peripherals.u_idac_ctrl.fb_slew_q);
+    if (cnt < ncycles) ncycles = cnt;
+  end
+endtask
+
+// Skip ncycles idle cycles (must not exceed tb_get_idle_cycles())
+task tb_skip_cycles;
+  input int ncycles;
+  if (`TOP.u_cheep_peripherals.u_vco_decoder.reg2hw.refresh_cycles != '0)
+    `TOP.u_cheep_peripherals.u_vco_decoder.u_counter_trigger.count += ncycles;
+  if (`TOP.u_cheep_peripherals.u_idac_ctrl.reg2hw.refresh_cycles != '0)
+    `TOP.u_cheep_peripherals.u_idac_ctrl.u_counter_trigger.count += ncycles;
+  if (`TOP.u_cheep_peripherals.u_vco_decoder.gap_active_q)
+    `TOP.u_cheep_peripherals.u_vco_decoder.gap_count_q += ncycles;
+  if (`TOP.u_cheep_peripherals.u_idac_ctrl.fb_active) begin
+    if (ncycles < int'(`TOP.u_cheep_peripherals.u_idac_ctrl.fb_slew_q))
+      `TOP.u_cheep_peripherals.u_idac_ctrl.fb_slew_q -= 16'(ncycles);
+    else
+      `TOP.u_cheep_peripherals.u_idac_ctrl.fb_slew_q = '0;
+  end
+  if (`TOP.u_cheep_peripherals.u_vco_decoder.fifo_enable)
+    `TOP.u_cheep_peripherals.u_vco_decoder.timestamp += ncycles;
+  u_uartdpi.rxcyccount += ncycles;
+  u_tb_energy.skipped_cycles += ncycles;
+endtask
+`endif // VERILATOR
 `endif //RTL_SIMULATION
 
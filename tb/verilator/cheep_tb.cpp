@@ -18,10 +18,22 @@
 #include <verilated.h>
 #include <verilated_fst_c.h>
 #include <svdpi.h>
+#ifdef TB_SAVABLE
+#include <verilated_save.h>
+#endif
 
 // User libraries
 #include "tb_macros.hh"
+#include "tb_trace.hh"
+#include "tb_perf.hh"
+#include "tb_mem.hh"
+#include "tb_dsm.hh"
+#include "tb_spi.hh"
+#include "tb_prof.hh"
+#include "tb_busmon.hh"
+#include "tb_energy.hh"
 #include "Vtb_system.h"
+#include "Vtb_system__Dpi.h"
 
 // Defines
 // -------
@@ -34,6 +46,13 @@
 #define EXEC_FROM_FLASH 0 // 0: do not execute from flash
 #define RUN_CYCLES 5000
 #define TB_HIER_NAME "TOP.tb_system"
+#define FF_IDLE_CYCLES 8 // consecutive idle cycles before fast-forwarding
+#define FF_MIN_CYCLES 64 // minimum number of cycles worth skipping
+#define SPI_SCK_DIV 4 // system clock cycles per SCK half period
+#define SPI_OUT_FILENAME "spi_read.bin"
+#define FW_PROFILE_PREFIX "fw_profile"
+#define BUS_MONITOR_FILENAME "bus_monitor.csv"
+#define ENERGY_OUT_FILENAME "energy.csv"
 
 // Data types
 // ----------
@@ -53,16 +72,34 @@ void initDut(Vtb_system *dut, uint8_t boot_mode, uint8_t exec_from_flash);
 
 // Generate clock and reset
 void clkGen(Vtb_system *dut);
-void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace);
+void rstDut(Vtb_system *dut, uint8_t gen_waves, TbTracer *trace);
 
 // Run simulation for the specififed number of cycles
-void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace);
+void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace);
+
+// Run simulation for the specified number of cycles, skipping idle cycles
+void runCyclesFastForward(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace);
+
+// Save and restore the simulation state (requires a model built with --savable)
+void saveCheckpoint(const std::string& filename, Vtb_system *dut);
+void restoreCheckpoint(const std::string& filename, Vtb_system *dut);
 
 // Global variables
 // ----------------
 // Testbench logger
 TbLogger logger;
 vluint64_t sim_cycles = 0;
+vluint64_t skipped_cycles = 0;
+// ΔΣ bitstream source (DPI)
+TbDsmSource dsm_source;
+// SPI master reading memory through the SPI slave (DPI)
+TbSpiMaster spi_master;
+// Firmware profiler (DPI)
+TbProfiler profiler;
+// Bus load monitor (DPI)
+TbBusMonitor bus_monitor;
+// Activity-based energy estimate (DPI)
+TbEnergy energy;
 
 int main(int argc, char *argv[])
 {
@@ -79,12 +116,13 @@ int main(int argc, char *argv[])
         {"log_level", required_argument, NULL, 'l'},
         {"trace", required_argument, NULL, 't'},
         {"no_err", required_argument, NULL, 'q'},
+        {"log_buffer", required_argument, NULL, 'b'},
         {NULL, 0, NULL, 0}
     };
 
     // Parse command-line options
     int opt;
-    while ((opt = getopt_long(argc, argv, "hl:t:q:", longopts, NULL)) >= 0) {
+    while ((opt = getopt_long(argc, argv, "hl:t:q:b:", longopts, NULL)) >= 0) {
         switch (opt) {
         case 'h':
             printf("Usage: %s [OPTIONS]\n", argv[0]);
@@ -93,6 +131,7 @@ int main(int argc, char *argv[])
             printf("  -l, --log_level=LOG_LEVEL\tSet the log level\n");
             printf("  -t, --trace=[true/false]\t\tGenerate waveforms\n");
             printf("  -q, --no_err=[true/false]\t\t\tAlways return 0\n");
+            printf("  -b, --log_buffer=N\t\tBuffer up to N log events and print them at exit\n");
             exit(0);
             break;
         case 'l':
@@ -108,6 +147,9 @@ int main(int argc, char *argv[])
                 no_err = true;
             }
             break;
+        case 'b':
+            logger.setLogBuffer(strtoul(optarg, NULL, 0));
+            break;
         default:
             printf("Usage: %s [OPTIONS]\n", argv[0]);
             printf("Try '%s --help' for more information.\n", argv[0]);
@@ -123,6 +165,33 @@ int main(int argc, char *argv[])
     std::string firmware_file;
     std::string max_cycles_str;
     unsigned long max_cycles = MAX_SIM_CYCLES;
+    std::string save_checkpoint_file;
+    std::string restore_checkpoint_file;
+    std::string checkpoint_cycle_str;
+    unsigned long checkpoint_cycle = 0;
+    bool checkpoint_pending = false;
+    std::string vcd_mode_str;
+    std::string trace_start_str;
+    std::string trace_stop_str;
+    std::string trace_depth_str;
+    std::string trace_scope;
+    unsigned long trace_start = 0;
+    unsigned long trace_stop = 0;
+    int trace_depth = 0;
+    trace_mode_t trace_mode = TRACE_MODE_ON;
+    std::string fast_forward_str;
+    bool fast_forward = false;
+    std::string perf_report_file;
+    bool firmware_elf = false;
+    std::string preload_spec;
+    std::string spi_sck_div_str;
+    unsigned int spi_sck_div = SPI_SCK_DIV;
+    std::string spi_out_file;
+    std::string profile_str;
+    std::string profile_elf;
+    std::string profile_prefix;
+    std::string bus_monitor_file;
+    std::string energy_out_file;
 
     // Boot mode
     boot_mode_str = getCmdOption(argc, argv, "+boot_mode=");
@@ -138,7 +207,7 @@ int main(int argc, char *argv[])
         boot_mode = BOOT_MODE_JTAG;
     }
 
-    // Firmware HEX file
+    // Firmware HEX or ELF file
     firmware_file = getCmdOption(argc, argv, "+firmware=");
     if (firmware_file.empty()) {
         TB_ERR("No firmware file specified");
@@ -150,7 +219,16 @@ int main(int argc, char *argv[])
             TB_ERR("Cannot open firmware file '%s': %s", firmware_file.c_str(), strerror(errno));
             exit(EXIT_FAILURE);
         }
+        fclose(fp);
     }
+    firmware_elf = TbMemLoader::isElf(firmware_file);
+    if (firmware_elf && boot_mode != BOOT_MODE_FORCE) {
+        TB_ERR("ELF firmware files are only supported with boot mode 'force'");
+        exit(EXIT_FAILURE);
+    }
+
+    // Data blobs to preload into SRAM (<file>@<address>[,<file>@<address>...])
+    preload_spec = getCmdOption(argc, argv, "+preload=");
 
     // Max simulation cycles
     max_cycles_str = getCmdOption(argc, argv, "+max_cycles=");
@@ -158,6 +236,111 @@ int main(int argc, char *argv[])
         max_cycles = std::stoul(max_cycles_str);
     }
 
+    // Simulation checkpoints
+    save_checkpoint_file = getCmdOption(argc, argv, "+save_checkpoint=");
+    restore_checkpoint_file = getCmdOption(argc, argv, "+restore_checkpoint=");
+    checkpoint_cycle_str = getCmdOption(argc, argv, "+checkpoint_cycle=");
+    if (!checkpoint_cycle_str.empty()) {
+        checkpoint_cycle = std::stoul(checkpoint_cycle_str);
+    }
+#ifndef TB_SAVABLE
+    if (!save_checkpoint_file.empty() || !restore_checkpoint_file.empty()) {
+        TB_ERR("Checkpoints require a savable model (build with VERILATOR_SAVABLE=1)");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    if (!restore_checkpoint_file.empty()) {
+        // Check if file exists
+        FILE *fp = fopen(restore_checkpoint_file.c_str(), "r");
+        if (fp == NULL) {
+            TB_ERR("Cannot open checkpoint file '%s': %s", restore_checkpoint_file.c_str(), strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+        fclose(fp);
+    }
+    checkpoint_pending = !save_checkpoint_file.empty();
+
+    // Idle fast-forward
+    fast_forward_str = getCmdOption(argc, argv, "+fast_forward=");
+    if (fast_forward_str == "1" || fast_forward_str == "true") {
+        fast_forward = true;
+    }
+
+    // Performance report
+    perf_report_file = getCmdOption(argc, argv, "+perf_report=");
+
+    // ΔΣ bitstream source (must be open before the first model evaluation)
+    if (!dsm_source.open(getCmdOption(argc, argv, "+dsm_source="))) {
+        exit(EXIT_FAILURE);
+    }
+
+    // SPI master (must be open before the first model evaluation)
+    spi_sck_div_str = getCmdOption(argc, argv, "+spi_sck_div=");
+    if (!spi_sck_div_str.empty()) {
+        spi_sck_div = std::stoul(spi_sck_div_str);
+    }
+    spi_out_file = getCmdOption(argc, argv, "+spi_out=");
+    if (spi_out_file.empty()) spi_out_file = SPI_OUT_FILENAME;
+    if (!spi_master.open(getCmdOption(argc, argv, "+spi_read="), spi_sck_div, spi_out_file, &sim_cycles)) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Firmware profiler (must be open before the first model evaluation).
+    // The symbols are read from the firmware ELF file, or from the ELF file
+    // next to the HEX file by default.
+    profile_str = getCmdOption(argc, argv, "+fw_profile=");
+    profile_elf = getCmdOption(argc, argv, "+fw_profile_elf=");
+    if (profile_elf.empty()) {
+        if (firmware_elf) {
+            profile_elf = firmware_file;
+        } else if (firmware_file.size() > 4 && firmware_file.substr(firmware_file.size() - 4) == ".hex") {
+            profile_elf = firmware_file.substr(0, firmware_file.size() - 4) + ".elf";
+        }
+    }
+    profile_prefix = getCmdOption(argc, argv, "+fw_profile_out=");
+    if (profile_prefix.empty()) profile_prefix = FW_PROFILE_PREFIX;
+    if (!profiler.open(profile_str, profile_elf, profile_prefix)) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Bus load monitor (must be open before the first model evaluation)
+    bus_monitor_file = getCmdOption(argc, argv, "+bus_monitor_out=");
+    if (bus_monitor_file.empty()) bus_monitor_file = BUS_MONITOR_FILENAME;
+    if (!bus_monitor.open(getCmdOption(argc, argv, "+bus_monitor="), bus_monitor_file)) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Energy estimate (must be open before the first model evaluation)
+    energy_out_file = getCmdOption(argc, argv, "+energy_out=");
+    if (energy_out_file.empty()) energy_out_file = ENERGY_OUT_FILENAME;
+    if (!energy.open(getCmdOption(argc, argv, "+energy_table="), energy_out_file)) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Waveform dump: trigger mode, cycle window and hierarchy filter
+    vcd_mode_str = getCmdOption(argc, argv, "+vcd_mode=");
+    if (vcd_mode_str == "2") {
+        trace_mode = TRACE_MODE_GPIO;
+    }
+    trace_start_str = getCmdOption(argc, argv, "+trace_start=");
+    if (!trace_start_str.empty()) {
+        trace_start = std::stoul(trace_start_str);
+    }
+    trace_stop_str = getCmdOption(argc, argv, "+trace_stop=");
+    if (!trace_stop_str.empty()) {
+        trace_stop = std::stoul(trace_stop_str);
+    }
+    trace_depth_str = getCmdOption(argc, argv, "+trace_depth=");
+    if (!trace_depth_str.empty()) {
+        trace_depth = std::stoi(trace_depth_str);
+    }
+    trace_scope = getCmdOption(argc, argv, "+trace_scope=");
+    if (trace_stop != 0 && trace_stop <= trace_start) {
+        TB_ERR("Invalid waveform window: trace_stop (%lu) must be greater than trace_start (%lu)",
+               trace_stop, trace_start);
+        exit(EXIT_FAILURE);
+    }
+
     // Testbench initialization
     // ------------------------
     // Create log directory
@@ -175,11 +358,13 @@ int main(int argc, char *argv[])
     Vtb_system *dut = new Vtb_system(cntx);
 
     // Set the file to store the waveforms in
-    VerilatedFstC *trace = NULL;
+    TbTracer *trace = NULL;
     if (gen_waves) {
-        trace = new VerilatedFstC;
-        dut->trace(trace, 10);
-        trace->open(FST_FILENAME);
+        trace = new TbTracer;
+        trace->setMode(trace_mode);
+        trace->setWindow(trace_start, trace_stop);
+        trace->setFilter(trace_depth, trace_scope);
+        trace->open(dut, FST_FILENAME);
     }
 
     // Set scope for DPI functions
@@ -194,52 +379,109 @@ int main(int argc, char *argv[])
     // -----------------------------
     TB_CONFIG("Log level set to %u", logger.getLogLvl());
     TB_CONFIG("Waveform tracing %s", gen_waves ? "enabled" : "disabled");
+    if (gen_waves) trace->printConfig();
+    TB_CONFIG("Idle fast-forward %s", fast_forward ? "enabled" : "disabled");
+    if (!perf_report_file.empty()) {
+        TB_CONFIG("Performance report: %s", perf_report_file.c_str());
+    }
     TB_CONFIG("Max simulation cycles set to %lu", max_cycles);
     TB_CONFIG("Boot mode: %s", boot_mode_str.c_str());
     TB_CONFIG("Firmware: %s", firmware_file.c_str());
+    if (!preload_spec.empty()) {
+        TB_CONFIG("Preloading data blobs: %s", preload_spec.c_str());
+    }
     TB_CONFIG("Executing from %s", EXEC_FROM_FLASH ? "flash" : "RAM");
+    dsm_source.printConfig();
+    spi_master.printConfig();
+    profiler.printConfig();
+    bus_monitor.printConfig();
+    energy.printConfig();
+    if (!restore_checkpoint_file.empty()) {
+        TB_CONFIG("Restoring checkpoint: %s", restore_checkpoint_file.c_str());
+    }
+    if (checkpoint_pending) {
+        if (checkpoint_cycle == 0) TB_CONFIG("Saving checkpoint after firmware load: %s", save_checkpoint_file.c_str());
+        else TB_CONFIG("Saving checkpoint at cycle %lu: %s", checkpoint_cycle, save_checkpoint_file.c_str());
+    }
 
     // RUN SIMULATION
     // --------------
     TB_LOG(LOG_MEDIUM, "Starting simulation");
+    TbPerf perf;
+    perf.startRun(firmware_file);
 
-    // Initialize the DUT
-    initDut(dut, boot_mode, EXEC_FROM_FLASH);
-
-    // Reset the DUT
-    rstDut(dut, gen_waves, trace);
+    // Restore the state after reset and firmware load from a checkpoint
+    if (!restore_checkpoint_file.empty()) {
+        restoreCheckpoint(restore_checkpoint_file, dut);
+    } else {
+        // Initialize the DUT
+        initDut(dut, boot_mode, EXEC_FROM_FLASH);
+
+        // Reset the DUT
+        perf.startReset();
+        rstDut(dut, gen_waves, trace);
+        perf.endReset(sim_cycles);
+
+        // Read the ELF firmware and the data blobs to preload through the SRAM backdoor
+        int mem_size = 0;
+        tb_getMemSize(&mem_size);
+        TbMemLoader mem(mem_size);
+        unsigned long mem_words = 0;
+        if (firmware_elf && !mem.loadElf(firmware_file)) exit(EXIT_FAILURE);
+        if (!mem.loadBlobs(preload_spec)) exit(EXIT_FAILURE);
+
+        // Load firmware to SRAM
+        switch (boot_mode)
+        {
+        case BOOT_MODE_JTAG:
+            TB_LOG(LOG_LOW, "Waiting for JTAG (e.g., OpenOCD) to load firmware...");
+            break;
 
-    // Load firmware to SRAM
-    switch (boot_mode)
-    {
-    case BOOT_MODE_JTAG:
-        TB_LOG(LOG_LOW, "Waiting for JTAG (e.g., OpenOCD) to load firmware...");
-        break;
-
-    case BOOT_MODE_FORCE:
-        TB_LOG(LOG_LOW, "Loading firmware...");
-        TB_LOG(LOG_MEDIUM, "- writing firmware to SRAM...");
-        dut->tb_loadHEX(firmware_file.c_str());
-        runCycles(1, dut, gen_waves, trace);
-        TB_LOG(LOG_MEDIUM, "- triggering boot loop exit...");
-        dut->tb_set_exit_loop();
-        runCycles(1, dut, gen_waves, trace);
-        TB_LOG(LOG_LOW, "Firmware loaded. Running app...");
-        break;
+        case BOOT_MODE_FORCE:
+            TB_LOG(LOG_LOW, "Loading firmware...");
+            TB_LOG(LOG_MEDIUM, "- writing firmware to SRAM...");
+            if (!firmware_elf) dut->tb_loadHEX(firmware_file.c_str());
+            mem_words = mem.flush();
+            TB_LOG(LOG_MEDIUM, "- %lu words written through the SRAM backdoor", mem_words);
+            runCycles(1, dut, gen_waves, trace);
+            TB_LOG(LOG_MEDIUM, "- triggering boot loop exit...");
+            dut->tb_set_exit_loop();
+            runCycles(1, dut, gen_waves, trace);
+            TB_LOG(LOG_LOW, "Firmware loaded. Running app...");
+            break;
 
-    case BOOT_MODE_FLASH:
-        TB_LOG(LOG_LOW, "Waiting for boot code to load firmware from flash...");
-        break;
+        case BOOT_MODE_FLASH:
+            TB_LOG(LOG_LOW, "Waiting for boot code to load firmware from flash...");
+            break;
 
-    default:
-        TB_ERR("Invalid boot mode: %d", boot_mode);
-        exit(EXIT_FAILURE);
+        default:
+            TB_ERR("Invalid boot mode: %d", boot_mode);
+            exit(EXIT_FAILURE);
+        }
+        if (boot_mode != BOOT_MODE_FORCE && !preload_spec.empty()) {
+            mem_words = mem.flush();
+            TB_LOG(LOG_MEDIUM, "- %lu data words written through the SRAM backdoor", mem_words);
+        }
+        perf.endLoad();
     }
 
     // Run until the end of simulation is reached
     while (!cntx->gotFinish() && cntx->time() < (max_cycles << 1) && dut->exit_valid_o == 0) {
-        TB_LOG(LOG_FULL, "Running %lu cycles...", RUN_CYCLES);
-        runCycles(RUN_CYCLES, dut, gen_waves, trace);
+        // Save the checkpoint when the requested cycle is reached
+        if (checkpoint_pending && sim_cycles >= checkpoint_cycle) {
+            saveCheckpoint(save_checkpoint_file, dut);
+            checkpoint_pending = false;
+        }
+        unsigned int run_cycles = RUN_CYCLES;
+        if (checkpoint_pending && checkpoint_cycle - sim_cycles < run_cycles) {
+            run_cycles = checkpoint_cycle - sim_cycles;
+        }
+        TB_LOG(LOG_FULL, "Running %u cycles...", run_cycles);
+        if (fast_forward) runCyclesFastForward(run_cycles, dut, gen_waves, trace);
+        else runCycles(run_cycles, dut, gen_waves, trace);
+    }
+    if (checkpoint_pending) {
+        TB_WARN("Simulation ended before checkpoint cycle %lu", checkpoint_cycle);
     }
     if (cntx->time() >= (max_cycles << 1)) {
         TB_WARN("Max simulation cycles reached");
@@ -247,6 +489,15 @@ int main(int argc, char *argv[])
 
     // Print simulation status
     TB_LOG(LOG_LOW, "Simulation complete");
+    perf.endRun(sim_cycles, skipped_cycles);
+    spi_master.printStats();
+    profiler.write();
+
+    // Print simulation performance
+    if (gen_waves) perf.setTrace(trace->getTracedCycles(), trace->getDumpTime());
+    perf.setExit(dut->exit_valid_o, dut->exit_value_o);
+    perf.print();
+    if (!perf_report_file.empty()) perf.write(perf_report_file);
 
     // Check exit value
     if (dut->exit_valid_o) {
@@ -260,11 +511,17 @@ int main(int argc, char *argv[])
 
     // CLEAN UP
     // --------
-    // Simulation complete
+    // Simulation complete (reports the last bus monitor window and the
+    // energy estimate event counts)
     dut->final();
+    bus_monitor.printStats();
+    energy.write();
 
     // Clean up and exit
-    if (gen_waves) trace->close();
+    if (gen_waves) {
+        trace->close();
+        delete trace;
+    }
     delete dut;
     delete cntx;
     if (no_err) exit(EXIT_SUCCESS);
@@ -286,7 +543,7 @@ void clkGen(Vtb_system *dut) {
     dut->ref_clk_i ^= 1;
 }
 
-void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
+void rstDut(Vtb_system *dut, uint8_t gen_waves, TbTracer *trace) {
     dut->rst_ni = 1;
     TB_LOG(LOG_MEDIUM, "Resetting DUT...");
     runCycles(PRE_RESET_CYCLES, dut, gen_waves, trace);
@@ -298,7 +555,7 @@ void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
     runCycles(POST_RESET_CYCLES, dut, gen_waves, trace);
 }
 
-void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
+void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace) {
     VerilatedContext *cntx = dut->contextp();
     for (unsigned int i = 0; i < (2*ncycles); i++) {
         // Generate clock
@@ -308,12 +565,91 @@ void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, Verilat
         dut->eval();
 
         // Save waveforms
-        if (gen_waves) trace->dump(cntx->time());
+        if (gen_waves) trace->dump(cntx->time(), sim_cycles, dut->gpio_0_o);
         if (dut->ref_clk_i == 1) sim_cycles++;
         cntx->timeInc(1);
     }
 }
 
+void runCyclesFastForward(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace) {
+    static unsigned int idle_streak = 0;
+    VerilatedContext *cntx = dut->contextp();
+    vluint64_t end_cycle = sim_cycles + ncycles;
+    while (sim_cycles < end_cycle && !cntx->gotFinish() && dut->exit_valid_o == 0) {
+        runCycles(1, dut, gen_waves, trace);
+
+        // Wait for the system to be idle for a few cycles, so that any
+        // in-flight bus transaction is complete (see tb_get_idle_cycles)
+        int idle_cycles = 0;
+        tb_get_idle_cycles(&idle_cycles);
+        if (idle_cycles == 0) {
+            idle_streak = 0;
+            continue;
+        }
+        if (++idle_streak < FF_IDLE_CYCLES) continue;
+
+        // Skip up to the next refresh trigger. An even number of cycles is
+        // skipped to preserve the state of the free-running toggle flops.
+        vluint64_t nskip = idle_cycles;
+        if (nskip > end_cycle - sim_cycles) nskip = end_cycle - sim_cycles;
+        if (nskip > spi_master.getIdleCycles()) nskip = spi_master.getIdleCycles();
+        nskip &= ~1ULL;
+        if (nskip < FF_MIN_CYCLES) continue;
+        tb_skip_cycles((int) nskip);
+        profiler.skip(nskip);
+        bus_monitor.skip(nskip, dut->gpio_0_o);
+        sim_cycles += nskip;
+        skipped_cycles += nskip;
+        cntx->timeInc(2 * nskip);
+        TB_LOG(LOG_DEBUG, "Skipped %lu idle cycles", nskip);
+    }
+}
+
+void saveCheckpoint(const std::string& filename, Vtb_system *dut) {
+#ifdef TB_SAVABLE
+    VerilatedContext *cntx = dut->contextp();
+    VerilatedSave os;
+    TB_LOG(LOG_LOW, "Saving checkpoint at cycle %lu to '%s'...", sim_cycles, filename.c_str());
+    os.open(filename.c_str());
+    if (!os.isOpen()) {
+        TB_ERR("Cannot open checkpoint file '%s'", filename.c_str());
+        exit(EXIT_FAILURE);
+    }
+    // Testbench state first, then the model
+    vluint64_t time = cntx->time();
+    os << time << sim_cycles;
+    os << *dut;
+    os.close();
+#else
+    TB_ERR("Checkpoints require a savable model (build with VERILATOR_SAVABLE=1)");
+    exit(EXIT_FAILURE);
+#endif
+}
+
+void restoreCheckpoint(const std::string& filename, Vtb_system *dut) {
+#ifdef TB_SAVABLE
+    VerilatedContext *cntx = dut->contextp();
+    VerilatedRestore os;
+    vluint64_t time;
+    os.open(filename.c_str());
+    if (!os.isOpen()) {
+        TB_ERR("Cannot open checkpoint file '%s'", filename.c_str());
+        exit(EXIT_FAILURE);
+    }
+    os >> time >> sim_cycles;
+    os >> *dut;
+    os.close();
+    cntx->time(time);
+    TB_LOG(LOG_LOW, "Restored checkpoint at cycle %lu from '%s'", sim_cycles, filename.c_str());
+
+    // Re-open the host resources that are not part of the checkpoint
+    dut->tb_restore_handles();
+#else
+    TB_ERR("Checkpoints require a savable model (build with VERILATOR_SAVABLE=1)");
+    exit(EXIT_FAILURE);
+#endif
+}
+
 std::string getCmdOption(int argc, char* argv[], const std::string& option)
 {
 
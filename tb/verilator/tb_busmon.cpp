@@ -0,0 +1,195 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_busmon.cpp
+// Description: Bus load monitor (per-window counters reported by
+//              tb_bus_monitor.sv through DPI)
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "tb_busmon.hh"
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+
+static const char *const bus_class_names[BUS_CLS_NUM] = {"master", "slave", "periph"};
+
+TbBusMonitor::TbBusMonitor()
+{
+    this->window = 0;
+    this->out = NULL;
+    this->close();
+}
+
+TbBusMonitor::~TbBusMonitor()
+{
+    this->close();
+}
+
+void TbBusMonitor::clear(Counters& c)
+{
+    c.txns = 0;
+    c.writes = 0;
+    c.stalls = 0;
+    c.bytes = 0;
+    c.max_lat = 0;
+}
+
+bool TbBusMonitor::open(const std::string& spec, const std::string& out_file)
+{
+    this->close();
+    if (spec.empty()) return true;
+
+    long window = -1;
+    if (spec != "gpio") {
+        char *end;
+        window = strtol(spec.c_str(), &end, 0);
+        if (*end != '\0' || window < 0 || window > 0x7fffffff) {
+            TB_ERR("Invalid bus monitor window '%s' (expected a number of cycles or 'gpio')", spec.c_str());
+            return false;
+        }
+        if (window == 0) return true;
+    }
+
+    this->out = fopen(out_file.c_str(), "w");
+    if (this->out == NULL) {
+        TB_ERR("Cannot open bus monitor output file '%s': %s", out_file.c_str(), strerror(errno));
+        return false;
+    }
+    fprintf(this->out, "window,window_start,cycles,class,port,transactions,writes,stall_cycles,bytes,"
+                       "utilization,max_grant_latency\n");
+    this->out_file = out_file;
+    this->window = window;
+    return true;
+}
+
+void TbBusMonitor::close()
+{
+    if (this->out != NULL) fclose(this->out);
+    this->out = NULL;
+    this->window = 0;
+    for (int c = 0; c < BUS_CLS_NUM; c++) this->ports[c].clear();
+    this->win_start = 0;
+    this->skip_acc = 0;
+    this->total_cycles = 0;
+    this->nwindows = 0;
+}
+
+int TbBusMonitor::getWindow()
+{
+    return this->window;
+}
+
+void TbBusMonitor::addPort(bus_class_t cls, unsigned int idx, const std::string& name)
+{
+    std::vector<Port>& ports = this->ports[cls];
+    if (ports.size() <= idx) ports.resize(idx + 1);
+    ports[idx].name = name;
+    clear(ports[idx].win);
+    clear(ports[idx].total);
+    ports[idx].max_util = 0.0;
+    ports[idx].max_util_start = 0;
+}
+
+void TbBusMonitor::report(bus_class_t cls, unsigned int idx, uint32_t txns, uint32_t writes, uint32_t stalls,
+                          uint32_t bytes, uint32_t max_lat)
+{
+    if (idx >= this->ports[cls].size()) return;
+    Counters& win = this->ports[cls][idx].win;
+    win.txns = txns;
+    win.writes = writes;
+    win.stalls = stalls;
+    win.bytes = bytes;
+    win.max_lat = max_lat;
+}
+
+void TbBusMonitor::windowEnd(uint32_t ncycles)
+{
+    if (this->window == 0) return;
+
+    // Idle cycles skipped by the fast-forward belong to this window
+    uint64_t cycles = ncycles + this->skip_acc;
+    this->skip_acc = 0;
+    if (cycles == 0) return;
+
+    // A port is busy when it transfers data or waits for the grant
+    for (int c = 0; c < BUS_CLS_NUM; c++) {
+        for (Port& p : this->ports[c]) {
+            double util = (double) (p.win.txns + p.win.stalls) / cycles;
+            fprintf(this->out, "%lu,%lu,%lu,%s,%s,%lu,%lu,%lu,%lu,%.4f,%u\n", this->nwindows, this->win_start, cycles,
+                    bus_class_names[c], p.name.c_str(), p.win.txns, p.win.writes, p.win.stalls, p.win.bytes, util,
+                    p.win.max_lat);
+            p.total.txns += p.win.txns;
+            p.total.writes += p.win.writes;
+            p.total.stalls += p.win.stalls;
+            p.total.bytes += p.win.bytes;
+            if (p.win.max_lat > p.total.max_lat) p.total.max_lat = p.win.max_lat;
+            if (util > p.max_util) {
+                p.max_util = util;
+                p.max_util_start = this->win_start;
+            }
+            clear(p.win);
+        }
+    }
+    this->win_start += cycles;
+    this->total_cycles += cycles;
+    this->nwindows++;
+}
+
+void TbBusMonitor::skip(uint64_t ncycles, bool gpio)
+{
+    if (this->window > 0 || (this->window < 0 && gpio)) this->skip_acc += ncycles;
+}
+
+void TbBusMonitor::printConfig()
+{
+    if (this->window == 0) return;
+    if (this->window < 0) {
+        TB_CONFIG("Bus monitor: windows set by GPIO 0, output: %s", this->out_file.c_str());
+    } else {
+        TB_CONFIG("Bus monitor: %d-cycle windows, output: %s", this->window, this->out_file.c_str());
+    }
+}
+
+void TbBusMonitor::printStats()
+{
+    if (this->window == 0 || this->total_cycles == 0) return;
+    fflush(this->out);
+    TB_LOG(LOG_LOW, "Bus monitor: %lu cycles in %lu windows written to %s", this->total_cycles, this->nwindows,
+           this->out_file.c_str());
+    for (int c = 0; c < BUS_CLS_NUM; c++) {
+        for (const Port& p : this->ports[c]) {
+            // Ports never used are left out
+            if (p.total.txns == 0 && p.total.stalls == 0) continue;
+            std::string name = std::string(bus_class_names[c]) + " " + p.name;
+            double util = (double) (p.total.txns + p.total.stalls) / this->total_cycles;
+            TB_LOG(LOG_LOW, "- %s: %lu transactions (%lu writes), %lu bytes, %lu stall cycles", name.c_str(),
+                   p.total.txns, p.total.writes, p.total.bytes, p.total.stalls);
+            TB_LOG(LOG_LOW, "  utilisation %.2f%% (peak %.2f%% from cycle %lu), max grant latency %u cycles",
+                   100.0 * util, 100.0 * p.max_util, p.max_util_start, p.total.max_lat);
+        }
+    }
+}
+
+// DPI functions (see tb/tb_bus_monitor.sv)
+int tb_bus_window()
+{
+    return bus_monitor.getWindow();
+}
+
+void tb_bus_port(int cls, int idx, const char *name)
+{
+    bus_monitor.addPort((bus_class_t) cls, idx, name);
+}
+
+void tb_bus_report(int cls, int idx, int txns, int writes, int stalls, int bytes, int max_lat)
+{
+    bus_monitor.report((bus_class_t) cls, idx, txns, writes, stalls, bytes, max_lat);
+}
+
+void tb_bus_window_end(int cycles)
+{
+    bus_monitor.windowEnd(cycles);
+}
@@ -0,0 +1,90 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_busmon.hh
+// Description: Bus load monitor (per-window counters reported by
+//              tb_bus_monitor.sv through DPI)
+
+#if !defined(TB_BUSMON_HH_)
+#define TB_BUSMON_HH_
+
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <verilated.h>
+
+// Port classes (see tb/tb_bus_monitor.sv)
+typedef enum {
+    BUS_CLS_MASTER = 0, // system crossbar master
+    BUS_CLS_SLAVE = 1,  // system crossbar slave
+    BUS_CLS_PERIPH = 2, // external peripheral (register interface)
+    BUS_CLS_NUM = 3
+} bus_class_t;
+
+// Class definition
+class TbBusMonitor
+{
+private:
+    struct Counters {
+        uint64_t txns;    // granted requests
+        uint64_t writes;  // granted write requests
+        uint64_t stalls;  // cycles with a request waiting for the grant
+        uint64_t bytes;   // bytes transferred (byte enables)
+        uint32_t max_lat; // worst-case grant latency (cycles)
+    };
+    struct Port {
+        std::string name;
+        Counters win;       // current window
+        Counters total;     // whole run
+        double max_util;    // worst window utilisation
+        uint64_t max_util_start;
+    };
+
+    int window; // > 0: window length in cycles, < 0: GPIO 0 windows
+    std::string out_file;
+    FILE *out;
+    std::vector<Port> ports[BUS_CLS_NUM];
+    uint64_t win_start;   // first cycle of the current window
+    uint64_t skip_acc;    // cycles skipped by the fast-forward in this window
+    uint64_t total_cycles;
+    unsigned long nwindows;
+
+    static void clear(Counters& c);
+
+public:
+    TbBusMonitor();
+    ~TbBusMonitor();
+
+    // Open the monitor: spec is the window length in system clock cycles, or
+    // 'gpio' for one window per interval in which GPIO 0 is high (empty or 0:
+    // disabled). One line per port and window is written to the CSV file
+    // out_file.
+    bool open(const std::string& spec, const std::string& out_file);
+    void close();
+
+    int getWindow();
+
+    // Port names (reported once by tb_bus_monitor.sv)
+    void addPort(bus_class_t cls, unsigned int idx, const std::string& name);
+
+    // Counters of one port in the current window
+    void report(bus_class_t cls, unsigned int idx, uint32_t txns, uint32_t writes, uint32_t stalls,
+                uint32_t bytes, uint32_t max_lat);
+
+    // End of the current window, lasting ncycles monitored cycles
+    void windowEnd(uint32_t ncycles);
+
+    // Account for cycles skipped by the idle fast-forward (bus idle), with
+    // GPIO 0 in the given state
+    void skip(uint64_t ncycles, bool gpio);
+
+    void printConfig();
+    void printStats();
+};
+
+// Shared monitor (for the DPI functions)
+extern TbBusMonitor bus_monitor;
+
+#endif // TB_BUSMON_HH_
@@ -0,0 +1,282 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_dsm.cpp
+// Description: 1-bit ΔΣ bitstream source for the dsm_in input (DPI)
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tb_dsm.hh"
+
+// The source is also used by the virtual platform (tb/vp), without Verilator
+#if defined(VP_BUILD)
+#include "vp_log.hh"
+#else
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+#endif
+
+TbDsmSource::TbDsmSource()
+{
+    this->type = DSM_SRC_NONE;
+    this->bits = NULL;
+    this->nbits = 0;
+    this->map_size = 0;
+    this->period = 0;
+    this->amplitude = 0.5;
+    this->oversampling = 64;
+    this->order = 2;
+    this->next_idx = 0;
+    this->integ[0] = 0;
+    this->integ[1] = 0;
+    this->last_bit = 0;
+}
+
+TbDsmSource::~TbDsmSource()
+{
+    this->close();
+}
+
+bool TbDsmSource::openBin(const std::string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        TB_ERR("Cannot open ΔΣ bitstream '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        TB_ERR("Empty ΔΣ bitstream '%s'", filename.c_str());
+        ::close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        TB_ERR("Cannot map ΔΣ bitstream '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+    this->bits = (const uint8_t *) map;
+    this->map_size = st.st_size;
+    this->nbits = 8 * (uint64_t) st.st_size;
+    return true;
+}
+
+bool TbDsmSource::openText(const std::string& filename)
+{
+    FILE *fp = fopen(filename.c_str(), "r");
+    if (fp == NULL) {
+        TB_ERR("Cannot open ΔΣ bitstream '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    // Convert to a packed bitstream once
+    char line[64];
+    this->text_bits.clear();
+    this->nbits = 0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[0] != '0' && line[0] != '1' && line[0] != '-') continue;
+        if (this->nbits % 8 == 0) this->text_bits.push_back(0);
+        if (line[0] == '1') this->text_bits.back() |= 1 << (this->nbits % 8);
+        this->nbits++;
+    }
+    fclose(fp);
+    if (this->nbits == 0) {
+        TB_ERR("Empty ΔΣ bitstream '%s'", filename.c_str());
+        return false;
+    }
+    this->bits = this->text_bits.data();
+    return true;
+}
+
+bool TbDsmSource::openPcm(const std::string& filename)
+{
+    FILE *fp = fopen(filename.c_str(), "r");
+    if (fp == NULL) {
+        TB_ERR("Cannot open ΔΣ input samples '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    double sample;
+    this->pcm.clear();
+    while (fscanf(fp, "%lf", &sample) == 1) {
+        this->pcm.push_back(sample);
+    }
+    fclose(fp);
+    if (this->pcm.empty()) {
+        TB_ERR("No samples in '%s'", filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TbDsmSource::open(const std::string& spec)
+{
+    this->close();
+    if (spec.empty()) return true;
+
+    // Split the generator parameters
+    std::vector<std::string> fields;
+    size_t start = 0, end;
+    do {
+        end = spec.find(':', start);
+        fields.push_back(spec.substr(start, end == std::string::npos ? end : end - start));
+        start = end + 1;
+    } while (end != std::string::npos);
+
+    if (fields[0] == "sine") {
+        if (fields.size() < 2) {
+            TB_ERR("Invalid ΔΣ source '%s' (expected sine:<period>[:<amplitude>[:<order>]])", spec.c_str());
+            return false;
+        }
+        this->type = DSM_SRC_SINE;
+        this->period = strtod(fields[1].c_str(), NULL);
+        if (fields.size() > 2) this->amplitude = strtod(fields[2].c_str(), NULL);
+        if (fields.size() > 3) this->order = atoi(fields[3].c_str());
+    } else if (fields[0] == "pcm") {
+        if (fields.size() < 2) {
+            TB_ERR("Invalid ΔΣ source '%s' (expected pcm:<file>[:<oversampling>[:<order>]])", spec.c_str());
+            return false;
+        }
+        if (!this->openPcm(fields[1])) return false;
+        this->type = DSM_SRC_PCM;
+        if (fields.size() > 2) this->oversampling = atoi(fields[2].c_str());
+        if (fields.size() > 3) this->order = atoi(fields[3].c_str());
+    } else {
+        size_t ext = spec.rfind('.');
+        bool ok = (ext != std::string::npos && spec.substr(ext) == ".txt") ? this->openText(spec)
+                                                                          : this->openBin(spec);
+        if (!ok) return false;
+        this->type = DSM_SRC_BITS;
+        return true;
+    }
+
+    if ((this->type == DSM_SRC_SINE && this->period < 2) || this->oversampling == 0 ||
+        (this->order != 1 && this->order != 2) || this->amplitude <= 0 || this->amplitude >= 1) {
+        TB_ERR("Invalid ΔΣ source parameters '%s'", spec.c_str());
+        this->type = DSM_SRC_NONE;
+        return false;
+    }
+    return true;
+}
+
+void TbDsmSource::close()
+{
+    if (this->map_size > 0) munmap((void *) this->bits, this->map_size);
+    this->type = DSM_SRC_NONE;
+    this->bits = NULL;
+    this->nbits = 0;
+    this->map_size = 0;
+    this->text_bits.clear();
+    this->pcm.clear();
+    this->next_idx = 0;
+    this->integ[0] = 0;
+    this->integ[1] = 0;
+}
+
+bool TbDsmSource::isActive()
+{
+    return this->type != DSM_SRC_NONE;
+}
+
+double TbDsmSource::input(uint64_t idx)
+{
+    if (this->type == DSM_SRC_SINE) {
+        return this->amplitude * sin(2 * M_PI * fmod((double) idx, this->period) / this->period);
+    }
+    return this->pcm[(idx / this->oversampling) % this->pcm.size()];
+}
+
+uint8_t TbDsmSource::modulate(double x)
+{
+    // 1st order: single integrator; 2nd order: two integrators with feedback
+    // to both (the output is the sign of the last integrator)
+    double y = this->last_bit ? 1.0 : -1.0;
+    this->integ[0] += x - y;
+    if (this->order == 2) {
+        this->integ[1] += this->integ[0] - y;
+        this->last_bit = this->integ[1] >= 0;
+    } else {
+        this->last_bit = this->integ[0] >= 0;
+    }
+    return this->last_bit;
+}
+
+uint8_t TbDsmSource::getBit(uint64_t idx)
+{
+    switch (this->type) {
+    case DSM_SRC_BITS:
+        idx %= this->nbits;
+        return (this->bits[idx >> 3] >> (idx & 7)) & 1;
+
+    case DSM_SRC_SINE:
+    case DSM_SRC_PCM:
+        // The modulator state depends on the whole input history
+        if (idx < this->next_idx) {
+            this->next_idx = 0;
+            this->integ[0] = 0;
+            this->integ[1] = 0;
+            this->last_bit = 0;
+        }
+        while (this->next_idx < idx) this->modulate(this->input(this->next_idx++));
+        this->next_idx++;
+        return this->modulate(this->input(idx));
+
+    default:
+        return 0;
+    }
+}
+
+uint64_t TbDsmSource::getLength()
+{
+    switch (this->type) {
+    case DSM_SRC_BITS:
+        return this->nbits;
+    case DSM_SRC_PCM:
+        return (uint64_t) this->pcm.size() * this->oversampling;
+    default:
+        return 0;
+    }
+}
+
+void TbDsmSource::printConfig()
+{
+    switch (this->type) {
+    case DSM_SRC_BITS:
+        TB_CONFIG("ΔΣ source: bitstream, %lu bits%s", this->nbits, this->map_size > 0 ? " (memory-mapped)" : "");
+        break;
+    case DSM_SRC_SINE:
+        TB_CONFIG("ΔΣ source: sine, period %.1f cycles, amplitude %.2f, order %d", this->period,
+                  this->amplitude, this->order);
+        break;
+    case DSM_SRC_PCM:
+        TB_CONFIG("ΔΣ source: %lu samples, %u bits per sample, order %d", this->pcm.size(),
+                  this->oversampling, this->order);
+        break;
+    default:
+        break;
+    }
+}
+
+#if !defined(VP_BUILD)
+
+// DPI functions (see tb/tb_dsm_source.sv)
+int tb_dsm_active()
+{
+    return dsm_source.isActive();
+}
+
+svBit tb_dsm_bit(long long idx)
+{
+    return dsm_source.getBit(idx);
+}
+
+#endif // VP_BUILD
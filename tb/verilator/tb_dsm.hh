@@ -0,0 +1,86 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_dsm.hh
+// Description: 1-bit ΔΣ bitstream source for the dsm_in input (DPI)
+
+#if !defined(TB_DSM_HH_)
+#define TB_DSM_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#if !defined(VP_BUILD)
+#include <verilated.h>
+#endif
+
+// Source types
+typedef enum {
+    DSM_SRC_NONE,   // no source: dsm_in is driven by pdm2pcm_dummy
+    DSM_SRC_BITS,   // packed bitstream (memory-mapped binary or converted text file)
+    DSM_SRC_SINE,   // sine wave, modulated on the fly
+    DSM_SRC_PCM     // recorded samples, modulated on the fly
+} dsm_src_t;
+
+// Class definition
+class TbDsmSource
+{
+private:
+    dsm_src_t type;
+
+    // Packed bitstream (LSB first)
+    const uint8_t *bits;
+    uint64_t nbits;
+    size_t map_size; // size of the memory-mapped file (0: 'bits' points to 'text_bits')
+    std::vector<uint8_t> text_bits;
+
+    // ΔΣ modulator input
+    double period;   // sine period in bits
+    double amplitude;
+    std::vector<double> pcm;
+    unsigned int oversampling; // bits per PCM sample
+    int order;
+
+    // ΔΣ modulator state
+    uint64_t next_idx;
+    double integ[2];
+    uint8_t last_bit;
+
+    bool openBin(const std::string& filename);
+    bool openText(const std::string& filename);
+    bool openPcm(const std::string& filename);
+    double input(uint64_t idx);
+    uint8_t modulate(double x);
+
+public:
+    TbDsmSource();
+    ~TbDsmSource();
+
+    // Open a source:
+    // - <file>.bin: packed bitstream (LSB first), memory-mapped
+    // - <file>.txt: one bit per line (1, or 0/-1)
+    // - sine:<period>[:<amplitude>[:<order>]]: sine wave with a period of
+    //   <period> dsm_clk cycles (default amplitude 0.5, order 2)
+    // - pcm:<file>[:<oversampling>[:<order>]]: one sample in [-1, 1] per line,
+    //   each held for <oversampling> dsm_clk cycles (default 64, order 2)
+    bool open(const std::string& spec);
+    void close();
+
+    bool isActive();
+
+    // Get the bit for the idx-th dsm_clk cycle. File sources wrap around at
+    // the end of the stream. Generated streams are replayed from the start
+    // when idx goes backwards (e.g., after restoring a checkpoint).
+    uint8_t getBit(uint64_t idx);
+
+    // Length of the stream in bits (0 for the sine source, which is endless)
+    uint64_t getLength();
+
+    void printConfig();
+};
+
+// Shared source (for the DPI functions)
+extern TbDsmSource dsm_source;
+
+#endif // TB_DSM_HH_
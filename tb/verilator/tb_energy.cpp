@@ -0,0 +1,162 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_energy.cpp
+// Description: Activity-based energy estimate (event counts reported by
+//              tb_energy.sv, weighted with a per-event energy table)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "tb_energy.hh"
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+
+TbEnergy::TbEnergy()
+{
+    this->active = false;
+}
+
+bool TbEnergy::open(const std::string& table_file, const std::string& out_file)
+{
+    this->active = false;
+    this->events.clear();
+    if (table_file.empty()) return true;
+
+    std::ifstream table(table_file);
+    if (!table.is_open()) {
+        TB_ERR("Cannot open energy table '%s': %s", table_file.c_str(), strerror(errno));
+        return false;
+    }
+    std::string line;
+    unsigned int line_num = 0;
+    while (std::getline(table, line)) {
+        line_num++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        Event evt;
+        std::string extra;
+        if (!(fields >> evt.name)) continue; // empty line
+        if (!(fields >> evt.block >> evt.energy_pj) || (fields >> extra)) {
+            TB_ERR("%s:%u: invalid energy table entry (expected '<event> <block> <energy in pJ>')",
+                   table_file.c_str(), line_num);
+            return false;
+        }
+        for (const Event& e : this->events) {
+            if (e.name == evt.name) {
+                TB_ERR("%s:%u: duplicate energy table entry '%s'", table_file.c_str(), line_num,
+                       evt.name.c_str());
+                return false;
+            }
+        }
+        evt.in_table = true;
+        evt.count = 0;
+        this->events.push_back(evt);
+    }
+
+    this->table_file = table_file;
+    this->out_file = out_file;
+    this->active = true;
+    return true;
+}
+
+bool TbEnergy::isActive()
+{
+    return this->active;
+}
+
+void TbEnergy::count(const std::string& name, uint64_t count)
+{
+    for (Event& e : this->events) {
+        if (e.name == name) {
+            e.count = count;
+            return;
+        }
+    }
+    Event evt;
+    evt.name = name;
+    evt.block = "-";
+    evt.energy_pj = 0.0;
+    evt.in_table = false;
+    evt.count = count;
+    this->events.push_back(evt);
+}
+
+void TbEnergy::printConfig()
+{
+    if (!this->active) return;
+    TB_CONFIG("Energy estimate: %lu events in %s, output: %s", this->events.size(), this->table_file.c_str(),
+              this->out_file.c_str());
+}
+
+bool TbEnergy::write()
+{
+    if (!this->active) return true;
+
+    // Energy per block, in order of first appearance in the table
+    std::vector<std::string> blocks;
+    std::vector<double> block_uj;
+    double total_uj = 0.0;
+    uint64_t cycles = 0;
+    for (const Event& e : this->events) {
+        if (e.name == "cycle") cycles = e.count;
+        if (!e.in_table) {
+            if (e.count > 0) TB_WARN("Energy estimate: event '%s' (%lu) is not in the energy table", e.name.c_str(), e.count);
+            continue;
+        }
+        double uj = e.count * e.energy_pj * 1e-6;
+        size_t b = std::find(blocks.begin(), blocks.end(), e.block) - blocks.begin();
+        if (b == blocks.size()) {
+            blocks.push_back(e.block);
+            block_uj.push_back(0.0);
+        }
+        block_uj[b] += uj;
+        total_uj += uj;
+    }
+
+    TB_LOG(LOG_LOW, "Estimated energy: %.4f uJ in %lu cycles (%.3f pJ/cycle)", total_uj, cycles,
+           cycles ? total_uj * 1e6 / cycles : 0.0);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        if (block_uj[b] == 0.0) continue;
+        TB_LOG(LOG_LOW, "- %-8s %10.4f uJ (%5.1f%%)", blocks[b].c_str(), block_uj[b],
+               total_uj > 0.0 ? 100.0 * block_uj[b] / total_uj : 0.0);
+    }
+
+    // Per-event breakdown
+    FILE *out = fopen(this->out_file.c_str(), "w");
+    if (out == NULL) {
+        TB_ERR("Cannot open energy output file '%s': %s", this->out_file.c_str(), strerror(errno));
+        return false;
+    }
+    fprintf(out, "event,block,count,energy_pj,total_uj\n");
+    for (const Event& e : this->events) {
+        if (!e.in_table) continue;
+        fprintf(out, "%s,%s,%lu,%g,%.6f\n", e.name.c_str(), e.block.c_str(), e.count, e.energy_pj,
+                e.count * e.energy_pj * 1e-6);
+    }
+    for (size_t b = 0; b < blocks.size(); b++) {
+        fprintf(out, "total,%s,,,%.6f\n", blocks[b].c_str(), block_uj[b]);
+    }
+    fprintf(out, "total,all,,,%.6f\n", total_uj);
+    fclose(out);
+    TB_LOG(LOG_MEDIUM, "Energy breakdown written to '%s'", this->out_file.c_str());
+    return true;
+}
+
+// DPI functions (see tb/tb_energy.sv)
+int tb_energy_active()
+{
+    return energy.isActive();
+}
+
+void tb_energy_count(const char *name, long long count)
+{
+    energy.count(name, count);
+}
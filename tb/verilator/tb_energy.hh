@@ -0,0 +1,55 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_energy.hh
+// Description: Activity-based energy estimate (event counts reported by
+//              tb_energy.sv, weighted with a per-event energy table)
+
+#if !defined(TB_ENERGY_HH_)
+#define TB_ENERGY_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Class definition
+class TbEnergy
+{
+private:
+    struct Event {
+        std::string name;
+        std::string block;
+        double energy_pj; // energy per event
+        bool in_table;
+        uint64_t count;
+    };
+
+    bool active;
+    std::string table_file;
+    std::string out_file;
+    std::vector<Event> events; // table order, then events missing from the table
+
+public:
+    TbEnergy();
+
+    // Open the estimator with the energy table in table_file (empty: disabled).
+    // Each table line is '<event> <block> <energy in pJ>' ('#' starts a
+    // comment). The per-event breakdown is written to the CSV file out_file.
+    bool open(const std::string& table_file, const std::string& out_file);
+
+    bool isActive();
+
+    // Event count (reported by tb_energy.sv at the end of the simulation)
+    void count(const std::string& name, uint64_t count);
+
+    void printConfig();
+
+    // Print the estimated energy per block and write the per-event breakdown
+    bool write();
+};
+
+// Shared estimator (for the DPI functions)
+extern TbEnergy energy;
+
+#endif // TB_ENERGY_HH_
@@ -0,0 +1,181 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_logbuf.cpp
+// Description: Ring buffer of binary log events, formatted lazily on flush
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "tb_logbuf.hh"
+
+TbLogBuffer::TbLogBuffer(size_t nevents)
+{
+    this->ring.resize(nevents > 0 ? nevents : 1);
+    this->head = 0;
+    this->count = 0;
+    this->dropped = 0;
+}
+
+TbLogBuffer::~TbLogBuffer()
+{
+}
+
+void TbLogBuffer::packArg(tb_log_evt_t *evt, long long val)
+{
+    evt->arg_type[evt->nargs] = LOG_ARG_INT;
+    evt->arg[evt->nargs++].i = val;
+}
+
+void TbLogBuffer::packArg(tb_log_evt_t *evt, unsigned long long val)
+{
+    evt->arg_type[evt->nargs] = LOG_ARG_UINT;
+    evt->arg[evt->nargs++].u = val;
+}
+
+void TbLogBuffer::packArg(tb_log_evt_t *evt, double val)
+{
+    evt->arg_type[evt->nargs] = LOG_ARG_DOUBLE;
+    evt->arg[evt->nargs++].d = val;
+}
+
+void TbLogBuffer::packArg(tb_log_evt_t *evt, const char *val)
+{
+    // Copy the string to the event storage and keep its offset. Once the
+    // storage is full, the remaining strings are truncated to empty strings.
+    size_t len = val != NULL ? strnlen(val, TB_LOG_EVT_STR - 1 - evt->str_len) : 0;
+    if (len > 0) memcpy(&evt->str[evt->str_len], val, len);
+    evt->str[evt->str_len + len] = '\0';
+    evt->arg_type[evt->nargs] = LOG_ARG_STR;
+    evt->arg[evt->nargs++].u = evt->str_len;
+    evt->str_len += len;
+    if (evt->str_len < TB_LOG_EVT_STR - 1) evt->str_len++;
+}
+
+void TbLogBuffer::packArg(tb_log_evt_t *evt, const void *val)
+{
+    evt->arg_type[evt->nargs] = LOG_ARG_PTR;
+    evt->arg[evt->nargs++].p = val;
+}
+
+tb_log_evt_t *TbLogBuffer::alloc()
+{
+    size_t size = this->ring.size();
+    if (this->count == size) {
+        // Overwrite the oldest event
+        this->head = (this->head + 1) % size;
+        this->count--;
+        this->dropped++;
+    }
+    return &this->ring[(this->head + this->count++) % size];
+}
+
+void TbLogBuffer::format(const tb_log_evt_t *evt, char *buf, size_t size)
+{
+    const char *f = evt->fmt;
+    unsigned int n = 0;
+    size_t pos = 0;
+
+    while (*f != '\0' && pos < size - 1) {
+        if (*f != '%') {
+            buf[pos++] = *f++;
+            continue;
+        }
+        if (f[1] == '%') {
+            buf[pos++] = '%';
+            f += 2;
+            continue;
+        }
+
+        // Split the conversion specification: flags, width and precision are
+        // kept, the length modifier is replaced according to the stored type
+        std::string spec = "%";
+        f++;
+        while (*f != '\0' && strchr("-+ #0123456789.", *f) != NULL) spec += *f++;
+        int bits = 32;
+        while (*f != '\0' && strchr("hlLqjzt", *f) != NULL) {
+            if (*f == 'h') bits = (bits == 16) ? 8 : 16;
+            else bits = 64;
+            f++;
+        }
+        char conv = *f;
+        if (conv == '\0') break;
+        f++;
+
+        int len = 0;
+        if (n >= evt->nargs) {
+            len = snprintf(&buf[pos], size - pos, "%s", "<?>");
+        } else {
+            uint64_t u = evt->arg[n].u;
+            uint64_t mask = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+            switch (conv) {
+            case 'd':
+            case 'i':
+            case 'c': {
+                // Sign-extend from the original width
+                int64_t i = (int64_t) (u << (64 - bits)) >> (64 - bits);
+                if (conv == 'c') spec += 'c';
+                else spec += "lld";
+                len = snprintf(&buf[pos], size - pos, spec.c_str(), conv == 'c' ? (int) i : (long long) i);
+                break;
+            }
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                spec += "ll";
+                spec += conv;
+                len = snprintf(&buf[pos], size - pos, spec.c_str(), (unsigned long long) (u & mask));
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                spec += conv;
+                len = snprintf(&buf[pos], size - pos, spec.c_str(),
+                               evt->arg_type[n] == LOG_ARG_DOUBLE ? evt->arg[n].d : (double) evt->arg[n].i);
+                break;
+            case 's':
+                spec += 's';
+                len = snprintf(&buf[pos], size - pos, spec.c_str(),
+                               evt->arg_type[n] == LOG_ARG_STR ? &evt->str[u] : "<?>");
+                break;
+            case 'p':
+                spec += 'p';
+                len = snprintf(&buf[pos], size - pos, spec.c_str(), evt->arg[n].p);
+                break;
+            default:
+                len = snprintf(&buf[pos], size - pos, "%s", "<?>");
+                break;
+            }
+            n++;
+        }
+        if (len > 0) pos += ((size_t) len < size - pos) ? len : size - pos - 1;
+    }
+    buf[pos] = '\0';
+}
+
+void TbLogBuffer::flush(void (*print)(uint8_t tag, vluint64_t time, const char *file,
+                                      unsigned int line, const char *msg))
+{
+    char msg[512];
+    size_t size = this->ring.size();
+    for (size_t i = 0; i < this->count; i++) {
+        const tb_log_evt_t *evt = &this->ring[(this->head + i) % size];
+        format(evt, msg, sizeof(msg));
+        print(evt->tag, evt->time, evt->file, evt->line, msg);
+    }
+    this->head = 0;
+    this->count = 0;
+}
+
+vluint64_t TbLogBuffer::getDropped()
+{
+    return this->dropped;
+}
@@ -0,0 +1,112 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_logbuf.hh
+// Description: Ring buffer of binary log events, formatted lazily on flush
+
+#if !defined(TB_LOGBUF_HH_)
+#define TB_LOGBUF_HH_
+
+#include <stdint.h>
+#include <vector>
+#include <verilated.h>
+
+#define TB_LOG_EVT_ARGS 6 // maximum number of arguments per event
+#define TB_LOG_EVT_STR 64 // storage for the string arguments of an event
+
+// Argument types
+typedef enum {
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_STR,
+    LOG_ARG_PTR
+} log_arg_t;
+
+// Binary log event: the format string and source location are stored as
+// pointers to static data, the arguments as raw values
+typedef struct {
+    vluint64_t time;
+    const char *file;
+    const char *fmt;
+    uint32_t line;
+    uint8_t tag; // message tag (see TbLogger)
+    uint8_t nargs;
+    uint8_t str_len;
+    uint8_t arg_type[TB_LOG_EVT_ARGS];
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void *p;
+    } arg[TB_LOG_EVT_ARGS];
+    char str[TB_LOG_EVT_STR];
+} tb_log_evt_t;
+
+// Class definition
+class TbLogBuffer
+{
+private:
+    std::vector<tb_log_evt_t> ring;
+    size_t head;
+    size_t count;
+    vluint64_t dropped;
+
+    // Store an argument in the event (narrower types are promoted). String
+    // arguments are copied (and possibly truncated), since they may not
+    // outlive the event.
+    static void packArg(tb_log_evt_t *evt, long long val);
+    static void packArg(tb_log_evt_t *evt, unsigned long long val);
+    static void packArg(tb_log_evt_t *evt, int val) { packArg(evt, (long long) val); }
+    static void packArg(tb_log_evt_t *evt, long val) { packArg(evt, (long long) val); }
+    static void packArg(tb_log_evt_t *evt, unsigned int val) { packArg(evt, (unsigned long long) val); }
+    static void packArg(tb_log_evt_t *evt, unsigned long val) { packArg(evt, (unsigned long long) val); }
+    static void packArg(tb_log_evt_t *evt, double val);
+    static void packArg(tb_log_evt_t *evt, const char *val);
+    static void packArg(tb_log_evt_t *evt, const void *val);
+
+    static void packArgs(tb_log_evt_t *) {}
+    template <typename T, typename... Args>
+    static void packArgs(tb_log_evt_t *evt, T val, Args... args)
+    {
+        packArg(evt, val);
+        packArgs(evt, args...);
+    }
+
+    // Get the slot of a new event, overwriting the oldest one if full
+    tb_log_evt_t *alloc();
+
+    // Format an event message
+    static void format(const tb_log_evt_t *evt, char *buf, size_t size);
+
+public:
+    TbLogBuffer(size_t nevents);
+    ~TbLogBuffer();
+
+    // Record an event
+    template <typename... Args>
+    void push(uint8_t tag, vluint64_t time, const char *file, unsigned int line, const char *fmt,
+              Args... args)
+    {
+        static_assert(sizeof...(Args) <= TB_LOG_EVT_ARGS, "too many log arguments");
+        tb_log_evt_t *evt = this->alloc();
+        evt->time = time;
+        evt->file = file;
+        evt->fmt = fmt;
+        evt->line = line;
+        evt->tag = tag;
+        evt->nargs = 0;
+        evt->str_len = 0;
+        packArgs(evt, args...);
+    }
+
+    // Format the buffered events in order and pass them to a print function
+    void flush(void (*print)(uint8_t tag, vluint64_t time, const char *file, unsigned int line,
+                             const char *msg));
+
+    // Number of events overwritten before being flushed
+    vluint64_t getDropped();
+};
+
+#endif // TB_LOGBUF_HH_
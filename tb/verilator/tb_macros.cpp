@@ -1,14 +1,28 @@
+#include <cstring>
+
 #include "tb_macros.hh"
 
+// File name without the directory
+static inline const char *fileName(const char *path)
+{
+    const char *name = strrchr(path, '/');
+    return name != NULL ? name + 1 : path;
+}
+
 TbLogger::TbLogger() 
 {
     // By default, set the log level to medium
     this->log_lvl = LOG_MEDIUM;
     this->vcntx = NULL;
+    this->log_buf = NULL;
+    this->log_dropped = 0;
 }
 
 TbLogger::~TbLogger()
 {
+    // Print the buffered events at exit
+    this->flush();
+    delete this->log_buf;
 }
 
 log_lvl_t TbLogger::log_lvl;
@@ -74,44 +88,55 @@ log_lvl_t TbLogger::getLogLvl()
     return this->log_lvl;
 }
 
-void TbLogger::log(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt, ...)
+void TbLogger::setLogBuffer(size_t nevents)
 {
-    if (lvl <= this->log_lvl)
-    {
-        char n[256];
-        strcpy(n, file);
-        sprintf(this->str_buf, "[LOG   ] %s:%u >", basename(n), line);
-        printf("%-35s [%5lu] ", this->str_buf, this->getSimTime());
-        va_list arg_ptr;
-        va_start(arg_ptr, fmt);
-        vprintf(fmt, arg_ptr);
-        va_end(arg_ptr);
-        printf("\n");
+    this->flush();
+    delete this->log_buf;
+    this->log_buf = nevents > 0 ? new TbLogBuffer(nevents) : NULL;
+    this->log_dropped = 0;
+}
+
+void TbLogger::flush()
+{
+    if (this->log_buf == NULL) return;
+    vluint64_t dropped = this->log_buf->getDropped();
+    if (dropped > this->log_dropped) {
+        printf("[LOG   ] %lu older log events dropped (increase the log buffer size)\n",
+               dropped - this->log_dropped);
+        this->log_dropped = dropped;
     }
+    this->log_buf->flush(printEvent);
+    fflush(stdout);
 }
 
-void TbLogger::success(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt, ...)
+void TbLogger::print(uint8_t tag, vluint64_t time, const char *file, unsigned int line, const char *fmt, ...)
 {
-    if (lvl <= this->log_lvl)
-    {
-        char n[256];
-        strcpy(n, file);
-        sprintf(this->str_buf, "\033[1;32m[OK!   ] %s:%u >\033[0m", basename(n), line);
-        printf("%-46s [%5lu] ", this->str_buf, this->getSimTime());
-        va_list arg_ptr;
-        va_start(arg_ptr, fmt);
-        vprintf(fmt, arg_ptr);
-        va_end(arg_ptr);
-        printf("\n");
+    char str_buf[256];
+    if (tag == LOG_TAG_SUCCESS) {
+        snprintf(str_buf, sizeof(str_buf), "\033[1;32m[OK!   ] %s:%u >\033[0m", fileName(file), line);
+        printf("%-46s [%5lu] ", str_buf, time);
+    } else {
+        snprintf(str_buf, sizeof(str_buf), "[LOG   ] %s:%u >", fileName(file), line);
+        printf("%-35s [%5lu] ", str_buf, time);
     }
+    va_list arg_ptr;
+    va_start(arg_ptr, fmt);
+    vprintf(fmt, arg_ptr);
+    va_end(arg_ptr);
+    printf("\n");
+}
+
+void TbLogger::printEvent(uint8_t tag, vluint64_t time, const char *file, unsigned int line, const char *msg)
+{
+    print(tag, time, file, line, "%s", msg);
 }
 
 void TbLogger::config(const char *file, const unsigned int line, const char *fmt, ...)
 {
-    char n[256];
-    strcpy(n, file);
-    sprintf(this->str_buf, "\033[1m[CONFIG] %s:%u >\033[0m", basename(n), line);
-    printf("%-44s", this->str_buf);
+    char str_buf[256];
+    this->flush();
+    snprintf(str_buf, sizeof(str_buf), "\033[1m[CONFIG] %s:%u >\033[0m", fileName(file), line);
+    printf("%-44s", str_buf);
     va_list arg_ptr;
     va_start(arg_ptr, fmt);
     vprintf(fmt, arg_ptr);
@@ -121,10 +146,10 @@ void TbLogger::config(const char *file, const unsigned int line, const char *fmt
 
 void TbLogger::warning(const char *file, const unsigned int line, const char *fmt, ...)
 {
-    char n[256];
-    strcpy(n, file);
-    sprintf(this->str_buf, "\033[1;33m[WARN  ] %s:%u >\033[0m", basename(n), line);
-    fprintf(stderr, "%-46s [%5lu] ", this->str_buf, this->getSimTime());
+    char str_buf[256];
+    this->flush();
+    snprintf(str_buf, sizeof(str_buf), "\033[1;33m[WARN  ] %s:%u >\033[0m", fileName(file), line);
+    fprintf(stderr, "%-46s [%5lu] ", str_buf, this->getSimTime());
     va_list arg_ptr;
     va_start(arg_ptr, fmt);
     vfprintf(stderr, fmt, arg_ptr);
@@ -134,10 +159,10 @@ void TbLogger::warning(const char *file, const unsigned int line, const char *fm
 
 void TbLogger::error(const char *file, const unsigned int line, const char *fmt, ...)
 {
-    char n[256];
-    strcpy(n, file);
-    sprintf(this->str_buf, "\033[1;31m[ERR!  ] %s:%u >\033[0m", basename(n), line);
-    fprintf(stderr, "%-46s [%5lu] ", this->str_buf, this->getSimTime());
+    char str_buf[256];
+    this->flush();
+    snprintf(str_buf, sizeof(str_buf), "\033[1;31m[ERR!  ] %s:%u >\033[0m", fileName(file), line);
+    fprintf(stderr, "%-46s [%5lu] ", str_buf, this->getSimTime());
     va_list arg_ptr;
     va_start(arg_ptr, fmt);
     vfprintf(stderr, fmt, arg_ptr);
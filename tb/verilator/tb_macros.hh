@@ -2,14 +2,27 @@
 #define TB_MACROS_HH_
 
 #include <cstdio>
-#include <libgen.h>
 #include <verilated.h>
 
+#include "tb_logbuf.hh"
+
+// Messages above this level are removed at compile time
+// (e.g., -DTB_LOG_MAX_LVL=LOG_LOW)
+#ifndef TB_LOG_MAX_LVL
+#define TB_LOG_MAX_LVL LOG_DEBUG
+#endif
+
 #define TB_LOG(lvl, ...)\
-    logger.log(lvl, __FILE__, __LINE__, __VA_ARGS__)
+    do {\
+        if ((lvl) <= TB_LOG_MAX_LVL && logger.isEnabled(lvl))\
+            logger.log(lvl, __FILE__, __LINE__, __VA_ARGS__);\
+    } while (0)
 
 #define TB_SUCCESS(lvl, ...)\
-    logger.success(lvl, __FILE__, __LINE__, __VA_ARGS__)
+    do {\
+        if ((lvl) <= TB_LOG_MAX_LVL && logger.isEnabled(lvl))\
+            logger.success(lvl, __FILE__, __LINE__, __VA_ARGS__);\
+    } while (0)
 
 #define TB_CONFIG(...)\
     logger.config(__FILE__, __LINE__, __VA_ARGS__)
@@ -32,16 +45,29 @@ typedef enum {
     LOG_DEBUG
 } log_lvl_t;
 
+// Message tags
+typedef enum {
+    LOG_TAG_LOG,
+    LOG_TAG_SUCCESS
+} log_tag_t;
+
 // Class definition
 class TbLogger
 {
 private:
-    char str_buf[256];
     static log_lvl_t log_lvl;
     VerilatedContext *vcntx; // handle to the simulation context
+    TbLogBuffer *log_buf; // buffered events (NULL: print immediately)
+    vluint64_t log_dropped; // dropped events already reported
 
     // Get current simulation time if available
     vluint64_t getSimTime();
+
+    // Print a LOG/SUCCESS message
+    static void print(uint8_t tag, vluint64_t time, const char *file, unsigned int line,
+                      const char *fmt, ...);
+    static void printEvent(uint8_t tag, vluint64_t time, const char *file, unsigned int line,
+                           const char *msg);
 public:
     TbLogger();
     ~TbLogger();
@@ -56,10 +82,30 @@ public:
     
     // Get the current log level
     log_lvl_t getLogLvl();
+    static inline bool isEnabled(log_lvl_t lvl) { return lvl <= log_lvl; }
+
+    // Record LOG/SUCCESS messages as binary events in a ring buffer of
+    // 'nevents' entries, formatted only when flushed (0: print immediately)
+    void setLogBuffer(size_t nevents);
+    void flush();
 
     // Log messages
-    void log(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt...);
-    void success(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt...);
+    template <typename... Args>
+    void log(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt, Args... args)
+    {
+        if (this->log_buf != NULL)
+            this->log_buf->push(LOG_TAG_LOG, this->getSimTime(), file, line, fmt, args...);
+        else
+            print(LOG_TAG_LOG, this->getSimTime(), file, line, fmt, args...);
+    }
+    template <typename... Args>
+    void success(log_lvl_t lvl, const char *file, const unsigned int line, const char *fmt, Args... args)
+    {
+        if (this->log_buf != NULL)
+            this->log_buf->push(LOG_TAG_SUCCESS, this->getSimTime(), file, line, fmt, args...);
+        else
+            print(LOG_TAG_SUCCESS, this->getSimTime(), file, line, fmt, args...);
+    }
     void config(const char *file, const unsigned int line, const char *fmt...);
     void warning(const char *file, const unsigned int line, const char *fmt...);
     void error(const char *file, const unsigned int line, const char *fmt...);
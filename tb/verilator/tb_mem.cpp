@@ -0,0 +1,167 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_mem.cpp
+// Description: Backdoor SRAM preload from ELF files and raw data blobs
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <elf.h>
+
+#include "tb_mem.hh"
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+
+#ifndef EM_RISCV
+#define EM_RISCV 243
+#endif
+
+TbMemLoader::TbMemLoader(size_t mem_size)
+{
+    this->image.assign(mem_size, 0);
+    this->byte_valid.assign(mem_size, false);
+}
+
+TbMemLoader::~TbMemLoader()
+{
+}
+
+bool TbMemLoader::write(uint32_t addr, const uint8_t *data, size_t size, const std::string& source)
+{
+    if (addr > this->image.size() || size > this->image.size() - addr) {
+        TB_ERR("%s: [0x%08x, 0x%08lx) is outside the SRAM (%lu bytes)", source.c_str(), addr,
+               addr + size, this->image.size());
+        return false;
+    }
+    if (data != NULL) memcpy(this->image.data() + addr, data, size);
+    else memset(this->image.data() + addr, 0, size);
+    std::fill(this->byte_valid.begin() + addr, this->byte_valid.begin() + addr + size, true);
+    return true;
+}
+
+bool TbMemLoader::isElf(const std::string& filename)
+{
+    unsigned char magic[SELFMAG];
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if (fp == NULL) return false;
+    size_t n = fread(magic, 1, SELFMAG, fp);
+    fclose(fp);
+    return n == SELFMAG && memcmp(magic, ELFMAG, SELFMAG) == 0;
+}
+
+bool TbMemLoader::loadElf(const std::string& filename)
+{
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if (fp == NULL) {
+        TB_ERR("Cannot open ELF file '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+
+    // Check the ELF header
+    Elf32_Ehdr ehdr;
+    if (fread(&ehdr, sizeof(ehdr), 1, fp) != 1 || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr.e_ident[EI_CLASS] != ELFCLASS32 || ehdr.e_ident[EI_DATA] != ELFDATA2LSB ||
+        ehdr.e_machine != EM_RISCV) {
+        TB_ERR("'%s' is not a 32-bit little-endian RISC-V ELF file", filename.c_str());
+        fclose(fp);
+        return false;
+    }
+    TB_LOG(LOG_MEDIUM, "- ELF entry point: 0x%08x", ehdr.e_entry);
+
+    // Copy the loadable segments, zero-filling .bss
+    std::vector<uint8_t> buf;
+    for (unsigned int i = 0; i < ehdr.e_phnum; i++) {
+        Elf32_Phdr phdr;
+        if (fseek(fp, ehdr.e_phoff + i * ehdr.e_phentsize, SEEK_SET) != 0 ||
+            fread(&phdr, sizeof(phdr), 1, fp) != 1) {
+            TB_ERR("Cannot read program header %u of '%s'", i, filename.c_str());
+            fclose(fp);
+            return false;
+        }
+        if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0) continue;
+
+        buf.resize(phdr.p_filesz);
+        if (phdr.p_filesz > 0 && (fseek(fp, phdr.p_offset, SEEK_SET) != 0 ||
+                                  fread(buf.data(), 1, phdr.p_filesz, fp) != phdr.p_filesz)) {
+            TB_ERR("Cannot read segment %u of '%s'", i, filename.c_str());
+            fclose(fp);
+            return false;
+        }
+        TB_LOG(LOG_HIGH, "- segment %u: 0x%08x, %u bytes (%u from file)", i, phdr.p_paddr,
+               phdr.p_memsz, phdr.p_filesz);
+        if (!this->write(phdr.p_paddr, buf.data(), phdr.p_filesz, filename) ||
+            !this->write(phdr.p_paddr + phdr.p_filesz, NULL, phdr.p_memsz - phdr.p_filesz, filename)) {
+            fclose(fp);
+            return false;
+        }
+    }
+
+    fclose(fp);
+    return true;
+}
+
+bool TbMemLoader::loadBlob(const std::string& filename, uint32_t addr)
+{
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if (fp == NULL) {
+        TB_ERR("Cannot open data blob '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+        buf.insert(buf.end(), chunk, chunk + n);
+    }
+    fclose(fp);
+
+    TB_LOG(LOG_MEDIUM, "- data blob '%s': 0x%08x, %lu bytes", filename.c_str(), addr, buf.size());
+    return this->write(addr, buf.data(), buf.size(), filename);
+}
+
+bool TbMemLoader::loadBlobs(const std::string& spec)
+{
+    size_t start = 0;
+    while (start < spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(start, end - start);
+        start = end + 1;
+        if (item.empty()) continue;
+
+        size_t at = item.rfind('@');
+        if (at == std::string::npos || at == 0 || at == item.size() - 1) {
+            TB_ERR("Invalid preload '%s' (expected <file>@<address>)", item.c_str());
+            return false;
+        }
+        uint32_t addr = std::stoul(item.substr(at + 1), NULL, 0);
+        if (!this->loadBlob(item.substr(0, at), addr)) return false;
+    }
+    return true;
+}
+
+unsigned long TbMemLoader::flush()
+{
+    unsigned long nwords = 0;
+    for (size_t w = 0; w < this->image.size() / 4; w++) {
+        unsigned int nvalid = 0;
+        for (unsigned int i = 0; i < 4; i++) nvalid += this->byte_valid[4 * w + i];
+        if (nvalid == 0) continue;
+
+        // Partial words keep the bytes already in the SRAM (tb_loadHEX or an
+        // earlier flush)
+        uint32_t word = 0;
+        if (nvalid < 4) tb_readWord(4 * w, (int *) &word);
+        for (unsigned int i = 0; i < 4; i++) {
+            if (!this->byte_valid[4 * w + i]) continue;
+            word = (word & ~(0xffu << (8 * i))) | ((uint32_t) this->image[4 * w + i] << (8 * i));
+            this->byte_valid[4 * w + i] = false;
+        }
+        tb_writeWord(4 * w, word);
+        nwords++;
+    }
+    return nwords;
+}
@@ -0,0 +1,47 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_mem.hh
+// Description: Backdoor SRAM preload from ELF files and raw data blobs
+
+#if !defined(TB_MEM_HH_)
+#define TB_MEM_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Class definition
+class TbMemLoader
+{
+private:
+    // SRAM image, written to the banks by flush()
+    std::vector<uint8_t> image;
+    std::vector<bool> byte_valid;
+
+    // Copy a buffer into the SRAM image
+    bool write(uint32_t addr, const uint8_t *data, size_t size, const std::string& source);
+
+public:
+    TbMemLoader(size_t mem_size);
+    ~TbMemLoader();
+
+    // Check if a file starts with the ELF magic number
+    static bool isElf(const std::string& filename);
+
+    // Load the loadable segments of a 32-bit RISC-V ELF file
+    bool loadElf(const std::string& filename);
+
+    // Load a raw binary file at the given SRAM address
+    bool loadBlob(const std::string& filename, uint32_t addr);
+
+    // Load a comma-separated list of <file>@<addr> blobs
+    bool loadBlobs(const std::string& spec);
+
+    // Write the loaded bytes to the SRAM banks (tb_readWord/tb_writeWord DPI
+    // tasks)
+    unsigned long flush();
+};
+
+#endif // TB_MEM_HH_
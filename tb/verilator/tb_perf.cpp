@@ -0,0 +1,172 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_perf.cpp
+// Description: Simulation performance report (wall time, throughput)
+
+#include <cstdio>
+
+#include "tb_perf.hh"
+
+// The report is also used by the virtual platform (tb/vp), without Verilator
+#if defined(VP_BUILD)
+#include "vp_log.hh"
+#else
+#include "tb_macros.hh"
+#endif
+
+TbPerf::TbPerf()
+{
+    this->wall_s = 0;
+    this->reset_s = 0;
+    this->load_s = 0;
+    this->sim_cycles = 0;
+    this->reset_cycles = 0;
+    this->skipped_cycles = 0;
+    this->trace_cycles = 0;
+    this->trace_s = 0;
+    this->exit_valid = false;
+    this->exit_value = 0;
+}
+
+TbPerf::~TbPerf()
+{
+}
+
+double TbPerf::elapsed(clock::time_point start)
+{
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+void TbPerf::startRun(const std::string& firmware)
+{
+    this->firmware = firmware;
+    this->run_start = clock::now();
+}
+
+void TbPerf::startReset()
+{
+    this->reset_start = clock::now();
+}
+
+void TbPerf::endReset(vluint64_t reset_cycles)
+{
+    this->reset_s = elapsed(this->reset_start);
+    this->reset_cycles = reset_cycles;
+}
+
+void TbPerf::endLoad()
+{
+    this->load_s = elapsed(this->run_start) - this->reset_s;
+}
+
+void TbPerf::endRun(vluint64_t sim_cycles, vluint64_t skipped_cycles)
+{
+    this->wall_s = elapsed(this->run_start);
+    this->sim_cycles = sim_cycles;
+    this->skipped_cycles = skipped_cycles;
+}
+
+void TbPerf::setTrace(vluint64_t trace_cycles, double trace_s)
+{
+    this->trace_cycles = trace_cycles;
+    this->trace_s = trace_s;
+}
+
+void TbPerf::setExit(bool exit_valid, int exit_value)
+{
+    this->exit_valid = exit_valid;
+    this->exit_value = exit_value;
+}
+
+double TbPerf::getThroughput()
+{
+    // Cycles skipped by the fast-forward are not evaluated
+    vluint64_t eval_cycles = this->sim_cycles - this->skipped_cycles;
+    return this->wall_s > 0 ? eval_cycles / this->wall_s : 0.0;
+}
+
+std::string TbPerf::jsonString(const std::string& str)
+{
+    std::string out = "\"";
+    for (unsigned char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string TbPerf::csvField(const std::string& str)
+{
+    if (str.find_first_of(",\"\r\n") == std::string::npos) return str;
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void TbPerf::print()
+{
+    // NOTE: the first line is parsed by scripts/sim/verilator-bench.sh
+    TB_LOG(LOG_LOW, "Simulated %lu cycles in %.3f s (%.2f kHz)", this->sim_cycles, this->wall_s,
+           this->getThroughput() / 1e3);
+    TB_LOG(LOG_MEDIUM, "- reset: %lu cycles in %.3f s", this->reset_cycles, this->reset_s);
+    TB_LOG(LOG_MEDIUM, "- firmware load: %.3f s", this->load_s);
+    if (this->trace_cycles > 0) {
+        TB_LOG(LOG_MEDIUM, "- waveform dump: %lu cycles, %.3f s spent dumping", this->trace_cycles,
+               this->trace_s);
+    }
+    if (this->skipped_cycles > 0) {
+        TB_LOG(LOG_LOW, "Fast-forward skipped %lu idle cycles (%.1f%% of the simulation)",
+               this->skipped_cycles, 100.0 * this->skipped_cycles / this->sim_cycles);
+    }
+}
+
+bool TbPerf::write(const std::string& filename)
+{
+    FILE *fp = fopen(filename.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open performance report '%s'", filename.c_str());
+        return false;
+    }
+
+    size_t ext = filename.rfind('.');
+    if (ext != std::string::npos && filename.substr(ext) == ".json") {
+        fprintf(fp, "{\n");
+        fprintf(fp, "  \"firmware\": %s,\n", jsonString(this->firmware).c_str());
+        fprintf(fp, "  \"wall_s\": %.6f,\n", this->wall_s);
+        fprintf(fp, "  \"sim_cycles\": %lu,\n", this->sim_cycles);
+        fprintf(fp, "  \"cycles_per_s\": %.1f,\n", this->getThroughput());
+        fprintf(fp, "  \"reset_cycles\": %lu,\n", this->reset_cycles);
+        fprintf(fp, "  \"reset_s\": %.6f,\n", this->reset_s);
+        fprintf(fp, "  \"load_s\": %.6f,\n", this->load_s);
+        fprintf(fp, "  \"trace_cycles\": %lu,\n", this->trace_cycles);
+        fprintf(fp, "  \"trace_s\": %.6f,\n", this->trace_s);
+        fprintf(fp, "  \"skipped_cycles\": %lu,\n", this->skipped_cycles);
+        fprintf(fp, "  \"exit_valid\": %s,\n", this->exit_valid ? "true" : "false");
+        fprintf(fp, "  \"exit_value\": %d\n", this->exit_value);
+        fprintf(fp, "}\n");
+    } else {
+        fprintf(fp, "firmware,wall_s,sim_cycles,cycles_per_s,reset_cycles,reset_s,load_s,"
+                    "trace_cycles,trace_s,skipped_cycles,exit_valid,exit_value\n");
+        fprintf(fp, "%s,%.6f,%lu,%.1f,%lu,%.6f,%.6f,%lu,%.6f,%lu,%d,%d\n", csvField(this->firmware).c_str(),
+                this->wall_s, this->sim_cycles, this->getThroughput(), this->reset_cycles, this->reset_s,
+                this->load_s, this->trace_cycles, this->trace_s, this->skipped_cycles, this->exit_valid,
+                this->exit_value);
+    }
+
+    fclose(fp);
+    TB_LOG(LOG_MEDIUM, "Performance report written to '%s'", filename.c_str());
+    return true;
+}
@@ -0,0 +1,69 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_perf.hh
+// Description: Simulation performance report (wall time, throughput)
+
+#if !defined(TB_PERF_HH_)
+#define TB_PERF_HH_
+
+#include <chrono>
+#include <string>
+#if defined(VP_BUILD)
+#include <stdint.h>
+typedef uint64_t vluint64_t;
+#else
+#include <verilated.h>
+#endif
+
+// Class definition
+class TbPerf
+{
+private:
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point run_start;
+    clock::time_point reset_start;
+    double wall_s;
+    double reset_s;
+    double load_s;
+    vluint64_t sim_cycles;
+    vluint64_t reset_cycles;
+    vluint64_t skipped_cycles;
+    vluint64_t trace_cycles;
+    double trace_s;
+    bool exit_valid;
+    int exit_value;
+    std::string firmware;
+
+    static double elapsed(clock::time_point start);
+    static std::string jsonString(const std::string& str);
+    static std::string csvField(const std::string& str);
+
+public:
+    TbPerf();
+    ~TbPerf();
+
+    // Simulation phases
+    void startRun(const std::string& firmware);
+    void startReset();
+    void endReset(vluint64_t reset_cycles);
+    void endLoad();
+    void endRun(vluint64_t sim_cycles, vluint64_t skipped_cycles);
+
+    // Additional statistics
+    void setTrace(vluint64_t trace_cycles, double trace_s);
+    void setExit(bool exit_valid, int exit_value);
+
+    // Evaluated (simulated and not fast-forwarded) clock cycles per wall-clock second
+    double getThroughput();
+
+    // Print the report to the log
+    void print();
+
+    // Write the report to a JSON (.json) or CSV (any other extension) file
+    bool write(const std::string& filename);
+};
+
+#endif // TB_PERF_HH_
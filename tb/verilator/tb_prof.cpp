@@ -0,0 +1,363 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_prof.cpp
+// Description: Firmware profiler (program counter sampling or instruction
+//              trace, with a shadow call stack)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+
+#include "tb_prof.hh"
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+
+#define PROF_MAX_DEPTH 256
+
+TbProfiler::TbProfiler()
+{
+    this->mode = PROF_MODE_OFF;
+    this->period = 0;
+    this->fn_unknown = 0;
+    this->fn_sleep = 0;
+    this->cache_lo = 1;
+    this->cache_hi = 0;
+    this->cache_fn = 0;
+    this->count = NULL;
+    this->sleep_count = NULL;
+    this->skip_acc = 0;
+}
+
+TbProfiler::~TbProfiler()
+{
+}
+
+bool TbProfiler::loadSymbols(const std::string& elf_file)
+{
+    FILE *fp = fopen(elf_file.c_str(), "rb");
+    if (fp == NULL) {
+        TB_ERR("Cannot open ELF file '%s': %s", elf_file.c_str(), strerror(errno));
+        return false;
+    }
+    Elf32_Ehdr ehdr;
+    if (fread(&ehdr, sizeof(ehdr), 1, fp) != 1 || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr.e_ident[EI_CLASS] != ELFCLASS32 || ehdr.e_shentsize != sizeof(Elf32_Shdr)) {
+        TB_ERR("'%s' is not a 32-bit ELF file", elf_file.c_str());
+        fclose(fp);
+        return false;
+    }
+    std::vector<Elf32_Shdr> shdrs(ehdr.e_shnum);
+    if (fseek(fp, ehdr.e_shoff, SEEK_SET) != 0 ||
+        fread(shdrs.data(), sizeof(Elf32_Shdr), ehdr.e_shnum, fp) != ehdr.e_shnum) {
+        TB_ERR("Cannot read the section headers of '%s'", elf_file.c_str());
+        fclose(fp);
+        return false;
+    }
+
+    // Function and code label symbols from the symbol table
+    for (const Elf32_Shdr& sh : shdrs) {
+        if (sh.sh_type != SHT_SYMTAB || sh.sh_link >= shdrs.size()) continue;
+        const Elf32_Shdr& strsh = shdrs[sh.sh_link];
+        std::vector<Elf32_Sym> syms(sh.sh_size / sizeof(Elf32_Sym));
+        std::vector<char> strtab(strsh.sh_size + 1, '\0');
+        if (fseek(fp, sh.sh_offset, SEEK_SET) != 0 ||
+            fread(syms.data(), sizeof(Elf32_Sym), syms.size(), fp) != syms.size() ||
+            fseek(fp, strsh.sh_offset, SEEK_SET) != 0 ||
+            fread(strtab.data(), 1, strsh.sh_size, fp) != strsh.sh_size) {
+            TB_ERR("Cannot read the symbol table of '%s'", elf_file.c_str());
+            fclose(fp);
+            return false;
+        }
+        for (const Elf32_Sym& sym : syms) {
+            int type = ELF32_ST_TYPE(sym.st_info);
+            if (type != STT_FUNC && type != STT_NOTYPE) continue;
+            if (sym.st_shndx == SHN_UNDEF || sym.st_shndx >= shdrs.size() || sym.st_name >= strsh.sh_size) continue;
+            if (!(shdrs[sym.st_shndx].sh_flags & SHF_EXECINSTR)) continue;
+            const char *name = &strtab[sym.st_name];
+            if (name[0] == '\0' || name[0] == '$' || strncmp(name, ".L", 2) == 0) continue;
+            this->symbols.push_back({sym.st_value, sym.st_value + sym.st_size, name});
+        }
+    }
+    fclose(fp);
+    if (this->symbols.empty()) {
+        TB_ERR("No function symbols in '%s' (stripped?)", elf_file.c_str());
+        return false;
+    }
+
+    // Sort by address, keep one name per address and extend the labels
+    // without a size up to the next symbol
+    std::sort(this->symbols.begin(), this->symbols.end(), [](const Symbol& a, const Symbol& b) {
+        return a.addr < b.addr || (a.addr == b.addr && a.end > b.end);
+    });
+    std::vector<Symbol> uniq;
+    for (const Symbol& s : this->symbols) {
+        if (uniq.empty() || uniq.back().addr != s.addr) uniq.push_back(s);
+    }
+    for (size_t i = 0; i < uniq.size(); i++) {
+        uint32_t next = i + 1 < uniq.size() ? uniq[i + 1].addr : 0xffffffff;
+        if (uniq[i].end <= uniq[i].addr || uniq[i].end > next) uniq[i].end = next;
+    }
+    this->symbols.swap(uniq);
+    return true;
+}
+
+bool TbProfiler::open(const std::string& spec, const std::string& elf_file, const std::string& out_prefix)
+{
+    if (spec.empty() || spec == "0") return true;
+    if (spec == "retire") {
+        this->mode = PROF_MODE_RETIRE;
+    } else {
+        this->mode = PROF_MODE_SAMPLE;
+        this->period = strtoul(spec.c_str(), NULL, 0);
+        if (this->period == 0) {
+            TB_ERR("Invalid profiler setting '%s' (expected a sampling period in cycles or 'retire')", spec.c_str());
+            return false;
+        }
+    }
+    if (elf_file.empty()) {
+        TB_ERR("The profiler needs the firmware ELF file for the symbols");
+        return false;
+    }
+    if (!this->loadSymbols(elf_file)) return false;
+    this->fn_unknown = this->symbols.size();
+    this->symbols.push_back({0, 0, "[unknown]"});
+    this->fn_sleep = this->symbols.size();
+    this->symbols.push_back({0, 0, "[sleep]"});
+    this->out_prefix = out_prefix;
+    return true;
+}
+
+prof_mode_t TbProfiler::getMode()
+{
+    return this->mode;
+}
+
+unsigned int TbProfiler::getPeriod()
+{
+    return this->period;
+}
+
+int TbProfiler::lookup(uint32_t pc)
+{
+    if (pc >= this->cache_lo && pc < this->cache_hi) return this->cache_fn;
+
+    // Last function symbol at or below pc (the pseudo-functions are excluded)
+    auto first = this->symbols.begin();
+    auto last = first + this->fn_unknown;
+    auto it = std::upper_bound(first, last, pc, [](uint32_t a, const Symbol& s) { return a < s.addr; });
+    if (it == first || pc >= (it - 1)->end) return this->fn_unknown;
+    --it;
+    this->cache_lo = it->addr;
+    this->cache_hi = it->end;
+    this->cache_fn = it - first;
+    return this->cache_fn;
+}
+
+void TbProfiler::push(int fn, bool trap)
+{
+    if (this->stack.size() >= PROF_MAX_DEPTH) {
+        // Runaway stack (e.g., a missed return): collapse it
+        this->stack.clear();
+        this->trap_frame.clear();
+    }
+    this->stack.push_back(fn);
+    this->trap_frame.push_back(trap);
+    this->count = NULL;
+    this->sleep_count = NULL;
+}
+
+void TbProfiler::pop()
+{
+    if (this->stack.empty()) return;
+    this->stack.pop_back();
+    this->trap_frame.pop_back();
+    this->count = NULL;
+    this->sleep_count = NULL;
+}
+
+void TbProfiler::setLeaf(int fn)
+{
+    // Jumps that are neither calls nor returns (e.g., tail calls) replace
+    // the current frame
+    if (this->stack.empty()) {
+        this->push(fn, false);
+    } else if (this->stack.back() != fn) {
+        this->stack.back() = fn;
+        this->count = NULL;
+        this->sleep_count = NULL;
+    }
+}
+
+void TbProfiler::addSamples(bool sleeping, uint64_t n)
+{
+    if (this->stack.empty()) return;
+    if (!sleeping) {
+        if (this->count == NULL) this->count = &this->stacks[this->stack];
+        *this->count += n;
+    } else {
+        if (this->sleep_count == NULL) {
+            std::vector<int> key = this->stack;
+            key.push_back(this->fn_sleep);
+            this->sleep_count = &this->stacks[key];
+        }
+        *this->sleep_count += n;
+    }
+}
+
+void TbProfiler::retire(uint32_t pc, prof_kind_t kind)
+{
+    int fn = this->lookup(pc);
+    switch (kind) {
+    case PROF_KIND_CALL:
+        this->push(fn, false);
+        break;
+    case PROF_KIND_RET:
+        if (this->stack.size() > 1 && !this->trap_frame.back()) this->pop();
+        break;
+    case PROF_KIND_MRET:
+        // Unwind up to and including the trap frame
+        while (!this->stack.empty()) {
+            bool trap = this->trap_frame.back();
+            this->pop();
+            if (trap) break;
+        }
+        break;
+    case PROF_KIND_TRAP:
+        this->push(fn, true);
+        break;
+    default:
+        break;
+    }
+    this->setLeaf(fn);
+    if (this->mode == PROF_MODE_RETIRE) this->addSamples(false, 1);
+}
+
+void TbProfiler::sample(uint32_t pc, bool sleeping)
+{
+    this->setLeaf(this->lookup(pc));
+    this->addSamples(sleeping, 1);
+}
+
+void TbProfiler::skip(uint64_t ncycles)
+{
+    if (this->mode != PROF_MODE_SAMPLE) return;
+    this->skip_acc += ncycles;
+    this->addSamples(true, this->skip_acc / this->period);
+    this->skip_acc %= this->period;
+}
+
+bool TbProfiler::write()
+{
+    if (this->mode == PROF_MODE_OFF) return true;
+
+    // Self and inclusive counts (each function counted once per stack)
+    std::vector<uint64_t> self(this->symbols.size(), 0);
+    std::vector<uint64_t> total(this->symbols.size(), 0);
+    uint64_t nsamples = 0;
+    std::vector<bool> seen(this->symbols.size(), false);
+    for (const auto& it : this->stacks) {
+        nsamples += it.second;
+        self[it.first.back()] += it.second;
+        for (int fn : it.first) {
+            if (seen[fn]) continue;
+            seen[fn] = true;
+            total[fn] += it.second;
+        }
+        for (int fn : it.first) seen[fn] = false;
+    }
+    if (nsamples == 0) {
+        TB_WARN("Profiler: no samples collected");
+        return true;
+    }
+
+    // Flat profile, sorted by self count
+    std::string flat_file = this->out_prefix + ".txt";
+    FILE *fp = fopen(flat_file.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open profile file '%s': %s", flat_file.c_str(), strerror(errno));
+        return false;
+    }
+    std::vector<int> order;
+    for (size_t fn = 0; fn < self.size(); fn++) {
+        if (total[fn] > 0) order.push_back(fn);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return self[a] > self[b] || (self[a] == self[b] && total[a] > total[b]);
+    });
+    const char *unit = this->mode == PROF_MODE_RETIRE ? "instructions" : "samples";
+    fprintf(fp, "# %lu %s", nsamples, unit);
+    if (this->mode == PROF_MODE_SAMPLE) fprintf(fp, " (1 every %u cycles)", this->period);
+    fprintf(fp, "\n# %12s %7s %12s %7s  %s\n", "self", "self%", "total", "total%", "function");
+    for (int fn : order) {
+        fprintf(fp, "  %12lu %6.2f%% %12lu %6.2f%%  %s\n", self[fn], 100.0 * self[fn] / nsamples, total[fn],
+                100.0 * total[fn] / nsamples, this->symbols[fn].name.c_str());
+    }
+    fclose(fp);
+
+    // Folded stacks (root first), e.g. for flamegraph.pl or speedscope
+    std::string folded_file = this->out_prefix + ".folded";
+    fp = fopen(folded_file.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open profile file '%s': %s", folded_file.c_str(), strerror(errno));
+        return false;
+    }
+    for (const auto& it : this->stacks) {
+        if (it.second == 0) continue;
+        for (size_t i = 0; i < it.first.size(); i++) {
+            fprintf(fp, "%s%s", i ? ";" : "", this->symbols[it.first[i]].name.c_str());
+        }
+        fprintf(fp, " %lu\n", it.second);
+    }
+    fclose(fp);
+
+    // Summary
+    TB_LOG(LOG_LOW, "Profile: %lu %s written to %s and %s", nsamples, unit, flat_file.c_str(),
+           folded_file.c_str());
+    for (size_t i = 0; i < order.size() && i < 5; i++) {
+        TB_LOG(LOG_LOW, "- %6.2f%% %s", 100.0 * self[order[i]] / nsamples,
+               this->symbols[order[i]].name.c_str());
+    }
+    return true;
+}
+
+void TbProfiler::printConfig()
+{
+    switch (this->mode) {
+    case PROF_MODE_SAMPLE:
+        TB_CONFIG("Profiler: program counter sampled every %u cycles, %lu symbols", this->period,
+                  this->symbols.size() - 2);
+        break;
+    case PROF_MODE_RETIRE:
+        TB_CONFIG("Profiler: every retired instruction, %lu symbols", this->symbols.size() - 2);
+        break;
+    default:
+        return;
+    }
+    TB_CONFIG("Profiler output: %s.txt, %s.folded", this->out_prefix.c_str(), this->out_prefix.c_str());
+}
+
+// DPI functions (see tb/tb_profiler.sv)
+int tb_prof_mode()
+{
+    return profiler.getMode();
+}
+
+int tb_prof_period()
+{
+    return profiler.getPeriod();
+}
+
+void tb_prof_retire(int pc, int kind)
+{
+    profiler.retire(pc, (prof_kind_t) kind);
+}
+
+void tb_prof_sample(int pc, svBit sleeping)
+{
+    profiler.sample(pc, sleeping);
+}
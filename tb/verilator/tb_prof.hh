@@ -0,0 +1,105 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_prof.hh
+// Description: Firmware profiler (program counter sampling or instruction
+//              trace, with a shadow call stack)
+
+#if !defined(TB_PROF_HH_)
+#define TB_PROF_HH_
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <verilated.h>
+
+// Profiler modes
+typedef enum {
+    PROF_MODE_OFF = 0,
+    PROF_MODE_SAMPLE = 1, // sample the program counter every N cycles
+    PROF_MODE_RETIRE = 2  // count every retired instruction
+} prof_mode_t;
+
+// Last control transfer before a reported instruction (see tb_profiler.sv)
+typedef enum {
+    PROF_KIND_NONE = 0,
+    PROF_KIND_CALL = 1,
+    PROF_KIND_RET = 2,
+    PROF_KIND_MRET = 3,
+    PROF_KIND_TRAP = 4
+} prof_kind_t;
+
+// Class definition
+class TbProfiler
+{
+private:
+    struct Symbol {
+        uint32_t addr;
+        uint32_t end;
+        std::string name;
+    };
+
+    prof_mode_t mode;
+    unsigned int period;
+    std::string out_prefix;
+
+    // Function symbols sorted by address, followed by the pseudo-functions
+    std::vector<Symbol> symbols;
+    int fn_unknown;
+    int fn_sleep;
+
+    // Last symbol lookup
+    uint32_t cache_lo;
+    uint32_t cache_hi;
+    int cache_fn;
+
+    // Shadow call stack (leaf last) and trap frames
+    std::vector<int> stack;
+    std::vector<bool> trap_frame;
+
+    // Samples (or instructions) per call stack
+    std::map<std::vector<int>, uint64_t> stacks;
+    uint64_t *count;       // counter of the current stack (NULL: look it up)
+    uint64_t *sleep_count; // counter of the current stack while sleeping
+    uint64_t skip_acc;     // skipped cycles not yet accounted as samples
+
+    bool loadSymbols(const std::string& elf_file);
+    int lookup(uint32_t pc);
+    void push(int fn, bool trap);
+    void pop();
+    void setLeaf(int fn);
+    void addSamples(bool sleeping, uint64_t n);
+
+public:
+    TbProfiler();
+    ~TbProfiler();
+
+    // Open the profiler: spec is the sampling period in cycles, or 'retire'
+    // to count every retired instruction. Symbols are read from elf_file.
+    bool open(const std::string& spec, const std::string& elf_file, const std::string& out_prefix);
+
+    prof_mode_t getMode();
+    unsigned int getPeriod();
+
+    // Instruction retired right after a control transfer (every instruction
+    // in retire mode)
+    void retire(uint32_t pc, prof_kind_t kind);
+
+    // Program counter sample
+    void sample(uint32_t pc, bool sleeping);
+
+    // Account for cycles skipped by the idle fast-forward (CPU sleeping)
+    void skip(uint64_t ncycles);
+
+    // Write <prefix>.txt (flat profile) and <prefix>.folded (folded stacks)
+    bool write();
+
+    void printConfig();
+};
+
+// Shared profiler (for the DPI functions)
+extern TbProfiler profiler;
+
+#endif // TB_PROF_HH_
@@ -0,0 +1,329 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_spi.cpp
+// Description: SPI master model reading memory through the SPI slave (DPI)
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "tb_spi.hh"
+#include "tb_macros.hh"
+#include "Vtb_system__Dpi.h"
+
+TbSpiMaster::TbSpiMaster()
+{
+    this->active = false;
+    this->addr = 0;
+    this->nbytes = 0;
+    this->trigger = SPI_TRIG_GPIO;
+    this->start_cycle = 0;
+    this->period = 0;
+    this->sck_div = 4;
+    this->out = NULL;
+    this->cycles = NULL;
+    this->clk_khz = 0;
+    this->close();
+}
+
+TbSpiMaster::~TbSpiMaster()
+{
+    this->close();
+}
+
+bool TbSpiMaster::open(const std::string& spec, unsigned int sck_div, const std::string& out_file,
+                       const vluint64_t *cycles)
+{
+    this->close();
+    if (spec.empty()) return true;
+
+    // Split the schedule fields
+    std::vector<std::string> fields;
+    size_t start = 0, end;
+    do {
+        end = spec.find(':', start);
+        fields.push_back(spec.substr(start, end == std::string::npos ? end : end - start));
+        start = end + 1;
+    } while (end != std::string::npos);
+
+    if (fields.size() < 2 || fields.size() > 4 || (fields.size() == 4 && fields[2] == "gpio")) {
+        TB_ERR("Invalid SPI read schedule '%s' (expected <addr>:<bytes>[:gpio|:<start>[:<period>]])", spec.c_str());
+        return false;
+    }
+    this->addr = strtoul(fields[0].c_str(), NULL, 0);
+    this->nbytes = strtoul(fields[1].c_str(), NULL, 0);
+    if (fields.size() == 2 || fields[2] == "gpio") {
+        this->trigger = SPI_TRIG_GPIO;
+    } else {
+        this->trigger = SPI_TRIG_CYCLE;
+        this->start_cycle = strtoull(fields[2].c_str(), NULL, 0);
+        if (fields.size() > 3) this->period = strtoull(fields[3].c_str(), NULL, 0);
+    }
+    if (this->nbytes == 0 || this->addr % 4 != 0 || sck_div == 0) {
+        TB_ERR("Invalid SPI read parameters '%s' (word-aligned address, non-zero size and SCK divider)",
+               spec.c_str());
+        return false;
+    }
+    this->sck_div = sck_div;
+
+    this->out = fopen(out_file.c_str(), "wb");
+    if (this->out == NULL) {
+        TB_ERR("Cannot open SPI output file '%s': %s", out_file.c_str(), strerror(errno));
+        return false;
+    }
+    this->out_file = out_file;
+    this->cycles = cycles;
+    this->next_cycle = this->start_cycle;
+    this->active = true;
+    return true;
+}
+
+void TbSpiMaster::close()
+{
+    if (this->out != NULL) fclose(this->out);
+    this->out = NULL;
+    this->active = false;
+    this->phase = SPI_PH_IDLE;
+    this->next_cycle = 0;
+    this->pending = false;
+    this->gpio_q = 0;
+    this->chunk_addr = 0;
+    this->chunk_words = 0;
+    this->bytes_left = 0;
+    this->bit_idx = 0;
+    this->dummy_left = 0;
+    this->rx_word = 0;
+    this->half_cnt = 0;
+    this->sck = 0;
+    this->mosi = 0;
+    this->xfer_start = 0;
+    this->transactions = 0;
+    this->missed = 0;
+    this->bytes = 0;
+    this->sck_cycles = 0;
+    this->busy_cycles = 0;
+}
+
+bool TbSpiMaster::isActive()
+{
+    return this->active;
+}
+
+bool TbSpiMaster::isBusy()
+{
+    return this->phase != SPI_PH_IDLE || this->pending;
+}
+
+void TbSpiMaster::setClkFreq(unsigned long clk_khz)
+{
+    this->clk_khz = clk_khz;
+}
+
+vluint64_t TbSpiMaster::getIdleCycles()
+{
+    // GPIO 0 does not change while the CPU sleeps
+    if (!this->active || this->trigger == SPI_TRIG_GPIO) return ~0ULL;
+    if (this->isBusy()) return 0;
+    if (this->next_cycle <= *this->cycles) return 0;
+    return this->next_cycle - *this->cycles;
+}
+
+void TbSpiMaster::startTransaction()
+{
+    this->pending = false;
+    this->transactions++;
+    this->chunk_addr = this->addr;
+    this->bytes_left = this->nbytes;
+    this->xfer_start = *this->cycles;
+    this->startChunk();
+}
+
+void TbSpiMaster::startChunk()
+{
+    // The wrap length of the SPI slave limits the words read per command
+    uint32_t words = (this->bytes_left + 3) / 4;
+    if (words > SPI_SLAVE_MAX_WORDS) words = SPI_SLAVE_MAX_WORDS;
+    this->chunk_words = words;
+
+    // Same sequence as spi_slave_request_read() in the X-HEEP SDK, with CS
+    // kept low: dummy cycles, wrap length, read command and address
+    this->header[0] = SPI_SLAVE_WRITE_REG0;
+    this->header[1] = SPI_SLAVE_DUMMY_CYCLES;
+    this->header[2] = SPI_SLAVE_WRITE_REG1;
+    this->header[3] = words & 0xff;
+    this->header[4] = SPI_SLAVE_WRITE_REG2;
+    this->header[5] = (words >> 8) & 0xff;
+    this->header[6] = SPI_SLAVE_CMD_READ;
+    this->header[7] = (this->chunk_addr >> 24) & 0xff;
+    this->header[8] = (this->chunk_addr >> 16) & 0xff;
+    this->header[9] = (this->chunk_addr >> 8) & 0xff;
+    this->header[10] = this->chunk_addr & 0xff;
+
+    this->phase = SPI_PH_HEADER;
+    this->bit_idx = 0;
+    this->half_cnt = 0;
+    this->sck = 0;
+    this->mosi = this->headerBit(0);
+}
+
+void TbSpiMaster::endChunk()
+{
+    this->chunk_addr += 4 * SPI_SLAVE_MAX_WORDS;
+    this->phase = SPI_PH_GAP;
+    this->half_cnt = 0;
+    this->sck = 0;
+    this->mosi = 0;
+    if (this->bytes_left == 0) {
+        this->busy_cycles += *this->cycles - this->xfer_start;
+        TB_LOG(LOG_HIGH, "SPI read of %u bytes from 0x%08x complete", this->nbytes, this->addr);
+    }
+}
+
+uint8_t TbSpiMaster::headerBit(unsigned int idx)
+{
+    // MSB first
+    return (this->header[idx >> 3] >> (7 - (idx & 7))) & 1;
+}
+
+void TbSpiMaster::risingEdge(uint8_t miso)
+{
+    this->sck_cycles++;
+    switch (this->phase) {
+    case SPI_PH_HEADER:
+        // The slave samples MOSI on this edge
+        if (++this->bit_idx == 8 * sizeof(this->header)) {
+            this->phase = SPI_PH_DUMMY;
+            this->dummy_left = SPI_SLAVE_DUMMY_CYCLES + 1;
+        }
+        break;
+
+    case SPI_PH_DUMMY:
+        if (--this->dummy_left == 0) {
+            this->phase = SPI_PH_DATA;
+            this->bit_idx = 0;
+        }
+        break;
+
+    case SPI_PH_DATA:
+        // Words are sent MSB first; store them in memory (little-endian) order
+        this->rx_word = (this->rx_word << 1) | miso;
+        if (++this->bit_idx == 32) {
+            uint8_t data[4];
+            uint32_t n = this->bytes_left < 4 ? this->bytes_left : 4;
+            for (int i = 0; i < 4; i++) data[i] = (this->rx_word >> (8 * i)) & 0xff;
+            fwrite(data, 1, n, this->out);
+            this->bytes += n;
+            this->bytes_left -= n;
+            this->chunk_words--;
+            this->bit_idx = 0;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void TbSpiMaster::fallingEdge()
+{
+    // The slave shifts MISO on this edge
+    if (this->phase == SPI_PH_HEADER) {
+        this->mosi = this->headerBit(this->bit_idx);
+    } else {
+        this->mosi = 0;
+        if (this->phase == SPI_PH_DATA && this->chunk_words == 0) this->endChunk();
+    }
+}
+
+uint8_t TbSpiMaster::step(uint8_t gpio, uint8_t miso)
+{
+    // Triggers
+    bool trig = false;
+    if (this->trigger == SPI_TRIG_GPIO) {
+        trig = gpio && !this->gpio_q;
+        this->gpio_q = gpio;
+    } else if (*this->cycles >= this->next_cycle) {
+        trig = true;
+        if (this->period == 0) this->next_cycle = ~0ULL;
+        else while (this->next_cycle <= *this->cycles) this->next_cycle += this->period;
+    }
+    if (trig) {
+        // Only one transaction is queued while the previous one is running
+        if (this->pending) this->missed++;
+        this->pending = true;
+    }
+
+    switch (this->phase) {
+    case SPI_PH_IDLE:
+        if (this->pending) this->startTransaction();
+        break;
+
+    case SPI_PH_GAP:
+        // Keep CS high for one SCK period
+        if (++this->half_cnt < 2 * this->sck_div) break;
+        if (this->bytes_left > 0) this->startChunk();
+        else this->phase = SPI_PH_IDLE;
+        break;
+
+    default:
+        if (++this->half_cnt < this->sck_div) break;
+        this->half_cnt = 0;
+        this->sck ^= 1;
+        if (this->sck) this->risingEdge(miso);
+        else this->fallingEdge();
+        break;
+    }
+
+    uint8_t cs_n = this->phase == SPI_PH_IDLE || this->phase == SPI_PH_GAP;
+    return (this->isBusy() << 3) | (cs_n << 2) | (this->sck << 1) | this->mosi;
+}
+
+void TbSpiMaster::printConfig()
+{
+    if (!this->active) return;
+    if (this->trigger == SPI_TRIG_GPIO) {
+        TB_CONFIG("SPI master: read %u bytes from 0x%08x on GPIO 0 rising edge", this->nbytes, this->addr);
+    } else if (this->period == 0) {
+        TB_CONFIG("SPI master: read %u bytes from 0x%08x at cycle %lu", this->nbytes, this->addr,
+                  this->start_cycle);
+    } else {
+        TB_CONFIG("SPI master: read %u bytes from 0x%08x at cycle %lu, every %lu cycles", this->nbytes,
+                  this->addr, this->start_cycle, this->period);
+    }
+    TB_CONFIG("SPI master: SCK = system clock / %u, output: %s", 2 * this->sck_div, this->out_file.c_str());
+}
+
+void TbSpiMaster::printStats()
+{
+    if (!this->active) return;
+    fflush(this->out);
+    TB_LOG(LOG_LOW, "SPI master: %lu transactions, %lu bytes read in %lu SCK cycles", this->transactions,
+           this->bytes, this->sck_cycles);
+    if (this->busy_cycles > 0) {
+        double bytes_per_cycle = (double) this->bytes / this->busy_cycles;
+        TB_LOG(LOG_LOW, "SPI master: readout bandwidth %.4f bytes/cycle (%.3f MB/s at %lu kHz)",
+               bytes_per_cycle, bytes_per_cycle * this->clk_khz / 1000.0, this->clk_khz);
+    }
+    if (this->missed > 0) {
+        TB_WARN("SPI master: %lu triggers dropped while the previous read was still pending", this->missed);
+    }
+    if (this->phase != SPI_PH_IDLE) {
+        TB_WARN("SPI master: simulation ended during a transaction (%u bytes left)", this->bytes_left);
+    }
+}
+
+// DPI functions (see tb/tb_spi_master.sv)
+int tb_spi_init(int clk_freq_khz)
+{
+    spi_master.setClkFreq(clk_freq_khz);
+    return spi_master.isActive();
+}
+
+int tb_spi_step(svBit gpio, svBit miso)
+{
+    return spi_master.step(gpio, miso);
+}
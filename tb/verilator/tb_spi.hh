@@ -0,0 +1,119 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_spi.hh
+// Description: SPI master model reading memory through the SPI slave (DPI)
+
+#if !defined(TB_SPI_HH_)
+#define TB_SPI_HH_
+
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <verilated.h>
+
+// SPI slave commands (see obi_spi_slave's spi_slave_cmd_parser)
+#define SPI_SLAVE_CMD_READ      0x0B
+#define SPI_SLAVE_WRITE_REG0    0x11 // dummy cycles
+#define SPI_SLAVE_WRITE_REG1    0x20 // wrap length, low byte
+#define SPI_SLAVE_WRITE_REG2    0x30 // wrap length, high byte
+#define SPI_SLAVE_DUMMY_CYCLES  32
+#define SPI_SLAVE_MAX_WORDS     0xffff
+
+// Transaction triggers
+typedef enum {
+    SPI_TRIG_GPIO,  // rising edge of GPIO 0
+    SPI_TRIG_CYCLE  // at a given cycle, optionally repeated with a period
+} spi_trig_t;
+
+// Transaction phases
+typedef enum {
+    SPI_PH_IDLE,    // CS high, waiting for a trigger
+    SPI_PH_HEADER,  // shifting out the register writes, command and address
+    SPI_PH_DUMMY,   // dummy cycles before the data
+    SPI_PH_DATA,    // shifting in the data words
+    SPI_PH_GAP      // CS high between two transactions
+} spi_phase_t;
+
+// Class definition
+class TbSpiMaster
+{
+private:
+    // Configuration
+    bool active;
+    uint32_t addr;
+    uint32_t nbytes;
+    spi_trig_t trigger;
+    vluint64_t start_cycle;
+    vluint64_t period;
+    unsigned int sck_div; // system clock cycles per SCK half period
+    std::string out_file;
+    FILE *out;
+    const vluint64_t *cycles; // testbench cycle counter
+    unsigned long clk_khz;    // system clock frequency (for the bandwidth)
+
+    // Transaction state
+    spi_phase_t phase;
+    vluint64_t next_cycle;
+    bool pending;
+    uint8_t gpio_q;
+    uint32_t chunk_addr;  // address of the current chunk
+    uint32_t chunk_words; // words left to read from the current chunk
+    uint32_t bytes_left;  // bytes left to read from the whole region
+    uint8_t header[11];
+    unsigned int bit_idx;
+    unsigned int dummy_left;
+    uint32_t rx_word;
+    unsigned int half_cnt;
+    uint8_t sck;
+    uint8_t mosi;
+    vluint64_t xfer_start;
+
+    // Statistics
+    unsigned long transactions;
+    unsigned long missed; // triggers dropped while a transaction was queued
+    unsigned long bytes;
+    vluint64_t sck_cycles;
+    vluint64_t busy_cycles;
+
+    void startTransaction();
+    void startChunk();
+    void endChunk();
+    uint8_t headerBit(unsigned int idx);
+    void risingEdge(uint8_t miso);
+    void fallingEdge();
+
+public:
+    TbSpiMaster();
+    ~TbSpiMaster();
+
+    // Open a read schedule: <addr>:<bytes>[:gpio|:<start>[:<period>]]
+    // - gpio: read on each rising edge of GPIO 0 (default)
+    // - <start>[:<period>]: read at cycle <start>, then every <period> cycles
+    // The bytes read are appended to out_file, in memory order.
+    bool open(const std::string& spec, unsigned int sck_div, const std::string& out_file,
+              const vluint64_t *cycles);
+    void close();
+
+    bool isActive();
+    bool isBusy();
+
+    // System clock frequency in kHz (set by tb_spi_master.sv)
+    void setClkFreq(unsigned long clk_khz);
+
+    // Cycles before the next scheduled transaction (for idle fast-forward)
+    vluint64_t getIdleCycles();
+
+    // Advance the model by one system clock cycle. Returns the pin values
+    // packed as {busy, cs_n, sck, mosi}.
+    uint8_t step(uint8_t gpio, uint8_t miso);
+
+    void printConfig();
+    void printStats();
+};
+
+// Shared model (for the DPI functions)
+extern TbSpiMaster spi_master;
+
+#endif // TB_SPI_HH_
@@ -0,0 +1,123 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_trace.cpp
+// Description: Windowed and GPIO-triggered FST waveform tracing
+
+#include "tb_trace.hh"
+#include "tb_macros.hh"
+
+TbTracer::TbTracer()
+{
+    this->fst = NULL;
+    this->mode = TRACE_MODE_ON;
+    this->start_cycle = 0;
+    this->stop_cycle = 0;
+    this->depth = 0;
+    this->active = false;
+    this->windows = 0;
+    this->dumps = 0;
+    this->dump_s = 0;
+}
+
+TbTracer::~TbTracer()
+{
+    this->close();
+}
+
+void TbTracer::setMode(trace_mode_t mode)
+{
+    this->mode = mode;
+}
+
+void TbTracer::setWindow(vluint64_t start_cycle, vluint64_t stop_cycle)
+{
+    this->start_cycle = start_cycle;
+    this->stop_cycle = stop_cycle;
+}
+
+void TbTracer::setFilter(int depth, const std::string& scope)
+{
+    this->depth = depth;
+    this->scope = scope;
+}
+
+void TbTracer::open(Vtb_system *dut, const char *filename)
+{
+    this->fst = new VerilatedFstC;
+#if defined(VERILATOR_VERSION_INTEGER) && VERILATOR_VERSION_INTEGER >= 5000000
+    // Only the signals selected by dumpvars() are registered in the FST file
+    if (this->depth > 0 || !this->scope.empty()) {
+        this->fst->dumpvars(this->depth, this->scope);
+    }
+    dut->trace(this->fst, 10);
+#else
+    if (!this->scope.empty()) {
+        TB_WARN("Trace scope filter requires Verilator v5: dumping the whole design");
+    }
+    dut->trace(this->fst, this->depth > 0 ? this->depth : 10);
+#endif
+    this->fst->open(filename);
+}
+
+void TbTracer::dump(vluint64_t time, vluint64_t cycle, bool gpio)
+{
+    if (this->fst == NULL) return;
+
+    // Check the cycle window and the GPIO trigger
+    bool en = cycle >= this->start_cycle && (this->stop_cycle == 0 || cycle < this->stop_cycle);
+    if (this->mode == TRACE_MODE_GPIO) en = en && gpio;
+
+    if (en != this->active) {
+        this->active = en;
+        if (en) {
+            this->windows++;
+            TB_LOG(LOG_MEDIUM, "Waveform dump ON (cycle %lu)", cycle);
+        } else {
+            TB_LOG(LOG_MEDIUM, "Waveform dump OFF (cycle %lu)", cycle);
+        }
+    }
+    if (this->active) {
+        auto t0 = std::chrono::steady_clock::now();
+        this->fst->dump(time);
+        this->dump_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        this->dumps++;
+    }
+}
+
+void TbTracer::close()
+{
+    if (this->fst == NULL) return;
+    if (this->windows == 0) {
+        TB_WARN("Waveform dump was never activated");
+    }
+    this->fst->close();
+    delete this->fst;
+    this->fst = NULL;
+}
+
+void TbTracer::printConfig()
+{
+    TB_CONFIG("Waveform trigger: %s", this->mode == TRACE_MODE_GPIO ? "GPIO 0" : "always");
+    if (this->stop_cycle != 0) {
+        TB_CONFIG("Waveform window: cycles [%lu, %lu)", this->start_cycle, this->stop_cycle);
+    } else {
+        TB_CONFIG("Waveform window: cycles [%lu, end)", this->start_cycle);
+    }
+    if (this->depth > 0 || !this->scope.empty()) {
+        TB_CONFIG("Waveform filter: scope '%s', depth %d",
+                  this->scope.empty() ? "TOP" : this->scope.c_str(), this->depth);
+    }
+}
+
+vluint64_t TbTracer::getTracedCycles()
+{
+    // Two time steps (clock edges) per cycle
+    return this->dumps >> 1;
+}
+
+double TbTracer::getDumpTime()
+{
+    return this->dump_s;
+}
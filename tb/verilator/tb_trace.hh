@@ -0,0 +1,65 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_trace.hh
+// Description: Windowed and GPIO-triggered FST waveform tracing
+
+#if !defined(TB_TRACE_HH_)
+#define TB_TRACE_HH_
+
+#include <chrono>
+#include <string>
+#include <verilated.h>
+#include <verilated_fst_c.h>
+
+#include "Vtb_system.h"
+
+// Waveform dump modes (same encoding as the QuestaSim VCD_MODE)
+typedef enum {
+    TRACE_MODE_ON = 1,  // dump inside the [start, stop) cycle window
+    TRACE_MODE_GPIO = 2 // dump inside the cycle window while GPIO 0 is high (see vcd-ctl driver)
+} trace_mode_t;
+
+// Class definition
+class TbTracer
+{
+private:
+    VerilatedFstC *fst;
+    trace_mode_t mode;
+    vluint64_t start_cycle;
+    vluint64_t stop_cycle; // 0: never stop
+    int depth;             // 0: all levels
+    std::string scope;     // empty: whole design
+    bool active;
+    unsigned int windows;
+    vluint64_t dumps;      // number of dumped time steps
+    double dump_s;         // wall-clock time spent dumping
+
+public:
+    TbTracer();
+    ~TbTracer();
+
+    // Configuration (must be called before open())
+    void setMode(trace_mode_t mode);
+    void setWindow(vluint64_t start_cycle, vluint64_t stop_cycle);
+    void setFilter(int depth, const std::string& scope);
+
+    // Attach to the DUT and open the FST file
+    void open(Vtb_system *dut, const char *filename);
+
+    // Dump the current time step if tracing is active
+    void dump(vluint64_t time, vluint64_t cycle, bool gpio);
+
+    // Close the FST file
+    void close();
+
+    // Print the tracing configuration
+    void printConfig();
+
+    // Tracing statistics
+    vluint64_t getTracedCycles();
+    double getDumpTime();
+};
+
+#endif // TB_TRACE_HH_
@@ -0,0 +1,273 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_bus.cpp
+// Description: System bus of the virtual platform
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+
+#include "vp_bus.hh"
+#include "vp_log.hh"
+
+#ifndef EM_RISCV
+#define EM_RISCV 243
+#endif
+
+VpDevice::VpDevice(const char *name)
+{
+    this->name = name;
+    this->bus = NULL;
+}
+
+VpDevice::~VpDevice()
+{
+}
+
+void VpDevice::update(uint64_t /* t */)
+{
+}
+
+uint64_t VpDevice::nextEvent()
+{
+    return VP_NEVER;
+}
+
+VpBus::VpBus(uint32_t ram_base, uint32_t ram_size)
+{
+    this->ram.assign(ram_size, 0);
+    this->ram_base = ram_base;
+    this->in_sync = false;
+    this->event_time = 0;
+    this->now = 0;
+    this->next_event = VP_NEVER;
+    this->mip = 0;
+    this->dev_reads = 0;
+    this->dev_writes = 0;
+}
+
+VpBus::~VpBus()
+{
+}
+
+void VpBus::attach(VpDevice *dev, uint32_t base, uint32_t size)
+{
+    Mapping m = {base, size, dev};
+    this->map.push_back(m);
+    dev->bus = this;
+    for (size_t i = 0; i < this->devices.size(); i++) {
+        if (this->devices[i] == dev) return;
+    }
+    this->devices.push_back(dev);
+    this->reschedule();
+}
+
+VpDevice *VpBus::find(uint32_t addr, uint32_t *off)
+{
+    for (size_t i = 0; i < this->map.size(); i++) {
+        if (addr - this->map[i].base < this->map[i].size) {
+            *off = addr - this->map[i].base;
+            return this->map[i].dev;
+        }
+    }
+    return NULL;
+}
+
+uint64_t VpBus::time()
+{
+    return this->in_sync ? this->event_time : this->now;
+}
+
+void VpBus::reschedule()
+{
+    uint64_t t = VP_NEVER;
+    for (size_t i = 0; i < this->devices.size(); i++) {
+        uint64_t e = this->devices[i]->nextEvent();
+        if (e < t) t = e;
+    }
+    this->next_event = t;
+}
+
+void VpBus::sync()
+{
+    // Accesses issued by the devices themselves (e.g., DMA) are performed at
+    // the time of the event being processed
+    if (this->in_sync) return;
+    this->in_sync = true;
+    while (true) {
+        uint64_t t = VP_NEVER;
+        for (size_t i = 0; i < this->devices.size(); i++) {
+            uint64_t e = this->devices[i]->nextEvent();
+            if (e < t) t = e;
+        }
+        if (t > this->now) {
+            this->next_event = t;
+            break;
+        }
+        this->event_time = t;
+        for (size_t i = 0; i < this->devices.size(); i++) {
+            if (this->devices[i]->nextEvent() <= t) this->devices[i]->update(t);
+        }
+    }
+    this->in_sync = false;
+}
+
+bool VpBus::read(uint32_t addr, unsigned int size, uint32_t *data)
+{
+    if (addr - this->ram_base < this->ram.size() && size <= this->ram.size() - (addr - this->ram_base)) {
+        uint32_t val = 0;
+        memcpy(&val, &this->ram[addr - this->ram_base], size);
+        *data = val;
+        return true;
+    }
+
+    // Peripheral registers are accessed as aligned words
+    uint32_t off;
+    VpDevice *dev = this->find(addr, &off);
+    if (dev == NULL || (addr & (size - 1)) != 0) return false;
+    this->sync();
+    uint32_t val = dev->read(off & ~3u) >> ((addr & 3) * 8);
+    *data = size == 4 ? val : val & ((1u << (size * 8)) - 1);
+    this->dev_reads++;
+    if (!this->in_sync) this->reschedule();
+    return true;
+}
+
+bool VpBus::write(uint32_t addr, unsigned int size, uint32_t data)
+{
+    if (addr - this->ram_base < this->ram.size() && size <= this->ram.size() - (addr - this->ram_base)) {
+        memcpy(&this->ram[addr - this->ram_base], &data, size);
+        return true;
+    }
+
+    uint32_t off;
+    VpDevice *dev = this->find(addr, &off);
+    if (dev == NULL || (addr & (size - 1)) != 0) return false;
+    this->sync();
+    unsigned int shift = (addr & 3) * 8;
+    uint32_t mask = size == 4 ? 0xffffffff : ((1u << (size * 8)) - 1) << shift;
+    dev->write(off & ~3u, data << shift, mask);
+    this->dev_writes++;
+    if (!this->in_sync) this->reschedule();
+    return true;
+}
+
+bool VpBus::fetch(uint32_t addr, uint16_t *data)
+{
+    if (addr - this->ram_base >= this->ram.size() - 1) return false;
+    memcpy(data, &this->ram[addr - this->ram_base], 2);
+    return true;
+}
+
+void VpBus::setIrq(unsigned int bit, bool level)
+{
+    if (level) this->mip |= 1u << bit;
+    else this->mip &= ~(1u << bit);
+}
+
+bool VpBus::isRam(uint32_t addr, uint32_t size)
+{
+    return addr - this->ram_base < this->ram.size() && size <= this->ram.size() - (addr - this->ram_base);
+}
+
+uint8_t *VpBus::ramPtr(uint32_t addr)
+{
+    return &this->ram[addr - this->ram_base];
+}
+
+uint32_t VpBus::ramSize()
+{
+    return this->ram.size();
+}
+
+bool VpBus::loadElf(const std::string& filename, uint32_t *entry)
+{
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if (fp == NULL) {
+        VP_ERR("Cannot open ELF file '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+
+    // Check the ELF header
+    Elf32_Ehdr ehdr;
+    if (fread(&ehdr, sizeof(ehdr), 1, fp) != 1 || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr.e_ident[EI_CLASS] != ELFCLASS32 || ehdr.e_ident[EI_DATA] != ELFDATA2LSB ||
+        ehdr.e_machine != EM_RISCV) {
+        VP_ERR("'%s' is not a 32-bit little-endian RISC-V ELF file", filename.c_str());
+        fclose(fp);
+        return false;
+    }
+    *entry = ehdr.e_entry;
+
+    // Copy the loadable segments, zero-filling .bss
+    for (unsigned int i = 0; i < ehdr.e_phnum; i++) {
+        Elf32_Phdr phdr;
+        if (fseek(fp, ehdr.e_phoff + i * ehdr.e_phentsize, SEEK_SET) != 0 ||
+            fread(&phdr, sizeof(phdr), 1, fp) != 1) {
+            VP_ERR("%s: cannot read program header %u", filename.c_str(), i);
+            fclose(fp);
+            return false;
+        }
+        if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0) continue;
+        if (!this->isRam(phdr.p_paddr, phdr.p_memsz)) {
+            VP_ERR("%s: segment [0x%08x, 0x%08x) is outside the SRAM", filename.c_str(), phdr.p_paddr,
+                   phdr.p_paddr + phdr.p_memsz);
+            fclose(fp);
+            return false;
+        }
+        uint8_t *dst = this->ramPtr(phdr.p_paddr);
+        memset(dst, 0, phdr.p_memsz);
+        if (phdr.p_filesz > 0 && (fseek(fp, phdr.p_offset, SEEK_SET) != 0 ||
+                                  fread(dst, 1, phdr.p_filesz, fp) != phdr.p_filesz)) {
+            VP_ERR("%s: cannot read segment %u", filename.c_str(), i);
+            fclose(fp);
+            return false;
+        }
+        VP_LOG(LOG_MEDIUM, "- Loaded segment [0x%08x, 0x%08x)", phdr.p_paddr, phdr.p_paddr + phdr.p_memsz);
+    }
+    fclose(fp);
+    return true;
+}
+
+bool VpBus::loadHex(const std::string& filename)
+{
+    // Verilog hex file ($readmemh on a byte array): '@<addr>' sets the byte
+    // address, the other tokens are consecutive bytes
+    FILE *fp = fopen(filename.c_str(), "r");
+    if (fp == NULL) {
+        VP_ERR("Cannot open HEX file '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    char tok[64];
+    uint32_t addr = 0;
+    while (fscanf(fp, "%63s", tok) == 1) {
+        if (tok[0] == '/' && tok[1] == '/') {
+            int c;
+            while ((c = fgetc(fp)) != EOF && c != '\n');
+            continue;
+        }
+        char *end;
+        if (tok[0] == '@') {
+            addr = strtoul(tok + 1, &end, 16);
+        } else {
+            unsigned long val = strtoul(tok, &end, 16);
+            if (!this->isRam(addr, 1)) {
+                VP_ERR("%s: address 0x%08x is outside the SRAM", filename.c_str(), addr);
+                fclose(fp);
+                return false;
+            }
+            *this->ramPtr(addr++) = val;
+        }
+        if (*end != '\0') {
+            VP_ERR("%s: invalid token '%s'", filename.c_str(), tok);
+            fclose(fp);
+            return false;
+        }
+    }
+    fclose(fp);
+    return true;
+}
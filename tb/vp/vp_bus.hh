@@ -0,0 +1,111 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_bus.hh
+// Description: System bus of the virtual platform. The SRAM is accessed
+//              directly; the peripherals are transaction-level models that
+//              are brought up to date (sync) before each access. Peripherals
+//              with internal activity (timers, filters, DMA...) advertise
+//              their next event and are updated in time order.
+
+#if !defined(VP_BUS_HH_)
+#define VP_BUS_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// No pending event
+#define VP_NEVER UINT64_MAX
+
+class VpBus;
+
+// Memory-mapped device
+class VpDevice
+{
+public:
+    const char *name;
+    VpBus *bus;
+
+    VpDevice(const char *name);
+    virtual ~VpDevice();
+
+    // Register access (off is word-aligned, mask selects the written bits)
+    virtual uint32_t read(uint32_t off) = 0;
+    virtual void write(uint32_t off, uint32_t data, uint32_t mask) = 0;
+
+    // Process the events due at cycle t
+    virtual void update(uint64_t t);
+
+    // Cycle of the next event (VP_NEVER if none)
+    virtual uint64_t nextEvent();
+};
+
+// Class definition
+class VpBus
+{
+private:
+    struct Mapping {
+        uint32_t base;
+        uint32_t size;
+        VpDevice *dev;
+    };
+
+    std::vector<uint8_t> ram;
+    uint32_t ram_base;
+    std::vector<Mapping> map;
+    std::vector<VpDevice *> devices;
+
+    bool in_sync;
+    uint64_t event_time;
+
+    VpDevice *find(uint32_t addr, uint32_t *off);
+    void reschedule();
+
+public:
+    // Current CPU cycle and earliest pending device event
+    uint64_t now;
+    uint64_t next_event;
+
+    // Interrupt lines, in the mip CSR layout (fast interrupts in [31:16])
+    uint32_t mip;
+
+    // Bus statistics
+    uint64_t dev_reads;
+    uint64_t dev_writes;
+
+    VpBus(uint32_t ram_base, uint32_t ram_size);
+    ~VpBus();
+
+    // Map a device (the bus does not take ownership)
+    void attach(VpDevice *dev, uint32_t base, uint32_t size);
+
+    // Current time, as seen by the device being accessed or updated
+    uint64_t time();
+
+    // Process all the device events up to the current cycle
+    void sync();
+
+    // Data accesses (size 1, 2 or 4); return false on bus errors
+    bool read(uint32_t addr, unsigned int size, uint32_t *data);
+    bool write(uint32_t addr, unsigned int size, uint32_t data);
+
+    // Instruction fetch (16 bits, SRAM only)
+    bool fetch(uint32_t addr, uint16_t *data);
+
+    // Set or clear an interrupt line (mip bit)
+    void setIrq(unsigned int bit, bool level);
+
+    // SRAM backdoor
+    bool isRam(uint32_t addr, uint32_t size);
+    uint8_t *ramPtr(uint32_t addr);
+    uint32_t ramSize();
+
+    // Load the firmware (ELF or verilog hex file). The entry point of ELF
+    // files is returned in entry (0 otherwise).
+    bool loadElf(const std::string& filename, uint32_t *entry);
+    bool loadHex(const std::string& filename);
+};
+
+#endif // VP_BUS_HH_
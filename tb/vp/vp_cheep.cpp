@@ -0,0 +1,1425 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_cheep.cpp
+// Description: Transaction-level models of the HEEPidermis peripherals
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "vp_cheep.hh"
+#include "vp_log.hh"
+
+#include "iDAC_ctrl_regs.h"
+#include "VCO_decoder_regs.h"
+#include "SES_filter_regs.h"
+#include "pdm2pcm_regs.h"
+#include "dlc.h"
+#include "IRQ_ctrl.h"
+#include "core_v_mini_mcu.h"
+
+// Cycles after a register write at which the iDACs are refreshed
+// (IdacTrigger2drDelayCc)
+#define VP_IDAC_REFRESH_DELAY 3
+
+// Analog subsystem parameters (analog_subsystem.sv, iDAC.sv, VCO.sv)
+#define VP_IDAC_IIN_NA 400
+#define VP_ANALOG_SUPPLY_UV 800000.0
+#define VP_ANALOG_RESISTANCE_KO 30.0
+#define VP_VCO_FREQ_GAIN 100
+#define VP_VCO_COARSE_MASK 0x3ffffff
+#define VP_VCO_FINE_MASK 0x7fffffff
+
+// Cycles taken by the system clock domain to see a filter FIFO write
+#define VP_CDC_FIFO_DST_SYNC 2
+
+// Simulation time of a clock cycle, in ns
+#define VP_CYCLE_NS 2
+
+// ------------------------------------------------------------------------
+// ΔΣ input
+// ------------------------------------------------------------------------
+
+VpDsmInput::VpDsmInput()
+{
+    this->src = NULL;
+    this->idx = 0;
+    this->data = 0;
+    this->dummy = NULL;
+    this->lines = 0;
+    this->stopped = false;
+}
+
+VpDsmInput::~VpDsmInput()
+{
+    if (this->dummy != NULL) fclose(this->dummy);
+}
+
+bool VpDsmInput::open(TbDsmSource *src, const std::string& dummy_file)
+{
+    if (src != NULL && src->isActive()) {
+        this->src = src;
+        return true;
+    }
+
+    // pdm2pcm_dummy: the first line is loaded after reset. A missing file
+    // is not fatal (the input is then always 0).
+    this->dummy = fopen(dummy_file.c_str(), "r");
+    if (this->dummy == NULL) {
+        VP_LOG(LOG_MEDIUM, "No ΔΣ source: cannot open PDM file '%s' (the input is 0)", dummy_file.c_str());
+    }
+    this->data = this->readDummy();
+    return true;
+}
+
+uint8_t VpDsmInput::readDummy()
+{
+    // Only the first character of each line is checked
+    if (this->dummy == NULL) return 0;
+    char line[64];
+    if (fgets(line, sizeof(line), this->dummy) == NULL) return 0;
+    uint8_t bit = line[0] == '1';
+    while (strchr(line, '\n') == NULL && fgets(line, sizeof(line), this->dummy) != NULL);
+    return bit;
+}
+
+uint8_t VpDsmInput::edge()
+{
+    uint8_t bit = this->data;
+    if (this->src != NULL) {
+        this->data = this->src->getBit(this->idx++);
+    } else if (!this->stopped) {
+        this->data = this->readDummy();
+        if (++this->lines >= VP_PDM_DUMMY_MAX_LINES) {
+            VP_ERR("End of the PDM file reached after %lu lines", this->lines);
+            this->stopped = true;
+        }
+    }
+    return bit;
+}
+
+bool VpDsmInput::isStopped()
+{
+    return this->stopped;
+}
+
+// ------------------------------------------------------------------------
+// Clock domain crossing FIFO
+// ------------------------------------------------------------------------
+
+VpCdcFifo::VpCdcFifo()
+{
+    memset(this->mem, 0, sizeof(this->mem));
+    memset(this->push_at, 0, sizeof(this->push_at));
+    memset(this->pop_at, 0, sizeof(this->pop_at));
+    this->wptr = 0;
+    this->rptr = 0;
+}
+
+bool VpCdcFifo::ready(uint64_t t, uint64_t sync_cycles)
+{
+    // The most recent reads are not seen yet by the source side
+    uint64_t rptr_seen = this->rptr;
+    for (uint64_t k = 1; k <= VP_CDC_FIFO_DEPTH && k <= this->rptr; k++) {
+        if (this->pop_at[(this->rptr - k) % VP_CDC_FIFO_DEPTH] + sync_cycles > t) rptr_seen--;
+    }
+    return this->wptr - rptr_seen < VP_CDC_FIFO_DEPTH;
+}
+
+void VpCdcFifo::push(uint32_t data, uint64_t t)
+{
+    this->mem[this->wptr % VP_CDC_FIFO_DEPTH] = data;
+    this->push_at[this->wptr % VP_CDC_FIFO_DEPTH] = t;
+    this->wptr++;
+}
+
+bool VpCdcFifo::valid(uint64_t t)
+{
+    return this->rptr != this->wptr && this->push_at[this->rptr % VP_CDC_FIFO_DEPTH] + VP_CDC_FIFO_DST_SYNC <= t;
+}
+
+uint32_t VpCdcFifo::pop(uint64_t t)
+{
+    uint32_t data = this->mem[this->rptr % VP_CDC_FIFO_DEPTH];
+    if (this->valid(t)) {
+        this->pop_at[this->rptr % VP_CDC_FIFO_DEPTH] = t;
+        this->rptr++;
+    }
+    return data;
+}
+
+uint64_t VpCdcFifo::nextValid(uint64_t t)
+{
+    if (this->rptr == this->wptr) return VP_NEVER;
+    uint64_t at = this->push_at[this->rptr % VP_CDC_FIFO_DEPTH] + VP_CDC_FIFO_DST_SYNC;
+    return at > t ? at : t + 1;
+}
+
+// ------------------------------------------------------------------------
+// SES filter output FIFO
+// ------------------------------------------------------------------------
+
+VpWatermarkFifo::VpWatermarkFifo(uint32_t depth, uint64_t delay, uint32_t overflow_max)
+{
+    this->last = 0;
+    this->burst = false;
+    this->depth = depth;
+    this->delay = delay;
+    this->overflow_max = overflow_max;
+    this->watermark = 0;
+    this->overflow = 0;
+}
+
+uint32_t VpWatermarkFifo::threshold()
+{
+    if (this->watermark == 0) return 1;
+    return this->watermark > this->depth ? this->depth : this->watermark;
+}
+
+void VpWatermarkFifo::settle(uint64_t t)
+{
+    while (!this->pending.empty() && this->pending.front().at <= t) {
+        if (this->mem.size() < this->depth) {
+            this->mem.push_back(this->pending.front().data);
+        } else if (this->overflow < this->overflow_max) {
+            this->overflow++;
+        }
+        this->pending.pop_front();
+        if (this->mem.size() >= this->threshold()) this->burst = true;
+    }
+}
+
+void VpWatermarkFifo::push(uint64_t data, uint64_t t)
+{
+    this->pending.push_back({data, t + this->delay});
+}
+
+void VpWatermarkFifo::flush()
+{
+    this->pending.clear();
+    this->mem.clear();
+    this->burst = false;
+}
+
+uint32_t VpWatermarkFifo::level(uint64_t t)
+{
+    this->settle(t);
+    return this->mem.size();
+}
+
+bool VpWatermarkFifo::trigger(uint64_t t)
+{
+    this->settle(t);
+    return !this->mem.empty() && (this->burst || this->mem.size() >= this->threshold());
+}
+
+uint64_t VpWatermarkFifo::pop(uint64_t t)
+{
+    this->settle(t);
+    if (!this->mem.empty()) {
+        this->last = this->mem.front();
+        this->mem.pop_front();
+        if (this->mem.empty()) this->burst = false;
+        return this->last;
+    }
+    return this->last;
+}
+
+uint64_t VpWatermarkFifo::peek(uint64_t t)
+{
+    this->settle(t);
+    return this->mem.empty() ? this->last : this->mem.front();
+}
+
+uint64_t VpWatermarkFifo::nextTrigger(uint64_t t)
+{
+    if (this->trigger(t)) return t + 1;
+    // Arrival of the output that brings the level to the watermark
+    size_t need = this->threshold() - this->mem.size();
+    if (need > this->pending.size()) return VP_NEVER;
+    uint64_t at = this->pending[need - 1].at;
+    return at > t ? at : t + 1;
+}
+
+// ------------------------------------------------------------------------
+// iDAC controller
+// ------------------------------------------------------------------------
+
+VpIdacCtrl::VpIdacCtrl(VpDma *dma) : VpDevice("idac_ctrl")
+{
+    this->refresh_cycles = 0;
+    this->manual_trigger = 0;
+    this->enable = 0;
+    this->calibration[0] = 0;
+    this->calibration[1] = 0;
+    this->current = 0;
+    this->in_r[0] = 0;
+    this->in_r[1] = 0;
+    this->refresh_at = VP_NEVER;
+    this->dds_control = 0;
+    this->dds_amplitude = 0;
+    this->dds_offset = 0;
+    for (unsigned int i = 0; i < 2; i++) {
+        this->dds_frequency[i] = 0;
+        this->dds_phase[i] = 0;
+        this->dds_chirp[i] = 0;
+        this->phase[i] = 0;
+        this->chirp[i] = 0;
+        this->dds_current[i] = 0;
+    }
+    memset(this->wave_ram, 0, sizeof(this->wave_ram));
+    this->fb_control = 0;
+    this->fb_step = 1;
+    this->fb_limits = 0xff << IDAC_CTRL_FEEDBACK_LIMITS_MAX_OFFSET;
+    this->fb_slew = 0;
+    this->fb_code[0] = 0;
+    this->fb_code[1] = 0;
+    this->fb_pending = 0;
+    this->fb_step_at = VP_NEVER;
+    this->fb_ready_at = 0;
+    this->dma = dma;
+    this->irq = NULL;
+}
+
+void VpIdacCtrl::stepDds()
+{
+    // Output the sample at the current phase and advance the phase
+    for (unsigned int i = 0; i < 2; i++) {
+        if (!((this->dds_control >> (IDAC_CTRL_DDS_CONTROL_ENABLE_1_BIT + i)) & 1)) continue;
+        uint32_t phase = this->phase[i] + this->dds_phase[i];
+        int32_t wave;
+        if ((this->dds_control >> (IDAC_CTRL_DDS_CONTROL_SQUARE_1_BIT + i)) & 1) wave = phase >> 31 ? -128 : 127;
+        else wave = (int8_t)this->wave_ram[(uint64_t)phase * VP_IDAC_WAVE_RAM_DEPTH >> 32];
+        int32_t amplitude = (this->dds_amplitude >> (8 * i)) & 0xff;
+        int32_t level = (int32_t)((this->dds_offset >> (8 * i)) & 0xff) + ((wave * amplitude) >> 8);
+        this->dds_current[i] = level < 0 ? 0 : level > 255 ? 255 : level;
+        this->phase[i] += this->dds_frequency[i] + this->chirp[i];
+        this->chirp[i] += this->dds_chirp[i];
+    }
+}
+
+uint8_t VpIdacCtrl::feedbackSeed(unsigned int i)
+{
+    // CURRENT field of the channel
+    return (this->current >> (i * IDAC_CTRL_CURRENT_CURRENT_2_OFFSET)) & IDAC_CTRL_CURRENT_CURRENT_1_MASK;
+}
+
+uint8_t VpIdacCtrl::feedbackCode(unsigned int i)
+{
+    // The code of a disabled loop follows the CURRENT field
+    if ((this->fb_control >> (IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT + i)) & 1) return this->fb_code[i];
+    return this->feedbackSeed(i);
+}
+
+void VpIdacCtrl::stepFeedback(uint64_t t)
+{
+    // One step towards the pending crossings, clamped to the limits
+    int32_t min = this->fb_limits & IDAC_CTRL_FEEDBACK_LIMITS_MIN_MASK;
+    int32_t max = (this->fb_limits >> IDAC_CTRL_FEEDBACK_LIMITS_MAX_OFFSET) & IDAC_CTRL_FEEDBACK_LIMITS_MAX_MASK;
+    for (unsigned int i = 0; i < 2; i++) {
+        if (!((this->fb_control >> (IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT + i)) & 1)) continue;
+        int32_t code = this->fb_code[i];
+        if (this->fb_pending > 0) {
+            code += this->fb_step;
+            this->fb_code[i] = code > max ? max : code;
+        } else {
+            code -= this->fb_step;
+            this->fb_code[i] = code < min ? min : code;
+        }
+    }
+    this->fb_pending += this->fb_pending > 0 ? -1 : 1;
+    this->fb_ready_at = t + this->fb_slew + 1;
+    this->fb_step_at = this->fb_pending != 0 ? this->fb_ready_at : VP_NEVER;
+    VP_LOG(LOG_FULL, "iDAC feedback step: %u, %u", this->feedbackCode(0), this->feedbackCode(1));
+}
+
+void VpIdacCtrl::crossing(bool dir, uint64_t t)
+{
+    if (!(this->fb_control & 3)) return;
+
+    // An upward crossing steps the code up, unless the polarity is inverted
+    bool up = dir == ((this->fb_control >> IDAC_CTRL_FEEDBACK_CONTROL_INVERT_BIT) & 1);
+    this->fb_pending += up ? 1 : -1;
+    if (this->fb_pending > 127) this->fb_pending = 127;
+    if (this->fb_pending < -127) this->fb_pending = -127;
+
+    // The pending count is registered: the first step is one cycle later
+    if (this->fb_pending == 0) this->fb_step_at = VP_NEVER;
+    else if (this->fb_step_at == VP_NEVER) this->fb_step_at = t + 1 > this->fb_ready_at ? t + 1 : this->fb_ready_at;
+}
+
+void VpIdacCtrl::setIrqCtrl(VpIrqCtrl *irq)
+{
+    this->irq = irq;
+}
+
+uint32_t VpIdacCtrl::read(uint32_t off)
+{
+    switch (off) {
+    case IDAC_CTRL_REFRESH_CYCLES_REG_OFFSET:
+        return this->refresh_cycles;
+    case IDAC_CTRL_MANUAL_TRIGGER_REG_OFFSET:
+        return this->manual_trigger;
+    case IDAC_CTRL_ENABLE_REG_OFFSET:
+        return this->enable;
+    case IDAC_CTRL_CALIBRATION_1_REG_OFFSET:
+        return this->calibration[0];
+    case IDAC_CTRL_CALIBRATION_2_REG_OFFSET:
+        return this->calibration[1];
+    case IDAC_CTRL_CURRENT_REG_OFFSET:
+        return this->current;
+    case IDAC_CTRL_DDS_CONTROL_REG_OFFSET:
+        return this->dds_control;
+    case IDAC_CTRL_DDS_FREQUENCY_1_REG_OFFSET:
+        return this->dds_frequency[0];
+    case IDAC_CTRL_DDS_FREQUENCY_2_REG_OFFSET:
+        return this->dds_frequency[1];
+    case IDAC_CTRL_DDS_PHASE_1_REG_OFFSET:
+        return this->dds_phase[0];
+    case IDAC_CTRL_DDS_PHASE_2_REG_OFFSET:
+        return this->dds_phase[1];
+    case IDAC_CTRL_DDS_CHIRP_1_REG_OFFSET:
+        return this->dds_chirp[0];
+    case IDAC_CTRL_DDS_CHIRP_2_REG_OFFSET:
+        return this->dds_chirp[1];
+    case IDAC_CTRL_DDS_AMPLITUDE_REG_OFFSET:
+        return this->dds_amplitude;
+    case IDAC_CTRL_DDS_OFFSET_REG_OFFSET:
+        return this->dds_offset;
+    case IDAC_CTRL_FEEDBACK_CONTROL_REG_OFFSET:
+        return this->fb_control;
+    case IDAC_CTRL_FEEDBACK_STEP_REG_OFFSET:
+        return this->fb_step;
+    case IDAC_CTRL_FEEDBACK_LIMITS_REG_OFFSET:
+        return this->fb_limits;
+    case IDAC_CTRL_FEEDBACK_SLEW_REG_OFFSET:
+        return this->fb_slew;
+    case IDAC_CTRL_FEEDBACK_CODE_REG_OFFSET:
+        return this->feedbackCode(0) | ((uint32_t)this->feedbackCode(1) << IDAC_CTRL_FEEDBACK_CODE_CODE_2_OFFSET);
+    case IDAC_CTRL_DDS_CURRENT_REG_OFFSET:
+        return this->dds_current[0] | ((uint32_t)this->dds_current[1] << IDAC_CTRL_DDS_CURRENT_CURRENT_2_OFFSET);
+    default:
+        if (off >= IDAC_CTRL_WAVE_RAM_REG_OFFSET && off < IDAC_CTRL_WAVE_RAM_REG_OFFSET + IDAC_CTRL_WAVE_RAM_SIZE_BYTES) {
+            return this->wave_ram[(off - IDAC_CTRL_WAVE_RAM_REG_OFFSET) / 4];
+        }
+        return 0;
+    }
+}
+
+void VpIdacCtrl::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint64_t t = this->bus->time();
+
+    // Any write refreshes the iDACs if they are enabled
+    if (this->enable & 3) this->refresh_at = t + VP_IDAC_REFRESH_DELAY;
+
+    switch (off) {
+    case IDAC_CTRL_REFRESH_CYCLES_REG_OFFSET:
+        this->refresh_cycles = vpMerge(this->refresh_cycles, data, mask);
+        this->trigger.setLimit(this->refresh_cycles, t);
+        break;
+    case IDAC_CTRL_MANUAL_TRIGGER_REG_OFFSET: {
+        uint32_t val = vpMerge(this->manual_trigger, data, mask) & 1;
+        if (val && !this->manual_trigger) this->trigger.setManual(t);
+        this->manual_trigger = val;
+        break;
+    }
+    case IDAC_CTRL_ENABLE_REG_OFFSET:
+        this->enable = vpMerge(this->enable, data, mask) & 3;
+        if (!(this->enable & 3)) this->refresh_at = VP_NEVER;
+
+        // A disabled iDAC clears its input register
+        if (!(this->enable & 1)) this->in_r[0] = 0;
+        if (!(this->enable & 2)) this->in_r[1] = 0;
+        break;
+    case IDAC_CTRL_CALIBRATION_1_REG_OFFSET:
+        this->calibration[0] = vpMerge(this->calibration[0], data, mask) & IDAC_CTRL_CALIBRATION_1_CALIBRATION_1_MASK;
+        break;
+    case IDAC_CTRL_CALIBRATION_2_REG_OFFSET:
+        this->calibration[1] = vpMerge(this->calibration[1], data, mask) & IDAC_CTRL_CALIBRATION_2_CALIBRATION_2_MASK;
+        break;
+    case IDAC_CTRL_CURRENT_REG_OFFSET:
+        this->current = vpMerge(this->current, data, mask) & 0xffff;
+        break;
+    case IDAC_CTRL_DDS_CONTROL_REG_OFFSET:
+        this->dds_control = vpMerge(this->dds_control, data, mask) & 0xf;
+        // A disabled channel resets its phase, chirp and current code
+        for (unsigned int i = 0; i < 2; i++) {
+            if (!((this->dds_control >> (IDAC_CTRL_DDS_CONTROL_ENABLE_1_BIT + i)) & 1)) {
+                this->phase[i] = 0;
+                this->chirp[i] = 0;
+                this->dds_current[i] = 0;
+            }
+        }
+        break;
+    case IDAC_CTRL_DDS_FREQUENCY_1_REG_OFFSET:
+        this->dds_frequency[0] = vpMerge(this->dds_frequency[0], data, mask);
+        break;
+    case IDAC_CTRL_DDS_FREQUENCY_2_REG_OFFSET:
+        this->dds_frequency[1] = vpMerge(this->dds_frequency[1], data, mask);
+        break;
+    case IDAC_CTRL_DDS_PHASE_1_REG_OFFSET:
+        this->dds_phase[0] = vpMerge(this->dds_phase[0], data, mask);
+        break;
+    case IDAC_CTRL_DDS_PHASE_2_REG_OFFSET:
+        this->dds_phase[1] = vpMerge(this->dds_phase[1], data, mask);
+        break;
+    case IDAC_CTRL_DDS_CHIRP_1_REG_OFFSET:
+        this->dds_chirp[0] = vpMerge(this->dds_chirp[0], data, mask);
+        break;
+    case IDAC_CTRL_DDS_CHIRP_2_REG_OFFSET:
+        this->dds_chirp[1] = vpMerge(this->dds_chirp[1], data, mask);
+        break;
+    case IDAC_CTRL_DDS_AMPLITUDE_REG_OFFSET:
+        this->dds_amplitude = vpMerge(this->dds_amplitude, data, mask) & 0xffff;
+        break;
+    case IDAC_CTRL_DDS_OFFSET_REG_OFFSET:
+        this->dds_offset = vpMerge(this->dds_offset, data, mask) & 0xffff;
+        break;
+    case IDAC_CTRL_FEEDBACK_CONTROL_REG_OFFSET: {
+        uint32_t val = vpMerge(this->fb_control, data, mask) & 0x7;
+
+        // Each loop starts from the CURRENT field of its channel
+        for (unsigned int i = 0; i < 2; i++) {
+            if (!((this->fb_control >> (IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT + i)) & 1)) this->fb_code[i] = this->feedbackSeed(i);
+        }
+        this->fb_control = val;
+
+        // The crossings are reset when both loops are disabled
+        if (!(val & 3)) {
+            this->fb_pending = 0;
+            this->fb_step_at = VP_NEVER;
+            this->fb_ready_at = 0;
+        }
+        break;
+    }
+    case IDAC_CTRL_FEEDBACK_STEP_REG_OFFSET:
+        this->fb_step = vpMerge(this->fb_step, data, mask) & IDAC_CTRL_FEEDBACK_STEP_FEEDBACK_STEP_MASK;
+        break;
+    case IDAC_CTRL_FEEDBACK_LIMITS_REG_OFFSET:
+        this->fb_limits = vpMerge(this->fb_limits, data, mask) & 0xffff;
+        break;
+    case IDAC_CTRL_FEEDBACK_SLEW_REG_OFFSET:
+        this->fb_slew = vpMerge(this->fb_slew, data, mask) & IDAC_CTRL_FEEDBACK_SLEW_FEEDBACK_SLEW_MASK;
+        break;
+    default:
+        if (off >= IDAC_CTRL_WAVE_RAM_REG_OFFSET && off < IDAC_CTRL_WAVE_RAM_REG_OFFSET + IDAC_CTRL_WAVE_RAM_SIZE_BYTES &&
+            (mask & IDAC_CTRL_WAVE_RAM_MASK)) {
+            unsigned int i = (off - IDAC_CTRL_WAVE_RAM_REG_OFFSET) / 4;
+            this->wave_ram[i] = vpMerge(this->wave_ram[i], data, mask) & IDAC_CTRL_WAVE_RAM_MASK;
+        }
+        break;
+    }
+}
+
+void VpIdacCtrl::update(uint64_t t)
+{
+    if (this->refresh_at <= t) {
+        this->refresh_at = VP_NEVER;
+        uint8_t code[2] = {
+            (uint8_t)(this->current & IDAC_CTRL_CURRENT_CURRENT_1_MASK),
+            (uint8_t)((this->current >> IDAC_CTRL_CURRENT_CURRENT_2_OFFSET) & IDAC_CTRL_CURRENT_CURRENT_2_MASK)};
+        for (unsigned int i = 0; i < 2; i++) {
+            if ((this->fb_control >> (IDAC_CTRL_FEEDBACK_CONTROL_ENABLE_1_BIT + i)) & 1) code[i] = this->fb_code[i];
+            else if ((this->dds_control >> (IDAC_CTRL_DDS_CONTROL_ENABLE_1_BIT + i)) & 1) code[i] = this->dds_current[i];
+            if ((this->enable >> i) & 1) this->in_r[i] = code[i];
+        }
+        VP_LOG(LOG_FULL, "iDAC refresh: %u, %u", this->in_r[0], this->in_r[1]);
+    }
+    if (this->trigger.next(t) <= t) {
+        this->trigger.fire(t);
+        if (this->dds_control & 3) {
+            this->stepDds();
+            if (this->enable & 3) this->refresh_at = t + VP_IDAC_REFRESH_DELAY;
+        }
+        this->dma->triggerTx(1);
+        if (this->irq != NULL) this->irq->pulse(IRQ_CTRL_SRC_IDAC_REFRESH);
+    }
+    if (this->fb_step_at <= t) {
+        this->stepFeedback(t);
+        if (this->enable & 3) this->refresh_at = t + VP_IDAC_REFRESH_DELAY;
+        this->dma->triggerRx(1);
+    }
+}
+
+uint64_t VpIdacCtrl::nextEvent()
+{
+    uint64_t next = this->trigger.next(this->bus->time());
+    if (this->fb_step_at < next) next = this->fb_step_at;
+    return this->refresh_at < next ? this->refresh_at : next;
+}
+
+int32_t VpIdacCtrl::getCurrent(unsigned int i)
+{
+    if (!((this->enable >> i) & 1)) return 0;
+    return (8 * VP_IDAC_IIN_NA * (int32_t)this->in_r[i]) / (95 - (int32_t)this->calibration[i]);
+}
+
+int32_t VpIdacCtrl::getVin(unsigned int i)
+{
+    // The VCOp resistance is slightly lower (resistance_kO / 1.01)
+    double r = i == 0 ? VP_ANALOG_RESISTANCE_KO / 1.01 : VP_ANALOG_RESISTANCE_KO;
+    return (int32_t)(VP_ANALOG_SUPPLY_UV - this->getCurrent(i) * r);
+}
+
+// ------------------------------------------------------------------------
+// VCO
+// ------------------------------------------------------------------------
+
+VpVco::VpVco()
+{
+    this->last_ref_ns = 0;
+    this->T_ns = 1;
+    this->T_prev_ns = 1;
+    this->T_last_ns = 1;
+    this->counter = 0;
+    this->coarse = 0;
+    this->phase = 0;
+}
+
+void VpVco::refresh(bool en, uint32_t vin_uV, uint64_t now_ns)
+{
+    if (!en) {
+        this->coarse = 0;
+        this->phase = 0;
+        this->counter = 0;
+        this->last_ref_ns = now_ns;
+        this->T_last_ns = this->T_prev_ns == 0 ? 1 : this->T_prev_ns;
+        return;
+    }
+
+    // Period from the input voltage (linear model, 100 kHz floor)
+    int32_t f_osc_Hz = vin_uV < 550000 ? 100000 : (int32_t)(2 * vin_uV - 1000000);
+    if (f_osc_Hz < 1) f_osc_Hz = 1;
+    this->T_ns = (1000000000 / f_osc_Hz) / VP_VCO_FREQ_GAIN;
+    if (this->T_ns < 1) this->T_ns = 1;
+
+    // Oscillator cycles and phase since the last refresh
+    uint64_t dt_ns = now_ns - this->last_ref_ns;
+    int32_t cycles = dt_ns / this->T_ns;
+    int32_t rem_ns = dt_ns % this->T_ns;
+    this->last_ref_ns = now_ns;
+    this->counter = (this->counter + cycles) & VP_VCO_COARSE_MASK;
+    this->coarse = this->counter;
+
+    // The phase is relative to the period before the previous refresh
+    int32_t base_T = this->T_last_ns != 0 ? this->T_last_ns : this->T_ns;
+    this->T_last_ns = this->T_prev_ns == 0 ? this->T_ns : this->T_prev_ns;
+    this->T_prev_ns = this->T_ns;
+    int32_t fi = (61 * rem_ns) / base_T;
+    if (fi < 0) fi = 0;
+    else if (fi > 61) fi = 61;
+    this->phase = fi;
+}
+
+// ------------------------------------------------------------------------
+// VCO decoder
+// ------------------------------------------------------------------------
+
+VpVcoDecoder::VpVcoDecoder(VpIdacCtrl *idac, VpDma *dma) :
+    VpDevice("vco_decoder"),
+    fifo(VP_VCO_FIFO_DEPTH, 1, VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_MASK)
+{
+    this->refresh_cycles = 0;
+    this->counter_limit = 0;
+    this->manual_trigger = 0;
+    this->enable = 0;
+    this->fine[0] = this->fine[1] = 0;
+    this->coarse[0] = this->coarse[1] = 0;
+    this->cnt = 0;
+    this->manual_train = 0;
+    for (unsigned int i = 0; i < 3; i++) this->stage_at[i] = VP_NEVER;
+    this->double_tap_gap = 0;
+    this->tap_at = VP_NEVER;
+    this->oversampling = 0;
+    this->acc[0] = this->acc[1] = 0;
+    this->acc_count = 0;
+    this->packing = 0;
+    this->fifo_control = 0;
+    this->timestamp_at = 0;
+    this->fifo_word = false;
+    memset(this->comp, 0, sizeof(this->comp));
+    memset(this->phase_lut, 0, sizeof(this->phase_lut));
+    this->idac = idac;
+    this->dma = dma;
+}
+
+bool VpVcoDecoder::loadPhaseLut(const std::string& filename)
+{
+    FILE *fp = fopen(filename.c_str(), "r");
+    if (fp == NULL) {
+        VP_ERR("Cannot open VCO phase table '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    char tok[64];
+    unsigned int n = 0;
+    while (n < 62 && fscanf(fp, "%63s", tok) == 1) {
+        this->phase_lut[n++] = strtoul(tok, NULL, 16);
+    }
+    fclose(fp);
+    if (n != 62) {
+        VP_ERR("%s: expected 62 entries, found %u", filename.c_str(), n);
+        return false;
+    }
+    return true;
+}
+
+uint32_t VpVcoDecoder::getCount(unsigned int i)
+{
+    Computation *c = &this->comp[i];
+    uint32_t coarse_diff = (c->coarse - c->coarse_prev) & VP_VCO_COARSE_MASK;
+    return 62 * coarse_diff + (c->fine - c->fine_prev);
+}
+
+uint32_t VpVcoDecoder::getTimestamp(uint64_t t)
+{
+    return this->fifoEnabled() && t > this->timestamp_at ? (uint32_t)(t - this->timestamp_at) : 0;
+}
+
+bool VpVcoDecoder::fifoEnabled()
+{
+    return (this->fifo_control >> VCO_DECODER_FIFO_CONTROL_ENABLE_BIT) & 1;
+}
+
+void VpVcoDecoder::stage(unsigned int i, uint64_t t)
+{
+    switch (i) {
+    case 0:
+        // Refresh the VCOs
+        this->vco_p.refresh(this->enable & 1, this->idac->getVin(0), t * VP_CYCLE_NS);
+        this->vco_n.refresh(this->enable & 2, this->idac->getVin(1), t * VP_CYCLE_NS);
+        break;
+    case 1: {
+        // Sample the VCO outputs (vco_computation)
+        VpVco *vco[2] = {&this->vco_p, &this->vco_n};
+        for (unsigned int k = 0; k < 2; k++) {
+            Computation *c = &this->comp[k];
+            uint32_t fine = this->phase_lut[vco[k]->phase] & VP_VCO_FINE_MASK;
+            uint32_t binaryph = __builtin_popcount(fine >> 1);
+            this->fine[k] = fine;
+            this->coarse[k] = vco[k]->coarse;
+            c->coarse_prev = c->coarse;
+            c->coarse = vco[k]->coarse;
+            c->fine_prev = c->fine;
+            c->fine = (fine & 1 ? binaryph : 61 - binaryph) & 0x3f;
+        }
+        break;
+    }
+    default: {
+        // Accumulate the counts and, on the last conversion of the output
+        // sample, update the count register and notify the DMA
+        uint32_t m = (this->oversampling >> VCO_DECODER_OVERSAMPLING_COUNT_OFFSET) & VCO_DECODER_OVERSAMPLING_COUNT_MASK;
+        uint32_t shift = (this->oversampling >> VCO_DECODER_OVERSAMPLING_SHIFT_OFFSET) & VCO_DECODER_OVERSAMPLING_SHIFT_MASK;
+        uint32_t sum[2];
+        for (unsigned int k = 0; k < 2; k++) {
+            sum[k] = (m > 1 ? this->acc[k] : 0) + this->getCount(k);
+        }
+        if (m > 1 && this->acc_count + 1 < m) {
+            this->acc[0] = sum[0];
+            this->acc[1] = sum[1];
+            this->acc_count++;
+            break;
+        }
+        this->acc[0] = this->acc[1] = 0;
+        this->acc_count = 0;
+        if ((this->packing >> VCO_DECODER_PACKING_ENABLE_BIT) & 1) {
+            // Each count in its 16-bit field, clamped to the field range
+            bool tag = (this->packing >> VCO_DECODER_PACKING_TAG_BIT) & 1;
+            int32_t field_max = tag ? 0x7fff : 0xffff;
+            uint32_t field[2];
+            for (unsigned int k = 0; k < 2; k++) {
+                int32_t count = (int32_t)sum[k] >> shift;
+                if (!((this->enable >> k) & 1) || count < 0) count = 0;
+                else if (count > field_max) count = field_max;
+                field[k] = (uint32_t)count | (tag ? k << 15 : 0);
+            }
+            this->cnt = (field[1] << 16) | field[0];
+        } else {
+            uint32_t diff;
+            if ((this->enable & 3) == 3) diff = sum[0] - sum[1];
+            else if (this->enable & 1) diff = sum[0];
+            else if (this->enable & 2) diff = sum[1];
+            else diff = 0;
+            this->cnt = (uint32_t)((int32_t)diff >> shift);
+        }
+        if (this->fifoEnabled()) {
+            this->fifo.push(((uint64_t)this->getTimestamp(t) << 32) | this->cnt, t);
+        } else {
+            this->dma->triggerRx(0);
+        }
+        VP_LOG(LOG_FULL, "VCO decoder count: %d", (int32_t)this->cnt);
+        break;
+    }
+    }
+}
+
+uint32_t VpVcoDecoder::read(uint32_t off)
+{
+    switch (off) {
+    case VCO_DECODER_REFRESH_CYCLES_REG_OFFSET:
+        return this->refresh_cycles;
+    case VCO_DECODER_COUNTER_LIMIT_REG_OFFSET:
+        return this->counter_limit;
+    case VCO_DECODER_MANUAL_TRIGGER_REG_OFFSET:
+        return this->manual_trigger;
+    case VCO_DECODER_ENABLE_REG_OFFSET:
+        return this->enable;
+    case VCO_DECODER_ADC_P_FINE_OUT_REG_OFFSET:
+        return this->fine[0];
+    case VCO_DECODER_ADC_N_FINE_OUT_REG_OFFSET:
+        return this->fine[1];
+    case VCO_DECODER_ADC_P_COARSE_OUT_REG_OFFSET:
+        return this->coarse[0];
+    case VCO_DECODER_ADC_N_COARSE_OUT_REG_OFFSET:
+        return this->coarse[1];
+    case VCO_DECODER_VCO_DECODER_CNT_REG_OFFSET:
+        return this->cnt;
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN0_REG_OFFSET:
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN1_REG_OFFSET:
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN2_REG_OFFSET:
+        return (this->manual_train >> ((off - VCO_DECODER_MANUAL_REFRESH_TRAIN0_REG_OFFSET) / 4)) & 1;
+    case VCO_DECODER_FIFO_CONTROL_REG_OFFSET:
+        return this->fifo_control;
+    case VCO_DECODER_FIFO_LEVEL_REG_OFFSET:
+        return this->fifo.level(this->bus->time());
+    case VCO_DECODER_FIFO_WATERMARK_REG_OFFSET:
+        return this->fifo.watermark;
+    case VCO_DECODER_FIFO_OVERFLOW_REG_OFFSET:
+        this->fifo.level(this->bus->time());
+        return this->fifo.overflow;
+    case VCO_DECODER_TIMESTAMP_REG_OFFSET:
+        return this->getTimestamp(this->bus->time());
+    case VCO_DECODER_OVERSAMPLING_REG_OFFSET:
+        return this->oversampling;
+    case VCO_DECODER_DOUBLE_TAP_GAP_REG_OFFSET:
+        return this->double_tap_gap;
+    case VCO_DECODER_PACKING_REG_OFFSET:
+        return this->packing;
+    case VCO_DECODER_FIFO_DATA_REG_OFFSET: {
+        // The count, then the timestamp of the head entry; reading the last
+        // word of the entry pops it
+        uint64_t t = this->bus->time();
+        bool two_words = (this->fifo_control >> VCO_DECODER_FIFO_CONTROL_TIMESTAMP_BIT) & 1;
+        bool valid = this->fifo.level(t) != 0;
+        uint64_t entry = (two_words && !this->fifo_word) || !valid ? this->fifo.peek(t) : this->fifo.pop(t);
+        uint32_t data = this->fifo_word ? (uint32_t)(entry >> 32) : (uint32_t)entry;
+        if (two_words && valid) this->fifo_word = !this->fifo_word;
+        return data;
+    }
+    default:
+        return 0;
+    }
+}
+
+void VpVcoDecoder::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint64_t t = this->bus->time();
+    switch (off) {
+    case VCO_DECODER_REFRESH_CYCLES_REG_OFFSET:
+        this->refresh_cycles = vpMerge(this->refresh_cycles, data, mask);
+        this->trigger.setLimit(this->refresh_cycles, t);
+        break;
+    case VCO_DECODER_COUNTER_LIMIT_REG_OFFSET:
+        // The VCO overflow counter is not modelled
+        this->counter_limit = vpMerge(this->counter_limit, data, mask);
+        break;
+    case VCO_DECODER_MANUAL_TRIGGER_REG_OFFSET: {
+        uint32_t val = vpMerge(this->manual_trigger, data, mask) & 1;
+        if (val && !this->manual_trigger) this->trigger.setManual(t);
+        this->manual_trigger = val;
+        break;
+    }
+    case VCO_DECODER_ENABLE_REG_OFFSET:
+        this->enable = vpMerge(this->enable, data, mask) & 3;
+        break;
+    case VCO_DECODER_FIFO_CONTROL_REG_OFFSET: {
+        uint32_t val = vpMerge(this->fifo_control, data, mask) & 3;
+        // Disabling the FIFO flushes it and resets the timestamp counter,
+        // which starts counting the cycle after it is enabled
+        if (!((val >> VCO_DECODER_FIFO_CONTROL_ENABLE_BIT) & 1)) this->fifo.flush();
+        else if (!this->fifoEnabled()) this->timestamp_at = t + 1;
+        if (!((val >> VCO_DECODER_FIFO_CONTROL_ENABLE_BIT) & 1) ||
+            !((val >> VCO_DECODER_FIFO_CONTROL_TIMESTAMP_BIT) & 1)) this->fifo_word = false;
+        this->fifo_control = val;
+        break;
+    }
+    case VCO_DECODER_FIFO_WATERMARK_REG_OFFSET:
+        this->fifo.watermark = vpMerge(this->fifo.watermark, data, mask) & VCO_DECODER_FIFO_WATERMARK_FIFO_WATERMARK_MASK;
+        break;
+    case VCO_DECODER_DOUBLE_TAP_GAP_REG_OFFSET:
+        this->double_tap_gap = vpMerge(this->double_tap_gap, data, mask);
+        if (this->double_tap_gap == 0) this->tap_at = VP_NEVER;
+        break;
+    case VCO_DECODER_OVERSAMPLING_REG_OFFSET:
+        this->oversampling = vpMerge(this->oversampling, data, mask) &
+            ((VCO_DECODER_OVERSAMPLING_COUNT_MASK << VCO_DECODER_OVERSAMPLING_COUNT_OFFSET) |
+             (VCO_DECODER_OVERSAMPLING_SHIFT_MASK << VCO_DECODER_OVERSAMPLING_SHIFT_OFFSET));
+        // The accumulator is held cleared without oversampling
+        if (((this->oversampling >> VCO_DECODER_OVERSAMPLING_COUNT_OFFSET) & VCO_DECODER_OVERSAMPLING_COUNT_MASK) <= 1) {
+            this->acc[0] = this->acc[1] = 0;
+            this->acc_count = 0;
+        }
+        break;
+    case VCO_DECODER_PACKING_REG_OFFSET:
+        this->packing = vpMerge(this->packing, data, mask) & 3;
+        break;
+    case VCO_DECODER_FIFO_OVERFLOW_REG_OFFSET:
+        this->fifo.level(t);
+        this->fifo.overflow = vpMerge(this->fifo.overflow, data, mask) & VCO_DECODER_FIFO_OVERFLOW_FIFO_OVERFLOW_MASK;
+        break;
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN0_REG_OFFSET:
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN1_REG_OFFSET:
+    case VCO_DECODER_MANUAL_REFRESH_TRAIN2_REG_OFFSET: {
+        // The manual train registers are ORed with the trigger train: each
+        // stage runs on their rising edge
+        unsigned int i = (off - VCO_DECODER_MANUAL_REFRESH_TRAIN0_REG_OFFSET) / 4;
+        uint32_t val = vpMerge((this->manual_train >> i) & 1, data, mask) & 1;
+        if (val && !((this->manual_train >> i) & 1)) this->stage(i, t);
+        this->manual_train = (this->manual_train & ~(1u << i)) | (val << i);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void VpVcoDecoder::update(uint64_t t)
+{
+    // Refresh train: the three stages run on consecutive cycles
+    for (unsigned int i = 0; i < 3; i++) {
+        if (this->stage_at[i] <= t) {
+            this->stage_at[i] = VP_NEVER;
+            if (!((this->manual_train >> i) & 1)) this->stage(i, t);
+        }
+    }
+    bool refreshed = false;
+    if (this->tap_at <= t) {
+        // Second train of a double tap
+        this->tap_at = VP_NEVER;
+        if (!(this->manual_train & 1)) this->stage(0, t);
+        this->stage_at[1] = t + 1;
+        this->stage_at[2] = t + 2;
+        refreshed = true;
+    }
+    if (this->trigger.next(t) <= t) {
+        this->trigger.fire(t);
+        // The triggers during a double-tap gap are skipped
+        if (this->tap_at != VP_NEVER) return;
+        // A trigger on the second train merges with it
+        if (!refreshed && !(this->manual_train & 1)) this->stage(0, t);
+        this->stage_at[1] = t + 1;
+        if (this->double_tap_gap != 0) {
+            // The first train does not convert; the second one starts after
+            // the gap (at least two cycles)
+            this->tap_at = t + (this->double_tap_gap > 2 ? this->double_tap_gap : 2);
+        } else {
+            this->stage_at[2] = t + 2;
+        }
+    }
+}
+
+uint64_t VpVcoDecoder::nextEvent()
+{
+    uint64_t next = this->trigger.next(this->bus->time());
+    if (this->tap_at < next) next = this->tap_at;
+    for (unsigned int i = 1; i < 3; i++) {
+        if (this->stage_at[i] < next) next = this->stage_at[i];
+    }
+    return next;
+}
+
+bool VpVcoDecoder::getLevel(uint64_t t)
+{
+    return this->fifoEnabled() && this->fifo.trigger(t);
+}
+
+uint64_t VpVcoDecoder::nextLevel(uint64_t t)
+{
+    return this->fifoEnabled() ? this->fifo.nextTrigger(t) : VP_NEVER;
+}
+
+// ------------------------------------------------------------------------
+// SES filter
+// ------------------------------------------------------------------------
+
+VpSesFilter::VpSesFilter(VpDsmInput *input) :
+    VpDevice("ses_filter"),
+    fifo(VP_SES_FIFO_DEPTH, VP_CDC_FIFO_DST_SYNC, SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_MASK)
+{
+    this->control = 0;
+    this->sysclk_div = 0;
+    this->gain_stage = 0;
+    this->filtered = 0;
+    this->data_valid = false;
+    this->next_edge = VP_NEVER;
+    this->input = input;
+}
+
+void VpSesFilter::edge(uint64_t t)
+{
+    // The registered output is written to the FIFO
+    if (this->data_valid) this->fifo.push(this->filtered, t);
+
+    // Stages and decimator
+    this->data_valid = this->model.edge(this->input->edge(), &this->filtered);
+}
+
+uint32_t VpSesFilter::read(uint32_t off)
+{
+    uint64_t t = this->bus->time();
+    switch (off) {
+    case SES_FILTER_SES_CONTROL_REG_OFFSET:
+        return this->control;
+    case SES_FILTER_SES_STATUS_REG_OFFSET:
+        return ((this->fifo.overflow != 0) << 3) | (this->fifo.trigger(t) << 2) |
+               ((this->fifo.level(t) != 0) << 1) | this->control;
+    case SES_FILTER_SES_WINDOW_SIZE_REG_OFFSET:
+        return this->model.window_size;
+    case SES_FILTER_SES_DECIM_FACTOR_REG_OFFSET:
+        return this->model.decim_factor;
+    case SES_FILTER_SES_SYSCLK_DIVISION_REG_OFFSET:
+        return this->sysclk_div;
+    case SES_FILTER_SES_ACTIVATED_STAGES_REG_OFFSET:
+        return this->model.activated;
+    case SES_FILTER_SES_GAIN_STAGE_REG_OFFSET:
+        return this->gain_stage;
+    case SES_FILTER_SES_FIFO_LEVEL_REG_OFFSET:
+        return this->fifo.level(t);
+    case SES_FILTER_SES_FIFO_WATERMARK_REG_OFFSET:
+        return this->fifo.watermark;
+    case SES_FILTER_SES_FIFO_OVERFLOW_REG_OFFSET:
+        this->fifo.level(t);
+        return this->fifo.overflow;
+    case SES_FILTER_RX_DATA_REG_OFFSET:
+        return this->fifo.pop(t);
+    default:
+        return 0;
+    }
+}
+
+void VpSesFilter::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint64_t t = this->bus->time();
+    switch (off) {
+    case SES_FILTER_SES_CONTROL_REG_OFFSET: {
+        uint32_t val = vpMerge(this->control, data, mask) & 1;
+        if (val && !this->control) {
+            // First rising edge of the filter clock after half a period; the
+            // clock stops with sysclk_division < 2
+            uint32_t half = this->sysclk_div >> 1;
+            this->next_edge = half != 0 ? t + half : VP_NEVER;
+        } else if (!val) {
+            this->next_edge = VP_NEVER;
+        }
+        this->control = val;
+        break;
+    }
+    case SES_FILTER_SES_WINDOW_SIZE_REG_OFFSET:
+        this->model.window_size = vpMerge(this->model.window_size, data, mask) & SES_FILTER_SES_WINDOW_SIZE_SES_WINDOW_SIZE_MASK;
+        break;
+    case SES_FILTER_SES_DECIM_FACTOR_REG_OFFSET:
+        this->model.decim_factor = vpMerge(this->model.decim_factor, data, mask) & SES_FILTER_SES_DECIM_FACTOR_SES_DECIM_FACTOR_MASK;
+        break;
+    case SES_FILTER_SES_SYSCLK_DIVISION_REG_OFFSET:
+        this->sysclk_div = vpMerge(this->sysclk_div, data, mask) & SES_FILTER_SES_SYSCLK_DIVISION_SES_SYSCLK_DIVISION_MASK;
+        if (this->control && this->next_edge == VP_NEVER && (this->sysclk_div >> 1) != 0) {
+            this->next_edge = t + (this->sysclk_div >> 1);
+        }
+        break;
+    case SES_FILTER_SES_ACTIVATED_STAGES_REG_OFFSET:
+        this->model.activated = vpMerge(this->model.activated, data, mask) & SES_FILTER_SES_ACTIVATED_STAGES_SES_ACTIVATED_STAGES_MASK;
+        break;
+    case SES_FILTER_SES_GAIN_STAGE_REG_OFFSET:
+        this->gain_stage = vpMerge(this->gain_stage, data, mask) & 0x3fffffff;
+        this->model.setGainStage(this->gain_stage);
+        break;
+    case SES_FILTER_SES_FIFO_WATERMARK_REG_OFFSET:
+        this->fifo.watermark = vpMerge(this->fifo.watermark, data, mask) & SES_FILTER_SES_FIFO_WATERMARK_SES_FIFO_WATERMARK_MASK;
+        break;
+    case SES_FILTER_SES_FIFO_OVERFLOW_REG_OFFSET:
+        this->fifo.level(t);
+        this->fifo.overflow = vpMerge(this->fifo.overflow, data, mask) & SES_FILTER_SES_FIFO_OVERFLOW_SES_FIFO_OVERFLOW_MASK;
+        break;
+    default:
+        break;
+    }
+}
+
+void VpSesFilter::update(uint64_t t)
+{
+    if (this->next_edge > t) return;
+    this->edge(t);
+    uint32_t half = this->sysclk_div >> 1;
+    this->next_edge = half != 0 ? t + 2 * half : VP_NEVER;
+}
+
+uint64_t VpSesFilter::nextEvent()
+{
+    return this->next_edge;
+}
+
+bool VpSesFilter::isActive()
+{
+    return this->control;
+}
+
+bool VpSesFilter::getValid(uint64_t t)
+{
+    return this->fifo.trigger(t);
+}
+
+uint64_t VpSesFilter::nextValid(uint64_t t)
+{
+    return this->fifo.nextTrigger(t);
+}
+
+// ------------------------------------------------------------------------
+// CIC filter
+// ------------------------------------------------------------------------
+
+VpCic::VpCic(VpDsmInput *input, VpSesFilter *ses) : VpDevice("cic")
+{
+    this->clkdividx = 0;
+    this->control = 0;
+    this->r_store = true;
+    this->r_send = false;
+    this->r_data = false;
+    this->r_en = false;
+    this->next_edge = VP_NEVER;
+    this->input = input;
+    this->ses = ses;
+}
+
+uint32_t VpCic::period()
+{
+    // clk_int_div: the divider is CLKDIVIDX/2, and 0 or 1 bypass it
+    uint32_t div = (this->clkdividx >> 1) & 0x7fff;
+    return div < 2 ? 1 : div;
+}
+
+void VpCic::edge(uint64_t t)
+{
+    if (!this->r_en) {
+        // First edge after enable: clear the filter state
+        this->model.clear();
+    } else if (this->r_send) {
+        // Integrators, decimator and combs; the comb output is written to
+        // the FIFO when valid
+        uint32_t pcm;
+        bool ready = this->fifo.ready(t, 2 * this->period());
+        if (this->model.sample(this->r_data, &pcm) && ready) this->fifo.push(pcm, t);
+    }
+
+    // PDM sampling: the ΔΣ input is routed to the CIC only while the SES
+    // filter is off
+    if (this->r_store) {
+        this->r_data = this->ses->isActive() ? 0 : this->input->edge();
+        this->r_send = true;
+        this->r_store = false;
+    } else {
+        this->r_send = false;
+        this->r_store = true;
+    }
+    this->r_en = true;
+}
+
+uint32_t VpCic::read(uint32_t off)
+{
+    uint64_t t = this->bus->time();
+    switch (off) {
+    case PDM2PCM_CLKDIVIDX_REG_OFFSET:
+        return this->clkdividx;
+    case PDM2PCM_CONTROL_REG_OFFSET:
+        return this->control;
+    case PDM2PCM_STATUS_REG_OFFSET:
+        return (!this->fifo.ready(t, 2 * this->period()) << 1) | !this->fifo.valid(t);
+    case PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET:
+        return this->model.activated;
+    case PDM2PCM_CIC_DELAY_COMB_REG_OFFSET:
+        return this->model.delay_comb;
+    case PDM2PCM_DECIMCIC_REG_OFFSET:
+        return this->model.decim;
+    case PDM2PCM_RXDATA_REG_OFFSET:
+        return this->fifo.pop(t);
+    default:
+        return 0;
+    }
+}
+
+void VpCic::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint64_t t = this->bus->time();
+    switch (off) {
+    case PDM2PCM_CLKDIVIDX_REG_OFFSET:
+        this->clkdividx = vpMerge(this->clkdividx, data, mask) & 0xffff;
+        break;
+    case PDM2PCM_CONTROL_REG_OFFSET: {
+        // The divided clock is gated while disabled; the filter state is
+        // held, and only cleared by the first edge after reset
+        uint32_t val = vpMerge(this->control, data, mask) & 3;
+        if ((val & 1) && !(this->control & 1)) this->next_edge = t + this->period();
+        else if (!(val & 1)) this->next_edge = VP_NEVER;
+        this->control = val;
+        break;
+    }
+    case PDM2PCM_CIC_ACTIVATED_STAGES_REG_OFFSET:
+        this->model.activated = vpMerge(this->model.activated, data, mask) & 0x3f;
+        break;
+    case PDM2PCM_CIC_DELAY_COMB_REG_OFFSET:
+        this->model.delay_comb = vpMerge(this->model.delay_comb, data, mask) & 0xf;
+        break;
+    case PDM2PCM_DECIMCIC_REG_OFFSET:
+        this->model.decim = vpMerge(this->model.decim, data, mask) & 0xf;
+        break;
+    default:
+        break;
+    }
+}
+
+void VpCic::update(uint64_t t)
+{
+    if (this->next_edge > t) return;
+    this->edge(t);
+    this->next_edge = t + this->period();
+}
+
+uint64_t VpCic::nextEvent()
+{
+    return this->next_edge;
+}
+
+bool VpCic::isActive()
+{
+    return this->control & 1;
+}
+
+bool VpCic::getValid(uint64_t t)
+{
+    return this->fifo.valid(t);
+}
+
+uint64_t VpCic::nextValid(uint64_t t)
+{
+    return this->fifo.nextValid(t);
+}
+
+// ------------------------------------------------------------------------
+// ΔΣ decimation refresh notification
+// ------------------------------------------------------------------------
+
+VpDsmDecimation::VpDsmDecimation(VpSesFilter *ses, VpCic *cic)
+{
+    this->ses = ses;
+    this->cic = cic;
+}
+
+bool VpDsmDecimation::getLevel(uint64_t t)
+{
+    if (this->ses->isActive()) return this->ses->getValid(t);
+    if (this->cic->isActive()) return this->cic->getValid(t);
+    return false;
+}
+
+uint64_t VpDsmDecimation::nextLevel(uint64_t t)
+{
+    if (this->ses->isActive()) return this->ses->nextValid(t);
+    if (this->cic->isActive()) return this->cic->nextValid(t);
+    return VP_NEVER;
+}
+
+VpDmaTriggerOr::VpDmaTriggerOr(VpDmaTrigger *a, VpDmaTrigger *b)
+{
+    this->a = a;
+    this->b = b;
+}
+
+bool VpDmaTriggerOr::getLevel(uint64_t t)
+{
+    return this->a->getLevel(t) || this->b->getLevel(t);
+}
+
+uint64_t VpDmaTriggerOr::nextLevel(uint64_t t)
+{
+    uint64_t next_a = this->a->nextLevel(t);
+    uint64_t next_b = this->b->nextLevel(t);
+    return next_a < next_b ? next_a : next_b;
+}
+
+// ------------------------------------------------------------------------
+// dLC
+// ------------------------------------------------------------------------
+
+#define DLC_REG(name) (this->regs[DLC_##name##_REG_OFFSET / 4])
+
+VpDlc::VpDlc() : VpDevice("dlc")
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->trans_counter = 0;
+    this->idac = NULL;
+}
+
+void VpDlc::setIdacCtrl(VpIdacCtrl *idac)
+{
+    this->idac = idac;
+}
+
+uint32_t VpDlc::read(uint32_t off)
+{
+    if (off >= sizeof(this->regs)) return 0;
+    if (off == DLC_CURR_LVL_REG_OFFSET) return this->model.curr_lvl;
+    return this->regs[off / 4];
+}
+
+void VpDlc::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    static const uint32_t reg_mask[10] = {0xffff, 0xffff, 0x1, 0xf, 0xf, 0xf, 0xffff, 0x1, 0xffff, 0x1};
+    if (off >= sizeof(this->regs)) return;
+    this->regs[off / 4] = vpMerge(this->regs[off / 4], data, mask) & reg_mask[off / 4];
+
+    // Configuration of the encoder
+    this->model.hysteresis_en = DLC_REG(HYSTERESIS_EN);
+    this->model.dlvl_log_level_width = DLC_REG(DLVL_LOG_LEVEL_WIDTH);
+    this->model.discard_bits = DLC_REG(DISCARD_BITS);
+    this->model.dlvl_n_bits = DLC_REG(DLVL_N_BITS);
+    this->model.dlvl_mask = DLC_REG(DLVL_MASK);
+    this->model.dlvl_format = DLC_REG(DLVL_FORMAT);
+    this->model.dt_mask = DLC_REG(DT_MASK);
+    this->model.bypass = DLC_REG(BYPASS);
+    if (off == DLC_CURR_LVL_REG_OFFSET) this->model.curr_lvl = DLC_REG(CURR_LVL);
+}
+
+void VpDlc::flush()
+{
+    this->trans_counter = DLC_REG(TRANS_SIZE);
+    this->out.clear();
+}
+
+void VpDlc::push(uint32_t data)
+{
+    uint64_t crossings = this->model.crossings;
+    this->trans_counter--;
+    this->model.push(data, this->out);
+    if (this->idac != NULL && this->model.crossings != crossings) {
+        this->idac->crossing(this->model.xing_dir, this->bus->time());
+    }
+}
+
+bool VpDlc::pop(uint32_t *packet)
+{
+    if (this->out.empty()) return false;
+    *packet = this->out.front();
+    this->out.pop_front();
+    return true;
+}
+
+bool VpDlc::done()
+{
+    return this->trans_counter == 0;
+}
+
+uint64_t VpDlc::getCrossings()
+{
+    return this->model.crossings;
+}
+
+// ------------------------------------------------------------------------
+// Peripheral interrupt controller
+// ------------------------------------------------------------------------
+
+// Sources sampled as levels
+#define VP_IRQ_CTRL_LEVELS ((1u << IRQ_CTRL_SRC_SES_DATA_VALID) | (1u << IRQ_CTRL_SRC_CIC_DATA_VALID) | \
+                            (1u << IRQ_CTRL_SRC_DLC_DONE))
+
+VpIrqCtrl::VpIrqCtrl(VpSesFilter *ses, VpCic *cic, VpDlc *dlc, VpPlic *plic) : VpDevice("irq_ctrl")
+{
+    this->state = 0;
+    this->enable = 0;
+    // The edge detectors reset to 1 (the dLC is done out of reset)
+    this->levels = VP_IRQ_CTRL_LEVELS;
+    this->ses = ses;
+    this->cic = cic;
+    this->dlc = dlc;
+    this->plic = plic;
+}
+
+uint32_t VpIrqCtrl::getLevels(uint64_t t)
+{
+    // Data valid of the filters while they are activated (dsm_decimation)
+    uint32_t l = 0;
+    if (this->ses->isActive() && this->ses->getValid(t)) l |= 1u << IRQ_CTRL_SRC_SES_DATA_VALID;
+    if (this->cic->isActive() && this->cic->getValid(t)) l |= 1u << IRQ_CTRL_SRC_CIC_DATA_VALID;
+    if (this->dlc->done()) l |= 1u << IRQ_CTRL_SRC_DLC_DONE;
+    return l;
+}
+
+void VpIrqCtrl::event(uint32_t rise)
+{
+    this->state |= rise;
+    uint32_t lines = this->state & this->enable;
+    for (unsigned int i = 0; i < IRQ_CTRL_NUM_SOURCES; i++) {
+        this->plic->setSource(EXT_INTR_0 + i, (lines >> i) & 1);
+    }
+}
+
+uint32_t VpIrqCtrl::read(uint32_t off)
+{
+    switch (off) {
+    case IRQ_CTRL_INTR_STATE_REG_OFFSET:
+        return this->state;
+    case IRQ_CTRL_INTR_ENABLE_REG_OFFSET:
+        return this->enable;
+    default:
+        return 0;
+    }
+}
+
+void VpIrqCtrl::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint32_t all = (1u << IRQ_CTRL_NUM_SOURCES) - 1;
+    switch (off) {
+    case IRQ_CTRL_INTR_STATE_REG_OFFSET:
+        this->state &= ~(data & mask);
+        break;
+    case IRQ_CTRL_INTR_ENABLE_REG_OFFSET:
+        this->enable = vpMerge(this->enable, data, mask) & all;
+        break;
+    default:
+        return;
+    }
+    this->event(0);
+}
+
+void VpIrqCtrl::update(uint64_t t)
+{
+    uint32_t l = this->getLevels(t);
+    uint32_t rise = l & ~this->levels;
+    this->levels = l;
+    if (rise != 0) VP_LOG(LOG_FULL, "Peripheral interrupts: 0x%02x", rise);
+    this->event(rise);
+}
+
+uint64_t VpIrqCtrl::nextEvent()
+{
+    // The levels may fall on register accesses and DMA transfers: sample
+    // them at once when they differ, then wait for the next rise of the
+    // filter outputs (the dLC is sampled when its level changes)
+    uint64_t t = this->bus->time();
+    if (this->getLevels(t) != this->levels) return t;
+    uint64_t next = VP_NEVER;
+    if (this->ses->isActive() && !((this->levels >> IRQ_CTRL_SRC_SES_DATA_VALID) & 1)) {
+        uint64_t e = this->ses->nextValid(t);
+        if (e < next) next = e;
+    }
+    if (this->cic->isActive() && !((this->levels >> IRQ_CTRL_SRC_CIC_DATA_VALID) & 1)) {
+        uint64_t e = this->cic->nextValid(t);
+        if (e < next) next = e;
+    }
+    return next;
+}
+
+void VpIrqCtrl::pulse(unsigned int source)
+{
+    this->event(1u << source);
+}
@@ -0,0 +1,463 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_cheep.hh
+// Description: Transaction-level models of the HEEPidermis peripherals (iDAC
+//              and VCO controllers with their analog blocks, SES filter, CIC,
+//              dLC, interrupt controller). The data paths follow the RTL bit by bit; only the clock
+//              domain crossings are approximated.
+
+#if !defined(VP_CHEEP_HH_)
+#define VP_CHEEP_HH_
+
+#include <stdint.h>
+#include <cstdio>
+#include <deque>
+#include <string>
+
+#include "vp_bus.hh"
+#include "vp_xheep.hh"
+#include "tb_dsm.hh"
+#include "ref_ses_filter.hh"
+#include "ref_cic.hh"
+#include "ref_dlc.hh"
+
+// Depth of the filter output FIFOs (cdc_fifo_gray)
+#define VP_CDC_FIFO_DEPTH 4
+
+// Depth of the output FIFO of the SES filter (SES_FIFO_DEPTH of dsm_decimation)
+#define VP_SES_FIFO_DEPTH 16
+
+// Depth of the sample FIFO of the VCO decoder (FIFO_DEPTH of vco_decoder)
+#define VP_VCO_FIFO_DEPTH 16
+
+// Entries of the waveform RAM of the iDAC controller (WAVE_RAM window)
+#define VP_IDAC_WAVE_RAM_DEPTH 64
+
+// Lines of the pdm2pcm_dummy input file read before it stops the simulation
+#define VP_PDM_DUMMY_MAX_LINES 65536
+
+// 1-bit ΔΣ input (dsm_in) of the filters. The bit is taken from the
+// +dsm_source stream or, as in the RTL testbench, from the pdm2pcm_dummy
+// file. The next bit is loaded on each rising edge of dsm_clk.
+class VpDsmInput
+{
+private:
+    TbDsmSource *src;
+    uint64_t idx;
+    uint8_t data;
+    FILE *dummy;
+    uint64_t lines;
+    bool stopped;
+
+    uint8_t readDummy();
+
+public:
+    VpDsmInput();
+    ~VpDsmInput();
+
+    // Use the given source if active, the dummy file otherwise
+    bool open(TbDsmSource *src, const std::string& dummy_file);
+
+    // Rising edge of dsm_clk: return the current bit and load the next one
+    uint8_t edge();
+
+    // The dummy file reached its end ($stop in the RTL)
+    bool isStopped();
+};
+
+// Clock domain crossing FIFO of the filter outputs. The writes are seen by the
+// system clock domain two cycles later; the reads are seen by the filter clock
+// domain after sync_cycles.
+class VpCdcFifo
+{
+private:
+    uint32_t mem[VP_CDC_FIFO_DEPTH];
+    uint64_t push_at[VP_CDC_FIFO_DEPTH];
+    uint64_t pop_at[VP_CDC_FIFO_DEPTH];
+    uint64_t wptr;
+    uint64_t rptr;
+
+public:
+    VpCdcFifo();
+
+    // Source side (filter clock)
+    bool ready(uint64_t t, uint64_t sync_cycles);
+    void push(uint32_t data, uint64_t t);
+
+    // Destination side (system clock). Reading pops the head if valid, and
+    // returns the entry at the read pointer anyway.
+    bool valid(uint64_t t);
+    uint32_t pop(uint64_t t);
+
+    // First cycle after t at which valid may rise (VP_NEVER if empty)
+    uint64_t nextValid(uint64_t t);
+};
+
+// FIFO with a watermark trigger (fifo_v3 of the SES filter output and of the
+// VCO decoder samples). The entries reach the FIFO delay cycles after they
+// are pushed (the cdc_fifo_gray in front of the SES filter FIFO); those
+// arriving on a full FIFO are dropped and counted. The trigger is raised at
+// the watermark and held until the FIFO is empty.
+class VpWatermarkFifo
+{
+private:
+    struct Entry {
+        uint64_t data;
+        uint64_t at;
+    };
+    std::deque<Entry> pending;
+    std::deque<uint64_t> mem;
+    uint64_t last;
+    bool burst;
+    uint32_t depth;
+    uint64_t delay;
+    uint32_t overflow_max;
+
+    // Move the outputs arrived by t into the FIFO
+    void settle(uint64_t t);
+    uint32_t threshold();
+
+public:
+    uint32_t watermark;    // FIFO level that raises the trigger
+    uint32_t overflow;     // Saturating count of the dropped entries
+
+    VpWatermarkFifo(uint32_t depth, uint64_t delay, uint32_t overflow_max);
+
+    void push(uint64_t data, uint64_t t);
+    void flush();
+    uint32_t level(uint64_t t);
+    bool trigger(uint64_t t);
+
+    // Reading pops the head if not empty, and returns the entry at the read
+    // pointer anyway
+    uint64_t pop(uint64_t t);
+    uint64_t peek(uint64_t t);
+
+    // First cycle after t at which the trigger may rise (VP_NEVER if it
+    // cannot before the next output)
+    uint64_t nextTrigger(uint64_t t);
+};
+
+class VpIrqCtrl;
+
+// iDAC controller and the two iDACs. The iDACs latch their input code three
+// cycles after any register write; the trigger notifies DMA channel 1 (tx)
+// and the interrupt controller, and steps the waveform generator (DDS), whose
+// enabled channels replace the current register and refresh the iDACs. The
+// closed-loop tracking steps its code on the dLC crossings; its enabled
+// channels take precedence over the DDS, and each step refreshes the iDACs
+// and notifies DMA channel 1 (rx).
+class VpIdacCtrl : public VpDevice
+{
+private:
+    uint32_t refresh_cycles;
+    uint32_t manual_trigger;
+    uint32_t enable;
+    uint32_t calibration[2];
+    uint32_t current;
+    uint8_t in_r[2];
+    uint64_t refresh_at;
+
+    // Waveform generator
+    uint32_t dds_control;
+    uint32_t dds_frequency[2];
+    uint32_t dds_phase[2];
+    uint32_t dds_chirp[2];
+    uint32_t dds_amplitude;
+    uint32_t dds_offset;
+    uint32_t phase[2];
+    uint32_t chirp[2];
+    uint8_t dds_current[2];
+    uint8_t wave_ram[VP_IDAC_WAVE_RAM_DEPTH];
+
+    // Closed-loop current tracking
+    uint32_t fb_control;
+    uint32_t fb_step;
+    uint32_t fb_limits;
+    uint32_t fb_slew;
+    uint8_t fb_code[2];     // per channel, stepped while its loop is enabled
+    int32_t fb_pending;     // crossings not applied yet (saturating, +-127)
+    uint64_t fb_step_at;    // next step (VP_NEVER if none is pending)
+    uint64_t fb_ready_at;   // first cycle allowed by the slew limit
+
+    void stepDds();
+    void stepFeedback(uint64_t t);
+    uint8_t feedbackSeed(unsigned int i);
+    uint8_t feedbackCode(unsigned int i);
+    VpCounterTrigger trigger;
+    VpDma *dma;
+    VpIrqCtrl *irq;
+
+public:
+    VpIdacCtrl(VpDma *dma);
+
+    void setIrqCtrl(VpIrqCtrl *irq);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+
+    // dLC level crossing at time t (dir: true when downward)
+    void crossing(bool dir, uint64_t t);
+
+    // Output current of an iDAC (nA) and input voltage of the VCO it biases
+    // (uV), as computed by the analog subsystem
+    int32_t getCurrent(unsigned int i);
+    int32_t getVin(unsigned int i);
+};
+
+// Behavioral VCO model (VCO.sv, Verilator branch): the phase is computed from
+// the time elapsed since the previous refresh. The fine output is the index of
+// the phase_lut entry (thermometer code) driven by the VCO.
+class VpVco
+{
+private:
+    uint64_t last_ref_ns;
+    int32_t T_ns;
+    int32_t T_prev_ns;
+    int32_t T_last_ns;
+    uint32_t counter;
+
+public:
+    uint32_t coarse;
+    uint32_t phase;
+
+    VpVco();
+
+    // Rising edge of REFRESH at time now_ns
+    void refresh(bool en, uint32_t vin_uV, uint64_t now_ns);
+};
+
+// VCO decoder. The refresh train of the counter trigger (or of the manual
+// train registers) refreshes the VCOs, samples their outputs into the
+// decoder and updates the count, which notifies DMA channel 0 (rx). With the
+// sample FIFO enabled, the count is pushed into the FIFO with its timestamp
+// instead, and the FIFO watermark drives the DMA slot (level). With
+// oversampling, only the sum of every M conversions is an output sample. In
+// double-tap mode, a second refresh train follows each trigger after the gap,
+// and only the second train converts. With packing, the output sample holds
+// the counts of both VCOs in 16-bit fields instead of their difference.
+class VpVcoDecoder : public VpDevice, public VpDmaTrigger
+{
+private:
+    uint32_t refresh_cycles;
+    uint32_t counter_limit;
+    uint32_t manual_trigger;
+    uint32_t enable;
+    uint32_t fine[2];
+    uint32_t coarse[2];
+    uint32_t cnt;
+    uint32_t manual_train;
+    uint64_t stage_at[3];
+    VpCounterTrigger trigger;
+    uint32_t double_tap_gap;
+    uint64_t tap_at;
+
+    // Oversampling (accumulate-and-dump), per VCO
+    uint32_t oversampling;
+    uint32_t acc[2];
+    uint32_t acc_count;
+    uint32_t packing;
+
+    // Sample FIFO
+    uint32_t fifo_control;
+    uint64_t timestamp_at;   // Cycle at which the timestamp counter was 0
+    bool fifo_word;          // The timestamp of the head entry is read next
+    VpWatermarkFifo fifo;
+
+    // Decoder state (vco_computation), per VCO
+    struct Computation {
+        uint32_t coarse;
+        uint32_t coarse_prev;
+        uint32_t fine;
+        uint32_t fine_prev;
+    } comp[2];
+
+    uint32_t phase_lut[62];
+    VpVco vco_p;
+    VpVco vco_n;
+    VpIdacCtrl *idac;
+    VpDma *dma;
+
+    void stage(unsigned int i, uint64_t t);
+    uint32_t getCount(unsigned int i);
+    uint32_t getTimestamp(uint64_t t);
+    bool fifoEnabled();
+
+public:
+    VpVcoDecoder(VpIdacCtrl *idac, VpDma *dma);
+
+    // Load the fine phase lookup table (phase_lut.hex)
+    bool loadPhaseLut(const std::string& filename);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+
+    // Watermark trigger of the sample FIFO
+    bool getLevel(uint64_t t);
+    uint64_t nextLevel(uint64_t t);
+};
+
+// SES filter. The filter clock (sysclk_division system cycles) is simulated
+// edge by edge; the data path is the reference model (tb/models).
+class VpSesFilter : public VpDevice
+{
+private:
+    uint32_t control;
+    uint32_t sysclk_div;
+    uint32_t gain_stage;
+
+    RefSesFilter model;
+    uint32_t filtered;
+    bool data_valid;
+    uint64_t next_edge;
+    VpWatermarkFifo fifo;
+    VpDsmInput *input;
+
+    void edge(uint64_t t);
+
+public:
+    VpSesFilter(VpDsmInput *input);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+
+    bool isActive();
+    bool getValid(uint64_t t);
+    uint64_t nextValid(uint64_t t);
+};
+
+// CIC filter (pdm2pcm without the half-band and FIR stages). The divided
+// clock is simulated edge by edge; the ΔΣ input is 0 while the SES filter is
+// active. The data path is the reference model (tb/models).
+class VpCic : public VpDevice
+{
+private:
+    uint32_t clkdividx;
+    uint32_t control;
+
+    bool r_store;
+    bool r_send;
+    bool r_data;
+    bool r_en;
+    RefCic model;
+    uint64_t next_edge;
+    VpCdcFifo fifo;
+    VpDsmInput *input;
+    VpSesFilter *ses;
+
+    uint32_t period();
+    void edge(uint64_t t);
+
+public:
+    VpCic(VpDsmInput *input, VpSesFilter *ses);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+
+    bool isActive();
+    bool getValid(uint64_t t);
+    uint64_t nextValid(uint64_t t);
+};
+
+// Refresh notification of the ΔΣ decimation filters (DMA channel 0 rx slot):
+// the output FIFO of the CIC is not empty, or the trigger of the SES filter
+// FIFO
+class VpDsmDecimation : public VpDmaTrigger
+{
+private:
+    VpSesFilter *ses;
+    VpCic *cic;
+
+public:
+    VpDsmDecimation(VpSesFilter *ses, VpCic *cic);
+
+    bool getLevel(uint64_t t);
+    uint64_t nextLevel(uint64_t t);
+};
+
+// OR of two level triggers on the same DMA slot (ext_dma_slot_rx[0] is driven
+// by the VCO decoder and the ΔΣ decimation filters)
+class VpDmaTriggerOr : public VpDmaTrigger
+{
+private:
+    VpDmaTrigger *a;
+    VpDmaTrigger *b;
+
+public:
+    VpDmaTriggerOr(VpDmaTrigger *a, VpDmaTrigger *b);
+
+    bool getLevel(uint64_t t);
+    uint64_t nextLevel(uint64_t t);
+};
+
+// Delta-level crossing encoder (dLC), attached to the DMA as hardware FIFO.
+// The write FIFO is assumed to be drained by the DMA (no stalls). The
+// encoder is the reference model (tb/models).
+class VpDlc : public VpDevice, public VpDmaFifo
+{
+private:
+    uint32_t regs[10];
+    uint16_t trans_counter;
+    RefDlc model;
+    std::deque<uint16_t> out;
+    VpIdacCtrl *idac;
+
+public:
+    VpDlc();
+
+    // The crossings drive the closed-loop tracking of the iDAC controller
+    void setIdacCtrl(VpIdacCtrl *idac);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+
+    void flush();
+    void push(uint32_t data);
+    bool pop(uint32_t *packet);
+    bool done();
+
+    // Level crossings detected (dlc_xing_o pulses, routed to a pad)
+    uint64_t getCrossings();
+};
+
+// Peripheral interrupt controller (IRQ_ctrl). The level sources (SES filter
+// trigger, CIC data valid, dLC done) are sampled when they may change, and
+// their rising edges set the pending bits; the iDAC refresh is pulsed. The
+// VCO counter overflow is not modelled. Each enabled pending source drives
+// its PLIC source (EXT_INTR_0 and following).
+class VpIrqCtrl : public VpDevice
+{
+private:
+    uint32_t state;
+    uint32_t enable;
+    uint32_t levels;
+    VpSesFilter *ses;
+    VpCic *cic;
+    VpDlc *dlc;
+    VpPlic *plic;
+
+    uint32_t getLevels(uint64_t t);
+    void event(uint32_t rise);
+
+public:
+    VpIrqCtrl(VpSesFilter *ses, VpCic *cic, VpDlc *dlc, VpPlic *plic);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+
+    void pulse(unsigned int source);
+};
+
+#endif // VP_CHEEP_HH_
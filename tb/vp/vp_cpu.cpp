@@ -0,0 +1,470 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_cpu.cpp
+// Description: Instruction-set simulator of the cv32e20 core (RV32IMC)
+
+#include <cstring>
+
+#include "vp_cpu.hh"
+#include "vp_log.hh"
+
+// mstatus fields
+#define MSTATUS_MIE (1u << 3)
+#define MSTATUS_MPIE (1u << 7)
+#define MSTATUS_MPP (3u << 11)
+
+// Exception causes
+#define CAUSE_INSN_FAULT 1
+#define CAUSE_ILLEGAL 2
+#define CAUSE_BREAKPOINT 3
+#define CAUSE_LOAD_FAULT 5
+#define CAUSE_STORE_FAULT 7
+#define CAUSE_ECALL_M 11
+#define CAUSE_IRQ (1u << 31)
+
+// Instruction fields
+#define RD(i) (((i) >> 7) & 0x1f)
+#define RS1(i) (((i) >> 15) & 0x1f)
+#define RS2(i) (((i) >> 20) & 0x1f)
+#define FUNCT3(i) (((i) >> 12) & 0x7)
+#define FUNCT7(i) ((i) >> 25)
+#define IMM_I(i) ((int32_t) (i) >> 20)
+#define IMM_S(i) ((((int32_t) (i) >> 25) << 5) | (((i) >> 7) & 0x1f))
+#define IMM_B(i) ((((int32_t) (i) >> 31) << 12) | ((((i) >> 7) & 1) << 11) | ((((i) >> 25) & 0x3f) << 5) | \
+                  ((((i) >> 8) & 0xf) << 1))
+#define IMM_J(i) ((((int32_t) (i) >> 31) << 20) | ((i) & 0xff000) | ((((i) >> 20) & 1) << 11) | \
+                  ((((i) >> 21) & 0x3ff) << 1))
+
+// Instruction encoders (for the expansion of compressed instructions)
+#define ENC_R(f7, rs2, rs1, f3, rd, op) (((f7) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define ENC_I(imm, rs1, f3, rd, op) ((((uint32_t) (imm) & 0xfff) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define ENC_S(imm, rs2, rs1, f3, op) (((((uint32_t) (imm) >> 5) & 0x7f) << 25) | ((rs2) << 20) | ((rs1) << 15) | \
+                                      ((f3) << 12) | (((uint32_t) (imm) & 0x1f) << 7) | (op))
+#define ENC_B(imm, rs2, rs1, f3, op) (((((uint32_t) (imm) >> 12) & 1) << 31) | ((((uint32_t) (imm) >> 5) & 0x3f) << 25) | \
+                                      ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | \
+                                      ((((uint32_t) (imm) >> 1) & 0xf) << 8) | ((((uint32_t) (imm) >> 11) & 1) << 7) | (op))
+#define ENC_U(imm, rd, op) (((uint32_t) (imm) & 0xfffff000) | ((rd) << 7) | (op))
+#define ENC_J(imm, rd, op) (((((uint32_t) (imm) >> 20) & 1) << 31) | ((((uint32_t) (imm) >> 1) & 0x3ff) << 21) | \
+                            ((((uint32_t) (imm) >> 11) & 1) << 20) | ((uint32_t) (imm) & 0xff000) | ((rd) << 7) | (op))
+
+// Bit field of a compressed instruction
+#define CB(c, hi, lo) (((uint32_t) (c) >> (lo)) & ((1u << ((hi) - (lo) + 1)) - 1))
+
+VpCpu::VpCpu(VpBus *bus)
+{
+    this->bus = bus;
+    this->reset(0);
+}
+
+VpCpu::~VpCpu()
+{
+}
+
+void VpCpu::reset(uint32_t boot_addr)
+{
+    memset(this->x, 0, sizeof(this->x));
+    this->pc = boot_addr;
+    this->sleeping = false;
+    this->mstatus = MSTATUS_MPP;
+    this->mie = 0;
+    this->mtvec = 0x00000001;
+    this->mepc = 0;
+    this->mcause = 0;
+    this->mtval = 0;
+    this->mscratch = 0;
+    this->mcountinhibit = 0;
+    this->mcycle = 0;
+    this->minstret = 0;
+}
+
+bool VpCpu::isSleeping()
+{
+    return this->sleeping;
+}
+
+uint32_t VpCpu::getPc()
+{
+    return this->pc;
+}
+
+uint64_t VpCpu::getInstret()
+{
+    return this->minstret;
+}
+
+uint32_t VpCpu::expand(uint16_t c)
+{
+    uint32_t rd = CB(c, 11, 7);
+    uint32_t rs2 = CB(c, 6, 2);
+    uint32_t rdp = CB(c, 4, 2) + 8;  // rd' / rs2'
+    uint32_t rs1p = CB(c, 9, 7) + 8; // rs1' / rd'
+    int32_t imm6 = (int32_t) ((CB(c, 12, 12) << 5) | CB(c, 6, 2)) << 26 >> 26;
+
+    switch ((CB(c, 15, 13) << 2) | CB(c, 1, 0)) {
+    case 0x00: { // C.ADDI4SPN
+        uint32_t imm = (CB(c, 12, 11) << 4) | (CB(c, 10, 7) << 6) | (CB(c, 6, 6) << 2) | (CB(c, 5, 5) << 3);
+        if (imm == 0) return 0;
+        return ENC_I(imm, 2, 0, rdp, 0x13);
+    }
+    case 0x08: { // C.LW
+        uint32_t imm = (CB(c, 12, 10) << 3) | (CB(c, 6, 6) << 2) | (CB(c, 5, 5) << 6);
+        return ENC_I(imm, rs1p, 2, rdp, 0x03);
+    }
+    case 0x18: { // C.SW
+        uint32_t imm = (CB(c, 12, 10) << 3) | (CB(c, 6, 6) << 2) | (CB(c, 5, 5) << 6);
+        return ENC_S(imm, rdp, rs1p, 2, 0x23);
+    }
+    case 0x01: // C.ADDI / C.NOP
+        return ENC_I(imm6, rd, 0, rd, 0x13);
+    case 0x05: // C.JAL
+    case 0x15: { // C.J
+        int32_t imm = (CB(c, 12, 12) << 11) | (CB(c, 11, 11) << 4) | (CB(c, 10, 9) << 8) | (CB(c, 8, 8) << 10) |
+                      (CB(c, 7, 7) << 6) | (CB(c, 6, 6) << 7) | (CB(c, 5, 3) << 1) | (CB(c, 2, 2) << 5);
+        imm = imm << 20 >> 20;
+        return ENC_J(imm, CB(c, 15, 13) == 1 ? 1 : 0, 0x6f);
+    }
+    case 0x09: // C.LI
+        return ENC_I(imm6, 0, 0, rd, 0x13);
+    case 0x0d:
+        if (rd == 2) { // C.ADDI16SP
+            int32_t imm = (CB(c, 12, 12) << 9) | (CB(c, 6, 6) << 4) | (CB(c, 5, 5) << 6) | (CB(c, 4, 3) << 7) |
+                          (CB(c, 2, 2) << 5);
+            imm = imm << 22 >> 22;
+            if (imm == 0) return 0;
+            return ENC_I(imm, 2, 0, 2, 0x13);
+        }
+        // C.LUI
+        if (imm6 == 0) return 0;
+        return ENC_U((uint32_t) imm6 << 12, rd, 0x37);
+    case 0x11:
+        switch (CB(c, 11, 10)) {
+        case 0: // C.SRLI
+            return ENC_I(CB(c, 6, 2), rs1p, 5, rs1p, 0x13);
+        case 1: // C.SRAI
+            return ENC_I(0x400 | CB(c, 6, 2), rs1p, 5, rs1p, 0x13);
+        case 2: // C.ANDI
+            return ENC_I(imm6, rs1p, 7, rs1p, 0x13);
+        default:
+            if (CB(c, 12, 12)) return 0;
+            switch (CB(c, 6, 5)) {
+            case 0: return ENC_R(0x20, rdp, rs1p, 0, rs1p, 0x33); // C.SUB
+            case 1: return ENC_R(0, rdp, rs1p, 4, rs1p, 0x33);    // C.XOR
+            case 2: return ENC_R(0, rdp, rs1p, 6, rs1p, 0x33);    // C.OR
+            default: return ENC_R(0, rdp, rs1p, 7, rs1p, 0x33);   // C.AND
+            }
+        }
+    case 0x19: // C.BEQZ
+    case 0x1d: { // C.BNEZ
+        int32_t imm = (CB(c, 12, 12) << 8) | (CB(c, 11, 10) << 3) | (CB(c, 6, 5) << 6) | (CB(c, 4, 3) << 1) |
+                      (CB(c, 2, 2) << 5);
+        imm = imm << 23 >> 23;
+        return ENC_B(imm, 0, rs1p, CB(c, 15, 13) == 6 ? 0 : 1, 0x63);
+    }
+    case 0x02: // C.SLLI
+        if (CB(c, 12, 12)) return 0;
+        return ENC_I(CB(c, 6, 2), rd, 1, rd, 0x13);
+    case 0x0a: { // C.LWSP
+        uint32_t imm = (CB(c, 12, 12) << 5) | (CB(c, 6, 4) << 2) | (CB(c, 3, 2) << 6);
+        if (rd == 0) return 0;
+        return ENC_I(imm, 2, 2, rd, 0x03);
+    }
+    case 0x12:
+        if (!CB(c, 12, 12)) {
+            if (rs2 == 0) { // C.JR
+                if (rd == 0) return 0;
+                return ENC_I(0, rd, 0, 0, 0x67);
+            }
+            return ENC_R(0, rs2, 0, 0, rd, 0x33); // C.MV
+        }
+        if (rs2 == 0) {
+            if (rd == 0) return 0x00100073;        // C.EBREAK
+            return ENC_I(0, rd, 0, 1, 0x67);       // C.JALR
+        }
+        return ENC_R(0, rs2, rd, 0, rd, 0x33);     // C.ADD
+    case 0x1a: { // C.SWSP
+        uint32_t imm = (CB(c, 12, 9) << 2) | (CB(c, 8, 7) << 6);
+        return ENC_S(imm, rs2, 2, 2, 0x23);
+    }
+    default:
+        return 0;
+    }
+}
+
+bool VpCpu::readCsr(uint32_t csr, uint32_t *val)
+{
+    switch (csr) {
+    case 0x300: *val = this->mstatus; break;
+    case 0x301: *val = (1u << 30) | (1u << 2) | (1u << 8) | (1u << 12); break; // misa: RV32IMC
+    case 0x304: *val = this->mie; break;
+    case 0x305: *val = this->mtvec; break;
+    case 0x320: *val = this->mcountinhibit; break;
+    case 0x340: *val = this->mscratch; break;
+    case 0x341: *val = this->mepc; break;
+    case 0x342: *val = this->mcause; break;
+    case 0x343: *val = this->mtval; break;
+    case 0x344: *val = this->bus->mip; break;
+    case 0xb00: case 0xc00: *val = (uint32_t) this->mcycle; break;
+    case 0xb02: case 0xc02: *val = (uint32_t) this->minstret; break;
+    case 0xb80: case 0xc80: *val = (uint32_t) (this->mcycle >> 32); break;
+    case 0xb82: case 0xc82: *val = (uint32_t) (this->minstret >> 32); break;
+    case 0xf14: *val = 0; break; // mhartid
+    default:
+        // Other CSRs (vendor IDs, performance counters...) read as zero
+        *val = 0;
+        break;
+    }
+    return true;
+}
+
+void VpCpu::writeCsr(uint32_t csr, uint32_t val)
+{
+    switch (csr) {
+    case 0x300: this->mstatus = (val & (MSTATUS_MIE | MSTATUS_MPIE)) | MSTATUS_MPP; break;
+    case 0x304: this->mie = val; break;
+    case 0x305: this->mtvec = (val & 0xffffff00) | 1; break; // vectored mode only
+    case 0x320: this->mcountinhibit = val & 0x5; break;
+    case 0x340: this->mscratch = val; break;
+    case 0x341: this->mepc = val & ~1u; break;
+    case 0x342: this->mcause = val; break;
+    case 0x343: this->mtval = val; break;
+    case 0xb00: this->mcycle = (this->mcycle & 0xffffffff00000000ull) | val; break;
+    case 0xb02: this->minstret = (this->minstret & 0xffffffff00000000ull) | val; break;
+    case 0xb80: this->mcycle = (this->mcycle & 0xffffffffull) | ((uint64_t) val << 32); break;
+    case 0xb82: this->minstret = (this->minstret & 0xffffffffull) | ((uint64_t) val << 32); break;
+    default: break;
+    }
+}
+
+void VpCpu::trap(uint32_t cause, uint32_t tval, uint32_t epc)
+{
+    this->mepc = epc;
+    this->mcause = cause;
+    this->mtval = tval;
+    this->mstatus = (this->mstatus & MSTATUS_MIE ? MSTATUS_MPIE : 0) | MSTATUS_MPP;
+    this->pc = (this->mtvec & ~3u) + (cause & CAUSE_IRQ ? 4 * (cause & 0x1f) : 0);
+    VP_LOG(LOG_DEBUG, "Trap: cause 0x%08x, tval 0x%08x, epc 0x%08x", cause, tval, epc);
+}
+
+unsigned int VpCpu::execute(uint32_t insn, uint32_t len)
+{
+    uint32_t npc = this->pc + len;
+    uint32_t rd = RD(insn);
+    uint32_t a = this->x[RS1(insn)];
+    uint32_t b = this->x[RS2(insn)];
+    uint32_t res = 0;
+    unsigned int cycles = VP_CYCLES_ALU;
+    bool wb = true;
+
+    switch (insn & 0x7f) {
+    case 0x37: // LUI
+        res = insn & 0xfffff000;
+        break;
+    case 0x17: // AUIPC
+        res = this->pc + (insn & 0xfffff000);
+        break;
+    case 0x6f: // JAL
+        res = npc;
+        npc = this->pc + IMM_J(insn);
+        cycles = VP_CYCLES_JUMP;
+        break;
+    case 0x67: // JALR
+        res = npc;
+        npc = (a + IMM_I(insn)) & ~1u;
+        cycles = VP_CYCLES_JUMP;
+        break;
+    case 0x63: { // Branches
+        bool taken;
+        switch (FUNCT3(insn)) {
+        case 0: taken = a == b; break;
+        case 1: taken = a != b; break;
+        case 4: taken = (int32_t) a < (int32_t) b; break;
+        case 5: taken = (int32_t) a >= (int32_t) b; break;
+        case 6: taken = a < b; break;
+        case 7: taken = a >= b; break;
+        default: goto illegal;
+        }
+        if (taken) {
+            npc = this->pc + IMM_B(insn);
+            cycles = VP_CYCLES_BRANCH_TAKEN;
+        }
+        wb = false;
+        break;
+    }
+    case 0x03: { // Loads
+        uint32_t addr = a + IMM_I(insn);
+        uint32_t val;
+        unsigned int size = 1u << (FUNCT3(insn) & 3);
+        if ((FUNCT3(insn) & 3) == 3 || FUNCT3(insn) > 5) goto illegal;
+        if (!this->bus->read(addr, size, &val)) {
+            this->trap(CAUSE_LOAD_FAULT, addr, this->pc);
+            return VP_CYCLES_TRAP;
+        }
+        switch (FUNCT3(insn)) {
+        case 0: res = (int32_t) (int8_t) val; break;
+        case 1: res = (int32_t) (int16_t) val; break;
+        default: res = val; break;
+        }
+        cycles = VP_CYCLES_LOAD;
+        break;
+    }
+    case 0x23: { // Stores
+        uint32_t addr = a + IMM_S(insn);
+        if (FUNCT3(insn) > 2) goto illegal;
+        if (!this->bus->write(addr, 1u << FUNCT3(insn), b)) {
+            this->trap(CAUSE_STORE_FAULT, addr, this->pc);
+            return VP_CYCLES_TRAP;
+        }
+        cycles = VP_CYCLES_STORE;
+        wb = false;
+        break;
+    }
+    case 0x13: { // ALU with immediate
+        int32_t imm = IMM_I(insn);
+        switch (FUNCT3(insn)) {
+        case 0: res = a + imm; break;
+        case 1: res = a << (imm & 0x1f); break;
+        case 2: res = (int32_t) a < imm; break;
+        case 3: res = a < (uint32_t) imm; break;
+        case 4: res = a ^ imm; break;
+        case 5: res = (insn & (1u << 30)) ? (uint32_t) ((int32_t) a >> (imm & 0x1f)) : a >> (imm & 0x1f); break;
+        case 6: res = a | imm; break;
+        default: res = a & imm; break;
+        }
+        break;
+    }
+    case 0x33: // ALU and M extension
+        if (FUNCT7(insn) == 1) {
+            int64_t sa = (int32_t) a, sb = (int32_t) b;
+            cycles = FUNCT3(insn) < 4 ? VP_CYCLES_MUL : VP_CYCLES_DIV;
+            switch (FUNCT3(insn)) {
+            case 0: res = a * b; break;
+            case 1: res = (uint32_t) ((sa * sb) >> 32); break;
+            case 2: res = (uint32_t) ((sa * (int64_t) (uint64_t) b) >> 32); break;
+            case 3: res = (uint32_t) (((uint64_t) a * b) >> 32); break;
+            case 4: res = b == 0 ? 0xffffffff : (a == 0x80000000 && b == 0xffffffff) ? a :
+                          (uint32_t) ((int32_t) a / (int32_t) b); break;
+            case 5: res = b == 0 ? 0xffffffff : a / b; break;
+            case 6: res = b == 0 ? a : (a == 0x80000000 && b == 0xffffffff) ? 0 :
+                          (uint32_t) ((int32_t) a % (int32_t) b); break;
+            default: res = b == 0 ? a : a % b; break;
+            }
+            break;
+        }
+        if (FUNCT7(insn) & ~0x20) goto illegal;
+        switch (FUNCT3(insn)) {
+        case 0: res = FUNCT7(insn) ? a - b : a + b; break;
+        case 1: res = a << (b & 0x1f); break;
+        case 2: res = (int32_t) a < (int32_t) b; break;
+        case 3: res = a < b; break;
+        case 4: res = a ^ b; break;
+        case 5: res = FUNCT7(insn) ? (uint32_t) ((int32_t) a >> (b & 0x1f)) : a >> (b & 0x1f); break;
+        case 6: res = a | b; break;
+        default: res = a & b; break;
+        }
+        break;
+    case 0x0f: // FENCE, FENCE.I
+        wb = false;
+        break;
+    case 0x73: { // System
+        uint32_t csr = insn >> 20;
+        if (FUNCT3(insn) == 0) {
+            wb = false;
+            switch (insn) {
+            case 0x00000073: // ECALL
+                this->trap(CAUSE_ECALL_M, 0, this->pc);
+                return VP_CYCLES_TRAP;
+            case 0x00100073: // EBREAK
+                this->trap(CAUSE_BREAKPOINT, this->pc, this->pc);
+                return VP_CYCLES_TRAP;
+            case 0x30200073: // MRET
+                this->mstatus = (this->mstatus & MSTATUS_MPIE ? MSTATUS_MIE : 0) | MSTATUS_MPIE | MSTATUS_MPP;
+                npc = this->mepc;
+                cycles = VP_CYCLES_TRAP;
+                break;
+            case 0x10500073: // WFI
+                if ((this->bus->mip & this->mie) == 0) this->sleeping = true;
+                break;
+            default:
+                goto illegal;
+            }
+            break;
+        }
+        uint32_t src = FUNCT3(insn) & 4 ? RS1(insn) : a;
+        uint32_t old;
+        this->readCsr(csr, &old);
+        switch (FUNCT3(insn) & 3) {
+        case 1: this->writeCsr(csr, src); break; // CSRRW(I)
+        case 2: if (RS1(insn) != 0) this->writeCsr(csr, old | src); break; // CSRRS(I)
+        case 3: if (RS1(insn) != 0) this->writeCsr(csr, old & ~src); break; // CSRRC(I)
+        default: goto illegal;
+        }
+        res = old;
+        break;
+    }
+    default:
+        goto illegal;
+    }
+
+    if (wb && rd != 0) this->x[rd] = res;
+    this->pc = npc;
+    return cycles;
+
+illegal:
+    this->trap(CAUSE_ILLEGAL, insn, this->pc);
+    return VP_CYCLES_TRAP;
+}
+
+unsigned int VpCpu::step()
+{
+    uint32_t pending = this->bus->mip & this->mie;
+
+    // WFI: wake up on any enabled interrupt, even if interrupts are globally
+    // disabled
+    if (this->sleeping) {
+        if (pending == 0) return 0;
+        this->sleeping = false;
+    }
+
+    // Interrupts: fast interrupts first (lowest index first), then external,
+    // software and timer
+    if (pending != 0 && (this->mstatus & MSTATUS_MIE)) {
+        unsigned int id;
+        if (pending & 0xffff0000) id = __builtin_ctz(pending & 0xffff0000);
+        else if (pending & (1u << 11)) id = 11;
+        else if (pending & (1u << 3)) id = 3;
+        else id = 7;
+        this->trap(CAUSE_IRQ | id, 0, this->pc);
+        if (!(this->mcountinhibit & 1)) this->mcycle += VP_CYCLES_TRAP;
+        return VP_CYCLES_TRAP;
+    }
+
+    // Fetch
+    uint16_t lo, hi;
+    uint32_t insn, len;
+    if (!this->bus->fetch(this->pc, &lo)) {
+        this->trap(CAUSE_INSN_FAULT, this->pc, this->pc);
+        return VP_CYCLES_TRAP;
+    }
+    if ((lo & 3) != 3) {
+        insn = this->expand(lo);
+        len = 2;
+        if (insn == 0) {
+            this->trap(CAUSE_ILLEGAL, lo, this->pc);
+            return VP_CYCLES_TRAP;
+        }
+    } else {
+        if (!this->bus->fetch(this->pc + 2, &hi)) {
+            this->trap(CAUSE_INSN_FAULT, this->pc + 2, this->pc);
+            return VP_CYCLES_TRAP;
+        }
+        insn = lo | ((uint32_t) hi << 16);
+        len = 4;
+    }
+
+    unsigned int cycles = this->execute(insn, len);
+    if (!(this->mcountinhibit & 1)) this->mcycle += cycles;
+    if (!(this->mcountinhibit & 4)) this->minstret++;
+    return cycles;
+}
@@ -0,0 +1,78 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_cpu.hh
+// Description: Instruction-set simulator of the cv32e20 core (RV32IMC,
+//              machine mode only, vectored interrupts). Instruction timing is
+//              approximated with a fixed cost per instruction class.
+
+#if !defined(VP_CPU_HH_)
+#define VP_CPU_HH_
+
+#include <stdint.h>
+
+#include "vp_bus.hh"
+
+// Approximate cycle cost of each instruction class
+#define VP_CYCLES_ALU 1
+#define VP_CYCLES_LOAD 2
+#define VP_CYCLES_STORE 2
+#define VP_CYCLES_BRANCH_TAKEN 3
+#define VP_CYCLES_JUMP 2
+#define VP_CYCLES_MUL 3
+#define VP_CYCLES_DIV 37
+#define VP_CYCLES_TRAP 3
+
+// Class definition
+class VpCpu
+{
+private:
+    VpBus *bus;
+
+    uint32_t x[32];
+    uint32_t pc;
+    bool sleeping;
+
+    // Machine-mode CSRs
+    uint32_t mstatus;
+    uint32_t mie;
+    uint32_t mtvec;
+    uint32_t mepc;
+    uint32_t mcause;
+    uint32_t mtval;
+    uint32_t mscratch;
+    uint32_t mcountinhibit;
+    uint64_t mcycle;
+    uint64_t minstret;
+
+    // Expand a compressed instruction (0 if illegal)
+    static uint32_t expand(uint16_t c);
+
+    bool readCsr(uint32_t csr, uint32_t *val);
+    void writeCsr(uint32_t csr, uint32_t val);
+
+    // Enter the trap handler
+    void trap(uint32_t cause, uint32_t tval, uint32_t epc);
+
+    // Execute a 32-bit instruction; return its cycle cost
+    unsigned int execute(uint32_t insn, uint32_t len);
+
+public:
+    VpCpu(VpBus *bus);
+    ~VpCpu();
+
+    void reset(uint32_t boot_addr);
+
+    // Take a pending interrupt or execute one instruction; return the
+    // number of cycles spent (0 while sleeping)
+    unsigned int step();
+
+    // Sleeping in WFI until an enabled interrupt is pending
+    bool isSleeping();
+
+    uint32_t getPc();
+    uint64_t getInstret();
+};
+
+#endif // VP_CPU_HH_
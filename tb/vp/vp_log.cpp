@@ -0,0 +1,69 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_log.cpp
+// Description: Logging functions of the virtual platform
+
+#include <cstdarg>
+#include <cstring>
+
+#include "vp_log.hh"
+
+log_lvl_t vp_log_lvl = LOG_MEDIUM;
+uint64_t vp_log_cycle = 0;
+
+// File name without the directory
+static inline const char *fileName(const char *path)
+{
+    const char *name = strrchr(path, '/');
+    return name != NULL ? name + 1 : path;
+}
+
+void vpSetLogLvl(const char *lvl)
+{
+    if (!strcmp(lvl, "LOG_NONE")) vp_log_lvl = LOG_NONE;
+    else if (!strcmp(lvl, "LOG_LOW")) vp_log_lvl = LOG_LOW;
+    else if (!strcmp(lvl, "LOG_HIGH")) vp_log_lvl = LOG_HIGH;
+    else if (!strcmp(lvl, "LOG_FULL")) vp_log_lvl = LOG_FULL;
+    else if (!strcmp(lvl, "LOG_DEBUG")) vp_log_lvl = LOG_DEBUG;
+    else vp_log_lvl = LOG_MEDIUM;
+}
+
+void vpPrint(vp_tag_t tag, const char *file, unsigned int line, const char *fmt, ...)
+{
+    // Same layout as TbLogger; the timestamp is in Verilator time units (two
+    // per clock cycle)
+    char str_buf[256];
+    FILE *out = stdout;
+    uint64_t time = vp_log_cycle << 1;
+    switch (tag) {
+    case VP_TAG_SUCCESS:
+        snprintf(str_buf, sizeof(str_buf), "\033[1;32m[OK!   ] %s:%u >\033[0m", fileName(file), line);
+        fprintf(out, "%-46s [%5lu] ", str_buf, time);
+        break;
+    case VP_TAG_CONFIG:
+        snprintf(str_buf, sizeof(str_buf), "\033[1m[CONFIG] %s:%u >\033[0m", fileName(file), line);
+        fprintf(out, "%-44s", str_buf);
+        break;
+    case VP_TAG_WARN:
+        out = stderr;
+        snprintf(str_buf, sizeof(str_buf), "\033[1;33m[WARN  ] %s:%u >\033[0m", fileName(file), line);
+        fprintf(out, "%-46s [%5lu] ", str_buf, time);
+        break;
+    case VP_TAG_ERR:
+        out = stderr;
+        snprintf(str_buf, sizeof(str_buf), "\033[1;31m[ERR!  ] %s:%u >\033[0m", fileName(file), line);
+        fprintf(out, "%-46s [%5lu] ", str_buf, time);
+        break;
+    default:
+        snprintf(str_buf, sizeof(str_buf), "[LOG   ] %s:%u >", fileName(file), line);
+        fprintf(out, "%-35s [%5lu] ", str_buf, time);
+        break;
+    }
+    va_list arg_ptr;
+    va_start(arg_ptr, fmt);
+    vfprintf(out, fmt, arg_ptr);
+    va_end(arg_ptr);
+    fprintf(out, "\n");
+}
@@ -0,0 +1,66 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_log.hh
+// Description: Logging macros of the virtual platform. Same levels and
+//              message format as the Verilator testbench (tb_macros.hh), with
+//              the simulated cycle as timestamp.
+
+#if !defined(VP_LOG_HH_)
+#define VP_LOG_HH_
+
+#include <cstdio>
+#include <stdint.h>
+
+typedef enum {
+    LOG_NONE,
+    LOG_LOW,
+    LOG_MEDIUM,
+    LOG_HIGH,
+    LOG_FULL,
+    LOG_DEBUG
+} log_lvl_t;
+
+// Current log level and simulated cycle (for timestamping)
+extern log_lvl_t vp_log_lvl;
+extern uint64_t vp_log_cycle;
+
+// Set the log level from its name (e.g., "LOG_LOW")
+void vpSetLogLvl(const char *lvl);
+
+// Message tags
+typedef enum {
+    VP_TAG_LOG,
+    VP_TAG_SUCCESS,
+    VP_TAG_CONFIG,
+    VP_TAG_WARN,
+    VP_TAG_ERR
+} vp_tag_t;
+
+// Print a message with the given tag
+void vpPrint(vp_tag_t tag, const char *file, unsigned int line, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+#define VP_LOG(lvl, ...)\
+    do {\
+        if ((lvl) <= vp_log_lvl) vpPrint(VP_TAG_LOG, __FILE__, __LINE__, __VA_ARGS__);\
+    } while (0)
+
+#define VP_SUCCESS(lvl, ...)\
+    do {\
+        if ((lvl) <= vp_log_lvl) vpPrint(VP_TAG_SUCCESS, __FILE__, __LINE__, __VA_ARGS__);\
+    } while (0)
+
+#define VP_CONFIG(...) vpPrint(VP_TAG_CONFIG, __FILE__, __LINE__, __VA_ARGS__)
+#define VP_WARN(...) vpPrint(VP_TAG_WARN, __FILE__, __LINE__, __VA_ARGS__)
+#define VP_ERR(...) vpPrint(VP_TAG_ERR, __FILE__, __LINE__, __VA_ARGS__)
+
+// Testbench sources shared with the virtual platform (tb_dsm.cpp)
+#define TB_LOG VP_LOG
+#define TB_SUCCESS VP_SUCCESS
+#define TB_CONFIG VP_CONFIG
+#define TB_WARN VP_WARN
+#define TB_ERR VP_ERR
+
+#endif // VP_LOG_HH_
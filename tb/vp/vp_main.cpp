@@ -0,0 +1,319 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_main.cpp
+// Description: Instruction-level virtual platform of HEEPidermis. Runs the
+//              same firmware images and accepts the same options as the
+//              Verilator testbench (cheep_tb.cpp), orders of magnitude faster.
+
+// System libraries
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <stdint.h>
+#include <string>
+
+// User libraries
+#include "vp_log.hh"
+#include "vp_bus.hh"
+#include "vp_cpu.hh"
+#include "vp_xheep.hh"
+#include "vp_cheep.hh"
+#include "tb_perf.hh"
+#include "tb_dsm.hh"
+#include "core_v_mini_mcu.h"
+#include "cheep.h"
+
+// Defines
+// -------
+// Cycles spent in reset by the RTL testbench (PRE_RESET_CYCLES +
+// RESET_CYCLES + POST_RESET_CYCLES), so that the timestamps match
+#define RESET_CYCLES 450
+#define MAX_SIM_CYCLES 2e6
+#define BOOT_ADDRESS 0x180 // __boot_address in the linker script
+#define UART_LOG_FILENAME "uart.log"
+#define PHASE_LUT_FILENAME "hw/vendor/analog-library/VCO/Verilog/phase_lut.hex"
+#define PDM_DUMMY_FILENAME "hw/vendor/x-heep/hw/ip/pdm2pcm/tb/signals/pdm.txt"
+
+// Function prototypes
+// -------------------
+// Process runtime parameters
+std::string getCmdOption(int argc, char* argv[], const std::string& option);
+
+// Global variables
+// ----------------
+// ΔΣ bitstream source
+TbDsmSource dsm_source;
+
+int main(int argc, char *argv[])
+{
+    // Exit value
+    int exit_val = EXIT_SUCCESS;
+
+    // COMMAND-LINE OPTIONS
+    // --------------------
+    // Define command-line options (same as the Verilator testbench; waveforms
+    // and log buffering are not available)
+    bool no_err = false;
+    const option longopts[] = {
+        {"help", no_argument, NULL, 'h'},
+        {"log_level", required_argument, NULL, 'l'},
+        {"trace", required_argument, NULL, 't'},
+        {"no_err", required_argument, NULL, 'q'},
+        {"log_buffer", required_argument, NULL, 'b'},
+        {NULL, 0, NULL, 0}
+    };
+
+    // Parse command-line options
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hl:t:q:b:", longopts, NULL)) >= 0) {
+        switch (opt) {
+        case 'h':
+            printf("Usage: %s [OPTIONS] +firmware=<file> [+PLUSARGS]\n", argv[0]);
+            printf("Options:\n");
+            printf("  -h, --help\t\t\tPrint this help message\n");
+            printf("  -l, --log_level=LOG_LEVEL\tSet the log level\n");
+            printf("  -q, --no_err=[true/false]\t\t\tAlways return 0\n");
+            printf("Plusargs:\n");
+            printf("  +firmware=<file.hex|file.elf>\tFirmware to load\n");
+            printf("  +max_cycles=<N>\t\tMax simulation cycles\n");
+            printf("  +dsm_source=<spec>\t\tΔΣ input bitstream (see cheep_tb)\n");
+            printf("  +perf_report=<file>\t\tWrite the performance report (JSON or CSV)\n");
+            printf("  +uart_log=<file>\t\tUART output file (default: %s)\n", UART_LOG_FILENAME);
+            printf("  +phase_lut=<file>\t\tVCO phase table (default: %s)\n", PHASE_LUT_FILENAME);
+            printf("  +pdm_file=<file>\t\tΔΣ input without +dsm_source (default: %s)\n", PDM_DUMMY_FILENAME);
+            exit(0);
+            break;
+        case 'l':
+            vpSetLogLvl(optarg);
+            break;
+        case 't':
+            if (strcmp(optarg, "1") == 0 || strcmp(optarg, "true") == 0) {
+                VP_WARN("Waveforms are not available in the virtual platform");
+            }
+            break;
+        case 'q':
+            if (strcmp(optarg, "1") == 0 || strcmp(optarg, "true") == 0) {
+                no_err = true;
+            }
+            break;
+        case 'b':
+            break;
+        default:
+            printf("Usage: %s [OPTIONS]\n", argv[0]);
+            printf("Try '%s --help' for more information.\n", argv[0]);
+            exit(1);
+            break;
+        }
+    }
+
+    // Parse the remaining command-line arguments
+    // ------------------------------------------
+    std::string boot_mode_str;
+    std::string firmware_file;
+    std::string max_cycles_str;
+    unsigned long max_cycles = MAX_SIM_CYCLES;
+    std::string perf_report_file;
+    std::string uart_log_file;
+    std::string phase_lut_file;
+    std::string pdm_file;
+    bool firmware_elf = false;
+
+    // Boot mode: the firmware is always loaded through the SRAM backdoor
+    boot_mode_str = getCmdOption(argc, argv, "+boot_mode=");
+    if (!boot_mode_str.empty() && boot_mode_str != "force" && boot_mode_str != "2") {
+        VP_WARN("Boot mode '%s' is not modelled. Using 'force'", boot_mode_str.c_str());
+    }
+
+    // Firmware HEX or ELF file
+    firmware_file = getCmdOption(argc, argv, "+firmware=");
+    if (firmware_file.empty()) {
+        VP_ERR("No firmware file specified");
+        exit(EXIT_FAILURE);
+    }
+    FILE *fp = fopen(firmware_file.c_str(), "rb");
+    if (fp == NULL) {
+        VP_ERR("Cannot open firmware file '%s': %s", firmware_file.c_str(), strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    char magic[4] = {0};
+    firmware_elf = fread(magic, 1, 4, fp) == 4 && memcmp(magic, "\177ELF", 4) == 0;
+    fclose(fp);
+
+    // Max simulation cycles
+    max_cycles_str = getCmdOption(argc, argv, "+max_cycles=");
+    if (!max_cycles_str.empty()) {
+        max_cycles = std::stoul(max_cycles_str);
+    }
+
+    // Output files and models
+    perf_report_file = getCmdOption(argc, argv, "+perf_report=");
+    uart_log_file = getCmdOption(argc, argv, "+uart_log=");
+    if (uart_log_file.empty()) uart_log_file = UART_LOG_FILENAME;
+    phase_lut_file = getCmdOption(argc, argv, "+phase_lut=");
+    if (phase_lut_file.empty()) phase_lut_file = PHASE_LUT_FILENAME;
+    pdm_file = getCmdOption(argc, argv, "+pdm_file=");
+    if (pdm_file.empty()) pdm_file = PDM_DUMMY_FILENAME;
+
+    // ΔΣ bitstream source
+    if (!dsm_source.open(getCmdOption(argc, argv, "+dsm_source="))) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Platform initialization
+    // -----------------------
+    // SRAM (contiguous banks of the same size)
+    VpBus bus(RAM0_START_ADDRESS, MEMORY_BANKS * (RAM0_END_ADDRESS - RAM0_START_ADDRESS));
+    VpCpu cpu(&bus);
+
+    // X-HEEP peripherals
+    VpFastIntrCtrl fic;
+    VpSocCtrl soc_ctrl;
+    VpUart uart;
+    VpRvTimer rv_timer_ao("rv_timer_ao", &fic, -1, VP_FIC_TIMER_1);
+    VpRvTimer rv_timer("rv_timer", &fic, VP_FIC_TIMER_2, VP_FIC_TIMER_3);
+    VpGpio gpio_ao(&fic);
+    VpDma dma(&fic);
+    VpPlic plic;
+    VpRegFile power_manager("power_manager");
+    VpRegFile pad_control("pad_control");
+    VpRegFile spi_flash("spi_flash");
+    VpRegFile spi_memio("spi_memio");
+    if (!uart.open(uart_log_file)) exit(EXIT_FAILURE);
+
+    // HEEPidermis peripherals
+    VpDsmInput dsm_input;
+    VpIdacCtrl idac_ctrl(&dma);
+    VpVcoDecoder vco_decoder(&idac_ctrl, &dma);
+    VpSesFilter ses_filter(&dsm_input);
+    VpCic cic(&dsm_input, &ses_filter);
+    VpDsmDecimation dsm_decimation(&ses_filter, &cic);
+    VpDmaTriggerOr adc_rx_slot(&vco_decoder, &dsm_decimation);
+    VpDlc dlc;
+    VpRegFile amux_ctrl("amux_ctrl");
+    VpRegFile refs_ctrl("refs_ctrl");
+    VpIrqCtrl irq_ctrl(&ses_filter, &cic, &dlc, &plic);
+    if (!vco_decoder.loadPhaseLut(phase_lut_file)) exit(EXIT_FAILURE);
+    if (!dsm_input.open(&dsm_source, pdm_file)) exit(EXIT_FAILURE);
+    dma.setFifo(&dlc);
+    dma.setRxLevel(&adc_rx_slot);
+    idac_ctrl.setIrqCtrl(&irq_ctrl);
+    dlc.setIdacCtrl(&idac_ctrl);
+
+    // Address map (core_v_mini_mcu.h and cheep.h)
+    bus.attach(&fic, FAST_INTR_CTRL_START_ADDRESS, FAST_INTR_CTRL_SIZE);
+    bus.attach(&soc_ctrl, SOC_CTRL_START_ADDRESS, SOC_CTRL_SIZE);
+    bus.attach(&spi_flash, SPI_FLASH_START_ADDRESS, SPI_FLASH_SIZE);
+    bus.attach(&spi_memio, SPI_MEMIO_START_ADDRESS, SPI_MEMIO_SIZE);
+    bus.attach(&dma, DMA_START_ADDRESS, DMA_SIZE);
+    bus.attach(&power_manager, POWER_MANAGER_START_ADDRESS, POWER_MANAGER_SIZE);
+    bus.attach(&rv_timer_ao, RV_TIMER_AO_START_ADDRESS, RV_TIMER_AO_SIZE);
+    bus.attach(&pad_control, PAD_CONTROL_START_ADDRESS, PAD_CONTROL_SIZE);
+    bus.attach(&gpio_ao, GPIO_AO_START_ADDRESS, GPIO_AO_SIZE);
+    bus.attach(&uart, UART_START_ADDRESS, UART_SIZE);
+    bus.attach(&rv_timer, RV_TIMER_START_ADDRESS, RV_TIMER_SIZE);
+    bus.attach(&plic, RV_PLIC_START_ADDRESS, RV_PLIC_SIZE);
+    bus.attach(&idac_ctrl, IDAC_CTRL_START_ADDRESS, IDAC_CTRL_SIZE);
+    bus.attach(&vco_decoder, VCO_DECODER_START_ADDRESS, VCO_DECODER_SIZE);
+    bus.attach(&ses_filter, SES_FILTER_START_ADDRESS, SES_FILTER_SIZE);
+    bus.attach(&amux_ctrl, AMUX_CTRL_START_ADDRESS, AMUX_CTRL_SIZE);
+    bus.attach(&refs_ctrl, REFS_CTRL_START_ADDRESS, REFS_CTRL_SIZE);
+    bus.attach(&dlc, DLC_START_ADDRESS, DLC_SIZE);
+    bus.attach(&cic, CIC_START_ADDRESS, CIC_SIZE);
+    bus.attach(&irq_ctrl, IRQ_CTRL_START_ADDRESS, IRQ_CTRL_SIZE);
+
+    // Print platform configuration
+    // ----------------------------
+    VP_CONFIG("Log level set to %u", vp_log_lvl);
+    if (!perf_report_file.empty()) {
+        VP_CONFIG("Performance report: %s", perf_report_file.c_str());
+    }
+    VP_CONFIG("Max simulation cycles set to %lu", max_cycles);
+    VP_CONFIG("Firmware: %s", firmware_file.c_str());
+    VP_CONFIG("VCO phase table: %s", phase_lut_file.c_str());
+    dsm_source.printConfig();
+
+    // RUN SIMULATION
+    // --------------
+    VP_LOG(LOG_MEDIUM, "Starting simulation");
+    TbPerf perf;
+    perf.startRun(firmware_file);
+    perf.startReset();
+    bus.now = RESET_CYCLES;
+    vp_log_cycle = bus.now;
+    perf.endReset(RESET_CYCLES);
+
+    // Load the firmware through the SRAM backdoor
+    VP_LOG(LOG_LOW, "Loading firmware...");
+    uint32_t entry = BOOT_ADDRESS;
+    if (firmware_elf) {
+        if (!bus.loadElf(firmware_file, &entry)) exit(EXIT_FAILURE);
+    } else {
+        if (!bus.loadHex(firmware_file)) exit(EXIT_FAILURE);
+    }
+    cpu.reset(entry);
+    VP_LOG(LOG_LOW, "Firmware loaded. Running app from 0x%08x...", entry);
+    perf.endLoad();
+
+    // Run until the firmware exits. While the CPU sleeps, the time jumps to
+    // the next device event.
+    uint64_t sleep_cycles = 0;
+    while (!soc_ctrl.getExitValid() && bus.now < max_cycles && !dsm_input.isStopped()) {
+        if (bus.now >= bus.next_event) bus.sync();
+        unsigned int cycles = cpu.step();
+        if (cycles == 0) {
+            if (bus.next_event == VP_NEVER) {
+                VP_ERR("The CPU is waiting for an interrupt, but no event is pending (pc 0x%08x)", cpu.getPc());
+                break;
+            }
+            uint64_t wake = bus.next_event < max_cycles ? bus.next_event : max_cycles;
+            sleep_cycles += wake - bus.now;
+            bus.now = wake;
+        } else {
+            bus.now += cycles;
+        }
+        vp_log_cycle = bus.now;
+    }
+    if (bus.now >= max_cycles) {
+        VP_WARN("Max simulation cycles reached");
+    }
+
+    // Print simulation status
+    VP_LOG(LOG_LOW, "Simulation complete");
+    perf.endRun(bus.now, sleep_cycles);
+    VP_LOG(LOG_MEDIUM, "Instructions retired: %lu", cpu.getInstret());
+    VP_LOG(LOG_MEDIUM, "Peripheral accesses: %lu reads, %lu writes", bus.dev_reads, bus.dev_writes);
+    VP_LOG(LOG_MEDIUM, "DMA elements: %lu, dLC level crossings: %lu", dma.elements, dlc.getCrossings());
+
+    // Print simulation performance
+    perf.setExit(soc_ctrl.getExitValid(), soc_ctrl.getExitValue());
+    perf.print();
+    if (!perf_report_file.empty()) perf.write(perf_report_file);
+
+    // Check exit value
+    if (soc_ctrl.getExitValid()) {
+        VP_LOG(LOG_LOW, "Exit value: %d", soc_ctrl.getExitValue());
+        exit_val = soc_ctrl.getExitValue();
+    } else {
+        VP_ERR("No exit value detected");
+        exit_val = EXIT_FAILURE;
+    }
+
+    if (no_err) exit(EXIT_SUCCESS);
+    exit(exit_val);
+}
+
+std::string getCmdOption(int argc, char* argv[], const std::string& option)
+{
+    std::string cmd;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find(option) == 0) {
+            cmd = arg.substr(option.length());
+        }
+    }
+    return cmd;
+}
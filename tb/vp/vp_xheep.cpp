@@ -0,0 +1,911 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_xheep.cpp
+// Description: Transaction-level models of the X-HEEP peripherals used by the
+//              HEEPidermis firmware
+
+#include <cerrno>
+#include <cstring>
+
+#include "vp_xheep.hh"
+#include "vp_log.hh"
+
+#include "soc_ctrl_regs.h"
+#include "uart_regs.h"
+#include "rv_timer_regs.h"
+#include "fast_intr_ctrl_regs.h"
+#include "rv_plic_regs.h"
+#include "gpio_regs.h"
+#include "dma_regs.h"
+#include "core_v_mini_mcu.h"
+
+// Cycles taken by the DMA to move one element
+#define VP_DMA_ELEM_CYCLES 2
+
+// UART status when idle (TX and RX FIFOs empty)
+#define VP_UART_STATUS_IDLE 0x3c
+
+// ------------------------------------------------------------------------
+// Plain register storage
+// ------------------------------------------------------------------------
+
+VpRegFile::VpRegFile(const char *name) : VpDevice(name)
+{
+    this->warned = false;
+}
+
+uint32_t VpRegFile::read(uint32_t off)
+{
+    return this->regs[off];
+}
+
+void VpRegFile::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    if (!this->warned) {
+        VP_WARN("%s is not modelled: register writes are stored but have no effect", this->name);
+        this->warned = true;
+    }
+    this->regs[off] = vpMerge(this->regs[off], data, mask);
+}
+
+// ------------------------------------------------------------------------
+// SoC control
+// ------------------------------------------------------------------------
+
+VpSocCtrl::VpSocCtrl() : VpDevice("soc_ctrl")
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[SOC_CTRL_BOOT_ADDRESS_REG_OFFSET / 4] = 0x180;
+    this->regs[SOC_CTRL_USE_SPIMEMIO_REG_OFFSET / 4] = 1;
+    this->regs[SOC_CTRL_SYSTEM_FREQUENCY_HZ_REG_OFFSET / 4] = 1;
+}
+
+uint32_t VpSocCtrl::read(uint32_t off)
+{
+    if (off >= sizeof(this->regs)) return 0;
+    return this->regs[off / 4];
+}
+
+void VpSocCtrl::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    if (off >= sizeof(this->regs)) return;
+    this->regs[off / 4] = vpMerge(this->regs[off / 4], data, mask);
+    if (off == SOC_CTRL_EXIT_VALID_REG_OFFSET && (data & mask & 1)) {
+        VP_LOG(LOG_MEDIUM, "Exit valid (value %d)", (int)this->regs[SOC_CTRL_EXIT_VALUE_REG_OFFSET / 4]);
+    }
+}
+
+bool VpSocCtrl::getExitValid()
+{
+    return this->regs[SOC_CTRL_EXIT_VALID_REG_OFFSET / 4] & 1;
+}
+
+int VpSocCtrl::getExitValue()
+{
+    return this->regs[SOC_CTRL_EXIT_VALUE_REG_OFFSET / 4];
+}
+
+// ------------------------------------------------------------------------
+// UART
+// ------------------------------------------------------------------------
+
+VpUart::VpUart() : VpDevice("uart")
+{
+    this->log = NULL;
+    this->ctrl = 0;
+}
+
+VpUart::~VpUart()
+{
+    if (this->log != NULL) fclose(this->log);
+}
+
+bool VpUart::open(const std::string& filename)
+{
+    this->log = fopen(filename.c_str(), "w");
+    if (this->log == NULL) {
+        VP_ERR("Cannot open UART log file '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+uint32_t VpUart::read(uint32_t off)
+{
+    switch (off) {
+    case UART_CTRL_REG_OFFSET:
+        return this->ctrl;
+    case UART_STATUS_REG_OFFSET:
+        return VP_UART_STATUS_IDLE;
+    default:
+        return 0;
+    }
+}
+
+void VpUart::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    switch (off) {
+    case UART_CTRL_REG_OFFSET:
+        this->ctrl = vpMerge(this->ctrl, data, mask);
+        break;
+    case UART_WDATA_REG_OFFSET:
+        if (this->log != NULL) {
+            fputc(data & 0xff, this->log);
+            fflush(this->log);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// ------------------------------------------------------------------------
+// Fast interrupt controller
+// ------------------------------------------------------------------------
+
+VpFastIntrCtrl::VpFastIntrCtrl() : VpDevice("fast_intr_ctrl")
+{
+    this->pending = 0;
+    this->enable = 0x7fff;
+    this->levels = 0;
+}
+
+void VpFastIntrCtrl::event(uint16_t pulses, uint16_t clear)
+{
+    // The RTL rewrites the whole pending register whenever a line is asserted
+    // or a clear is requested, and holds it otherwise. A clear lasts one cycle,
+    // so the asserted level lines are pending again right after it.
+    if ((this->levels | pulses | clear) != 0) {
+        this->pending = (this->levels | pulses) & this->enable & ~clear;
+        if (clear != 0 && this->levels != 0) this->pending = this->levels & this->enable;
+    }
+    for (unsigned int i = 0; i < 16; i++) {
+        this->bus->setIrq(16 + i, (this->pending >> i) & 1);
+    }
+}
+
+uint32_t VpFastIntrCtrl::read(uint32_t off)
+{
+    switch (off) {
+    case FAST_INTR_CTRL_FAST_INTR_PENDING_REG_OFFSET:
+        return this->pending;
+    case FAST_INTR_CTRL_FAST_INTR_ENABLE_REG_OFFSET:
+        return this->enable;
+    default:
+        return 0;
+    }
+}
+
+void VpFastIntrCtrl::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    switch (off) {
+    case FAST_INTR_CTRL_FAST_INTR_CLEAR_REG_OFFSET:
+        if ((data & mask & 0xffff) != 0) this->event(0, data & mask);
+        break;
+    case FAST_INTR_CTRL_FAST_INTR_ENABLE_REG_OFFSET:
+        this->enable = vpMerge(this->enable, data, mask);
+        this->event(0, 0);
+        break;
+    default:
+        break;
+    }
+}
+
+void VpFastIntrCtrl::setLine(unsigned int line, bool level)
+{
+    uint16_t prev = this->levels;
+    if (level) this->levels |= 1u << line;
+    else this->levels &= ~(1u << line);
+    if (this->levels != prev) this->event(0, 0);
+}
+
+void VpFastIntrCtrl::pulse(unsigned int line)
+{
+    this->event(1u << line, 0);
+}
+
+// ------------------------------------------------------------------------
+// PLIC
+// ------------------------------------------------------------------------
+
+VpPlic::VpPlic() : VpDevice("rv_plic")
+{
+    this->src = 0;
+    this->ip = 0;
+    this->le = 0;
+    this->ie = 0;
+    this->claimed = 0;
+    memset(this->prio, 0, sizeof(this->prio));
+    this->threshold = 0;
+    this->msip = false;
+}
+
+unsigned int VpPlic::best()
+{
+    // Highest priority pending and enabled source (lowest ID first), 0 if none
+    uint64_t pending = this->ip & this->ie;
+    unsigned int id = 0;
+    for (unsigned int i = 1; i < VP_PLIC_NUM_SRC; i++) {
+        if (((pending >> i) & 1) && this->prio[i] > this->prio[id]) id = i;
+    }
+    return id;
+}
+
+void VpPlic::event(uint64_t rise)
+{
+    // Gateways: level sources are pending while asserted, edge sources from
+    // their rising edge. Claimed sources wait for the completion.
+    this->ip |= ((this->src & ~this->le) | (rise & this->le)) & ~this->claimed;
+    unsigned int id = this->best();
+    this->bus->setIrq(VP_IRQ_EXTERNAL, id != 0 && this->prio[id] > this->threshold);
+    this->bus->setIrq(VP_IRQ_SOFTWARE, this->msip);
+}
+
+uint32_t VpPlic::read(uint32_t off)
+{
+    if (off >= RV_PLIC_PRIO0_REG_OFFSET && off < RV_PLIC_PRIO0_REG_OFFSET + 4 * VP_PLIC_NUM_SRC) {
+        return this->prio[(off - RV_PLIC_PRIO0_REG_OFFSET) / 4];
+    }
+    switch (off) {
+    case RV_PLIC_IP_0_REG_OFFSET: return (uint32_t) this->ip;
+    case RV_PLIC_IP_1_REG_OFFSET: return (uint32_t)(this->ip >> 32);
+    case RV_PLIC_LE_0_REG_OFFSET: return (uint32_t) this->le;
+    case RV_PLIC_LE_1_REG_OFFSET: return (uint32_t)(this->le >> 32);
+    case RV_PLIC_IE0_0_REG_OFFSET: return (uint32_t) this->ie;
+    case RV_PLIC_IE0_1_REG_OFFSET: return (uint32_t)(this->ie >> 32);
+    case RV_PLIC_THRESHOLD0_REG_OFFSET: return this->threshold;
+    case RV_PLIC_MSIP0_REG_OFFSET: return this->msip;
+    case RV_PLIC_CC0_REG_OFFSET: {
+        // Claim
+        unsigned int id = this->best();
+        this->ip &= ~(1ull << id);
+        if (id != 0) this->claimed |= 1ull << id;
+        this->event(0);
+        return id;
+    }
+    default:
+        return 0;
+    }
+}
+
+void VpPlic::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    if (off >= RV_PLIC_PRIO0_REG_OFFSET && off < RV_PLIC_PRIO0_REG_OFFSET + 4 * VP_PLIC_NUM_SRC) {
+        uint8_t *p = &this->prio[(off - RV_PLIC_PRIO0_REG_OFFSET) / 4];
+        *p = vpMerge(*p, data, mask) & RV_PLIC_PRIO0_PRIO0_MASK;
+        this->event(0);
+        return;
+    }
+    switch (off) {
+    case RV_PLIC_LE_0_REG_OFFSET:
+        this->le = (this->le & ~0xffffffffull) | vpMerge((uint32_t) this->le, data, mask);
+        break;
+    case RV_PLIC_LE_1_REG_OFFSET:
+        this->le = (this->le & 0xffffffffull) | ((uint64_t) vpMerge(this->le >> 32, data, mask) << 32);
+        break;
+    case RV_PLIC_IE0_0_REG_OFFSET:
+        this->ie = (this->ie & ~0xffffffffull) | vpMerge((uint32_t) this->ie, data, mask);
+        break;
+    case RV_PLIC_IE0_1_REG_OFFSET:
+        this->ie = (this->ie & 0xffffffffull) | ((uint64_t) vpMerge(this->ie >> 32, data, mask) << 32);
+        break;
+    case RV_PLIC_THRESHOLD0_REG_OFFSET:
+        this->threshold = vpMerge(this->threshold, data, mask) & RV_PLIC_THRESHOLD0_THRESHOLD0_MASK;
+        break;
+    case RV_PLIC_MSIP0_REG_OFFSET:
+        this->msip = vpMerge(this->msip, data, mask) & 1;
+        break;
+    case RV_PLIC_CC0_REG_OFFSET:
+        // Completion
+        if ((data & mask) < VP_PLIC_NUM_SRC) this->claimed &= ~(1ull << (data & mask));
+        break;
+    default:
+        return;
+    }
+    this->event(0);
+}
+
+void VpPlic::setSource(unsigned int id, bool level)
+{
+    if (id == 0 || id >= VP_PLIC_NUM_SRC) return;
+    uint64_t prev = this->src;
+    if (level) this->src |= 1ull << id;
+    else this->src &= ~(1ull << id);
+    if (this->src != prev) this->event(this->src & ~prev);
+}
+
+// ------------------------------------------------------------------------
+// RISC-V timer
+// ------------------------------------------------------------------------
+
+VpRvTimer::VpRvTimer(const char *name, VpFastIntrCtrl *fic, int irq0, int irq1) : VpDevice(name)
+{
+    for (unsigned int h = 0; h < 2; h++) {
+        this->hart[h].active = false;
+        this->hart[h].prescaler = 0;
+        this->hart[h].step = 1;
+        this->hart[h].mtime = 0;
+        this->hart[h].t_base = 0;
+        this->hart[h].mtimecmp = UINT64_MAX;
+        this->hart[h].intr_enable = false;
+        this->hart[h].intr_state = false;
+    }
+    this->hart[0].irq = irq0;
+    this->hart[1].irq = irq1;
+    this->fic = fic;
+}
+
+uint64_t VpRvTimer::getMtime(unsigned int h, uint64_t t)
+{
+    Hart *p = &this->hart[h];
+    if (!p->active) return p->mtime;
+    return p->mtime + (uint64_t)p->step * ((t - p->t_base) / (p->prescaler + 1));
+}
+
+void VpRvTimer::rebase(unsigned int h, uint64_t t)
+{
+    // Keep the prescaler phase when the configuration changes
+    Hart *p = &this->hart[h];
+    if (!p->active) return;
+    p->mtime = this->getMtime(h, t);
+    p->t_base = t - (t - p->t_base) % (p->prescaler + 1);
+}
+
+void VpRvTimer::check(unsigned int h, uint64_t t)
+{
+    Hart *p = &this->hart[h];
+    if (p->active && this->getMtime(h, t) >= p->mtimecmp) p->intr_state = true;
+    this->updateIrq(h);
+}
+
+void VpRvTimer::updateIrq(unsigned int h)
+{
+    Hart *p = &this->hart[h];
+    bool level = p->intr_state && p->intr_enable;
+    if (p->irq < 0) this->bus->setIrq(VP_IRQ_TIMER, level);
+    else this->fic->setLine(p->irq, level);
+}
+
+uint32_t VpRvTimer::read(uint32_t off)
+{
+    uint64_t t = this->bus->time();
+    if (off == RV_TIMER_CTRL_REG_OFFSET) {
+        return this->hart[0].active | (this->hart[1].active << 1);
+    }
+    unsigned int h = (off >> 8) - 1;
+    if (h > 1) return 0;
+    Hart *p = &this->hart[h];
+    switch (off & 0xff) {
+    case RV_TIMER_CFG0_REG_OFFSET & 0xff:
+        return p->prescaler | (p->step << 16);
+    case RV_TIMER_TIMER_V_LOWER0_REG_OFFSET & 0xff:
+        return this->getMtime(h, t);
+    case RV_TIMER_TIMER_V_UPPER0_REG_OFFSET & 0xff:
+        return this->getMtime(h, t) >> 32;
+    case RV_TIMER_COMPARE_LOWER0_0_REG_OFFSET & 0xff:
+        return p->mtimecmp;
+    case RV_TIMER_COMPARE_UPPER0_0_REG_OFFSET & 0xff:
+        return p->mtimecmp >> 32;
+    case RV_TIMER_INTR_ENABLE0_REG_OFFSET & 0xff:
+        return p->intr_enable;
+    case RV_TIMER_INTR_STATE0_REG_OFFSET & 0xff:
+        return p->intr_state;
+    default:
+        return 0;
+    }
+}
+
+void VpRvTimer::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    uint64_t t = this->bus->time();
+    if (off == RV_TIMER_CTRL_REG_OFFSET) {
+        for (unsigned int h = 0; h < 2; h++) {
+            if (!((mask >> h) & 1)) continue;
+            bool active = (data >> h) & 1;
+            if (active == this->hart[h].active) continue;
+            this->rebase(h, t);
+            this->hart[h].active = active;
+            this->hart[h].t_base = t;
+            this->check(h, t);
+        }
+        return;
+    }
+    unsigned int h = (off >> 8) - 1;
+    if (h > 1) return;
+    Hart *p = &this->hart[h];
+    uint32_t val;
+    switch (off & 0xff) {
+    case RV_TIMER_CFG0_REG_OFFSET & 0xff:
+        this->rebase(h, t);
+        val = vpMerge(p->prescaler | (p->step << 16), data, mask);
+        p->prescaler = val & RV_TIMER_CFG0_PRESCALE_MASK;
+        p->step = (val >> RV_TIMER_CFG0_STEP_OFFSET) & RV_TIMER_CFG0_STEP_MASK;
+        break;
+    case RV_TIMER_TIMER_V_LOWER0_REG_OFFSET & 0xff:
+        this->rebase(h, t);
+        p->mtime = (p->mtime & ~0xffffffffull) | vpMerge(p->mtime, data, mask);
+        break;
+    case RV_TIMER_TIMER_V_UPPER0_REG_OFFSET & 0xff:
+        this->rebase(h, t);
+        p->mtime = (p->mtime & 0xffffffffull) | ((uint64_t)vpMerge(p->mtime >> 32, data, mask) << 32);
+        break;
+    case RV_TIMER_COMPARE_LOWER0_0_REG_OFFSET & 0xff:
+    case RV_TIMER_COMPARE_UPPER0_0_REG_OFFSET & 0xff:
+        if ((off & 0xff) == (RV_TIMER_COMPARE_LOWER0_0_REG_OFFSET & 0xff)) {
+            p->mtimecmp = (p->mtimecmp & ~0xffffffffull) | vpMerge(p->mtimecmp, data, mask);
+        } else {
+            p->mtimecmp = (p->mtimecmp & 0xffffffffull) | ((uint64_t)vpMerge(p->mtimecmp >> 32, data, mask) << 32);
+        }
+        // A compare update clears the interrupt state. The RTL uses the hart 0
+        // compare registers for both harts.
+        if (h == 0) {
+            this->hart[0].intr_state = false;
+            this->hart[1].intr_state = false;
+            this->check(1, t);
+        }
+        break;
+    case RV_TIMER_INTR_ENABLE0_REG_OFFSET & 0xff:
+        p->intr_enable = vpMerge(p->intr_enable, data, mask) & 1;
+        break;
+    case RV_TIMER_INTR_STATE0_REG_OFFSET & 0xff:
+        if (data & mask & 1) p->intr_state = false;
+        break;
+    case RV_TIMER_INTR_TEST0_REG_OFFSET & 0xff:
+        if (data & mask & 1) p->intr_state = true;
+        break;
+    default:
+        break;
+    }
+    this->check(h, t);
+}
+
+void VpRvTimer::update(uint64_t t)
+{
+    this->check(0, t);
+    this->check(1, t);
+}
+
+uint64_t VpRvTimer::nextEvent()
+{
+    uint64_t next = VP_NEVER;
+    for (unsigned int h = 0; h < 2; h++) {
+        Hart *p = &this->hart[h];
+        if (!p->active || p->intr_state || p->step == 0) continue;
+        if (p->mtime >= p->mtimecmp) return p->t_base;
+
+        // Ticks left until the comparator matches
+        uint64_t ticks = (p->mtimecmp - p->mtime + p->step - 1) / p->step;
+        if (ticks > (VP_NEVER - p->t_base) / (p->prescaler + 1)) continue;
+        uint64_t t = p->t_base + ticks * (p->prescaler + 1);
+        if (t < next) next = t;
+    }
+    return next;
+}
+
+// ------------------------------------------------------------------------
+// GPIO
+// ------------------------------------------------------------------------
+
+VpGpio::VpGpio(VpFastIntrCtrl *fic) : VpDevice("gpio_ao")
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[GPIO_INFO_REG_OFFSET / 4] = GPIO_PARAM_G_P_I_O_COUNT;
+    this->fic = fic;
+}
+
+void VpGpio::setOut(uint32_t out)
+{
+    // Output pins are read back as inputs
+    uint32_t drive = 0;
+    for (unsigned int i = 0; i < 32; i++) {
+        uint32_t mode = this->regs[GPIO_GPIO_MODE_0_REG_OFFSET / 4 + i / 16] >> ((i % 16) * 2);
+        if ((mode & 3) != GPIO_GPIO_MODE_0_MODE_0_VALUE_INPUT_ONLY) drive |= 1u << i;
+    }
+    uint32_t in_prev = this->regs[GPIO_GPIO_IN_REG_OFFSET / 4];
+    uint32_t in = (out & drive) | (in_prev & ~drive);
+    this->regs[GPIO_GPIO_OUT_REG_OFFSET / 4] = out;
+    this->regs[GPIO_GPIO_IN_REG_OFFSET / 4] = in;
+
+    // Interrupt detection on the sampled pins
+    uint32_t en = this->regs[GPIO_GPIO_EN_REG_OFFSET / 4];
+    uint32_t rise = in & ~in_prev & en & this->regs[GPIO_INTRPT_RISE_EN_REG_OFFSET / 4];
+    uint32_t fall = ~in & in_prev & en & this->regs[GPIO_INTRPT_FALL_EN_REG_OFFSET / 4];
+    uint32_t high = in & en & this->regs[GPIO_INTRPT_LVL_HIGH_EN_REG_OFFSET / 4];
+    uint32_t low = ~in & en & this->regs[GPIO_INTRPT_LVL_LOW_EN_REG_OFFSET / 4];
+    this->regs[GPIO_INTRPT_RISE_STATUS_REG_OFFSET / 4] |= rise;
+    this->regs[GPIO_INTRPT_FALL_STATUS_REG_OFFSET / 4] |= fall;
+    this->regs[GPIO_INTRPT_LVL_HIGH_STATUS_REG_OFFSET / 4] |= high;
+    this->regs[GPIO_INTRPT_LVL_LOW_STATUS_REG_OFFSET / 4] |= low;
+    this->regs[GPIO_INTRPT_STATUS_REG_OFFSET / 4] |= rise | fall | high | low;
+
+    uint32_t status = this->regs[GPIO_INTRPT_STATUS_REG_OFFSET / 4];
+    for (unsigned int i = 0; i < 8; i++) {
+        this->fic->setLine(VP_FIC_GPIO_0 + i, (status >> i) & 1);
+    }
+}
+
+uint32_t VpGpio::read(uint32_t off)
+{
+    if (off >= sizeof(this->regs)) return 0;
+    return this->regs[off / 4];
+}
+
+void VpGpio::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    if (off >= sizeof(this->regs)) return;
+    uint32_t out = this->regs[GPIO_GPIO_OUT_REG_OFFSET / 4];
+    data &= mask;
+    switch (off) {
+    case GPIO_INFO_REG_OFFSET:
+    case GPIO_GPIO_IN_REG_OFFSET:
+        return;
+    case GPIO_GPIO_SET_REG_OFFSET:
+        out |= data;
+        break;
+    case GPIO_GPIO_CLEAR_REG_OFFSET:
+        out &= ~data;
+        break;
+    case GPIO_GPIO_TOGGLE_REG_OFFSET:
+        out ^= data;
+        break;
+    case GPIO_INTRPT_STATUS_REG_OFFSET:
+        // Clearing the global status clears all the pin statuses
+        this->regs[GPIO_INTRPT_RISE_STATUS_REG_OFFSET / 4] &= ~data;
+        this->regs[GPIO_INTRPT_FALL_STATUS_REG_OFFSET / 4] &= ~data;
+        this->regs[GPIO_INTRPT_LVL_HIGH_STATUS_REG_OFFSET / 4] &= ~data;
+        this->regs[GPIO_INTRPT_LVL_LOW_STATUS_REG_OFFSET / 4] &= ~data;
+        this->regs[off / 4] &= ~data;
+        break;
+    case GPIO_INTRPT_RISE_STATUS_REG_OFFSET:
+    case GPIO_INTRPT_FALL_STATUS_REG_OFFSET:
+    case GPIO_INTRPT_LVL_HIGH_STATUS_REG_OFFSET:
+    case GPIO_INTRPT_LVL_LOW_STATUS_REG_OFFSET:
+        this->regs[off / 4] &= ~data;
+        this->regs[GPIO_INTRPT_STATUS_REG_OFFSET / 4] =
+            this->regs[GPIO_INTRPT_RISE_STATUS_REG_OFFSET / 4] | this->regs[GPIO_INTRPT_FALL_STATUS_REG_OFFSET / 4] |
+            this->regs[GPIO_INTRPT_LVL_HIGH_STATUS_REG_OFFSET / 4] | this->regs[GPIO_INTRPT_LVL_LOW_STATUS_REG_OFFSET / 4];
+        break;
+    case GPIO_GPIO_OUT_REG_OFFSET:
+        out = vpMerge(out, data, mask);
+        break;
+    default:
+        this->regs[off / 4] = vpMerge(this->regs[off / 4], data, mask);
+        break;
+    }
+    this->setOut(out);
+}
+
+uint32_t VpGpio::getOut()
+{
+    return this->regs[GPIO_GPIO_OUT_REG_OFFSET / 4];
+}
+
+// ------------------------------------------------------------------------
+// Counter trigger
+// ------------------------------------------------------------------------
+
+VpCounterTrigger::VpCounterTrigger()
+{
+    this->reset(0);
+}
+
+void VpCounterTrigger::reset(uint64_t t)
+{
+    this->limit = 0;
+    this->t0 = t;
+    this->manual_at = VP_NEVER;
+}
+
+void VpCounterTrigger::setLimit(uint32_t limit, uint64_t t)
+{
+    // The counter is held at 0 while the limit is 0
+    if (this->limit == 0) this->t0 = t;
+    this->limit = limit;
+}
+
+void VpCounterTrigger::setManual(uint64_t t)
+{
+    this->manual_at = t + 1;
+}
+
+uint64_t VpCounterTrigger::next(uint64_t t)
+{
+    uint64_t next = this->manual_at;
+    if (this->limit != 0) {
+        // The counter wraps around when the limit is lowered below its value
+        uint64_t elapsed = t > this->t0 ? t - this->t0 : 0;
+        uint64_t at = this->t0 + this->limit;
+        if (elapsed > this->limit) at += 1ull << 32;
+        if (at < next) next = at;
+    }
+    return next;
+}
+
+void VpCounterTrigger::fire(uint64_t t)
+{
+    this->t0 = t + 1;
+    if (this->manual_at <= t) this->manual_at = VP_NEVER;
+}
+
+// ------------------------------------------------------------------------
+// DMA
+// ------------------------------------------------------------------------
+
+#define CH_REG(c, name) (this->ch[c].regs[DMA_##name##_REG_OFFSET / 4])
+
+// Element size of a DMA data type, in bytes
+static unsigned int dmaDataSize(uint32_t type)
+{
+    static const unsigned int size[4] = {4, 2, 1, 1};
+    return size[type & 3];
+}
+
+VpDma::VpDma(VpFastIntrCtrl *fic) : VpDevice("dma")
+{
+    for (unsigned int c = 0; c < VP_DMA_CH_NUM; c++) {
+        memset(&this->ch[c], 0, sizeof(Channel));
+        CH_REG(c, SRC_PTR_INC_D1) = 4;
+        CH_REG(c, SRC_PTR_INC_D2) = 4;
+        CH_REG(c, DST_PTR_INC_D1) = 4;
+        CH_REG(c, DST_PTR_INC_D2) = 4;
+        this->ch[c].next_at = VP_NEVER;
+    }
+    this->fic = fic;
+    this->fifo = NULL;
+    this->rx_level = NULL;
+    this->elements = 0;
+}
+
+void VpDma::setFifo(VpDmaFifo *fifo)
+{
+    this->fifo = fifo;
+}
+
+void VpDma::setRxLevel(VpDmaTrigger *trigger)
+{
+    this->rx_level = trigger;
+}
+
+void VpDma::triggerRx(unsigned int c)
+{
+    Channel *p = &this->ch[c];
+    if (!p->busy || !(CH_REG(c, SLOT) & 0xffff)) return;
+    p->rx_pulses++;
+    if (p->next_at == VP_NEVER) p->next_at = this->bus->time();
+}
+
+void VpDma::triggerTx(unsigned int c)
+{
+    Channel *p = &this->ch[c];
+    if (!p->busy || !(CH_REG(c, SLOT) >> 16)) return;
+    p->tx_pulses++;
+    if (p->next_at == VP_NEVER) p->next_at = this->bus->time();
+}
+
+void VpDma::start(unsigned int c, uint64_t t)
+{
+    Channel *p = &this->ch[c];
+    uint32_t mode = CH_REG(c, MODE) & 3;
+    if (mode == DMA_MODE_MODE_VALUE_ADDRESS_MODE) {
+        VP_WARN("DMA channel %u: address mode is not supported", c);
+    }
+    if (CH_REG(c, DIM_INV) & 1 || CH_REG(c, PAD_TOP) || CH_REG(c, PAD_BOTTOM) || CH_REG(c, PAD_LEFT) ||
+        CH_REG(c, PAD_RIGHT)) {
+        VP_WARN("DMA channel %u: padding and transposition are not supported", c);
+    }
+    p->busy = true;
+    p->src = CH_REG(c, SRC_PTR);
+    p->dst = CH_REG(c, DST_PTR);
+    p->d1 = CH_REG(c, SIZE_D1) & 0xffff;
+    p->d2 = (CH_REG(c, DIM_CONFIG) & 1) ? CH_REG(c, SIZE_D2) & 0xffff : 1;
+    p->rx_pulses = 0;
+    p->tx_pulses = 0;
+    if (mode != DMA_MODE_MODE_VALUE_CIRCULAR_MODE) p->window_count = 0;
+    if (c == 0 && (CH_REG(c, HW_FIFO_EN) & 1) && this->fifo != NULL) this->fifo->flush();
+    p->next_at = t + VP_DMA_ELEM_CYCLES;
+    VP_LOG(LOG_HIGH, "DMA channel %u: start (%u x %u elements)", c, p->d1, p->d2);
+
+    // Memory-to-memory copies without triggers nor windows are done at once
+    if (CH_REG(c, SLOT) == 0 && !(CH_REG(c, HW_FIFO_EN) & 1) && (CH_REG(c, WINDOW_SIZE) & 0x1fff) == 0 &&
+        this->bus->isRam(p->src, 1) && this->bus->isRam(p->dst, 1)) {
+        uint32_t n = p->d1 * p->d2;
+        while (p->busy && p->d2 > 0) this->transfer(c);
+        p->next_at = t + (uint64_t)VP_DMA_ELEM_CYCLES * (n + 1);
+    }
+}
+
+bool VpDma::ready(unsigned int c, uint64_t t)
+{
+    Channel *p = &this->ch[c];
+    uint32_t slot_rx = CH_REG(c, SLOT) & 0xffff;
+    uint32_t slot_tx = CH_REG(c, SLOT) >> 16;
+    bool rx = slot_rx == 0 || p->rx_pulses > 0 ||
+              (c == 0 && (slot_rx & VP_DMA_SLOT_EXT_RX) && this->rx_level != NULL && this->rx_level->getLevel(t));
+    bool tx = slot_tx == 0 || p->tx_pulses > 0;
+    return rx && tx;
+}
+
+void VpDma::transfer(unsigned int c)
+{
+    Channel *p = &this->ch[c];
+    unsigned int src_size = dmaDataSize(CH_REG(c, SRC_DATA_TYPE));
+
+    // Read one element (sign-extended to the destination size if requested)
+    uint32_t data = 0;
+    if (!this->bus->read(p->src, src_size, &data)) {
+        VP_WARN("DMA channel %u: bus error reading 0x%08x", c, p->src);
+    }
+    if ((CH_REG(c, SIGN_EXT) & 1) && src_size < 4 && (data >> (src_size * 8 - 1)) & 1) {
+        data |= ~0u << (src_size * 8);
+    }
+    if (p->rx_pulses > 0) p->rx_pulses--;
+    if (p->tx_pulses > 0) p->tx_pulses--;
+    this->elements++;
+
+    // Write it, or process it through the hardware FIFO
+    if (c == 0 && (CH_REG(c, HW_FIFO_EN) & 1) && this->fifo != NULL) {
+        this->fifo->push(data);
+        while (this->fifo->pop(&data)) this->writeElement(c, data);
+    } else {
+        this->writeElement(c, data);
+    }
+
+    // Advance the source pointer; the rows of 2D transactions end with the
+    // second-dimension increment
+    if (--p->d1 == 0) {
+        p->d2--;
+        p->d1 = CH_REG(c, SIZE_D1) & 0xffff;
+        p->src += CH_REG(c, SRC_PTR_INC_D2) & 0x7fffff;
+        if (CH_REG(c, DIM_CONFIG) & 1) p->dst += (CH_REG(c, DST_PTR_INC_D2) & 0x7fffff) - (CH_REG(c, DST_PTR_INC_D1) & 0x3f);
+    } else {
+        p->src += CH_REG(c, SRC_PTR_INC_D1) & 0x3f;
+    }
+    if (CH_REG(c, MODE) == DMA_MODE_MODE_VALUE_SUBADDRESS_MODE) p->src = CH_REG(c, SRC_PTR);
+}
+
+void VpDma::writeElement(unsigned int c, uint32_t data)
+{
+    Channel *p = &this->ch[c];
+    if (!this->bus->write(p->dst, dmaDataSize(CH_REG(c, DST_DATA_TYPE)), data)) {
+        VP_WARN("DMA channel %u: bus error writing 0x%08x", c, p->dst);
+    }
+    p->dst += CH_REG(c, DST_PTR_INC_D1) & 0x3f;
+
+    // The window event fires on the write following window_size writes
+    uint32_t window_size = CH_REG(c, WINDOW_SIZE) & 0x1fff;
+    if (window_size != 0) {
+        if (p->window_count == window_size) {
+            p->window_count = 0;
+            if (CH_REG(c, INTERRUPT_EN) & 2) p->window_ifr = true;
+        } else {
+            p->window_count++;
+        }
+    }
+}
+
+void VpDma::finish(unsigned int c, uint64_t t)
+{
+    Channel *p = &this->ch[c];
+    p->busy = false;
+    p->next_at = VP_NEVER;
+    if (CH_REG(c, INTERRUPT_EN) & 1) p->transaction_ifr = true;
+    VP_LOG(LOG_HIGH, "DMA channel %u: done", c);
+
+    // Circular transactions restart immediately
+    if ((CH_REG(c, MODE) & 3) == DMA_MODE_MODE_VALUE_CIRCULAR_MODE) this->start(c, t);
+}
+
+void VpDma::updateIrq()
+{
+    bool done = false;
+    bool window = false;
+    for (unsigned int c = 0; c < VP_DMA_CH_NUM; c++) {
+        done |= this->ch[c].transaction_ifr;
+        window |= this->ch[c].window_ifr;
+    }
+    this->fic->setLine(VP_FIC_DMA_DONE, done);
+    this->fic->setLine(VP_FIC_DMA_WINDOW, window);
+}
+
+uint32_t VpDma::read(uint32_t off)
+{
+    unsigned int c = off / DMA_CH_SIZE;
+    if (c >= VP_DMA_CH_NUM) return 0;
+    Channel *p = &this->ch[c];
+    uint32_t val;
+    switch (off % DMA_CH_SIZE) {
+    case DMA_STATUS_REG_OFFSET:
+        return !p->busy;
+    case DMA_WINDOW_COUNT_REG_OFFSET:
+        return p->window_count & 0xff;
+    case DMA_TRANSACTION_IFR_REG_OFFSET:
+        // The interrupt flags are cleared on read
+        val = p->transaction_ifr;
+        if (CH_REG(c, INTERRUPT_EN) & 1) p->transaction_ifr = false;
+        this->updateIrq();
+        return val;
+    case DMA_WINDOW_IFR_REG_OFFSET:
+        val = p->window_ifr;
+        if (CH_REG(c, INTERRUPT_EN) & 2) p->window_ifr = false;
+        this->updateIrq();
+        return val;
+    default:
+        return p->regs[(off % DMA_CH_SIZE) / 4];
+    }
+}
+
+void VpDma::write(uint32_t off, uint32_t data, uint32_t mask)
+{
+    unsigned int c = off / DMA_CH_SIZE;
+    if (c >= VP_DMA_CH_NUM) return;
+    Channel *p = &this->ch[c];
+    uint32_t reg = off % DMA_CH_SIZE;
+    switch (reg) {
+    case DMA_STATUS_REG_OFFSET:
+    case DMA_WINDOW_COUNT_REG_OFFSET:
+    case DMA_TRANSACTION_IFR_REG_OFFSET:
+    case DMA_WINDOW_IFR_REG_OFFSET:
+        break;
+    case DMA_SIZE_D1_REG_OFFSET:
+        p->regs[reg / 4] = vpMerge(p->regs[reg / 4], data, mask);
+        if (!p->busy) this->start(c, this->bus->time());
+        break;
+    case DMA_WINDOW_SIZE_REG_OFFSET:
+        p->regs[reg / 4] = vpMerge(p->regs[reg / 4], data, mask);
+        if ((CH_REG(c, MODE) & 3) == DMA_MODE_MODE_VALUE_CIRCULAR_MODE) p->window_count = 0;
+        break;
+    default:
+        if (reg < sizeof(p->regs)) p->regs[reg / 4] = vpMerge(p->regs[reg / 4], data, mask);
+        break;
+    }
+    this->updateIrq();
+}
+
+void VpDma::update(uint64_t t)
+{
+    for (unsigned int c = 0; c < VP_DMA_CH_NUM; c++) {
+        Channel *p = &this->ch[c];
+        if (p->next_at > t) continue;
+
+        // All the elements have been moved (and, in hardware FIFO mode, the
+        // last packet has been written)
+        bool hw_fifo = c == 0 && (CH_REG(c, HW_FIFO_EN) & 1) && this->fifo != NULL;
+        if (hw_fifo ? this->fifo->done() : p->d2 == 0) {
+            this->finish(c, t);
+            continue;
+        }
+        if (p->d2 == 0) {
+            p->next_at = VP_NEVER;
+            continue;
+        }
+
+        // Wait for the trigger slots
+        if (!this->ready(c, t)) {
+            p->next_at = VP_NEVER;
+            continue;
+        }
+        this->transfer(c);
+        p->next_at = t + VP_DMA_ELEM_CYCLES;
+    }
+    this->updateIrq();
+}
+
+uint64_t VpDma::nextEvent()
+{
+    uint64_t next = VP_NEVER;
+    for (unsigned int c = 0; c < VP_DMA_CH_NUM; c++) {
+        Channel *p = &this->ch[c];
+        uint64_t t = p->next_at;
+
+        // A channel waiting for a level trigger wakes up when it is asserted
+        if (p->busy && t == VP_NEVER && c == 0 && this->rx_level != NULL &&
+            (CH_REG(c, SLOT) & VP_DMA_SLOT_EXT_RX)) {
+            uint64_t now = this->bus->time();
+            t = this->ready(c, now) ? now : this->rx_level->nextLevel(now);
+        }
+        if (t < next) next = t;
+    }
+    return next;
+}
@@ -0,0 +1,304 @@
+// Copyright 2025 EPFL contributors
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: vp_xheep.hh
+// Description: Transaction-level models of the X-HEEP peripherals used by the
+//              HEEPidermis firmware (SoC control, UART, timers, fast interrupt
+//              controller, PLIC, GPIO and DMA)
+
+#if !defined(VP_XHEEP_HH_)
+#define VP_XHEEP_HH_
+
+#include <stdint.h>
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "vp_bus.hh"
+
+// Number of DMA channels and trigger slots connected to the external
+// peripherals (see cheep_top.sv.tpl)
+#define VP_DMA_CH_NUM 2
+#define VP_DMA_SLOT_EXT_TX 0x20
+#define VP_DMA_SLOT_EXT_RX 0x40
+
+// Interrupt lines of the mip CSR driven by rv_timer_ao (hart 0) and by the
+// PLIC (machine software and external interrupts)
+#define VP_IRQ_TIMER 7
+#define VP_IRQ_SOFTWARE 3
+#define VP_IRQ_EXTERNAL 11
+
+// Interrupt sources of the PLIC
+#define VP_PLIC_NUM_SRC 64
+
+// Fast interrupt lines (fast_intr_ctrl.h)
+#define VP_FIC_TIMER_1 0
+#define VP_FIC_TIMER_2 1
+#define VP_FIC_TIMER_3 2
+#define VP_FIC_DMA_DONE 3
+#define VP_FIC_GPIO_0 6
+#define VP_FIC_DMA_WINDOW 14
+
+// Merge a masked register write
+static inline uint32_t vpMerge(uint32_t reg, uint32_t data, uint32_t mask)
+{
+    return (reg & ~mask) | (data & mask);
+}
+
+// Plain register storage, for the peripherals that are not modelled
+class VpRegFile : public VpDevice
+{
+private:
+    std::map<uint32_t, uint32_t> regs;
+    bool warned;
+
+public:
+    VpRegFile(const char *name);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+};
+
+// SoC control (exit value and boot registers)
+class VpSocCtrl : public VpDevice
+{
+private:
+    uint32_t regs[8];
+
+public:
+    VpSocCtrl();
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+
+    bool getExitValid();
+    int getExitValue();
+};
+
+// UART: the transmitted characters are written to a log file, as done by
+// uartdpi in the RTL testbench
+class VpUart : public VpDevice
+{
+private:
+    FILE *log;
+    uint32_t ctrl;
+
+public:
+    VpUart();
+    ~VpUart();
+
+    bool open(const std::string& filename);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+};
+
+// Fast interrupt controller. Level lines (e.g., timers, DMA) keep the pending
+// bit set while asserted, like in the RTL: clearing it only sticks once the
+// source is cleared.
+class VpFastIntrCtrl : public VpDevice
+{
+private:
+    uint16_t pending;
+    uint16_t enable;
+    uint16_t levels;
+
+    void event(uint16_t pulses, uint16_t clear);
+
+public:
+    VpFastIntrCtrl();
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+
+    void setLine(unsigned int line, bool level);
+    void pulse(unsigned int line);
+};
+
+// PLIC (one target). The gateways of level sources keep the interrupt
+// pending while the source is asserted and not claimed, like in the RTL; edge
+// sources are pending from their rising edge until claimed.
+class VpPlic : public VpDevice
+{
+private:
+    uint64_t src;
+    uint64_t ip;
+    uint64_t le;
+    uint64_t ie;
+    uint64_t claimed;
+    uint8_t prio[VP_PLIC_NUM_SRC];
+    uint32_t threshold;
+    bool msip;
+
+    unsigned int best();
+    void event(uint64_t rise);
+
+public:
+    VpPlic();
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+
+    void setSource(unsigned int id, bool level);
+};
+
+// RISC-V timer (two harts). The counters are computed from the elapsed
+// cycles when accessed; the comparator match is scheduled as an event.
+class VpRvTimer : public VpDevice
+{
+private:
+    struct Hart {
+        bool active;
+        uint32_t prescaler;
+        uint32_t step;
+        uint64_t mtime;     // value at cycle t_base
+        uint64_t t_base;    // cycle of the last prescaler wrap
+        uint64_t mtimecmp;
+        bool intr_enable;
+        bool intr_state;
+        int irq;            // fast interrupt line, -1 for the mip timer bit
+    } hart[2];
+    VpFastIntrCtrl *fic;
+
+    uint64_t getMtime(unsigned int h, uint64_t t);
+    void rebase(unsigned int h, uint64_t t);
+    void check(unsigned int h, uint64_t t);
+    void updateIrq(unsigned int h);
+
+public:
+    VpRvTimer(const char *name, VpFastIntrCtrl *fic, int irq0, int irq1);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+};
+
+// GPIO (pins 0-7 drive the fast interrupt lines). There is no pad model: the
+// input value of the output pins is their output value.
+class VpGpio : public VpDevice
+{
+private:
+    uint32_t regs[0x800 / 4];
+    VpFastIntrCtrl *fic;
+
+    void setOut(uint32_t out);
+
+public:
+    VpGpio(VpFastIntrCtrl *fic);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+
+    uint32_t getOut();
+};
+
+// Counter-based trigger train of the external peripherals (counter_trigger):
+// a trigger is fired every limit+1 cycles (never when limit is 0), or one
+// cycle after a manual trigger is set.
+class VpCounterTrigger
+{
+private:
+    uint32_t limit;
+    uint64_t t0;       // last cycle at which the counter was 0
+    uint64_t manual_at;
+
+public:
+    VpCounterTrigger();
+
+    void reset(uint64_t t);
+    void setLimit(uint32_t limit, uint64_t t);
+    void setManual(uint64_t t);
+
+    // Next trigger at or after cycle t (VP_NEVER if none)
+    uint64_t next(uint64_t t);
+
+    // Acknowledge the trigger fired at cycle t
+    void fire(uint64_t t);
+};
+
+// Hardware FIFO attached to the DMA channel 0 output (the dLC). The DMA pushes
+// the elements it reads and pops the packets to write.
+class VpDmaFifo
+{
+public:
+    virtual ~VpDmaFifo() {}
+
+    // Start of a transaction
+    virtual void flush() = 0;
+
+    // Process one element
+    virtual void push(uint32_t data) = 0;
+
+    // Get the next packet to write (false if none)
+    virtual bool pop(uint32_t *packet) = 0;
+
+    // End of the transaction reached (element count)
+    virtual bool done() = 0;
+};
+
+// Source of a DMA trigger slot driven by a level (e.g., a FIFO not empty)
+class VpDmaTrigger
+{
+public:
+    virtual ~VpDmaTrigger() {}
+    virtual bool getLevel(uint64_t t) = 0;
+
+    // First cycle after t at which the level may be asserted (VP_NEVER if
+    // none is scheduled)
+    virtual uint64_t nextLevel(uint64_t t) = 0;
+};
+
+// DMA (VP_DMA_CH_NUM channels). Untriggered transactions are copied at once
+// and completed after the time taken by the RTL (one element every two
+// cycles); triggered transactions move one element per trigger.
+class VpDma : public VpDevice
+{
+private:
+    struct Channel {
+        uint32_t regs[0x100 / 4];
+        bool busy;
+        uint32_t d1;         // elements left in the current row
+        uint32_t d2;         // rows left
+        uint32_t src;
+        uint32_t dst;
+        uint32_t window_count;
+        uint64_t next_at;    // next element (or completion) cycle
+        uint32_t rx_pulses;  // triggers received while busy
+        uint32_t tx_pulses;
+        bool transaction_ifr;
+        bool window_ifr;
+    } ch[VP_DMA_CH_NUM];
+    VpFastIntrCtrl *fic;
+    VpDmaFifo *fifo;
+    VpDmaTrigger *rx_level;
+
+    void start(unsigned int c, uint64_t t);
+    bool ready(unsigned int c, uint64_t t);
+    void transfer(unsigned int c);
+    void writeElement(unsigned int c, uint32_t data);
+    void finish(unsigned int c, uint64_t t);
+    void updateIrq();
+
+public:
+    // Elements moved
+    uint64_t elements;
+
+    VpDma(VpFastIntrCtrl *fic);
+
+    // Hardware FIFO of channel 0 and level trigger of the channel 0 rx slot
+    void setFifo(VpDmaFifo *fifo);
+    void setRxLevel(VpDmaTrigger *trigger);
+
+    // Pulsed triggers of the external slots
+    void triggerRx(unsigned int c);
+    void triggerTx(unsigned int c);
+
+    uint32_t read(uint32_t off);
+    void write(uint32_t off, uint32_t data, uint32_t mask);
+    void update(uint64_t t);
+    uint64_t nextEvent();
+};
+
+#endif // VP_XHEEP_HH_
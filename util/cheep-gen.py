@@ -157,6 +157,11 @@ def main():
     CIC_size = int(cfg["ext_periph"]["CIC"]["length"], 16)
     CIC_size_hex = int2hexstr(CIC_size, 32)
 
+    IRQ_ctrl_start_address = int(cfg["ext_periph"]["IRQ_ctrl"]["offset"], 16)
+    IRQ_ctrl_start_address_hex = int2hexstr(IRQ_ctrl_start_address, 32)
+    IRQ_ctrl_size = int(cfg["ext_periph"]["IRQ_ctrl"]["length"], 16)
+    IRQ_ctrl_size_hex = int2hexstr(IRQ_ctrl_size, 32)
+
     # Explicit arguments
     kwargs = {
         "cpu_corev_pulp": int(cpu_features["corev_pulp"]),
@@ -180,6 +185,8 @@ def main():
         "dLC_size": dLC_size_hex,
         "CIC_start_address": CIC_start_address_hex,
         "CIC_size": CIC_size_hex,
+        "IRQ_ctrl_start_address": IRQ_ctrl_start_address_hex,
+        "IRQ_ctrl_size": IRQ_ctrl_size_hex,
     }
 
     # Generate SystemVerilog package